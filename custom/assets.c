@@ -0,0 +1,193 @@
+/*
+* Copyright 2023 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include "lvgl.h"
+#include "assets.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ASSET_IMG(sym)  {#sym, LV_ASSETPACK_TYPE_IMG, &sym}
+#define ASSET_FONT(sym) {#sym, LV_ASSETPACK_TYPE_FONT, &sym}
+#define ASSET_CNT       (sizeof(asset_list) / sizeof(asset_list[0]))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const void * asset_remap(const void * builtin);
+static void style_remap(lv_style_t * style);
+static void obj_remap(lv_obj_t * obj);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(_itemperature_alpha_40x30);
+LV_IMG_DECLARE(_ihumidity_alpha_31x28);
+LV_IMG_DECLARE(_onlight_alpha_38x35);
+LV_IMG_DECLARE(_switch_alpha_37x33);
+LV_IMG_DECLARE(_clock_alpha_32x32);
+LV_IMG_DECLARE(_offlight_alpha_54x52);
+LV_IMG_DECLARE(_led_alpha_54x52);
+LV_IMG_DECLARE(_timer_alpha_47x41);
+LV_IMG_DECLARE(_arrow_alpha_38x35);
+
+LV_FONT_DECLARE(lv_font_montserratMedium_12);
+LV_FONT_DECLARE(lv_font_montserratMedium_14);
+LV_FONT_DECLARE(lv_font_montserratMedium_16);
+LV_FONT_DECLARE(lv_font_montserratMedium_18);
+LV_FONT_DECLARE(lv_font_montserratMedium_20);
+LV_FONT_DECLARE(lv_font_montserratMedium_24);
+LV_FONT_DECLARE(lv_font_Acme_Regular_25);
+LV_FONT_DECLARE(lv_font_Alatsi_Regular_16);
+LV_FONT_DECLARE(lv_font_Antonio_Regular_32);
+LV_FONT_DECLARE(lv_font_FontAwesome5_18);
+
+/*The compiled assets which can be replaced by the pack*/
+static const lv_assetpack_src_t asset_list[] = {
+    ASSET_IMG(_itemperature_alpha_40x30),
+    ASSET_IMG(_ihumidity_alpha_31x28),
+    ASSET_IMG(_onlight_alpha_38x35),
+    ASSET_IMG(_switch_alpha_37x33),
+    ASSET_IMG(_clock_alpha_32x32),
+    ASSET_IMG(_offlight_alpha_54x52),
+    ASSET_IMG(_led_alpha_54x52),
+    ASSET_IMG(_timer_alpha_47x41),
+    ASSET_IMG(_arrow_alpha_38x35),
+    ASSET_FONT(lv_font_montserratMedium_12),
+    ASSET_FONT(lv_font_montserratMedium_14),
+    ASSET_FONT(lv_font_montserratMedium_16),
+    ASSET_FONT(lv_font_montserratMedium_18),
+    ASSET_FONT(lv_font_montserratMedium_20),
+    ASSET_FONT(lv_font_montserratMedium_24),
+    ASSET_FONT(lv_font_Acme_Regular_25),
+    ASSET_FONT(lv_font_Alatsi_Regular_16),
+    ASSET_FONT(lv_font_Antonio_Regular_32),
+    ASSET_FONT(lv_font_FontAwesome5_18),
+};
+
+static lv_assetpack_t * pack;
+static const void * asset_mapped[ASSET_CNT];   /*Asset of the pack replacing `asset_list[i]` or NULL*/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool assets_init(const char * path)
+{
+    if(pack) return true;
+
+    pack = lv_assetpack_open(path);
+    if(pack == NULL) return false;
+
+    uint32_t i;
+    uint32_t found = 0;
+    for(i = 0; i < ASSET_CNT; i++) {
+        if(asset_list[i].type == LV_ASSETPACK_TYPE_IMG) asset_mapped[i] = lv_assetpack_get_img(pack, asset_list[i].name);
+        else asset_mapped[i] = lv_assetpack_get_font(pack, asset_list[i].name);
+        if(asset_mapped[i]) found++;
+    }
+
+    LV_LOG_USER("%s: %d of %d assets replaced", path, (int)found, (int)ASSET_CNT);
+    return true;
+}
+
+void assets_apply(lv_obj_t * root)
+{
+    if(pack == NULL) return;
+
+    obj_remap(root);
+
+    /*The fonts and images of the styles have changed*/
+    lv_obj_report_style_change(NULL);
+}
+
+const void * assets_img(const lv_img_dsc_t * img)
+{
+    return asset_remap(img);
+}
+
+const lv_font_t * assets_font(const lv_font_t * font)
+{
+    return asset_remap(font);
+}
+
+bool assets_write_pack(const char * path)
+{
+    return lv_assetpack_write(path, asset_list, ASSET_CNT) == LV_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static const void * asset_remap(const void * builtin)
+{
+    uint32_t i;
+    for(i = 0; i < ASSET_CNT; i++) {
+        if(asset_list[i].asset == builtin) return asset_mapped[i] ? asset_mapped[i] : builtin;
+    }
+
+    return builtin;
+}
+
+static void style_remap(lv_style_t * style)
+{
+    /*Constant styles can't be changed*/
+    if(style->prop1 == LV_STYLE_PROP_ANY) return;
+
+    static const lv_style_prop_t props[] = {LV_STYLE_TEXT_FONT, LV_STYLE_BG_IMG_SRC, LV_STYLE_ARC_IMG_SRC};
+    uint32_t i;
+    for(i = 0; i < sizeof(props) / sizeof(props[0]); i++) {
+        lv_style_value_t v;
+        if(lv_style_get_prop(style, props[i], &v) != LV_STYLE_RES_FOUND) continue;
+
+        const void * mapped = asset_remap(v.ptr);
+        if(mapped != v.ptr) {
+            v.ptr = mapped;
+            lv_style_set_prop(style, props[i], v);
+        }
+    }
+}
+
+static void obj_remap(lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < obj->style_cnt; i++) {
+        /*Shared styles are visited once per user but remapped only the first time*/
+        style_remap(obj->styles[i].style);
+    }
+
+    if(lv_obj_check_type(obj, &lv_img_class)) {
+        const void * src = lv_img_get_src(obj);
+        const void * mapped = asset_remap(src);
+        if(mapped != src) lv_img_set_src(obj, mapped);
+    }
+    else if(lv_obj_check_type(obj, &lv_imgbtn_class)) {
+        lv_imgbtn_t * imgbtn = (lv_imgbtn_t *)obj;
+        lv_imgbtn_state_t state;
+        for(state = 0; state < _LV_IMGBTN_STATE_NUM; state++) {
+            lv_imgbtn_set_src(obj, state, asset_remap(imgbtn->img_src_left[state]),
+                              asset_remap(imgbtn->img_src_mid[state]), asset_remap(imgbtn->img_src_right[state]));
+        }
+    }
+
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        obj_remap(lv_obj_get_child(obj, i));
+    }
+}
@@ -0,0 +1,63 @@
+/*
+* Copyright 2023 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+#ifndef __ASSETS_H_
+#define __ASSETS_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/*
+ * The images and fonts of the UI can be replaced by an asset pack (see lv_assetpack.h) without relinking.
+ * The pack is mapped at startup and the compiled assets are swapped for the ones in the pack
+ * which have the same name (the name of the C symbol, e.g. "_clock_alpha_32x32").
+ * Without a pack the compiled assets are used.
+ */
+
+/**
+ * Map an asset pack
+ * @param path      path of the pack file
+ * @return          true if the pack is mapped and it's compatible with this build
+ */
+bool assets_init(const char * path);
+
+/**
+ * Replace the compiled images and fonts with the ones of the pack in the styles, images
+ * and image buttons of an object and its children
+ * @param root      the object to start from, typically a screen
+ */
+void assets_apply(lv_obj_t * root);
+
+/**
+ * Get the image of the pack which replaces a compiled image
+ * @param img       a compiled image
+ * @return          the image of the pack or `img` if there is no pack or it doesn't have this image
+ */
+const void * assets_img(const lv_img_dsc_t * img);
+
+/**
+ * Get the font of the pack which replaces a compiled font
+ * @param font      a compiled font
+ * @return          the font of the pack or `font` if there is no pack or it doesn't have this font
+ */
+const lv_font_t * assets_font(const lv_font_t * font);
+
+/**
+ * Write the compiled images and fonts into an asset pack
+ * @param path      path of the pack file to create
+ * @return          true on success
+ */
+bool assets_write_pack(const char * path);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __ASSETS_H_ */
@@ -38,5 +38,14 @@
 void custom_init(lv_ui *ui)
 {
     /* Add your codes here */
+
+    /*Swipe the pages by moving their rendered pixels, the tileviews and the tiles draw only their plain backgrounds*/
+    lv_obj_t *tileviews[] = {ui->screen_tileview_main, ui->screen_tileview_hub};
+    for (uint32_t i = 0; i < sizeof(tileviews) / sizeof(tileviews[0]); i++) {
+        lv_obj_add_flag(tileviews[i], LV_OBJ_FLAG_SCROLL_BLIT);
+        for (uint32_t j = 0; j < lv_obj_get_child_cnt(tileviews[i]); j++) {
+            lv_obj_add_flag(lv_obj_get_child(tileviews[i], j), LV_OBJ_FLAG_SCROLL_BLIT);
+        }
+    }
 }
 
@@ -8,19 +8,22 @@
 #include <unistd.h>
 #include <gui_guider.h>
 #include <pthread.h>
+#include "hub/device_store.h"
+
+/* The LED of the demo, bound to screen_sw_3 */
+#define LED_DEMO_MAC    0x000000000001ULL
+#define LED_DEMO_EP     1
 
 void* led_change_st(void* arg) {
-    lv_ui *ui = (lv_ui*)arg;
+    (void)arg;
+    bool status = false;
     while (true) {
-
-	    // lv_imgbtn_set_state(ui->screen_imgbtn_8, LV_IMGBTN_STATE_RELEASED);
-        // sleep(5);
-	    // lv_imgbtn_set_state(ui->screen_imgbtn_8, LV_IMGBTN_STATE_CHECKED_RELEASED);
-        // sleep(5);
-        lv_obj_add_state(ui->screen_sw_3, LV_STATE_CHECKED);
-        sleep(5);
-        lv_obj_clear_state(ui->screen_sw_3, LV_STATE_CHECKED);
+        /* The switch follows the store at the next frame, this thread doesn't touch the widget */
+        status = !status;
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        device_store_update(LED_DEMO_MAC, LED_DEMO_EP, status, "demo led", ts.tv_sec * 1000 + ts.tv_nsec / 1000000, NULL);
         sleep(5);
     }
     return NULL;
-}
\ No newline at end of file
+}
@@ -0,0 +1,250 @@
+/**
+ * @file device_store.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "device_store.h"
+#include <pthread.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SLOT_MASK   (DEVICE_STORE_CAPACITY - 1)
+
+#if DEVICE_STORE_CAPACITY & SLOT_MASK
+#error "DEVICE_STORE_CAPACITY has to be a power of 2"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t find_slot(uint64_t mac, uint32_t ep);
+static bool insert(uint32_t id, uint64_t mac, uint32_t ep);
+static void copy_entry(uint32_t id, device_entry_t * entry);
+static uint32_t count_changed(uint32_t since, uint32_t upto);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*The devices in an open addressing table with linear probing. The id of a device is its slot.
+ *A field per array, so scanning the versions or statuses touches only those.*/
+static uint64_t dev_mac[DEVICE_STORE_CAPACITY];
+static uint32_t dev_ep[DEVICE_STORE_CAPACITY];
+static uint32_t dev_version[DEVICE_STORE_CAPACITY];     /*0: free slot*/
+static uint32_t dev_last_seen[DEVICE_STORE_CAPACITY];
+static uint16_t dev_name_ofs[DEVICE_STORE_CAPACITY];    /*0: no name*/
+static bool dev_status[DEVICE_STORE_CAPACITY];
+
+static char name_pool[DEVICE_STORE_NAME_POOL] = "";     /*Starts with the empty name*/
+static uint32_t name_pool_used = 1;
+
+static uint32_t store_version;
+static uint32_t store_cnt;
+static pthread_mutex_t store_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t device_store_update(uint64_t mac, uint32_t ep, bool status, const char * name, uint32_t now_ms,
+                             bool * changed)
+{
+    bool chg = false;
+
+    pthread_mutex_lock(&store_mutex);
+    uint32_t id = find_slot(mac, ep);
+    if(dev_version[id] == 0) {
+        if(!insert(id, mac, ep)) {
+            pthread_mutex_unlock(&store_mutex);
+            if(changed) *changed = false;
+            return DEVICE_ID_INVALID;
+        }
+        chg = true;
+    }
+    else if(dev_status[id] != status) {
+        chg = true;
+    }
+
+    if(name && name[0] && dev_name_ofs[id] == 0) {
+        size_t len = strlen(name) + 1;
+        if(name_pool_used + len <= DEVICE_STORE_NAME_POOL && name_pool_used <= UINT16_MAX) {
+            memcpy(&name_pool[name_pool_used], name, len);
+            dev_name_ofs[id] = name_pool_used;
+            name_pool_used += len;
+        }
+    }
+
+    dev_status[id] = status;
+    dev_last_seen[id] = now_ms;
+    if(chg) dev_version[id] = ++store_version;
+    pthread_mutex_unlock(&store_mutex);
+
+    if(changed) *changed = chg;
+    return id;
+}
+
+uint32_t device_store_add(uint64_t mac, uint32_t ep)
+{
+    pthread_mutex_lock(&store_mutex);
+    uint32_t id = find_slot(mac, ep);
+    if(dev_version[id] == 0) {
+        if(insert(id, mac, ep)) {
+            dev_status[id] = false;
+            dev_last_seen[id] = 0;
+            dev_version[id] = ++store_version;
+        }
+        else {
+            id = DEVICE_ID_INVALID;
+        }
+    }
+    pthread_mutex_unlock(&store_mutex);
+    return id;
+}
+
+uint32_t device_store_find(uint64_t mac, uint32_t ep)
+{
+    pthread_mutex_lock(&store_mutex);
+    uint32_t id = find_slot(mac, ep);
+    if(dev_version[id] == 0) id = DEVICE_ID_INVALID;
+    pthread_mutex_unlock(&store_mutex);
+    return id;
+}
+
+bool device_store_get(uint32_t id, device_entry_t * entry)
+{
+    if(id >= DEVICE_STORE_CAPACITY) return false;
+
+    pthread_mutex_lock(&store_mutex);
+    bool found = dev_version[id] != 0;
+    if(found) copy_entry(id, entry);
+    pthread_mutex_unlock(&store_mutex);
+    return found;
+}
+
+bool device_store_get_status(uint32_t id)
+{
+    if(id >= DEVICE_STORE_CAPACITY) return false;
+
+    pthread_mutex_lock(&store_mutex);
+    bool status = dev_status[id];
+    pthread_mutex_unlock(&store_mutex);
+    return status;
+}
+
+uint32_t device_store_get_version(void)
+{
+    pthread_mutex_lock(&store_mutex);
+    uint32_t version = store_version;
+    pthread_mutex_unlock(&store_mutex);
+    return version;
+}
+
+uint32_t device_store_get_cnt(void)
+{
+    pthread_mutex_lock(&store_mutex);
+    uint32_t cnt = store_cnt;
+    pthread_mutex_unlock(&store_mutex);
+    return cnt;
+}
+
+uint32_t device_store_snapshot(device_entry_t * entries, uint32_t max, uint32_t since, uint32_t * version)
+{
+    uint32_t cnt = 0;
+
+    pthread_mutex_lock(&store_mutex);
+    uint32_t upto = store_version;
+    if(max == 0) upto = since;
+    else if(count_changed(since, upto) > max) {
+        /*Return the oldest changes. Every change has its own version, so at least `since + 1` fits.*/
+        uint32_t fits = since + 1;
+        uint32_t too_many = upto;
+        while(too_many - fits > 1) {
+            uint32_t mid = fits + (too_many - fits) / 2;
+            if(count_changed(since, mid) <= max) fits = mid;
+            else too_many = mid;
+        }
+        upto = fits;
+    }
+
+    uint32_t id;
+    for(id = 0; id < DEVICE_STORE_CAPACITY; id++) {
+        uint32_t v = dev_version[id];
+        if(v <= since || v > upto) continue;
+        copy_entry(id, &entries[cnt]);
+        cnt++;
+    }
+    *version = upto;
+    pthread_mutex_unlock(&store_mutex);
+
+    return cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The slot of the device or the free slot where it should be added. Called with `store_mutex` locked.*/
+static uint32_t find_slot(uint64_t mac, uint32_t ep)
+{
+    /*splitmix64 finalizer, the MACs of a vendor differ only in the low bytes*/
+    uint64_t h = mac ^ ((uint64_t)ep << 48) ^ ep;
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+
+    uint32_t slot = (uint32_t)h & SLOT_MASK;
+    while(dev_version[slot] != 0 && (dev_mac[slot] != mac || dev_ep[slot] != ep)) {
+        slot = (slot + 1) & SLOT_MASK;
+    }
+    return slot;
+}
+
+/*Take a free slot for a device. The caller sets the version. Called with `store_mutex` locked.*/
+static bool insert(uint32_t id, uint64_t mac, uint32_t ep)
+{
+    if(store_cnt >= DEVICE_STORE_MAX_CNT) return false;
+
+    dev_mac[id] = mac;
+    dev_ep[id] = ep;
+    dev_name_ofs[id] = 0;
+    store_cnt++;
+    return true;
+}
+
+/*Called with `store_mutex` locked*/
+static uint32_t count_changed(uint32_t since, uint32_t upto)
+{
+    uint32_t cnt = 0;
+    uint32_t id;
+    for(id = 0; id < DEVICE_STORE_CAPACITY; id++) {
+        uint32_t v = dev_version[id];
+        if(v > since && v <= upto) cnt++;
+    }
+    return cnt;
+}
+
+/*Called with `store_mutex` locked*/
+static void copy_entry(uint32_t id, device_entry_t * entry)
+{
+    entry->id = id;
+    entry->mac = dev_mac[id];
+    entry->ep = dev_ep[id];
+    entry->status = dev_status[id];
+    entry->name = &name_pool[dev_name_ofs[id]];
+    entry->last_seen = dev_last_seen[id];
+    entry->version = dev_version[id];
+}
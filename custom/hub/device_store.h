@@ -0,0 +1,126 @@
+/**
+ * @file device_store.h
+ * The state of the hub's devices keyed by MAC address and endpoint.
+ * Written by the hub receiver thread and read by the UI. The storage is static,
+ * so an update doesn't allocate.
+ */
+
+#ifndef DEVICE_STORE_H
+#define DEVICE_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Slots of the hash table, a power of 2. At most 3/4 of them are used.*/
+#ifndef DEVICE_STORE_CAPACITY
+#define DEVICE_STORE_CAPACITY   1024
+#endif
+
+/*Bytes for the device names*/
+#ifndef DEVICE_STORE_NAME_POOL
+#define DEVICE_STORE_NAME_POOL  (16 * 1024)
+#endif
+
+#define DEVICE_STORE_MAX_CNT    (DEVICE_STORE_CAPACITY / 4 * 3)
+#define DEVICE_ID_INVALID       UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t id;            /**< Stable while the program runs*/
+    uint64_t mac;
+    uint32_t ep;
+    bool status;
+    const char * name;      /**< "" if it wasn't reported. Valid while the program runs.*/
+    uint32_t last_seen;     /**< The `now_ms` of the last report*/
+    uint32_t version;       /**< The store version of the last change*/
+} device_entry_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Save a report of a device. A device is added by its first report.
+ * @param mac       MAC address of the device
+ * @param ep        endpoint of the device
+ * @param status    the reported status
+ * @param name      name of the device or NULL. Only the first name is kept.
+ * @param now_ms    time of the report
+ * @param changed   set to true if it's a new device or the status changed. Can be NULL.
+ * @return          id of the device or `DEVICE_ID_INVALID` if the store is full
+ */
+uint32_t device_store_update(uint64_t mac, uint32_t ep, bool status, const char * name, uint32_t now_ms,
+                             bool * changed);
+
+/**
+ * Add a device if it's not in the store yet, e.g. to bind a widget to it before its first report.
+ * A new device is off and has no name.
+ * @param mac       MAC address of the device
+ * @param ep        endpoint of the device
+ * @return          id of the device or `DEVICE_ID_INVALID` if the store is full
+ */
+uint32_t device_store_add(uint64_t mac, uint32_t ep);
+
+/**
+ * Find a device
+ * @param mac       MAC address of the device
+ * @param ep        endpoint of the device
+ * @return          id of the device or `DEVICE_ID_INVALID` if it wasn't reported yet
+ */
+uint32_t device_store_find(uint64_t mac, uint32_t ep);
+
+/**
+ * Get a device
+ * @param id        id of the device
+ * @param entry     store the state of the device here
+ * @return          false if there is no such device
+ */
+bool device_store_get(uint32_t id, device_entry_t * entry);
+
+/**
+ * Get the status of a device
+ * @param id        id of the device
+ * @return          the last reported status, false if there is no such device
+ */
+bool device_store_get_status(uint32_t id);
+
+/**
+ * Get the version of the store. It's incremented by every change.
+ * @return          the version, 0 if nothing was reported yet
+ */
+uint32_t device_store_get_version(void);
+
+/**
+ * Get the number of devices
+ * @return          the devices in the store
+ */
+uint32_t device_store_get_cnt(void);
+
+/**
+ * Copy the devices changed after a version of the store
+ * @param entries   store the devices here
+ * @param max       size of `entries`. If it's smaller than the number of changes,
+ *                  the oldest changes are copied and the others are returned by the next call.
+ * @param since     a version returned earlier in `version`, 0 to get every device
+ * @param version   store the version to pass in `since` next time
+ * @return          the number of devices copied
+ */
+uint32_t device_store_snapshot(device_entry_t * entries, uint32_t max, uint32_t since, uint32_t * version);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DEVICE_STORE_H*/
@@ -0,0 +1,254 @@
+/**
+ * @file hub_ingest.cc
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "hub_ingest.h"
+#include "device_store.h"
+#include "lvgl.h"
+#include "proto3/typedef.pb.h"
+#include <google/protobuf/arena.h>
+#include <atomic>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RECV_TIMEOUT_MS     100     /*How often the thread checks if it should stop*/
+#define RECV_BUF_SIZE       (1024 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * receive_thread(void * arg);
+static void apply_reports(const Buffer & msg, uint32_t now_ms);
+static void apply_report(uint64_t mac, uint32_t ep, bool status, const std::string & name, uint32_t now_ms);
+static void deliver_timer_cb(lv_timer_t * timer);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static int sock_fd = -1;
+static char sock_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+static pthread_t recv_tid;
+static std::atomic<bool> recv_stop;
+static lv_timer_t * deliver_timer;
+static hub_change_cb_t change_cb;
+static void * change_user_data;
+
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static hub_ingest_stats_t stats;
+static hub_ingest_stats_t batch_stats;  /*Counted by the receive thread, added to `stats` after a batch*/
+
+/*Used only in the UI thread*/
+static uint32_t delivered_version;
+static device_entry_t deliver_entries[DEVICE_STORE_MAX_CNT];
+static hub_change_t deliver_buf[DEVICE_STORE_MAX_CNT];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int hub_ingest_start(const char * path, hub_change_cb_t cb, void * user_data)
+{
+    if(deliver_timer) return -1;
+
+    /*The other writers of the device store are delivered even if the socket can't be used*/
+    change_cb = cb;
+    change_user_data = user_data;
+    delivered_version = 0;
+    deliver_timer = lv_timer_create(deliver_timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(addr.sun_path)) {
+        LV_LOG_WARN("hub: socket path is too long: %s", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        LV_LOG_WARN("hub: socket() failed: %s", strerror(errno));
+        return -1;
+    }
+
+    /*Room for the bursts while the thread is parsing*/
+    int rcvbuf = RECV_BUF_SIZE;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    struct timeval tv = {0, RECV_TIMEOUT_MS * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    unlink(path);
+    if(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        LV_LOG_WARN("hub: can't bind %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    sock_fd = fd;
+    strcpy(sock_path, path);
+    recv_stop.store(false);
+
+    if(pthread_create(&recv_tid, NULL, receive_thread, NULL) != 0) {
+        LV_LOG_WARN("hub: can't create the receive thread");
+        close(fd);
+        unlink(path);
+        sock_fd = -1;
+        return -1;
+    }
+
+    return 0;
+}
+
+void hub_ingest_stop(void)
+{
+    if(deliver_timer) {
+        lv_timer_del(deliver_timer);
+        deliver_timer = NULL;
+    }
+
+    if(sock_fd < 0) return;
+
+    recv_stop.store(true);
+    pthread_join(recv_tid, NULL);
+    close(sock_fd);
+    unlink(sock_path);
+    sock_fd = -1;
+}
+
+void hub_ingest_get_stats(hub_ingest_stats_t * stats_out)
+{
+    pthread_mutex_lock(&stats_mutex);
+    *stats_out = stats;
+    pthread_mutex_unlock(&stats_mutex);
+    stats_out->device_cnt = device_store_get_cnt();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * receive_thread(void * arg)
+{
+    (void)arg;
+
+    static uint8_t recv_bufs[HUB_RECV_BATCH][HUB_MSG_MAX];
+    static uint8_t arena_block[HUB_ARENA_BLOCK];
+    struct mmsghdr msgs[HUB_RECV_BATCH];
+    struct iovec iovs[HUB_RECV_BATCH];
+
+    /*Parse into the same message on the same block, so a burst doesn't allocate*/
+    google::protobuf::ArenaOptions options;
+    options.initial_block = (char *)arena_block;
+    options.initial_block_size = sizeof(arena_block);
+    google::protobuf::Arena arena(options);
+    Buffer * msg = google::protobuf::Arena::CreateMessage<Buffer>(&arena);
+
+    while(!recv_stop.load()) {
+        for(int i = 0; i < HUB_RECV_BATCH; i++) {
+            iovs[i].iov_base = recv_bufs[i];
+            iovs[i].iov_len = HUB_MSG_MAX;
+            memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        /*Wait for the first message, then take what else is queued*/
+        int n = recvmmsg(sock_fd, msgs, HUB_RECV_BATCH, MSG_WAITFORONE, NULL);
+        if(n <= 0) {
+            if(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LV_LOG_WARN("hub: recvmmsg() failed: %s", strerror(errno));
+                usleep(RECV_TIMEOUT_MS * 1000);
+            }
+            continue;
+        }
+
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        uint32_t now_ms = ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+
+        memset(&batch_stats, 0, sizeof(batch_stats));
+        batch_stats.recv_cnt = 1;
+        for(int i = 0; i < n; i++) {
+            if((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ||
+               !msg->ParseFromArray(recv_bufs[i], (int)msgs[i].msg_len)) {
+                batch_stats.drop_cnt++;
+                continue;
+            }
+            batch_stats.msg_cnt++;
+            apply_reports(*msg, now_ms);
+        }
+
+        /*Reusing the message keeps the largest message's objects; start over if that grew too much*/
+        if(arena.SpaceAllocated() > 4 * sizeof(arena_block)) {
+            arena.Reset();
+            msg = google::protobuf::Arena::CreateMessage<Buffer>(&arena);
+        }
+
+        pthread_mutex_lock(&stats_mutex);
+        stats.recv_cnt += batch_stats.recv_cnt;
+        stats.msg_cnt += batch_stats.msg_cnt;
+        stats.drop_cnt += batch_stats.drop_cnt;
+        stats.report_cnt += batch_stats.report_cnt;
+        stats.change_cnt += batch_stats.change_cnt;
+        stats.full_cnt += batch_stats.full_cnt;
+        pthread_mutex_unlock(&stats_mutex);
+    }
+
+    return NULL;
+}
+
+static void apply_reports(const Buffer & msg, uint32_t now_ms)
+{
+    for(const Led_t & led : msg.led()) {
+        apply_report(led.mac(), led.ep(), led.status(), led.name(), now_ms);
+    }
+    for(const Sw_t & sw : msg.sw()) {
+        apply_report(sw.mac(), sw.ep(), sw.status(), sw.name(), now_ms);
+    }
+}
+
+static void apply_report(uint64_t mac, uint32_t ep, bool status, const std::string & name, uint32_t now_ms)
+{
+    bool changed;
+    uint32_t id = device_store_update(mac, ep, status, name.c_str(), now_ms, &changed);
+
+    batch_stats.report_cnt++;
+    if(id == DEVICE_ID_INVALID) batch_stats.full_cnt++;
+    else if(changed) batch_stats.change_cnt++;
+}
+
+/*Pass the devices changed since the last call. Several changes of a device are passed once.*/
+static void deliver_timer_cb(lv_timer_t * timer)
+{
+    (void)timer;
+
+    uint32_t cnt = device_store_snapshot(deliver_entries, DEVICE_STORE_MAX_CNT, delivered_version,
+                                         &delivered_version);
+    if(cnt == 0 || change_cb == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        deliver_buf[i].id = deliver_entries[i].id;
+        deliver_buf[i].mac = deliver_entries[i].mac;
+        deliver_buf[i].ep = deliver_entries[i].ep;
+        deliver_buf[i].status = deliver_entries[i].status;
+    }
+    change_cb(deliver_buf, cnt, change_user_data);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file hub_ingest.h
+ * Receive the `Buffer` messages of the hub on a Unix domain datagram socket, save the
+ * switches and LEDs in the device store and pass the changed ones to the UI thread once per frame.
+ */
+
+#ifndef HUB_INGEST_H
+#define HUB_INGEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef HUB_SOCKET_PATH
+#define HUB_SOCKET_PATH         "/tmp/gui_hub.sock"
+#endif
+
+/*Datagrams read by one system call*/
+#ifndef HUB_RECV_BATCH
+#define HUB_RECV_BATCH          32
+#endif
+
+/*The largest message. Longer ones are dropped.*/
+#ifndef HUB_MSG_MAX
+#define HUB_MSG_MAX             8192
+#endif
+
+/*The messages are parsed into this block. The arena is reset if it had to grow beyond 4 times of it.*/
+#ifndef HUB_ARENA_BLOCK
+#define HUB_ARENA_BLOCK         (64 * 1024)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t id;            /**< id of the device in the device store*/
+    uint64_t mac;
+    uint32_t ep;
+    bool status;
+} hub_change_t;
+
+/**
+ * Called in the UI thread with the devices changed since the last call.
+ * A device is passed once with its last status even if it changed several times.
+ */
+typedef void (*hub_change_cb_t)(const hub_change_t * changes, uint32_t cnt, void * user_data);
+
+typedef struct {
+    uint64_t msg_cnt;       /**< Messages parsed*/
+    uint64_t drop_cnt;      /**< Messages which were too long or couldn't be parsed*/
+    uint64_t recv_cnt;      /**< System calls which returned messages*/
+    uint64_t report_cnt;    /**< Device reports in the messages*/
+    uint64_t change_cnt;    /**< Reports which changed the status of a device*/
+    uint64_t full_cnt;      /**< Reports of new devices which didn't fit into the device store*/
+    uint32_t device_cnt;    /**< Devices seen so far*/
+} hub_ingest_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Bind the socket and start receiving in a thread. Call it from the UI thread after `lv_init()`.
+ * @param path      path of the socket. An existing file there is removed.
+ * @param cb        called with the changes once per frame
+ * @param user_data passed to `cb`
+ * @return          0 on success, -1 on error. The changes written to the device store by others
+ *                  are passed to `cb` even if the socket can't be used, until `hub_ingest_stop()`.
+ */
+int hub_ingest_start(const char * path, hub_change_cb_t cb, void * user_data);
+
+/**
+ * Stop the thread, the delivery of the changes and remove the socket. The devices are kept in the device store,
+ * after a new start the callback gets all of them first.
+ */
+void hub_ingest_stop(void);
+
+/**
+ * Get the statistics of the ingestion
+ * @param stats     store the statistics here
+ */
+void hub_ingest_get_stats(hub_ingest_stats_t * stats);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*HUB_INGEST_H*/
@@ -0,0 +1,409 @@
+/**
+ * @file i2c_bus.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "i2c_bus.h"
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MIN_BACKOFF     100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _i2c_bus_t {
+    const i2c_adapter_t * adapter;
+    i2c_dev_t * devs[I2C_BUS_MAX_DEVICES];
+    uint32_t dev_cnt;
+
+    /*`devs`, `dev_cnt`, `stop` and `stats` are protected by `mutex`*/
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t tid;
+    bool running;
+    bool stop;
+    i2c_bus_stats_t stats;
+};
+
+/*A transaction of a device in a transfer*/
+typedef struct {
+    i2c_dev_t * dev;
+    uint32_t msg_start;
+    uint32_t msg_cnt;
+    int err;
+} transaction_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * bus_thread(void * arg);
+static uint32_t collect_due(i2c_bus_t * bus, uint64_t now, i2c_dev_t ** due);
+static bool run_transactions(i2c_bus_t * bus, i2c_dev_t ** due, uint32_t due_cnt);
+static void wait_until(i2c_bus_t * bus, uint64_t time_us);
+static uint64_t now_us(void);
+
+static int linux_open(void * ctx);
+static void linux_close(void * ctx);
+static int linux_transfer(void * ctx, i2c_msg_t * msgs, uint32_t cnt);
+
+static int mock_open(void * ctx);
+static void mock_close(void * ctx);
+static int mock_transfer(void * ctx, i2c_msg_t * msgs, uint32_t cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void i2c_adapter_init_linux(i2c_adapter_t * adapter, i2c_linux_t * linux_i2c, const char * path)
+{
+    linux_i2c->path = path;
+    linux_i2c->fd = -1;
+
+    adapter->open = linux_open;
+    adapter->close = linux_close;
+    adapter->transfer = linux_transfer;
+    adapter->ctx = linux_i2c;
+}
+
+void i2c_adapter_init_mock(i2c_adapter_t * adapter, i2c_mock_t * mock)
+{
+    adapter->open = mock_open;
+    adapter->close = mock_close;
+    adapter->transfer = mock_transfer;
+    adapter->ctx = mock;
+}
+
+i2c_bus_t * i2c_bus_create(const i2c_adapter_t * adapter)
+{
+    i2c_bus_t * bus = calloc(1, sizeof(i2c_bus_t));
+    if(bus == NULL) return NULL;
+
+    bus->adapter = adapter;
+    pthread_mutex_init(&bus->mutex, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&bus->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    return bus;
+}
+
+int i2c_bus_add(i2c_bus_t * bus, i2c_dev_t * dev)
+{
+    int res = -1;
+    pthread_mutex_lock(&bus->mutex);
+    if(bus->dev_cnt < I2C_BUS_MAX_DEVICES) {
+        dev->deadline = now_us();
+        bus->devs[bus->dev_cnt++] = dev;
+        pthread_cond_signal(&bus->cond);
+        res = 0;
+    }
+    pthread_mutex_unlock(&bus->mutex);
+    return res;
+}
+
+int i2c_bus_start(i2c_bus_t * bus)
+{
+    if(bus->running) return -1;
+
+    bus->stop = false;
+    if(pthread_create(&bus->tid, NULL, bus_thread, bus) != 0) return -1;
+    bus->running = true;
+    return 0;
+}
+
+void i2c_bus_del(i2c_bus_t * bus)
+{
+    if(bus->running) {
+        pthread_mutex_lock(&bus->mutex);
+        bus->stop = true;
+        pthread_cond_signal(&bus->cond);
+        pthread_mutex_unlock(&bus->mutex);
+        pthread_join(bus->tid, NULL);
+    }
+
+    pthread_cond_destroy(&bus->cond);
+    pthread_mutex_destroy(&bus->mutex);
+    free(bus);
+}
+
+void i2c_bus_get_stats(i2c_bus_t * bus, i2c_bus_stats_t * stats)
+{
+    pthread_mutex_lock(&bus->mutex);
+    *stats = bus->stats;
+    pthread_mutex_unlock(&bus->mutex);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * bus_thread(void * arg)
+{
+    i2c_bus_t * bus = arg;
+    const i2c_adapter_t * adapter = bus->adapter;
+    i2c_dev_t * due[I2C_BUS_MAX_DEVICES];
+    bool open = false;
+    uint32_t backoff = 0;
+    uint32_t errors = 0;
+
+    pthread_mutex_lock(&bus->mutex);
+    while(!bus->stop) {
+        if(!open) {
+            pthread_mutex_unlock(&bus->mutex);
+            open = adapter->open(adapter->ctx) == 0;
+            pthread_mutex_lock(&bus->mutex);
+
+            if(!open) {
+                backoff = backoff ? backoff * 2 : MIN_BACKOFF;
+                if(backoff > I2C_BUS_MAX_BACKOFF) backoff = I2C_BUS_MAX_BACKOFF;
+                wait_until(bus, now_us() + (uint64_t)backoff * 1000);
+                continue;
+            }
+
+            /*The devices might have lost their state, start them again*/
+            bus->stats.open_cnt++;
+            backoff = 0;
+            errors = 0;
+            uint64_t now = now_us();
+            uint32_t i;
+            for(i = 0; i < bus->dev_cnt; i++) {
+                if(bus->stats.open_cnt > 1 && bus->devs[i]->reset_cb) bus->devs[i]->reset_cb(bus->devs[i]);
+                bus->devs[i]->deadline = now;
+            }
+        }
+
+        uint64_t now = now_us();
+        uint32_t due_cnt = collect_due(bus, now, due);
+        if(due_cnt == 0) {
+            uint64_t next = UINT64_MAX;
+            uint32_t i;
+            for(i = 0; i < bus->dev_cnt; i++) {
+                if(bus->devs[i]->deadline < next) next = bus->devs[i]->deadline;
+            }
+            wait_until(bus, next);
+            continue;
+        }
+
+        pthread_mutex_unlock(&bus->mutex);
+        bool failed = run_transactions(bus, due, due_cnt);
+        pthread_mutex_lock(&bus->mutex);
+
+        /*Open the adapter again if it keeps failing*/
+        errors = failed ? errors + 1 : 0;
+        if(errors >= I2C_BUS_MAX_ERRORS) {
+            adapter->close(adapter->ctx);
+            open = false;
+            backoff = MIN_BACKOFF;
+            wait_until(bus, now_us() + (uint64_t)backoff * 1000);
+        }
+    }
+    pthread_mutex_unlock(&bus->mutex);
+
+    if(open) adapter->close(adapter->ctx);
+    return NULL;
+}
+
+/*The devices due until the end of the batch window, the earliest first. Called with `mutex` locked.*/
+static uint32_t collect_due(i2c_bus_t * bus, uint64_t now, i2c_dev_t ** due)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < bus->dev_cnt; i++) {
+        i2c_dev_t * dev = bus->devs[i];
+        if(dev->deadline > now + I2C_BUS_BATCH_WINDOW) continue;
+
+        /*Only a few devices, insertion sort*/
+        uint32_t j = cnt++;
+        while(j > 0 && due[j - 1]->deadline > dev->deadline) {
+            due[j] = due[j - 1];
+            j--;
+        }
+        due[j] = dev;
+    }
+
+    /*Wait for the first one if it's not due yet*/
+    if(cnt && due[0]->deadline > now) return 0;
+    return cnt;
+}
+
+/*Send the transactions of the devices in as few transfers as possible.
+ *Return true if all of them failed with other errors than a NACK.*/
+static bool run_transactions(i2c_bus_t * bus, i2c_dev_t ** due, uint32_t due_cnt)
+{
+    const i2c_adapter_t * adapter = bus->adapter;
+    i2c_msg_t msgs[I2C_BUS_MAX_DEVICES * I2C_DEV_MAX_MSGS];
+    transaction_t trs[I2C_BUS_MAX_DEVICES];
+    uint32_t msg_cnt = 0;
+    uint32_t transfer_cnt = 0;
+    uint32_t retry_cnt = 0;
+    uint32_t error_cnt = 0;
+    uint32_t bus_error_cnt = 0;
+    uint32_t i;
+
+    for(i = 0; i < due_cnt; i++) {
+        trs[i].dev = due[i];
+        trs[i].msg_start = msg_cnt;
+        trs[i].msg_cnt = due[i]->prepare_cb(due[i], &msgs[msg_cnt]);
+        trs[i].err = 0;
+        msg_cnt += trs[i].msg_cnt;
+    }
+
+    /*Send the transactions in groups which fit into a transfer*/
+    uint32_t first = 0;
+    while(first < due_cnt) {
+        uint32_t last = first;
+        uint32_t cnt = trs[first].msg_cnt;
+        while(last + 1 < due_cnt && cnt + trs[last + 1].msg_cnt <= I2C_BUS_MAX_MSGS) {
+            last++;
+            cnt += trs[last].msg_cnt;
+        }
+
+        transfer_cnt++;
+        if(adapter->transfer(adapter->ctx, &msgs[trs[first].msg_start], cnt) != 0) {
+            if(first == last) {
+                trs[first].err = errno;
+            }
+            else {
+                /*Find the failed ones. The transactions before the failure are repeated,
+                 *the drivers have to tolerate that.*/
+                for(i = first; i <= last; i++) {
+                    transfer_cnt++;
+                    retry_cnt++;
+                    if(adapter->transfer(adapter->ctx, &msgs[trs[i].msg_start], trs[i].msg_cnt) != 0) trs[i].err = errno;
+                }
+            }
+        }
+        first = last + 1;
+    }
+
+    uint64_t now = now_us();
+    for(i = 0; i < due_cnt; i++) {
+        if(trs[i].err) {
+            error_cnt++;
+            if(!I2C_IS_NACK(trs[i].err)) bus_error_cnt++;
+        }
+        trs[i].dev->deadline = now + trs[i].dev->complete_cb(trs[i].dev, trs[i].err);
+    }
+
+    pthread_mutex_lock(&bus->mutex);
+    bus->stats.transfer_cnt += transfer_cnt;
+    bus->stats.transaction_cnt += due_cnt;
+    bus->stats.retry_cnt += retry_cnt;
+    bus->stats.error_cnt += error_cnt;
+    pthread_mutex_unlock(&bus->mutex);
+
+    return bus_error_cnt == due_cnt;
+}
+
+/*Called with `mutex` locked. Returns at `time_us`, or earlier if a device was added or the bus is stopped.*/
+static void wait_until(i2c_bus_t * bus, uint64_t time_us)
+{
+    if(bus->stop) return;
+    if(time_us == UINT64_MAX) {
+        pthread_cond_wait(&bus->cond, &bus->mutex);
+        return;
+    }
+
+    struct timespec ts;
+    ts.tv_sec = time_us / 1000000;
+    ts.tv_nsec = (time_us % 1000000) * 1000;
+    pthread_cond_timedwait(&bus->cond, &bus->mutex, &ts);
+}
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int linux_open(void * ctx)
+{
+    i2c_linux_t * linux_i2c = ctx;
+    linux_i2c->fd = open(linux_i2c->path, O_RDWR | O_CLOEXEC);
+    return linux_i2c->fd < 0 ? -1 : 0;
+}
+
+static void linux_close(void * ctx)
+{
+    i2c_linux_t * linux_i2c = ctx;
+    if(linux_i2c->fd >= 0) close(linux_i2c->fd);
+    linux_i2c->fd = -1;
+}
+
+static int linux_transfer(void * ctx, i2c_msg_t * msgs, uint32_t cnt)
+{
+    i2c_linux_t * linux_i2c = ctx;
+    struct i2c_msg kmsgs[I2C_BUS_MAX_MSGS];
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        kmsgs[i].addr = msgs[i].addr;
+        kmsgs[i].flags = msgs[i].flags & I2C_MSG_READ ? I2C_M_RD : 0;
+        kmsgs[i].len = msgs[i].len;
+        kmsgs[i].buf = msgs[i].buf;
+    }
+
+    struct i2c_rdwr_ioctl_data data = {kmsgs, cnt};
+    return ioctl(linux_i2c->fd, I2C_RDWR, &data) < 0 ? -1 : 0;
+}
+
+static int mock_open(void * ctx)
+{
+    (void)ctx;
+    return 0;
+}
+
+static void mock_close(void * ctx)
+{
+    (void)ctx;
+}
+
+static int mock_transfer(void * ctx, i2c_msg_t * msgs, uint32_t cnt)
+{
+    i2c_mock_t * mock = ctx;
+    mock->transfer_cnt++;
+    if(mock->fail_cnt) {
+        mock->fail_cnt--;
+        errno = EIO;
+        return -1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        i2c_mock_dev_t * dev = NULL;
+        uint32_t d;
+        for(d = 0; d < mock->dev_cnt; d++) {
+            if(mock->devs[d].addr == msgs[i].addr) dev = &mock->devs[d];
+        }
+        if(dev == NULL) {
+            errno = ENXIO;
+            return -1;
+        }
+
+        mock->msg_cnt++;
+        int res = msgs[i].flags & I2C_MSG_READ ? dev->read(dev->ctx, msgs[i].buf, msgs[i].len) :
+                  dev->write(dev->ctx, msgs[i].buf, msgs[i].len);
+        if(res != 0) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file i2c_bus.h
+ * One thread owns an I2C adapter and runs the transactions of its devices by deadline.
+ * The transactions due at about the same time are sent together in one transfer
+ * (one `I2C_RDWR` call on Linux).
+ */
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef I2C_BUS_MAX_DEVICES
+#define I2C_BUS_MAX_DEVICES     16
+#endif
+
+/*Messages of one transfer, the limit of I2C_RDWR*/
+#define I2C_BUS_MAX_MSGS        42
+
+/*Messages of one transaction of a device*/
+#define I2C_DEV_MAX_MSGS        4
+
+/*Transactions due within this time are sent with the first one [us]*/
+#ifndef I2C_BUS_BATCH_WINDOW
+#define I2C_BUS_BATCH_WINDOW    2000
+#endif
+
+/*After this many failed transfers in a row the adapter is opened again*/
+#ifndef I2C_BUS_MAX_ERRORS
+#define I2C_BUS_MAX_ERRORS      5
+#endif
+
+/*Backoff of opening the adapter [ms]: 100 ms, then 200 ms, ... up to this*/
+#ifndef I2C_BUS_MAX_BACKOFF
+#define I2C_BUS_MAX_BACKOFF     30000
+#endif
+
+#define I2C_MSG_READ            0x0001  /*The same as I2C_M_RD*/
+
+/*A device didn't acknowledge. Depending on the adapter driver it's reported with `EREMOTEIO` or `ENXIO`.*/
+#define I2C_IS_NACK(err)        ((err) == EREMOTEIO || (err) == ENXIO)
+
+#define I2C_MOCK_MAX_DEVICES    8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint16_t addr;
+    uint16_t flags;             /**< `I2C_MSG_READ` or 0 to write*/
+    uint16_t len;
+    uint8_t * buf;
+} i2c_msg_t;
+
+/**
+ * Access to an adapter. The functions return 0 on success and -1 with `errno` on error.
+ * `transfer` sends the messages with repeated starts. If a device doesn't acknowledge it fails with `EREMOTEIO`
+ * or `ENXIO`, see `I2C_IS_NACK()`.
+ */
+typedef struct {
+    int (*open)(void * ctx);
+    void (*close)(void * ctx);
+    int (*transfer)(void * ctx, i2c_msg_t * msgs, uint32_t cnt);
+    void * ctx;
+} i2c_adapter_t;
+
+struct _i2c_dev_t;
+
+/**
+ * Called in the bus thread to start a transaction.
+ * @param dev       the device
+ * @param msgs      fill the messages of the transaction here
+ * @return          the number of messages, 1 to `I2C_DEV_MAX_MSGS`
+ */
+typedef uint32_t (*i2c_dev_prepare_cb_t)(struct _i2c_dev_t * dev, i2c_msg_t * msgs);
+
+/**
+ * Called in the bus thread with the result of the transaction
+ * @param dev       the device
+ * @param err       0 on success or the `errno` of the transfer
+ * @return          time until the next transaction [us]
+ */
+typedef uint32_t (*i2c_dev_complete_cb_t)(struct _i2c_dev_t * dev, int err);
+
+/**
+ * Called in the bus thread after the adapter was opened again, the device should be set up again
+ * @param dev       the device
+ */
+typedef void (*i2c_dev_reset_cb_t)(struct _i2c_dev_t * dev);
+
+typedef struct _i2c_dev_t {
+    const char * name;
+    i2c_dev_prepare_cb_t prepare_cb;
+    i2c_dev_complete_cb_t complete_cb;
+    i2c_dev_reset_cb_t reset_cb;    /**< Can be NULL*/
+    void * user_data;
+
+    /*Used by the bus*/
+    uint64_t deadline;
+} i2c_dev_t;
+
+typedef struct {
+    uint32_t transfer_cnt;      /**< Transfers, e.g. I2C_RDWR calls*/
+    uint32_t transaction_cnt;   /**< Transactions of the devices in them*/
+    uint32_t retry_cnt;         /**< Transactions sent again alone because a transfer failed*/
+    uint32_t error_cnt;         /**< Failed transactions*/
+    uint32_t open_cnt;          /**< Times the adapter was opened*/
+} i2c_bus_stats_t;
+
+struct _i2c_bus_t;
+typedef struct _i2c_bus_t i2c_bus_t;
+
+/*A Linux i2c-dev adapter*/
+typedef struct {
+    const char * path;
+    int fd;
+} i2c_linux_t;
+
+/*A simulated device on a mock adapter. The functions return 0 or -1 with `errno`.*/
+typedef struct {
+    uint16_t addr;
+    int (*write)(void * ctx, const uint8_t * buf, uint32_t len);
+    int (*read)(void * ctx, uint8_t * buf, uint32_t len);
+    void * ctx;
+} i2c_mock_dev_t;
+
+/*A simulated adapter*/
+typedef struct {
+    i2c_mock_dev_t devs[I2C_MOCK_MAX_DEVICES];
+    uint32_t dev_cnt;
+    uint32_t fail_cnt;          /**< Fail this many transfers with `EIO`*/
+    uint32_t transfer_cnt;      /**< Transfers done*/
+    uint32_t msg_cnt;           /**< Messages done*/
+} i2c_mock_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Use a Linux i2c-dev adapter
+ * @param adapter   initialized with the functions of the adapter
+ * @param linux_i2c the state of the adapter, it has to be valid while the bus is used
+ * @param path      path of the adapter, e.g. "/dev/i2c-1"
+ */
+void i2c_adapter_init_linux(i2c_adapter_t * adapter, i2c_linux_t * linux_i2c, const char * path);
+
+/**
+ * Use a simulated adapter. Add its devices to `mock->devs`.
+ * A message to an address without a device fails with `ENXIO`, like on most Linux adapters.
+ * @param adapter   initialized with the functions of the adapter
+ * @param mock      the state of the adapter, zeroed or with devices
+ */
+void i2c_adapter_init_mock(i2c_adapter_t * adapter, i2c_mock_t * mock);
+
+/**
+ * Create the bus of an adapter
+ * @param adapter   access to the adapter. Only the pointer is saved.
+ * @return          the new bus or NULL on error
+ */
+i2c_bus_t * i2c_bus_create(const i2c_adapter_t * adapter);
+
+/**
+ * Add a device to a bus. Its first transaction is started at once.
+ * @param bus       pointer to a bus
+ * @param dev       the device, it has to be valid while the bus runs
+ * @return          0 on success, -1 if the bus is full
+ */
+int i2c_bus_add(i2c_bus_t * bus, i2c_dev_t * dev);
+
+/**
+ * Start the thread of the bus
+ * @param bus       pointer to a bus
+ * @return          0 on success, -1 on error
+ */
+int i2c_bus_start(i2c_bus_t * bus);
+
+/**
+ * Stop the thread, close the adapter and free the bus
+ * @param bus       pointer to a bus
+ */
+void i2c_bus_del(i2c_bus_t * bus);
+
+/**
+ * Get the statistics of the bus
+ * @param bus       pointer to a bus
+ * @param stats     store the statistics here
+ */
+void i2c_bus_get_stats(i2c_bus_t * bus, i2c_bus_stats_t * stats);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*I2C_BUS_H*/
@@ -0,0 +1,113 @@
+/**
+ * @file sensor_table.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "sensor_table.h"
+#include <stdatomic.h>
+#include <pthread.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*A sequence lock: `seq` is odd while the value is written. The fields are atomic only to be
+ *read while they are written, their order is given by `seq`.*/
+typedef struct {
+    const char * name;
+    atomic_uint seq;
+    atomic_uint value_bits;
+    atomic_uint time;
+} channel_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static channel_t channels[SENSOR_TABLE_SIZE];
+static atomic_uint channel_cnt;
+static pthread_mutex_t add_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t sensor_table_add(const char * name)
+{
+    pthread_mutex_lock(&add_mutex);
+    uint32_t id = sensor_table_find(name);
+    if(id == SENSOR_CHANNEL_INVALID) {
+        uint32_t cnt = atomic_load_explicit(&channel_cnt, memory_order_relaxed);
+        if(cnt < SENSOR_TABLE_SIZE) {
+            id = cnt;
+            channels[id].name = name;
+            atomic_store_explicit(&channel_cnt, cnt + 1, memory_order_release);
+        }
+    }
+    pthread_mutex_unlock(&add_mutex);
+    return id;
+}
+
+uint32_t sensor_table_find(const char * name)
+{
+    uint32_t cnt = atomic_load_explicit(&channel_cnt, memory_order_acquire);
+    uint32_t id;
+    for(id = 0; id < cnt; id++) {
+        if(strcmp(channels[id].name, name) == 0) return id;
+    }
+    return SENSOR_CHANNEL_INVALID;
+}
+
+void sensor_table_set(uint32_t id, float value, uint32_t time)
+{
+    if(id >= SENSOR_TABLE_SIZE) return;
+    channel_t * ch = &channels[id];
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t seq = atomic_load_explicit(&ch->seq, memory_order_relaxed);
+    atomic_store_explicit(&ch->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&ch->value_bits, bits, memory_order_relaxed);
+    atomic_store_explicit(&ch->time, time, memory_order_relaxed);
+    atomic_store_explicit(&ch->seq, seq + 2, memory_order_release);
+}
+
+bool sensor_table_get(uint32_t id, sensor_value_t * value)
+{
+    if(id >= SENSOR_TABLE_SIZE) return false;
+    channel_t * ch = &channels[id];
+
+    uint32_t seq;
+    uint32_t bits;
+    uint32_t time;
+    while(1) {
+        seq = atomic_load_explicit(&ch->seq, memory_order_acquire);
+        if(seq & 1) continue;
+        bits = atomic_load_explicit(&ch->value_bits, memory_order_relaxed);
+        time = atomic_load_explicit(&ch->time, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if(atomic_load_explicit(&ch->seq, memory_order_relaxed) == seq) break;
+    }
+
+    if(seq == 0) return false;
+    memcpy(&value->value, &bits, sizeof(bits));
+    value->time = time;
+    value->seq = seq / 2;
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
@@ -0,0 +1,76 @@
+/**
+ * @file sensor_table.h
+ * The latest value of every sensor channel. Written by the bus threads and read by the UI
+ * without locks: a reader retries if the value was written meanwhile.
+ */
+
+#ifndef SENSOR_TABLE_H
+#define SENSOR_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef SENSOR_TABLE_SIZE
+#define SENSOR_TABLE_SIZE       32
+#endif
+
+#define SENSOR_CHANNEL_INVALID  UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    float value;
+    uint32_t time;          /**< `CLOCK_MONOTONIC` in ms when it was measured*/
+    uint32_t seq;           /**< Incremented by every write, 0 if there is no value yet*/
+} sensor_value_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Add a channel or find it if it was added already
+ * @param name      name of the channel, e.g. "sht30.temp". Only the pointer is saved.
+ * @return          id of the channel or `SENSOR_CHANNEL_INVALID` if the table is full
+ */
+uint32_t sensor_table_add(const char * name);
+
+/**
+ * Find a channel
+ * @param name      name of the channel
+ * @return          id of the channel or `SENSOR_CHANNEL_INVALID`
+ */
+uint32_t sensor_table_find(const char * name);
+
+/**
+ * Write the value of a channel. A channel has to be written by one thread only.
+ * @param id        id of the channel
+ * @param value     the new value
+ * @param time      time of the measurement
+ */
+void sensor_table_set(uint32_t id, float value, uint32_t time);
+
+/**
+ * Read the value of a channel. It doesn't block the writer.
+ * @param id        id of the channel
+ * @param value     store the value here
+ * @return          false if the channel has no value yet
+ */
+bool sensor_table_get(uint32_t id, sensor_value_t * value);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*SENSOR_TABLE_H*/
@@ -1,77 +1,447 @@
+/**
+ * @file sht30.c
+ *
+ */
 
-#include <fcntl.h>
-#include <linux/i2c-dev.h>
+/*********************
+ *      INCLUDES
+ *********************/
+#include "sht30.h"
+#include "sensor_table.h"
 #include <stdio.h>
-#include <stdlib.h>
-#include <sys/ioctl.h>
+#include <string.h>
+#include <errno.h>
 #include <time.h>
-#include <unistd.h>
-#include <gui_guider.h>
 #include <pthread.h>
 
-void* sensor_thread(void* arg) {
-    lv_ui *ui = (lv_ui*)arg;
-    
-    // Create I2C bus
-    int file;
-    char *bus = "/dev/i2c-1";
-    if ((file = open(bus, O_RDWR)) < 0) {
-        printf("Failed to open the bus. \n");
-        return NULL;
-    }
-
-    // Get I2C device, SHT30 I2C address is 0x44(68)
-    if (ioctl(file, I2C_SLAVE, 0x44) < 0) {
-        printf("Failed to acquire bus access and/or talk to slave.\n");
-        close(file);
-        return NULL;
-    }
-
-    while (1) {
-        // Send measurement command(0x2C)
-        // High repeatability measurement(0x06)
-        char config[2] = {0};
-        config[0] = 0x2C;
-        config[1] = 0x06;
-        if (write(file, config, 2) != 2) {
-            printf("Failed to write to the i2c bus.\n");
-            close(file);
-            return NULL;
-        }
-        sleep(1);
-
-        // Read 6 bytes of data
-        // Temp msb, Temp lsb, Temp CRC, Humidity msb, Humidity lsb, Humidity CRC
-        char data[6] = {0};
-        if (read(file, data, 6) != 6) {
-            printf("Failed to read from the i2c bus.\n");
-            close(file);
-            return NULL;
-        } else {
-            // Convert the data
-            int temp = (data[0] * 256 + data[1]);
-            float cTemp = -45 + (175 * temp / 65535.0);
-            float humidity = 100 * (data[3] * 256 + data[4]) / 65535.0;
-
-            // Update LVGL labels
-            char strTemp[32];
-            snprintf(strTemp, sizeof(strTemp), "%.2f °C", cTemp);
-
-            char strHumd[32];
-            snprintf(strHumd, sizeof(strHumd), "%.2f %%RH", humidity);
-
-            // Ensure LVGL calls are made from the LVGL thread
-            lv_label_set_text(ui->screen_label_49, strTemp);
-            lv_label_set_text(ui->screen_label_50, strHumd);
-
-            // Trigger LVGL task handler to refresh the display
-            lv_task_handler();
+/*********************
+ *      DEFINES
+ *********************/
+#define CMD_ART             0x2B32  /*Periodic mode with accelerated response time*/
+#define CMD_FETCH           0xE000  /*Read the last measurement of the periodic mode*/
+#define CMD_BREAK           0x3093  /*Stop the periodic mode*/
+#define CMD_SOFT_RESET      0x30A2
+
+#define ART_PERIOD_US       250000
+#define BREAK_TIME_US       1000
+#define RESET_TIME_US       2000
+#define MIN_BACKOFF         100
+#define MAX_BUS_ERRORS      3       /*Consecutive failed fetches before setting up the sensor again*/
+#define MAX_NO_DATA         10      /*Consecutive NACKed fetches before setting up the sensor again*/
+#define NO_DATA_RETRY_US    50000   /*Fetch again after a NACK*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    STATE_BREAK,        /*Stop the periodic mode, the sensor might be in it from an earlier run*/
+    STATE_RESET,
+    STATE_START,
+    STATE_FETCH,
+    STATE_READ,         /*Read the measurement if it's not read with the fetch command*/
+} state_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t prepare(i2c_dev_t * dev, i2c_msg_t * msgs);
+static uint32_t complete(i2c_dev_t * dev, int err);
+static void reset(i2c_dev_t * dev);
+static uint32_t fetch_failed(int err);
+static uint32_t setup_failed(int err);
+static uint32_t recover(void);
+static void count_error(int err);
+static void sample_add(const sht30_sample_t * sample);
+static uint64_t now_us(void);
+
+static int fake_write(void * ctx, const uint8_t * buf, uint32_t len);
+static int fake_read(void * ctx, uint8_t * buf, uint32_t len);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static i2c_dev_t sensor_dev;
+static uint16_t sensor_addr;
+static uint32_t sample_period;
+static state_t state;
+static uint8_t cmd_buf[2];
+static uint8_t data_buf[6];     /*Temperature MSB, LSB, CRC, humidity MSB, LSB, CRC*/
+static uint32_t backoff;
+static uint32_t bus_errors;
+static uint32_t no_data;
+static uint32_t temp_channel;
+static uint32_t humidity_channel;
+
+/*The ring and the counters are protected by `sample_mutex`*/
+static pthread_mutex_t sample_mutex = PTHREAD_MUTEX_INITIALIZER;
+static sht30_sample_t ring[SHT30_RING_SIZE];
+static uint32_t ring_head;      /*The next sample is written here*/
+static uint32_t ring_cnt;
+static sht30_counters_t counters;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int sht30_add(i2c_bus_t * bus, uint16_t addr, uint32_t period_ms)
+{
+    if(sensor_dev.prepare_cb) return -1;
+
+    temp_channel = sensor_table_add(SHT30_TEMP_CHANNEL);
+    humidity_channel = sensor_table_add(SHT30_HUMIDITY_CHANNEL);
+
+    sensor_addr = addr;
+    sample_period = period_ms < ART_PERIOD_US / 1000 ? ART_PERIOD_US / 1000 : period_ms;
+    state = STATE_BREAK;
+
+    sensor_dev.name = "sht30";
+    sensor_dev.prepare_cb = prepare;
+    sensor_dev.complete_cb = complete;
+    sensor_dev.reset_cb = reset;
+    if(i2c_bus_add(bus, &sensor_dev) != 0) {
+        sensor_dev.prepare_cb = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+int sht30_fake_attach(i2c_mock_t * mock, sht30_fake_t * fake, uint16_t addr)
+{
+    if(mock->dev_cnt >= I2C_MOCK_MAX_DEVICES) return -1;
+
+    i2c_mock_dev_t * dev = &mock->devs[mock->dev_cnt++];
+    dev->addr = addr;
+    dev->write = fake_write;
+    dev->read = fake_read;
+    dev->ctx = fake;
+    return 0;
+}
+
+bool sht30_get_last(sht30_sample_t * sample)
+{
+    pthread_mutex_lock(&sample_mutex);
+    bool res = ring_cnt > 0;
+    if(res) *sample = ring[(ring_head + SHT30_RING_SIZE - 1) % SHT30_RING_SIZE];
+    pthread_mutex_unlock(&sample_mutex);
+    return res;
+}
+
+uint32_t sht30_get_samples(sht30_sample_t * samples, uint32_t max, uint32_t since)
+{
+    pthread_mutex_lock(&sample_mutex);
+
+    /*Find the oldest sample to copy, going back from the newest*/
+    uint32_t n = 0;
+    while(n < ring_cnt && n < max) {
+        const sht30_sample_t * s = &ring[(ring_head + SHT30_RING_SIZE - 1 - n) % SHT30_RING_SIZE];
+        if((int32_t)(s->time - since) <= 0) break;
+        n++;
+    }
+
+    uint32_t i;
+    for(i = 0; i < n; i++) {
+        samples[i] = ring[(ring_head + SHT30_RING_SIZE - n + i) % SHT30_RING_SIZE];
+    }
+
+    pthread_mutex_unlock(&sample_mutex);
+    return n;
+}
+
+bool sht30_get_stats(uint32_t window_ms, sht30_stats_t * stats)
+{
+    uint32_t now = now_us() / 1000;
+
+    memset(stats, 0, sizeof(sht30_stats_t));
+    float temp_sum = 0;
+    float humidity_sum = 0;
+
+    pthread_mutex_lock(&sample_mutex);
+    uint32_t i;
+    for(i = 0; i < ring_cnt; i++) {
+        const sht30_sample_t * s = &ring[(ring_head + SHT30_RING_SIZE - 1 - i) % SHT30_RING_SIZE];
+        if(now - s->time > window_ms) break;
+
+        if(stats->cnt == 0 || s->temp < stats->temp_min) stats->temp_min = s->temp;
+        if(stats->cnt == 0 || s->temp > stats->temp_max) stats->temp_max = s->temp;
+        if(stats->cnt == 0 || s->humidity < stats->humidity_min) stats->humidity_min = s->humidity;
+        if(stats->cnt == 0 || s->humidity > stats->humidity_max) stats->humidity_max = s->humidity;
+        temp_sum += s->temp;
+        humidity_sum += s->humidity;
+        stats->cnt++;
+    }
+    pthread_mutex_unlock(&sample_mutex);
+
+    if(stats->cnt == 0) return false;
+    stats->temp_avg = temp_sum / stats->cnt;
+    stats->humidity_avg = humidity_sum / stats->cnt;
+    return true;
+}
+
+void sht30_get_counters(sht30_counters_t * counters_out)
+{
+    pthread_mutex_lock(&sample_mutex);
+    *counters_out = counters;
+    pthread_mutex_unlock(&sample_mutex);
+}
+
+uint8_t sht30_crc8(const uint8_t * data, uint32_t len)
+{
+    uint8_t crc = 0xFF;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        crc ^= data[i];
+        int b;
+        for(b = 0; b < 8; b++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
         }
-        // Sleep for 5 minutes (300 seconds)
-        sleep(300);
+    }
+    return crc;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The next transaction of the state*/
+static uint32_t prepare(i2c_dev_t * dev, i2c_msg_t * msgs)
+{
+    (void)dev;
+
+    uint16_t cmd;
+    switch(state) {
+        case STATE_BREAK:
+            cmd = CMD_BREAK;
+            break;
+        case STATE_RESET:
+            cmd = CMD_SOFT_RESET;
+            break;
+        case STATE_START:
+            cmd = CMD_ART;
+            break;
+        case STATE_FETCH:
+            cmd = CMD_FETCH;
+            break;
+        case STATE_READ:
+        default:
+            msgs[0].addr = sensor_addr;
+            msgs[0].flags = I2C_MSG_READ;
+            msgs[0].len = sizeof(data_buf);
+            msgs[0].buf = data_buf;
+            return 1;
     }
 
-    // Close the I2C bus
-    close(file);
-    return NULL;
-}
\ No newline at end of file
+    cmd_buf[0] = cmd >> 8;
+    cmd_buf[1] = cmd & 0xFF;
+    msgs[0].addr = sensor_addr;
+    msgs[0].flags = 0;
+    msgs[0].len = sizeof(cmd_buf);
+    msgs[0].buf = cmd_buf;
+
+#if SHT30_FETCH_RESTART
+    if(state == STATE_FETCH) {
+        msgs[1].addr = sensor_addr;
+        msgs[1].flags = I2C_MSG_READ;
+        msgs[1].len = sizeof(data_buf);
+        msgs[1].buf = data_buf;
+        return 2;
+    }
+#endif
+    return 1;
+}
+
+/*Go to the next state and return the time until its transaction*/
+static uint32_t complete(i2c_dev_t * dev, int err)
+{
+    (void)dev;
+
+    switch(state) {
+        case STATE_BREAK:
+            /*NACKed if the sensor is not in periodic mode*/
+            if(err && !I2C_IS_NACK(err)) return setup_failed(err);
+            state = STATE_RESET;
+            return BREAK_TIME_US;
+        case STATE_RESET:
+            if(err) return setup_failed(err);
+            state = STATE_START;
+            return RESET_TIME_US;
+        case STATE_START:
+            if(err) return setup_failed(err);
+            pthread_mutex_lock(&sample_mutex);
+            counters.setup_cnt++;
+            pthread_mutex_unlock(&sample_mutex);
+            bus_errors = 0;
+            no_data = 0;
+            state = STATE_FETCH;
+            return ART_PERIOD_US;   /*The first measurement is ready after one period of the sensor*/
+        case STATE_FETCH:
+            if(err) return fetch_failed(err);
+#if !SHT30_FETCH_RESTART
+            state = STATE_READ;
+            return 0;
+#endif
+            break;
+        case STATE_READ:
+            state = STATE_FETCH;
+            if(err) return fetch_failed(err);
+            break;
+    }
+
+    /*A measurement was read*/
+    bus_errors = 0;
+    no_data = 0;
+    if(sht30_crc8(&data_buf[0], 2) != data_buf[2] || sht30_crc8(&data_buf[3], 2) != data_buf[5]) {
+        pthread_mutex_lock(&sample_mutex);
+        counters.crc_err_cnt++;
+        pthread_mutex_unlock(&sample_mutex);
+        return sample_period * 1000;
+    }
+
+    /*The sensor works, the next recovery starts with the shortest backoff again*/
+    backoff = 0;
+
+    sht30_sample_t sample;
+    sample.time = now_us() / 1000;
+    sample.temp = -45 + 175 * ((data_buf[0] << 8) | data_buf[1]) / 65535.0f;
+    sample.humidity = 100 * ((data_buf[3] << 8) | data_buf[4]) / 65535.0f;
+    sensor_table_set(temp_channel, sample.temp, sample.time);
+    sensor_table_set(humidity_channel, sample.humidity, sample.time);
+
+    pthread_mutex_lock(&sample_mutex);
+    sample_add(&sample);
+    pthread_mutex_unlock(&sample_mutex);
+    return sample_period * 1000;
+}
+
+/*The adapter was opened again. Keep the backoff, the sensor might be the reason.*/
+static void reset(i2c_dev_t * dev)
+{
+    (void)dev;
+    state = STATE_BREAK;
+}
+
+static uint32_t fetch_failed(int err)
+{
+    count_error(err);
+
+    if(I2C_IS_NACK(err)) {
+        if(++no_data < MAX_NO_DATA) return NO_DATA_RETRY_US;
+    }
+    else if(++bus_errors < MAX_BUS_ERRORS) {
+        return sample_period * 1000;
+    }
+    return recover();
+}
+
+/*A NACK during the setup is an error too*/
+static uint32_t setup_failed(int err)
+{
+    count_error(I2C_IS_NACK(err) ? EIO : err);
+    return recover();
+}
+
+/*Set up the sensor again, each time later*/
+static uint32_t recover(void)
+{
+    backoff = backoff ? backoff * 2 : MIN_BACKOFF;
+    if(backoff > SHT30_MAX_BACKOFF) backoff = SHT30_MAX_BACKOFF;
+    state = STATE_BREAK;
+    return backoff * 1000;
+}
+
+static void count_error(int err)
+{
+    pthread_mutex_lock(&sample_mutex);
+    if(I2C_IS_NACK(err)) counters.no_data_cnt++;
+    else counters.bus_err_cnt++;
+    pthread_mutex_unlock(&sample_mutex);
+}
+
+/*Called with `sample_mutex` locked*/
+static void sample_add(const sht30_sample_t * sample)
+{
+    ring[ring_head] = *sample;
+    ring_head = (ring_head + 1) % SHT30_RING_SIZE;
+    if(ring_cnt < SHT30_RING_SIZE) ring_cnt++;
+    counters.sample_cnt++;
+}
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int fake_write(void * ctx, const uint8_t * buf, uint32_t len)
+{
+    sht30_fake_t * fake = ctx;
+    if(fake->fail_cnt) {
+        fake->fail_cnt--;
+        errno = EIO;
+        return -1;
+    }
+    if(len != 2) {
+        errno = EREMOTEIO;
+        return -1;
+    }
+
+    fake->cmd = (buf[0] << 8) | buf[1];
+    switch(fake->cmd) {
+        case CMD_ART:
+            fake->start_us = now_us();
+            fake->read_cnt = 0;
+            break;
+        case CMD_BREAK:
+        case CMD_SOFT_RESET:
+            fake->start_us = 0;
+            break;
+        case CMD_FETCH:
+            break;
+        default:
+            errno = EREMOTEIO;
+            return -1;
+    }
+    return 0;
+}
+
+static int fake_read(void * ctx, uint8_t * buf, uint32_t len)
+{
+    sht30_fake_t * fake = ctx;
+    if(fake->fail_cnt) {
+        fake->fail_cnt--;
+        errno = EIO;
+        return -1;
+    }
+
+    if(fake->nack_cnt) {
+        fake->nack_cnt--;
+        errno = EREMOTEIO;
+        return -1;
+    }
+
+    /*NACK if there is no measurement which wasn't read yet*/
+    uint32_t measured = fake->start_us ? (now_us() - fake->start_us) / ART_PERIOD_US : 0;
+    if(fake->cmd != CMD_FETCH || len != 6 || measured <= fake->read_cnt) {
+        errno = EREMOTEIO;
+        return -1;
+    }
+    fake->read_cnt = measured;
+    fake->cmd = 0;
+
+    float t = fake->temp < -45 ? -45 : fake->temp > 130 ? 130 : fake->temp;
+    float h = fake->humidity < 0 ? 0 : fake->humidity > 100 ? 100 : fake->humidity;
+    uint16_t raw_t = (t + 45) * 65535 / 175 + 0.5f;
+    uint16_t raw_h = h * 65535 / 100 + 0.5f;
+    buf[0] = raw_t >> 8;
+    buf[1] = raw_t & 0xFF;
+    buf[2] = sht30_crc8(&buf[0], 2);
+    buf[3] = raw_h >> 8;
+    buf[4] = raw_h & 0xFF;
+    buf[5] = sht30_crc8(&buf[3], 2);
+
+    if(fake->corrupt_cnt) {
+        fake->corrupt_cnt--;
+        buf[1] ^= 0x01;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file sht30.h
+ * Driver of an SHT30 temperature and humidity sensor on an I2C bus thread. The sensor runs
+ * in its periodic mode with accelerated response time (4 measurements/s). The samples are checked
+ * with their CRC-8, kept with their time in a ring and written to the sensor table.
+ */
+
+#ifndef SHT30_H
+#define SHT30_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_bus.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SHT30_ADDR              0x44
+
+/*Time between two fetches of the last measurement*/
+#ifndef SHT30_FETCH_PERIOD
+#define SHT30_FETCH_PERIOD      1000
+#endif
+
+/*Number of the last samples to keep*/
+#ifndef SHT30_RING_SIZE
+#define SHT30_RING_SIZE         512
+#endif
+
+/*After a bus error the sensor is set up again after 100 ms, then 200 ms, ... up to this.
+ *It starts from 100 ms again after a valid measurement.*/
+#ifndef SHT30_MAX_BACKOFF
+#define SHT30_MAX_BACKOFF       30000
+#endif
+
+/*1: read the measurement after a repeated start in the transaction of the fetch command,
+ *0: read it in a separate transaction if the adapter or the sensor needs a stop between them*/
+#ifndef SHT30_FETCH_RESTART
+#define SHT30_FETCH_RESTART     1
+#endif
+
+/*The channels of the sensor table*/
+#define SHT30_TEMP_CHANNEL      "sht30.temp"
+#define SHT30_HUMIDITY_CHANNEL  "sht30.humidity"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A simulated sensor on a mock adapter. It NACKs a read if there is no new measurement.*/
+typedef struct {
+    float temp;                 /**< The next measurement*/
+    float humidity;
+    uint32_t fail_cnt;          /**< Fail this many reads and writes with `EIO`*/
+    uint32_t corrupt_cnt;       /**< Flip a bit in this many read measurements*/
+    uint32_t nack_cnt;          /**< NACK this many reads as if there was no new measurement*/
+    uint64_t start_us;          /**< Start of the periodic mode, 0 if it's stopped*/
+    uint32_t read_cnt;          /**< Measurements read since the start*/
+    uint16_t cmd;               /**< The last command*/
+} sht30_fake_t;
+
+typedef struct {
+    uint32_t time;              /**< `CLOCK_MONOTONIC` in ms*/
+    float temp;                 /**< °C*/
+    float humidity;             /**< %RH*/
+} sht30_sample_t;
+
+typedef struct {
+    uint32_t cnt;               /**< Samples in the window*/
+    float temp_min;
+    float temp_max;
+    float temp_avg;
+    float humidity_min;
+    float humidity_max;
+    float humidity_avg;
+} sht30_stats_t;
+
+typedef struct {
+    uint32_t sample_cnt;        /**< Samples saved*/
+    uint32_t crc_err_cnt;       /**< Measurements dropped because of a wrong CRC*/
+    uint32_t no_data_cnt;       /**< Fetches NACKed because there was no new measurement*/
+    uint32_t bus_err_cnt;       /**< Failed transfers*/
+    uint32_t setup_cnt;         /**< Times the sensor was set up, 1 if there were no errors*/
+} sht30_counters_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Add the sensor to a bus. There can be one sensor.
+ * @param bus       pointer to a bus
+ * @param addr      address of the sensor, e.g. `SHT30_ADDR`
+ * @param period_ms time between two samples, at least 250
+ * @return          0 on success, -1 on error
+ */
+int sht30_add(i2c_bus_t * bus, uint16_t addr, uint32_t period_ms);
+
+/**
+ * Add a simulated sensor to a mock adapter. It measures 4 times/s in periodic mode like the real one.
+ * @param mock      pointer to a mock adapter
+ * @param fake      the state of the sensor. Its fields can be changed while the bus runs.
+ * @param addr      address of the sensor
+ * @return          0 on success, -1 if the adapter is full
+ */
+int sht30_fake_attach(i2c_mock_t * mock, sht30_fake_t * fake, uint16_t addr);
+
+/**
+ * Get the last sample
+ * @param sample    store the sample here
+ * @return          false if there is no sample yet
+ */
+bool sht30_get_last(sht30_sample_t * sample);
+
+/**
+ * Copy the last samples
+ * @param samples   store the samples here, the oldest first
+ * @param max       size of `samples`
+ * @param since     copy only the samples after this time
+ * @return          the number of samples copied
+ */
+uint32_t sht30_get_samples(sht30_sample_t * samples, uint32_t max, uint32_t since);
+
+/**
+ * Get the minimum, maximum and average of the last samples
+ * @param window_ms use the samples of this last period
+ * @param stats     store the result here
+ * @return          false if there is no sample in the window
+ */
+bool sht30_get_stats(uint32_t window_ms, sht30_stats_t * stats);
+
+/**
+ * Get the counters of the samples and the errors
+ * @param counters  store the counters here
+ */
+void sht30_get_counters(sht30_counters_t * counters);
+
+/**
+ * Calculate the CRC-8 of the sensor (polynomial 0x31, initial value 0xFF)
+ * @param data      the bytes to check
+ * @param len       number of bytes
+ * @return          the CRC
+ */
+uint8_t sht30_crc8(const uint8_t * data, uint32_t len);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*SHT30_H*/
@@ -23,9 +23,9 @@ static void screen_label_14_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_sw);
+		ui_hide_part(guider_ui.screen_cont_timer);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -39,9 +39,9 @@ static void screen_imgbtn_5_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_timer);
+		ui_hide_part(guider_ui.screen_cont_sw);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -55,9 +55,9 @@ static void screen_label_15_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_timer);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_sw);
+		ui_hide_part(guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -71,9 +71,9 @@ static void screen_imgbtn_6_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_timer);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_sw);
+		ui_hide_part(guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -87,9 +87,9 @@ static void screen_label_16_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_timer);
+		ui_hide_part(guider_ui.screen_cont_sw);
+		ui_hide_part(guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -103,9 +103,9 @@ static void screen_imgbtn_7_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_cont_timer, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_sw, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_led, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_timer);
+		ui_hide_part(guider_ui.screen_cont_sw);
+		ui_hide_part(guider_ui.screen_cont_led);
 		break;
 	}
 	default:
@@ -119,7 +119,7 @@ static void screen_imgbtn_14_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_win_1, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_win_1);
 		ui_move_animation(guider_ui.screen_win_1, 1000, 0, 490, 0, &lv_anim_path_linear, 0, 0, 0, 0, NULL, NULL, NULL);
 		break;
 	}
@@ -134,7 +134,7 @@ static void screen_imgbtn_15_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_win_1, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_win_1);
 		ui_move_animation(guider_ui.screen_win_1, 1000, 0, 490, 0, &lv_anim_path_linear, 0, 0, 0, 0, NULL, NULL, NULL);
 		break;
 	}
@@ -149,7 +149,7 @@ static void screen_imgbtn_16_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_win_1, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_win_1);
 		ui_move_animation(guider_ui.screen_win_1, 1000, 0, 490, 0, &lv_anim_path_linear, 0, 0, 0, 0, NULL, NULL, NULL);
 		break;
 	}
@@ -164,7 +164,7 @@ static void screen_win_1_item0_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_win_1, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_win_1);
 		ui_move_animation(guider_ui.screen_win_1, 1000, 0, 810, 0, &lv_anim_path_linear, 0, 0, 0, 0, NULL, NULL, NULL);
 		break;
 	}
@@ -179,10 +179,10 @@ static void screen_imgbtn_1_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_cont_wifi, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_ble, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_lang, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_noti, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_wifi);
+		ui_hide_part(guider_ui.screen_cont_ble);
+		ui_hide_part(guider_ui.screen_cont_lang);
+		ui_hide_part(guider_ui.screen_cont_noti);
 		break;
 	}
 	default:
@@ -196,10 +196,10 @@ static void screen_imgbtn_2_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_wifi, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_ble, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_lang, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_noti, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_wifi);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_ble);
+		ui_hide_part(guider_ui.screen_cont_lang);
+		ui_hide_part(guider_ui.screen_cont_noti);
 		break;
 	}
 	default:
@@ -213,10 +213,10 @@ static void screen_imgbtn_3_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_add_flag(guider_ui.screen_cont_noti, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_clear_flag(guider_ui.screen_cont_lang, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_ble, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_wifi, LV_OBJ_FLAG_HIDDEN);
+		ui_hide_part(guider_ui.screen_cont_noti);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_lang);
+		ui_hide_part(guider_ui.screen_cont_ble);
+		ui_hide_part(guider_ui.screen_cont_wifi);
 		break;
 	}
 	default:
@@ -230,10 +230,10 @@ static void screen_imgbtn_4_event_handler (lv_event_t *e)
 	switch (code) {
 	case LV_EVENT_CLICKED:
 	{
-		lv_obj_clear_flag(guider_ui.screen_cont_noti, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_lang, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_ble, LV_OBJ_FLAG_HIDDEN);
-		lv_obj_add_flag(guider_ui.screen_cont_wifi, LV_OBJ_FLAG_HIDDEN);
+		ui_show_part(&guider_ui, &guider_ui.screen_cont_noti);
+		ui_hide_part(guider_ui.screen_cont_lang);
+		ui_hide_part(guider_ui.screen_cont_ble);
+		ui_hide_part(guider_ui.screen_cont_wifi);
 		break;
 	}
 	default:
@@ -298,7 +298,7 @@ static void screen_sw_2_event_handler (lv_event_t *e)
 		break;
 	}
 }
-void events_init_screen(lv_ui *ui)
+void events_init_screen_cont_hub_menu(lv_ui *ui)
 {
 	lv_obj_add_event_cb(ui->screen_label_14, screen_label_14_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_5, screen_imgbtn_5_event_handler, LV_EVENT_ALL, ui);
@@ -306,15 +306,35 @@ void events_init_screen(lv_ui *ui)
 	lv_obj_add_event_cb(ui->screen_imgbtn_6, screen_imgbtn_6_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_label_16, screen_label_16_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_7, screen_imgbtn_7_event_handler, LV_EVENT_ALL, ui);
+}
+
+void events_init_screen_cont_timer(lv_ui *ui)
+{
 	lv_obj_add_event_cb(ui->screen_imgbtn_14, screen_imgbtn_14_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_15, screen_imgbtn_15_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_16, screen_imgbtn_16_event_handler, LV_EVENT_ALL, ui);
+}
+
+void events_init_screen_win_1(lv_ui *ui)
+{
 	lv_obj_add_event_cb(ui->screen_win_1_item0, screen_win_1_item0_event_handler, LV_EVENT_ALL, ui);
+}
+
+void events_init_screen_cont_setting_menu(lv_ui *ui)
+{
 	lv_obj_add_event_cb(ui->screen_imgbtn_1, screen_imgbtn_1_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_2, screen_imgbtn_2_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_3, screen_imgbtn_3_event_handler, LV_EVENT_ALL, ui);
 	lv_obj_add_event_cb(ui->screen_imgbtn_4, screen_imgbtn_4_event_handler, LV_EVENT_ALL, ui);
+}
+
+void events_init_screen_cont_wifi(lv_ui *ui)
+{
 	lv_obj_add_event_cb(ui->screen_sw_1, screen_sw_1_event_handler, LV_EVENT_ALL, ui);
+}
+
+void events_init_screen_cont_ble(lv_ui *ui)
+{
 	lv_obj_add_event_cb(ui->screen_sw_2, screen_sw_2_event_handler, LV_EVENT_ALL, ui);
 }
 
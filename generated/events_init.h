@@ -18,7 +18,12 @@ extern "C" {
 
 void events_init(lv_ui *ui);
 
-void events_init_screen(lv_ui *ui);
+void events_init_screen_cont_hub_menu(lv_ui *ui);
+void events_init_screen_cont_timer(lv_ui *ui);
+void events_init_screen_win_1(lv_ui *ui);
+void events_init_screen_cont_setting_menu(lv_ui *ui);
+void events_init_screen_cont_wifi(lv_ui *ui);
+void events_init_screen_cont_ble(lv_ui *ui);
 
 #ifdef __cplusplus
 }
@@ -22,6 +22,22 @@ void ui_init_style(lv_style_t * style)
 		lv_style_init(style);
 }
 
+void (*ui_part_built_cb)(lv_obj_t * tile);
+
+void ui_show_part(lv_ui *ui, lv_obj_t ** part)
+{
+	//Build the part first if the screen was set up without it.
+	lv_obj_clear_flag(setup_scr_screen_part(ui, part), LV_OBJ_FLAG_HIDDEN);
+}
+
+void ui_hide_part(lv_obj_t * part)
+{
+	//A part which is not built yet starts hidden anyway.
+	if (part != NULL) {
+		lv_obj_add_flag(part, LV_OBJ_FLAG_HIDDEN);
+	}
+}
+
 void ui_load_scr_animation(lv_ui *ui, lv_obj_t ** new_scr, bool new_scr_del, bool * old_scr_del, ui_setup_scr_t setup_scr,
                            lv_scr_load_anim_t anim_type, uint32_t time, uint32_t delay, bool is_clean, bool auto_del)
 {
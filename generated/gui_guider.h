@@ -15,6 +15,18 @@ extern "C" {
 
 #include "lvgl.h"
 
+/*Build the off-screen tiles and the hidden panels of the screens only when they are needed
+ *instead of in setup_scr_xxx(). 0: build everything at start up.*/
+#ifndef GUI_LAZY_BUILD
+#define GUI_LAZY_BUILD 1
+#endif
+
+/*Build the off-screen tiles ahead of time once the user was inactive for this long [ms].
+ *0: build a tile only when a swipe towards it starts. Hidden panels are always built on first show.*/
+#ifndef GUI_LAZY_PREBUILD_TIME
+#define GUI_LAZY_PREBUILD_TIME 300
+#endif
+
 typedef struct
 {
   
@@ -187,6 +199,13 @@ typedef void (*ui_setup_scr_t)(lv_ui * ui);
 
 void ui_init_style(lv_style_t * style);
 
+void ui_show_part(lv_ui *ui, lv_obj_t ** part);
+
+void ui_hide_part(lv_obj_t * part);
+
+/*Called with the tile of every part of a screen which is built after the screen was set up*/
+extern void (*ui_part_built_cb)(lv_obj_t * tile);
+
 void ui_load_scr_animation(lv_ui *ui, lv_obj_t ** new_scr, bool new_scr_del, bool * old_scr_del, ui_setup_scr_t setup_scr,
                            lv_scr_load_anim_t anim_type, uint32_t time, uint32_t delay, bool is_clean, bool auto_del);
 
@@ -215,6 +234,7 @@ extern lv_ui guider_ui;
 
 
 void setup_scr_screen(lv_ui *ui);
+lv_obj_t * setup_scr_screen_part(lv_ui *ui, lv_obj_t ** part);
 LV_IMG_DECLARE(_background_alpha_800x480);
 LV_IMG_DECLARE(_itemperature_alpha_40x30);
 LV_IMG_DECLARE(_ihumidity_alpha_31x28);
@@ -69,6 +69,9 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD    30      /*[ms]*/
 
+/*Predict the scrolling from the time stamped input samples and animate with the frames*/
+#define LV_INDEV_SCROLL_PREDICT     1
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 uint32_t custom_tick_get(void);
@@ -97,8 +100,13 @@ uint32_t custom_tick_get(void);
 
 /*Allow buffering some shadow calculation.
  *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
- *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
-#define LV_SHADOW_CACHE_SIZE    0
+ *LV_SHADOW_CACHE_MEM_SIZE is the byte budget of all the buffered shadows, each costs its shadow size^2*/
+#define LV_SHADOW_CACHE_SIZE    64
+#define LV_SHADOW_CACHE_MEM_SIZE    (32 * 1024)
+
+/*Byte budget of the anti-aliased coverage of rounded corners, about 12 bytes per pixel of radius.
+ *Rounded rectangles with a single color and no other masks are drawn from them. 0: calculate them on every draw*/
+#define LV_CORNER_CACHE_MEM_SIZE    (4 * 1024)
 #endif /*LV_DRAW_COMPLEX*/
 
 /*Default image cache size. Image caching keeps the images opened.
@@ -108,8 +116,21 @@ uint32_t custom_tick_get(void);
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE       10
 
-/*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
-#define LV_DISP_ROT_MAX_BUF         (10*1024)
+/*Default gradient buffer size.
+ *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
+ *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
+ *If the cache is too small the map will be allocated only while it's required for the drawing.
+ *0 mean no caching.*/
+#define LV_GRAD_CACHE_DEF_SIZE      (16 * 1024)
+
+/*Memory budget [bytes] of the retained renderings of the objects with `lv_obj_set_layer_cache()`.
+ *The pages of the tileviews are cached if it's not 0. The four 800x480 pages of the screen fit in it.
+ *0: to disable layer caching*/
+#define LV_LAYER_CACHE_SIZE         (4 * 800 * 480 * LV_COLOR_DEPTH / 8)
+
+/*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.
+ *A whole screen to rotate the draw buffer at once, also in full refresh mode.*/
+#define LV_DISP_ROT_MAX_BUF         (800 * 480 * LV_COLOR_DEPTH / 8)
 /*-------------
  * GPU
  *-----------*/
@@ -439,6 +460,8 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 
 #define LV_USE_CHART        1
 
+#define LV_USE_STREAMCHART  1
+
 #define LV_USE_COLORWHEEL   1
 
 #define LV_USE_IMGBTN       1
@@ -449,6 +472,8 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 
 #define LV_USE_LIST         1
 
+#define LV_USE_VLIST        1
+
 #define LV_USE_METER        1
 
 #define LV_USE_MSGBOX       1
@@ -502,6 +527,26 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*A layout similar to Grid in CSS.*/
 #define LV_USE_GRID     1
 
+/*---------------------
+ * 3rd party libraries
+ *--------------------*/
+
+/*Memory mapped pack of images and fonts, see custom/assets.h*/
+#define LV_USE_ASSETPACK    1
+
+/*-----------
+ * Others
+ *----------*/
+
+/*Startup profiler, see lv_profiler_report()*/
+#define LV_USE_PROFILER     1
+
+/*Touch-to-photon latency, see lv_latency_report()*/
+#define LV_USE_LATENCY      1
+
+/*Bind widgets to the device states, see lv_binding_create()*/
+#define LV_USE_BINDING      1
+
 /*==================
 * EXAMPLES
 *==================*/
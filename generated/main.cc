@@ -1,24 +1,125 @@
-#include "lvgl/lvgl.h"
-#include "lv_drivers/display/fbdev.h"
-#include "lv_drivers/indev/evdev.h"
+#include "lvgl.h"
+#include "display/fbdev.h"
+#include "indev/evdev.h"
 #include <unistd.h>
 #include <pthread.h>
 #include <time.h>
 #include <sys/time.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 #include <gui_guider.h>
 #include <pthread.h>
+#include "custom.h"
 
-#include "../custom/sensor/sht30.c"
 #include "../custom/demo/led_change.c"
+#include "sensor/sht30.h"
+#include "sensor/sensor_table.h"
+#include "hub/hub_ingest.h"
 
 
 #define DISP_BUF_SIZE (1024 * 1024)
 
+/*Split the startup into phases, the report is printed to stderr on exit*/
+#if LV_USE_PROFILER
+#define PROFILER_PHASE(name) lv_profiler_phase(name)
+#else
+#define PROFILER_PHASE(name)
+#endif
+
+/*Widgets follow the device store through bindings*/
+#if LV_USE_BINDING
+#define GUI_BINDING 1
+#else
+#define GUI_BINDING 0
+#endif
+
 lv_style_t  style;
 lv_ui guider_ui;
 
+static volatile sig_atomic_t quit;
+
+static void quit_handler(int sig)
+{
+    (void)sig;
+    quit = 1;
+}
+
+static void hub_changed(const hub_change_t *changes, uint32_t cnt, void *user_data)
+{
+    (void)user_data;
+    for (uint32_t i = 0; i < cnt; i++) {
+        LV_LOG_INFO("device %llx/%u: %s", (unsigned long long)changes[i].mac, (unsigned)changes[i].ep,
+                    changes[i].status ? "on" : "off");
+#if GUI_BINDING
+        lv_binding_notify(changes[i].id);
+#else
+        /*Called in the UI thread, so the switch can be set directly*/
+        if (changes[i].mac == LED_DEMO_MAC && changes[i].ep == LED_DEMO_EP && guider_ui.screen_sw_3) {
+            if (changes[i].status)
+                lv_obj_add_state(guider_ui.screen_sw_3, LV_STATE_CHECKED);
+            else
+                lv_obj_clear_state(guider_ui.screen_sw_3, LV_STATE_CHECKED);
+        }
+#endif
+    }
+}
+
+#if GUI_BINDING
+static int32_t device_status_get(uint32_t id, void *user_data)
+{
+    (void)user_data;
+    return device_store_get_status(id);
+}
+
+/*Called after setup_ui() and for every part built later. A part is built again after its screen was deleted.*/
+static void bind_devices(lv_obj_t *tile)
+{
+    (void)tile;
+    static lv_obj_t *bound_sw_3;
+    if (guider_ui.screen_sw_3 && guider_ui.screen_sw_3 != bound_sw_3) {
+        uint32_t id = device_store_add(LED_DEMO_MAC, LED_DEMO_EP);
+        if (id != DEVICE_ID_INVALID)
+            lv_binding_create(guider_ui.screen_sw_3, LV_BINDING_PROP_CHECKED, id, device_status_get, NULL);
+        bound_sw_3 = guider_ui.screen_sw_3;
+    }
+}
+#endif
+
+/*Show a channel of the sensor table if it changed. Labels which show it already aren't set again.*/
+static void sensor_label_update(lv_obj_t *label, uint32_t channel, uint32_t *shown_seq, const char *fmt)
+{
+    sensor_value_t value;
+    if (!label || !sensor_table_get(channel, &value) || value.seq == *shown_seq)
+        return;
+    *shown_seq = value.seq;
+
+    char str[32];
+    snprintf(str, sizeof(str), fmt, value.value);
+    if (strcmp(lv_label_get_text(label), str) != 0)
+        lv_label_set_text(label, str);
+}
+
+static void sensor_show(lv_timer_t *timer)
+{
+    lv_ui *ui = (lv_ui *)timer->user_data;
+    static uint32_t temp_channel = sensor_table_find(SHT30_TEMP_CHANNEL);
+    static uint32_t humidity_channel = sensor_table_find(SHT30_HUMIDITY_CHANNEL);
+    static uint32_t temp_seq;
+    static uint32_t humidity_seq;
+
+    sensor_label_update(ui->screen_label_49, temp_channel, &temp_seq, "%.2f °C");
+    sensor_label_update(ui->screen_label_50, humidity_channel, &humidity_seq, "%.2f %%RH");
+}
+
+#if LV_USE_PROFILER || LV_USE_LATENCY
+static void report_print(const char *buf)
+{
+    fputs(buf, stderr);
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     int hor_res = 800;
@@ -36,15 +137,23 @@ int main(int argc, char *argv[])
                argv[0], argv[0]);
     }
 
+    signal(SIGINT, quit_handler);
+    signal(SIGTERM, quit_handler);
+
     /*LittlevGL init*/
+    PROFILER_PHASE("lv_init");
     lv_init();
 
     /*Linux frame buffer device init*/
+    PROFILER_PHASE("fbdev_init");
     fbdev_init();
 
     // Touch pointer device init
+    PROFILER_PHASE("evdev_init");
 	evdev_init();
 
+    PROFILER_PHASE("drivers");
+
     /*A small buffer for LittlevGL to draw the screen's content*/
     static lv_color_t buf[DISP_BUF_SIZE];
 
@@ -57,6 +166,7 @@ int main(int argc, char *argv[])
     lv_disp_drv_init(&disp_drv);
     disp_drv.draw_buf = &disp_buf;
     disp_drv.flush_cb = fbdev_flush;
+    disp_drv.copy_area_cb = fbdev_copy_area;   /*Scroll by moving the pixels on the frame buffer*/
     disp_drv.hor_res = hor_res;
     disp_drv.ver_res = ver_res;
     lv_disp_drv_register(&disp_drv);
@@ -75,16 +185,53 @@ int main(int argc, char *argv[])
 
     //app
 
+    PROFILER_PHASE("setup_ui");
     ui_init_style(&style);
     init_scr_del_flag(&guider_ui);
     setup_ui(&guider_ui);
+    PROFILER_PHASE("custom_init");
+    custom_init(&guider_ui);
+
+#if GUI_BINDING
+    bind_devices(NULL);
+    ui_part_built_cb = bind_devices;
+#endif
 
-    // Create a new thread for sensor reading
-    pthread_t thread_id;
-    if (pthread_create(&thread_id, NULL, sensor_thread, (void*)&guider_ui) != 0) {
+    /*Measure the touch-to-photon latency if the GUI_LATENCY environment variable is set.
+     *With GUI_LATENCY=synthetic a virtual finger taps and swipes too. The report is printed to stderr on exit.*/
+#if LV_USE_LATENCY
+    const char *latency = getenv("GUI_LATENCY");
+    if (latency)
+    {
+        lv_latency_set_screen_name(guider_ui.screen, "screen");
+        if (strcmp(latency, "synthetic") == 0)
+            lv_latency_synthetic_create(NULL, 1000);
+        lv_latency_start();
+    }
+#endif
+
+    PROFILER_PHASE("threads");
+
+    // Sample the sensors in the thread of the I2C bus, GUI_SENSOR=fake simulates them
+    static i2c_adapter_t sensor_adapter;
+    static i2c_linux_t sensor_i2c;
+    static i2c_mock_t sensor_mock;
+    static sht30_fake_t sensor_fake = {23.5f, 45.0f};
+    const char *sensor = getenv("GUI_SENSOR");
+    if (sensor && strcmp(sensor, "fake") == 0) {
+        i2c_adapter_init_mock(&sensor_adapter, &sensor_mock);
+        sht30_fake_attach(&sensor_mock, &sensor_fake, SHT30_ADDR);
+    }
+    else {
+        i2c_adapter_init_linux(&sensor_adapter, &sensor_i2c, "/dev/i2c-1");
+    }
+    i2c_bus_t *sensor_bus = i2c_bus_create(&sensor_adapter);
+    if (!sensor_bus || sht30_add(sensor_bus, SHT30_ADDR, SHT30_FETCH_PERIOD) != 0 ||
+        i2c_bus_start(sensor_bus) != 0) {
         fprintf(stderr, "Failed to create sensor thread.\n");
         return 1;
     }
+    lv_timer_create(sensor_show, SHT30_FETCH_PERIOD, &guider_ui);
 
     pthread_t thread_id_led;
     if (pthread_create(&thread_id_led, NULL, led_change_st, (void*)&guider_ui) != 0) {
@@ -92,13 +239,35 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Receive the device reports of the hub, HUB_SOCKET overrides the path of the socket
+    const char *hub_socket = getenv("HUB_SOCKET");
+    if (hub_ingest_start(hub_socket ? hub_socket : HUB_SOCKET_PATH, hub_changed, &guider_ui) != 0)
+        fprintf(stderr, "Failed to start the hub receiver.\n");
+
+    /*The first call renders the whole screen*/
+    PROFILER_PHASE("first frame");
+    lv_task_handler();
+    PROFILER_PHASE("run");
+
     /*Handle LitlevGL tasks (tickless mode)*/
-    while (1)
+    while (!quit)
     {
         lv_task_handler();
         usleep(5000);
     }
 
+    hub_ingest_stop();
+    i2c_bus_del(sensor_bus);
+
+#if LV_USE_PROFILER
+    lv_profiler_stop();
+    lv_profiler_report(report_print);
+#endif
+#if LV_USE_LATENCY
+    if (getenv("GUI_LATENCY"))
+        lv_latency_report(report_print);
+#endif
+
     // Join the thread before exiting (if needed)
     // pthread_join(thread_id, NULL);
 
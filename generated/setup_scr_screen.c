@@ -9,12 +9,145 @@
 
 #include "lvgl.h"
 #include <stdio.h>
+#include <stddef.h>
 #include <pthread.h>
 #include "gui_guider.h"
 #include "events_init.h"
 #include "widgets_init.h"
 #include "custom.h"
 
+#define SCREEN_OBJ(ui, ofs) (*(lv_obj_t **)((uint8_t *)(ui) + (ofs)))
+
+//A part of the screen which can be built after setup_scr_screen(), see GUI_LAZY_BUILD.
+typedef struct {
+	uint16_t obj;		//offsetof() the first object created by the part, it's NULL until the part is built
+	uint16_t last;		//offsetof() the last object created by the part, the objects between are created by it too
+	uint16_t tile;		//offsetof() the tile the objects of the part are created on
+	bool hidden;		//The part starts hidden so it's built on first show only, not ahead of time
+	void (*setup)(lv_ui *ui);
+} screen_part_t;
+
+static void setup_scr_screen_cont_hub_menu(lv_ui *ui);
+static void setup_scr_screen_cont_led(lv_ui *ui);
+static void setup_scr_screen_cont_sw(lv_ui *ui);
+static void setup_scr_screen_cont_timer(lv_ui *ui);
+static void setup_scr_screen_win_1(lv_ui *ui);
+static void setup_scr_screen_cont_setting_menu(lv_ui *ui);
+static void setup_scr_screen_cont_wifi(lv_ui *ui);
+static void setup_scr_screen_cont_ble(lv_ui *ui);
+static void setup_scr_screen_cont_lang(lv_ui *ui);
+static void setup_scr_screen_cont_noti(lv_ui *ui);
+
+static const screen_part_t screen_parts[] = {
+	{offsetof(lv_ui, screen_cont_hub_menu), offsetof(lv_ui, screen_imgbtn_7_label), offsetof(lv_ui, screen_tileview_hub_home_control), false, setup_scr_screen_cont_hub_menu},
+	{offsetof(lv_ui, screen_cont_led), offsetof(lv_ui, screen_imgbtn_13_label), offsetof(lv_ui, screen_tileview_hub_home_control), true, setup_scr_screen_cont_led},
+	{offsetof(lv_ui, screen_cont_sw), offsetof(lv_ui, screen_sw_8), offsetof(lv_ui, screen_tileview_hub_home_control), true, setup_scr_screen_cont_sw},
+	{offsetof(lv_ui, screen_cont_timer), offsetof(lv_ui, screen_imgbtn_21_label), offsetof(lv_ui, screen_tileview_hub_home_control), false, setup_scr_screen_cont_timer},
+	{offsetof(lv_ui, screen_win_1), offsetof(lv_ui, screen_win_1_item0), offsetof(lv_ui, screen_tileview_hub_home_control), true, setup_scr_screen_win_1},
+	{offsetof(lv_ui, screen_cont_setting_menu), offsetof(lv_ui, screen_imgbtn_4_label), offsetof(lv_ui, screen_tileview_main_settings), false, setup_scr_screen_cont_setting_menu},
+	{offsetof(lv_ui, screen_cont_wifi), offsetof(lv_ui, screen_btn_1_label), offsetof(lv_ui, screen_tileview_main_settings), true, setup_scr_screen_cont_wifi},
+	{offsetof(lv_ui, screen_cont_ble), offsetof(lv_ui, screen_btn_2_label), offsetof(lv_ui, screen_tileview_main_settings), true, setup_scr_screen_cont_ble},
+	{offsetof(lv_ui, screen_cont_lang), offsetof(lv_ui, screen_ddlist_1), offsetof(lv_ui, screen_tileview_main_settings), true, setup_scr_screen_cont_lang},
+	{offsetof(lv_ui, screen_cont_noti), offsetof(lv_ui, screen_list_1_item2), offsetof(lv_ui, screen_tileview_main_settings), true, setup_scr_screen_cont_noti},
+};
+
+#if GUI_LAZY_BUILD
+static lv_timer_t * screen_prebuild_timer;
+#endif
+
+static void screen_build_part(lv_ui *ui, const screen_part_t *part)
+{
+	part->setup(ui);
+
+	//Parts can be built in any order, restore the stacking order of the design in the tile.
+	uint32_t idx = 0;
+	for (uint32_t i = 0; i < sizeof(screen_parts) / sizeof(screen_parts[0]); i++) {
+		lv_obj_t *obj = SCREEN_OBJ(ui, screen_parts[i].obj);
+		if (screen_parts[i].tile == part->tile && obj != NULL) {
+			lv_obj_move_to_index(obj, idx++);
+		}
+	}
+}
+
+static void screen_build_part_late(lv_ui *ui, const screen_part_t *part)
+{
+	screen_build_part(ui, part);
+	lv_obj_update_layout(ui->screen);
+	if (ui_part_built_cb) {
+		ui_part_built_cb(SCREEN_OBJ(ui, part->tile));
+	}
+}
+
+lv_obj_t * setup_scr_screen_part(lv_ui *ui, lv_obj_t **obj)
+{
+	for (uint32_t i = 0; i < sizeof(screen_parts) / sizeof(screen_parts[0]); i++) {
+		if (&SCREEN_OBJ(ui, screen_parts[i].obj) == obj) {
+			if (*obj == NULL) {
+				screen_build_part_late(ui, &screen_parts[i]);
+			}
+			break;
+		}
+	}
+	return *obj;
+}
+
+#if GUI_LAZY_BUILD
+static void screen_build_tiles(lv_ui *ui, lv_obj_t *tileview)
+{
+	for (uint32_t i = 0; i < sizeof(screen_parts) / sizeof(screen_parts[0]); i++) {
+		const screen_part_t *part = &screen_parts[i];
+		if (!part->hidden && SCREEN_OBJ(ui, part->obj) == NULL && lv_obj_get_parent(SCREEN_OBJ(ui, part->tile)) == tileview) {
+			screen_build_part_late(ui, part);
+		}
+	}
+}
+
+static void screen_tileview_event_handler(lv_event_t *e)
+{
+	lv_event_code_t code = lv_event_get_code(e);
+	lv_ui *ui = lv_event_get_user_data(e);
+
+	switch (code) {
+	case LV_EVENT_SCROLL_BEGIN:
+	case LV_EVENT_VALUE_CHANGED:
+	{
+		//Build the tiles before they are scrolled in.
+		screen_build_tiles(ui, lv_event_get_target(e));
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static void screen_prebuild_timer_cb(lv_timer_t *timer)
+{
+	lv_ui *ui = timer->user_data;
+
+	//Build one tile at a time, and only while the user is not interacting.
+	if (lv_disp_get_inactive_time(NULL) < GUI_LAZY_PREBUILD_TIME) {
+		return;
+	}
+	for (uint32_t i = 0; i < sizeof(screen_parts) / sizeof(screen_parts[0]); i++) {
+		const screen_part_t *part = &screen_parts[i];
+		if (!part->hidden && SCREEN_OBJ(ui, part->obj) == NULL) {
+			screen_build_part_late(ui, part);
+			return;
+		}
+	}
+	lv_timer_del(timer);
+	screen_prebuild_timer = NULL;
+}
+
+static void screen_delete_event_handler(lv_event_t *e)
+{
+	if (screen_prebuild_timer) {
+		lv_timer_del(screen_prebuild_timer);
+		screen_prebuild_timer = NULL;
+	}
+}
+#endif
+
 void setup_scr_screen(lv_ui *ui)
 {
 	//Write codes screen
@@ -305,8 +438,34 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_style_pad_left(ui->screen_label_50, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
 	lv_obj_set_style_shadow_width(ui->screen_label_50, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
 
+	//Build the parts of the other tiles, or only mark them as not built yet.
+	for (uint32_t i = 0; i < sizeof(screen_parts) / sizeof(screen_parts[0]); i++) {
+#if GUI_LAZY_BUILD
+		for (uint32_t ofs = screen_parts[i].obj; ofs <= screen_parts[i].last; ofs += sizeof(lv_obj_t *)) {
+			SCREEN_OBJ(ui, ofs) = NULL;
+		}
+#else
+		screen_build_part(ui, &screen_parts[i]);
+#endif
+	}
+#if GUI_LAZY_BUILD
+	lv_obj_add_event_cb(ui->screen_tileview_main, screen_tileview_event_handler, LV_EVENT_ALL, ui);
+	lv_obj_add_event_cb(ui->screen_tileview_hub, screen_tileview_event_handler, LV_EVENT_ALL, ui);
+	lv_obj_add_event_cb(ui->screen, screen_delete_event_handler, LV_EVENT_DELETE, ui);
+	if (GUI_LAZY_PREBUILD_TIME > 0 && screen_prebuild_timer == NULL) {
+		screen_prebuild_timer = lv_timer_create(screen_prebuild_timer_cb, GUI_LAZY_PREBUILD_TIME / 2, ui);
+	}
+#endif
 
+	//The custom code of screen.
 
+
+	//Update current screen layout.
+	lv_obj_update_layout(ui->screen);
+}
+
+static void setup_scr_screen_cont_hub_menu(lv_ui *ui)
+{
 	//Write codes screen_cont_hub_menu
 	ui->screen_cont_hub_menu = lv_obj_create(ui->screen_tileview_hub_home_control);
 	lv_obj_set_pos(ui->screen_cont_hub_menu, 0, 0);
@@ -593,6 +752,12 @@ void setup_scr_screen(lv_ui *ui)
 	//Write style for screen_imgbtn_7, Part: LV_PART_MAIN, State: LV_IMGBTN_STATE_RELEASED.
 	lv_obj_set_style_img_opa(ui->screen_imgbtn_7, 255, LV_PART_MAIN|LV_IMGBTN_STATE_RELEASED);
 
+	//Init events for screen_cont_hub_menu.
+	events_init_screen_cont_hub_menu(ui);
+}
+
+static void setup_scr_screen_cont_led(lv_ui *ui)
+{
 	//Write codes screen_cont_led
 	ui->screen_cont_led = lv_obj_create(ui->screen_tileview_hub_home_control);
 	lv_obj_set_pos(ui->screen_cont_led, 204, 26);
@@ -1099,7 +1264,10 @@ void setup_scr_screen(lv_ui *ui)
 
 	//Write style for screen_imgbtn_13, Part: LV_PART_MAIN, State: LV_IMGBTN_STATE_RELEASED.
 	lv_obj_set_style_img_opa(ui->screen_imgbtn_13, 255, LV_PART_MAIN|LV_IMGBTN_STATE_RELEASED);
+}
 
+static void setup_scr_screen_cont_sw(lv_ui *ui)
+{
 	//Write codes screen_cont_sw
 	ui->screen_cont_sw = lv_obj_create(ui->screen_tileview_hub_home_control);
 	lv_obj_set_pos(ui->screen_cont_sw, 204, 26);
@@ -1539,7 +1707,10 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_style_bg_grad_dir(ui->screen_sw_8, LV_GRAD_DIR_NONE, LV_PART_KNOB|LV_STATE_DEFAULT);
 	lv_obj_set_style_border_width(ui->screen_sw_8, 0, LV_PART_KNOB|LV_STATE_DEFAULT);
 	lv_obj_set_style_radius(ui->screen_sw_8, 10, LV_PART_KNOB|LV_STATE_DEFAULT);
+}
 
+static void setup_scr_screen_cont_timer(lv_ui *ui)
+{
 	//Write codes screen_cont_timer
 	ui->screen_cont_timer = lv_obj_create(ui->screen_tileview_hub_home_control);
 	lv_obj_set_pos(ui->screen_cont_timer, 204, 26);
@@ -2201,6 +2372,12 @@ void setup_scr_screen(lv_ui *ui)
 	//Write style for screen_imgbtn_21, Part: LV_PART_MAIN, State: LV_IMGBTN_STATE_RELEASED.
 	lv_obj_set_style_img_opa(ui->screen_imgbtn_21, 255, LV_PART_MAIN|LV_IMGBTN_STATE_RELEASED);
 
+	//Init events for screen_cont_timer.
+	events_init_screen_cont_timer(ui);
+}
+
+static void setup_scr_screen_win_1(lv_ui *ui)
+{
 	//Write codes screen_win_1
 	ui->screen_win_1 = lv_win_create(ui->screen_tileview_hub_home_control, 55);
 	lv_obj_t * screen_win_1_title = lv_win_add_title(ui->screen_win_1, "Control device information");
@@ -2258,8 +2435,12 @@ void setup_scr_screen(lv_ui *ui)
 	lv_style_set_bg_grad_dir(&style_screen_win_1_extra_btns_main_default, LV_GRAD_DIR_NONE);
 	lv_obj_add_style(ui->screen_win_1_item0, &style_screen_win_1_extra_btns_main_default, LV_PART_MAIN|LV_STATE_DEFAULT);
 
+	//Init events for screen_win_1.
+	events_init_screen_win_1(ui);
+}
 
-
+static void setup_scr_screen_cont_setting_menu(lv_ui *ui)
+{
 	//Write codes screen_cont_setting_menu
 	ui->screen_cont_setting_menu = lv_obj_create(ui->screen_tileview_main_settings);
 	lv_obj_set_pos(ui->screen_cont_setting_menu, 0, 0);
@@ -2643,6 +2824,12 @@ void setup_scr_screen(lv_ui *ui)
 	//Write style for screen_imgbtn_4, Part: LV_PART_MAIN, State: LV_IMGBTN_STATE_RELEASED.
 	lv_obj_set_style_img_opa(ui->screen_imgbtn_4, 255, LV_PART_MAIN|LV_IMGBTN_STATE_RELEASED);
 
+	//Init events for screen_cont_setting_menu.
+	events_init_screen_cont_setting_menu(ui);
+}
+
+static void setup_scr_screen_cont_wifi(lv_ui *ui)
+{
 	//Write codes screen_cont_wifi
 	ui->screen_cont_wifi = lv_obj_create(ui->screen_tileview_main_settings);
 	lv_obj_set_pos(ui->screen_cont_wifi, 207, 32);
@@ -2802,6 +2989,12 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_style_text_opa(ui->screen_btn_1, 255, LV_PART_MAIN|LV_STATE_DEFAULT);
 	lv_obj_set_style_text_align(ui->screen_btn_1, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN|LV_STATE_DEFAULT);
 
+	//Init events for screen_cont_wifi.
+	events_init_screen_cont_wifi(ui);
+}
+
+static void setup_scr_screen_cont_ble(lv_ui *ui)
+{
 	//Write codes screen_cont_ble
 	ui->screen_cont_ble = lv_obj_create(ui->screen_tileview_main_settings);
 	lv_obj_set_pos(ui->screen_cont_ble, 207, 32);
@@ -2961,6 +3154,12 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_style_text_opa(ui->screen_btn_2, 255, LV_PART_MAIN|LV_STATE_DEFAULT);
 	lv_obj_set_style_text_align(ui->screen_btn_2, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN|LV_STATE_DEFAULT);
 
+	//Init events for screen_cont_ble.
+	events_init_screen_cont_ble(ui);
+}
+
+static void setup_scr_screen_cont_lang(lv_ui *ui)
+{
 	//Write codes screen_cont_lang
 	ui->screen_cont_lang = lv_obj_create(ui->screen_tileview_main_settings);
 	lv_obj_set_pos(ui->screen_cont_lang, 207, 32);
@@ -3148,7 +3347,10 @@ void setup_scr_screen(lv_ui *ui)
 	lv_style_set_bg_color(&style_screen_ddlist_1_extra_list_scrollbar_default, lv_color_hex(0x000000));
 	lv_style_set_bg_grad_dir(&style_screen_ddlist_1_extra_list_scrollbar_default, LV_GRAD_DIR_NONE);
 	lv_obj_add_style(lv_dropdown_get_list(ui->screen_ddlist_1), &style_screen_ddlist_1_extra_list_scrollbar_default, LV_PART_SCROLLBAR|LV_STATE_DEFAULT);
+}
 
+static void setup_scr_screen_cont_noti(lv_ui *ui)
+{
 	//Write codes screen_cont_noti
 	ui->screen_cont_noti = lv_obj_create(ui->screen_tileview_main_settings);
 	lv_obj_set_pos(ui->screen_cont_noti, 207, 32);
@@ -3289,13 +3491,4 @@ void setup_scr_screen(lv_ui *ui)
 	lv_style_set_text_opa(&style_screen_list_1_extra_texts_main_default, 255);
 	lv_style_set_radius(&style_screen_list_1_extra_texts_main_default, 3);
 	lv_style_set_bg_opa(&style_screen_list_1_extra_texts_main_default, 0);
-
-	//The custom code of screen.
-	
-
-	//Update current screen layout.
-	lv_obj_update_layout(ui->screen);
-
-	//Init events for screen.
-	events_init_screen(ui);
 }
@@ -0,0 +1,17 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+/* Stands for the file generated by GUI Guider: the client connects to the stand-in server of fm_bench */
+#ifndef EXTERNAL_DATA_INIT_H
+#define EXTERNAL_DATA_INIT_H
+
+extern char fm_bench_server_url[];
+#define FREEMASTER_SERVER fm_bench_server_url
+
+#endif
@@ -0,0 +1,349 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+/*
+ * Benchmark of the external data path: gg_edata tasks read FreeMASTER variables through
+ * websocket JSON-RPC from the stand-in server in this process, and the values are shown on
+ * labels, charts and meters of an in-memory display.
+ * The end-to-end latency of an update is the time from the change of the value in the server
+ * until the widget shows it after lv_timer_handler(). The CPU time of the data threads is the
+ * time of the process without the LVGL thread and the server.
+ * Prints a JSON object per line: the configuration, then the latency of every widget type
+ * and the totals.
+ * Usage: fm_bench [--labels N] [--charts N] [--meters N] [--period-ms N] [--rate HZ]
+ *                 [--latency-us N] [--jitter-us N] [--service-us N] [--duration-s N] [--no-batch]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for usleep() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "lvgl.h"
+#include "gg_external_data.h"
+#include "freemaster_client.h"
+#include "fm_standin.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES       800
+#define BENCH_VER_RES       480
+#define BENCH_LOOP_MS       5       /*Sleep of the LVGL loop, as in main.c*/
+#define CHART_POINTS        50
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    KIND_LABEL,
+    KIND_CHART,
+    KIND_METER,
+    KIND_NUM
+};
+
+typedef struct {
+    int kind;
+    readVariableParm param;
+    fm_var var;
+    char name[16];
+    void * child[1];
+    int32_t shown;          /*The value on the widget, -1 before the first update*/
+} bench_widget_t;
+
+typedef struct {
+    uint32_t * us;
+    uint32_t cnt;
+    uint32_t size;
+} latency_list_t;
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+/*Used by gg_external_data.c and connect_utils.c*/
+pthread_mutex_t gg_edata_ll_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t jsonrpc_mutex = PTHREAD_MUTEX_INITIALIZER;
+char fm_bench_server_url[64];
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t draw_buf_px[BENCH_HOR_RES * 48];
+static latency_list_t latencies[KIND_NUM];
+static const char * kind_names[KIND_NUM] = {"label", "chart", "meter"};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void create_widget(bench_widget_t * w, int kind, uint32_t index, uint32_t count);
+static int32_t get_shown(bench_widget_t * w);
+static void add_latency(int kind, uint32_t us);
+static int cmp_u32(const void * a, const void * b);
+static void print_latency(const char * name, latency_list_t * list);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t counts[KIND_NUM] = {20, 4, 4};
+    uint32_t period_ms = 50;
+    uint32_t duration_s = 10;
+    bool batch = true;
+    fm_standin_config_t server = { .rate = 100, .latency_us = 1000 };
+    int i;
+
+    for(i = 1; i < argc; i++) {
+        const char * value = (i + 1 < argc) ? argv[i + 1] : "0";
+        if(strcmp(argv[i], "--no-batch") == 0) { batch = false; continue; }
+        else if(strcmp(argv[i], "--labels") == 0) counts[KIND_LABEL] = atoi(value);
+        else if(strcmp(argv[i], "--charts") == 0) counts[KIND_CHART] = atoi(value);
+        else if(strcmp(argv[i], "--meters") == 0) counts[KIND_METER] = atoi(value);
+        else if(strcmp(argv[i], "--period-ms") == 0) period_ms = atoi(value);
+        else if(strcmp(argv[i], "--rate") == 0) server.rate = atoi(value);
+        else if(strcmp(argv[i], "--latency-us") == 0) server.latency_us = atoi(value);
+        else if(strcmp(argv[i], "--jitter-us") == 0) server.jitter_us = atoi(value);
+        else if(strcmp(argv[i], "--service-us") == 0) server.service_us = atoi(value);
+        else if(strcmp(argv[i], "--duration-s") == 0) duration_s = atoi(value);
+        else {
+            fprintf(stderr, "usage: %s [--labels N] [--charts N] [--meters N] [--period-ms N] [--rate HZ]\n"
+                    "       [--latency-us N] [--jitter-us N] [--service-us N] [--duration-s N] [--no-batch]\n", argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    /*The server*/
+    int port = fm_standin_start(&server);
+    if(port < 0) return 1;
+    snprintf(fm_bench_server_url, sizeof(fm_bench_server_url), "ws://127.0.0.1:%d", port);
+
+    /*An in-memory display*/
+    lv_init();
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_px, NULL, BENCH_HOR_RES * 48);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = BENCH_HOR_RES;
+    disp_drv.ver_res = BENCH_VER_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    /*The widgets and their tasks*/
+    uint32_t widget_cnt = counts[KIND_LABEL] + counts[KIND_CHART] + counts[KIND_METER];
+    bench_widget_t * widgets = calloc(widget_cnt, sizeof(bench_widget_t));
+    if(widgets == NULL) return 1;
+
+    gg_edata_task_init();
+    if(!batch) gg_edata_task_set_batch_cb(freeMasterParse, NULL);
+    freemaster_apply_init();
+
+    uint32_t w = 0;
+    int kind;
+    for(kind = 0; kind < KIND_NUM; kind++) {
+        uint32_t n;
+        for(n = 0; n < counts[kind]; n++) {
+            create_widget(&widgets[w], kind, w, widget_cnt);
+            gg_edata_task_create(period_ms, freeMasterParse, &widgets[w].param);
+            w++;
+        }
+    }
+
+    printf("{\"bench\":\"fm_bench\",\"labels\":%u,\"charts\":%u,\"meters\":%u,\"period_ms\":%u,\"rate\":%u,"
+           "\"latency_us\":%u,\"jitter_us\":%u,\"service_us\":%u,\"duration_s\":%u,\"batch\":%s,\"workers\":%d}\n",
+           counts[KIND_LABEL], counts[KIND_CHART], counts[KIND_METER], period_ms, server.rate,
+           server.latency_us, server.jitter_us, server.service_us, duration_s, batch ? "true" : "false",
+           GG_EDATA_WORKER_NUM);
+
+    /*Run*/
+    pthread_t thread;
+    pthread_create(&thread, NULL, gg_edata_task_exec, NULL);
+
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    uint64_t proc_cpu_start = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    uint64_t lvgl_cpu_start = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    fm_standin_stats_t stats_start;
+    fm_standin_get_stats(&stats_start);
+    uint64_t start = gg_get_us_time();
+    uint64_t updates = 0;
+
+    while(gg_get_us_time() - start < (uint64_t)duration_s * 1000000) {
+        lv_timer_handler();
+
+        /*A new value is on the widget: it took this long from the server*/
+        uint64_t now = gg_get_us_time();
+        for(w = 0; w < widget_cnt; w++) {
+            int32_t shown = get_shown(&widgets[w]);
+            if(shown < 0 || shown == widgets[w].shown) continue;
+            widgets[w].shown = shown;
+            add_latency(widgets[w].kind, (uint32_t)(now - fm_standin_change_time(shown, now)));
+            updates++;
+        }
+        usleep(BENCH_LOOP_MS * 1000);
+    }
+
+    uint64_t wall_us = gg_get_us_time() - start;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    uint64_t proc_cpu = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 - proc_cpu_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    uint64_t lvgl_cpu = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 - lvgl_cpu_start;
+    fm_standin_stats_t stats;
+    fm_standin_get_stats(&stats);
+    uint64_t server_cpu = stats.cpu_us - stats_start.cpu_us;
+    uint64_t requests = stats.requests - stats_start.requests;
+    uint64_t data_cpu = proc_cpu > lvgl_cpu + server_cpu ? proc_cpu - lvgl_cpu - server_cpu : 0;
+
+    for(kind = 0; kind < KIND_NUM; kind++) {
+        if(counts[kind] == 0) continue;
+        print_latency(kind_names[kind], &latencies[kind]);
+    }
+    printf("{\"total\":{\"wall_ms\":%.1f,\"requests\":%llu,\"errors\":%llu,\"requests_per_s\":%.0f,\"updates_shown\":%llu,"
+           "\"data_cpu_pct\":%.1f,\"data_cpu_us_per_request\":%.1f,\"lvgl_cpu_pct\":%.1f,\"server_cpu_pct\":%.1f}}\n",
+           wall_us / 1000.0, (unsigned long long)requests, (unsigned long long)(stats.errors - stats_start.errors),
+           requests * 1000000.0 / wall_us, (unsigned long long)updates,
+           data_cpu * 100.0 / wall_us, requests ? (double)data_cpu / requests : 0.0,
+           lvgl_cpu * 100.0 / wall_us, server_cpu * 100.0 / wall_us);
+
+    /*The worker threads keep running, leave without cleaning up*/
+    fflush(stdout);
+    _exit(0);
+}
+
+/*The tick of LVGL, see lv_conf.h*/
+uint32_t fm_bench_tick_get(void)
+{
+    return (uint32_t)gg_get_ms_time();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void create_widget(bench_widget_t * w, int kind, uint32_t index, uint32_t count)
+{
+    /*Lay them out in a grid so they're all drawn*/
+    uint32_t cols = 1;
+    while(cols * cols < count) cols++;
+    lv_coord_t cell_w = BENCH_HOR_RES / cols;
+    lv_coord_t cell_h = BENCH_VER_RES / ((count + cols - 1) / cols);
+    lv_obj_t * obj;
+
+    w->kind = kind;
+    w->shown = -1;
+    snprintf(w->name, sizeof(w->name), "var%u", (unsigned)index);
+    w->var.varName = w->name;
+    w->var.varType = "Fixed point number";
+
+    switch(kind) {
+        case KIND_LABEL:
+            obj = lv_label_create(lv_scr_act());
+            lv_label_set_text(obj, "");
+            w->param.widget_type = GG_LABEL;
+            break;
+        case KIND_CHART: {
+            obj = lv_chart_create(lv_scr_act());
+            lv_chart_set_point_count(obj, CHART_POINTS);
+            lv_chart_set_range(obj, LV_CHART_AXIS_PRIMARY_Y, 0, FM_STANDIN_VALUE_WRAP);
+            w->child[0] = lv_chart_add_series(obj, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+            w->param.widget_type = GG_CHART;
+            break;
+        }
+        default: {
+            obj = lv_meter_create(lv_scr_act());
+            lv_meter_scale_t * scale = lv_meter_add_scale(obj);
+            lv_meter_set_scale_range(obj, scale, 0, FM_STANDIN_VALUE_WRAP, 270, 135);
+            w->child[0] = lv_meter_add_needle_line(obj, scale, 2, lv_palette_main(LV_PALETTE_BLUE), -10);
+            /*Not a value of the server, so the first update is seen*/
+            lv_meter_set_indicator_value(obj, w->child[0], -1);
+            w->param.widget_type = GG_METER;
+            break;
+        }
+    }
+    lv_obj_set_pos(obj, (index % cols) * cell_w, (index / cols) * cell_h);
+    if(kind != KIND_LABEL) lv_obj_set_size(obj, cell_w - 4, cell_h - 4);
+
+    w->param.screen = lv_scr_act();
+    w->param.parentObj = obj;
+    w->param.varArray = &w->var;
+    w->param.childObjArray = w->child;
+    w->param.arrayLen = 1;
+    w->param.apiName = "ReadVariable";
+}
+
+static int32_t get_shown(bench_widget_t * w)
+{
+    switch(w->kind) {
+        case KIND_LABEL: {
+            const char * txt = lv_label_get_text(w->param.parentObj);
+            return txt[0] ? atoi(txt) : -1;
+        }
+        case KIND_CHART: {
+            lv_chart_series_t * ser = w->child[0];
+            uint16_t last = (lv_chart_get_x_start_point(w->param.parentObj, ser) + CHART_POINTS - 1) % CHART_POINTS;
+            lv_coord_t v = lv_chart_get_y_array(w->param.parentObj, ser)[last];
+            return v == LV_CHART_POINT_NONE ? -1 : v;
+        }
+        default: {
+            lv_meter_indicator_t * indic = w->child[0];
+            return indic->start_value;
+        }
+    }
+}
+
+static void add_latency(int kind, uint32_t us)
+{
+    latency_list_t * list = &latencies[kind];
+    if(list->cnt == list->size) {
+        uint32_t size = list->size ? list->size * 2 : 1024;
+        uint32_t * new_us = realloc(list->us, size * sizeof(uint32_t));
+        if(new_us == NULL) return;
+        list->us = new_us;
+        list->size = size;
+    }
+    list->us[list->cnt++] = us;
+}
+
+static int cmp_u32(const void * a, const void * b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_latency(const char * name, latency_list_t * list)
+{
+    if(list->cnt == 0) {
+        printf("{\"widget\":\"%s\",\"updates\":0}\n", name);
+        return;
+    }
+    qsort(list->us, list->cnt, sizeof(uint32_t), cmp_u32);
+    uint64_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < list->cnt; i++) sum += list->us[i];
+    printf("{\"widget\":\"%s\",\"updates\":%u,\"latency_us\":{\"min\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,\"mean\":%u}}\n",
+           name, list->cnt, list->us[0], list->us[list->cnt / 2], list->us[list->cnt * 9 / 10],
+           list->us[list->cnt * 99 / 100], list->us[list->cnt - 1], (uint32_t)(sum / list->cnt));
+}
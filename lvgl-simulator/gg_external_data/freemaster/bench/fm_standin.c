@@ -0,0 +1,484 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+#define _GNU_SOURCE /* needed for usleep(), memmem() and strcasestr() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "fm_standin.h"
+
+#define WS_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define RECV_BUFFER_SIZE (64 * 1024)
+#define MAX_PENDING 1024
+
+/* a response waiting for its injected latency */
+typedef struct {
+  uint64_t due;
+  char *data;
+} pending_response;
+
+typedef struct {
+  int fd;
+  uint8_t *buf;
+  size_t len;
+  pending_response pending[MAX_PENDING];
+  int pending_head;
+  int pending_cnt;
+  uint64_t cpu_us;
+} connection;
+
+static fm_standin_config_t config;
+static uint64_t start_time;
+static int listen_fd = -1;
+static pthread_t accept_thread;
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static fm_standin_stats_t stats;
+static int32_t written_value = -1;
+static uint64_t written_cnt;
+
+static uint64_t time_us(clockid_t clock)
+{
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* count the updates since the start, the variables read this */
+static uint64_t update_count(uint64_t now)
+{
+  return (now - start_time) * config.rate / 1000000;
+}
+
+/*---------- SHA-1 and base64 for the websocket handshake ----------*/
+
+static void sha1(const uint8_t *data, size_t len, uint8_t out[20])
+{
+  uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+  uint8_t block[64];
+  size_t total = ((len + 8) / 64 + 1) * 64;
+  size_t ofs;
+
+  for (ofs = 0; ofs < total; ofs += 64) {
+    uint32_t w[80];
+    int i;
+    for (i = 0; i < 64; i++) {
+      size_t p = ofs + i;
+      if (p < len) block[i] = data[p];
+      else if (p == len) block[i] = 0x80;
+      else if (p >= total - 8) block[i] = (uint8_t)(((uint64_t)len * 8) >> ((total - 1 - p) * 8));
+      else block[i] = 0;
+    }
+    for (i = 0; i < 16; i++) {
+      w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16 | (uint32_t)block[i * 4 + 2] << 8 | block[i * 4 + 3];
+    }
+    for (i = 16; i < 80; i++) {
+      uint32_t x = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+      w[i] = (x << 1) | (x >> 31);
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (i = 0; i < 80; i++) {
+      uint32_t f, k;
+      if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+      else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+      else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+      else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+      uint32_t t = ((a << 5) | (a >> 27)) + f + e + k + w[i];
+      e = d; d = c; c = (b << 30) | (b >> 2); b = a; a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+  }
+  for (ofs = 0; ofs < 20; ofs++) {
+    out[ofs] = (uint8_t)(h[ofs / 4] >> (24 - (ofs % 4) * 8));
+  }
+}
+
+static void base64(const uint8_t *data, size_t len, char *out)
+{
+  static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t i;
+  for (i = 0; i < len; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16 | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0) | (i + 2 < len ? data[i + 2] : 0);
+    *out++ = table[(v >> 18) & 0x3F];
+    *out++ = table[(v >> 12) & 0x3F];
+    *out++ = (i + 1 < len) ? table[(v >> 6) & 0x3F] : '=';
+    *out++ = (i + 2 < len) ? table[v & 0x3F] : '=';
+  }
+  *out = '\0';
+}
+
+/*---------- websocket ----------*/
+
+static bool send_all(int fd, const void *data, size_t len)
+{
+  const uint8_t *p = data;
+  while (len > 0) {
+    ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+static bool send_frame(int fd, uint8_t opcode, const char *data, size_t len)
+{
+  uint8_t head[10];
+  size_t head_len = 2;
+  head[0] = 0x80 | opcode;
+  if (len < 126) {
+    head[1] = (uint8_t)len;
+  } else if (len < 65536) {
+    head[1] = 126;
+    head[2] = (uint8_t)(len >> 8);
+    head[3] = (uint8_t)len;
+    head_len = 4;
+  } else {
+    int i;
+    head[1] = 127;
+    for (i = 0; i < 8; i++) head[2 + i] = (uint8_t)((uint64_t)len >> (56 - i * 8));
+    head_len = 10;
+  }
+  return send_all(fd, head, head_len) && send_all(fd, data, len);
+}
+
+/* answer the upgrade request, false if it's not one */
+static bool handshake(connection *conn)
+{
+  char *end;
+  while ((end = memmem(conn->buf, conn->len, "\r\n\r\n", 4)) == NULL) {
+    ssize_t n = recv(conn->fd, conn->buf + conn->len, RECV_BUFFER_SIZE - 1 - conn->len, 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0 || conn->len + n >= RECV_BUFFER_SIZE - 1) return false;
+    conn->len += n;
+  }
+  conn->buf[conn->len] = '\0';
+
+  char *key = strcasestr((char *)conn->buf, "Sec-WebSocket-Key:");
+  if (key == NULL || key > end) return false;
+  key += strlen("Sec-WebSocket-Key:");
+  while (*key == ' ') key++;
+  size_t key_len = strcspn(key, "\r\n ");
+
+  char accept_src[128];
+  uint8_t digest[20];
+  char accept[32];
+  char response[256];
+  if (key_len + strlen(WS_GUID) >= sizeof(accept_src)) return false;
+  memcpy(accept_src, key, key_len);
+  strcpy(accept_src + key_len, WS_GUID);
+  sha1((uint8_t *)accept_src, strlen(accept_src), digest);
+  base64(digest, sizeof(digest), accept);
+  snprintf(response, sizeof(response),
+           "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+           "Sec-WebSocket-Accept: %s\r\n\r\n", accept);
+
+  /* keep what the client sent after the request */
+  size_t used = (uint8_t *)end + 4 - conn->buf;
+  memmove(conn->buf, conn->buf + used, conn->len - used);
+  conn->len -= used;
+  return send_all(conn->fd, response, strlen(response));
+}
+
+/*---------- JSON-RPC ----------*/
+
+/* find the string value of a key, e.g. "id": "3" */
+static bool json_string(const char *json, const char *key, char *out, size_t size)
+{
+  char pattern[32];
+  snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+  const char *p = strstr(json, pattern);
+  if (p == NULL) return false;
+  p += strlen(pattern);
+  while (*p == ' ' || *p == ':') p++;
+  if (*p == '"') p++;
+  size_t len = strcspn(p, "\",}]");
+  if (len >= size) return false;
+  memcpy(out, p, len);
+  out[len] = '\0';
+  return true;
+}
+
+static bool known_variable(const char *name)
+{
+  uint32_t i;
+  if (config.var_names == NULL) return true;
+  for (i = 0; i < config.var_cnt; i++) {
+    if (strcmp(config.var_names[i], name) == 0) return true;
+  }
+  return false;
+}
+
+static char *handle_request(const char *request)
+{
+  char id[32] = "0";
+  char method[32] = "";
+  char name[128] = "";
+  char *response = malloc(512);
+  bool ok = true;
+  if (response == NULL) return NULL;
+
+  json_string(request, "id", id, sizeof(id));
+  json_string(request, "method", method, sizeof(method));
+  const char *params = strstr(request, "\"params\"");
+  if (params != NULL) params = strchr(params, '[');
+  if (params != NULL) {
+    params++;
+    while (*params == ' ' || *params == '"') params++;
+    size_t len = strcspn(params, "\",]");
+    if (len < sizeof(name)) {
+      memcpy(name, params, len);
+      name[len] = '\0';
+    }
+  }
+
+  if (strcmp(method, "ReadVariable") == 0 && known_variable(name)) {
+    /* a written value is read until the next update */
+    uint64_t cnt = update_count(time_us(CLOCK_MONOTONIC));
+    int32_t value = (written_value >= 0 && written_cnt == cnt) ? written_value : (int32_t)(cnt % FM_STANDIN_VALUE_WRAP);
+    snprintf(response, 512, "{\"jsonrpc\": \"2.0\", \"id\": \"%s\", \"result\": {\"success\": true, \"data\": %d, "
+             "\"xtra\": {\"retval\": true, \"formatted\": \"%d\"}}}", id, (int)value, (int)value);
+  } else if (strcmp(method, "WriteVariable") == 0 && known_variable(name)) {
+    const char *value = params ? strchr(params, ',') : NULL;
+    if (value) {
+      written_value = atoi(value + 1);
+      written_cnt = update_count(time_us(CLOCK_MONOTONIC));
+    }
+    snprintf(response, 512, "{\"jsonrpc\": \"2.0\", \"id\": \"%s\", \"result\": {\"success\": true, "
+             "\"xtra\": {\"retval\": true}}}", id);
+  } else {
+    ok = false;
+    snprintf(response, 512, "{\"jsonrpc\": \"2.0\", \"id\": \"%s\", \"result\": {\"success\": false, "
+             "\"xtra\": {\"retval\": false}, \"error\": {\"code\": -1, \"msg\": \"Unknown variable or method: %s %s\"}}}",
+             id, method, name);
+  }
+
+  pthread_mutex_lock(&stats_mutex);
+  stats.requests++;
+  if (!ok) stats.errors++;
+  pthread_mutex_unlock(&stats_mutex);
+  return response;
+}
+
+/* parse the complete frames in the buffer, false if the connection is closed */
+static bool handle_frames(connection *conn)
+{
+  while (conn->len >= 2) {
+    uint8_t opcode = conn->buf[0] & 0x0F;
+    bool masked = conn->buf[1] & 0x80;
+    uint64_t len = conn->buf[1] & 0x7F;
+    size_t head_len = 2;
+    if (len == 126) {
+      if (conn->len < 4) return true;
+      len = (uint64_t)conn->buf[2] << 8 | conn->buf[3];
+      head_len = 4;
+    } else if (len == 127) {
+      int i;
+      if (conn->len < 10) return true;
+      for (len = 0, i = 0; i < 8; i++) len = len << 8 | conn->buf[2 + i];
+      head_len = 10;
+    }
+    if (masked) head_len += 4;
+    if (head_len + len > RECV_BUFFER_SIZE - 1) return false;
+    if (conn->len < head_len + len) return true;
+
+    char *payload = (char *)conn->buf + head_len;
+    if (masked) {
+      const uint8_t *mask = conn->buf + head_len - 4;
+      uint64_t i;
+      for (i = 0; i < len; i++) payload[i] ^= mask[i % 4];
+    }
+
+    if (opcode == 0x8) {
+      send_frame(conn->fd, 0x8, payload, len);
+      return false;
+    } else if (opcode == 0x9) {
+      send_frame(conn->fd, 0xA, payload, len);
+    } else if (opcode == 0x1) {
+      char saved = payload[len];
+      payload[len] = '\0';
+      if (config.service_us) usleep(config.service_us);
+      char *response = handle_request(payload);
+      payload[len] = saved;
+      if (response != NULL) {
+        if (conn->pending_cnt == MAX_PENDING) {
+          free(response);
+        } else {
+          /* the responses keep their order, only the jitter changes between them */
+          pending_response *p = &conn->pending[(conn->pending_head + conn->pending_cnt) % MAX_PENDING];
+          p->due = time_us(CLOCK_MONOTONIC) + config.latency_us + (config.jitter_us ? (uint32_t)rand() % config.jitter_us : 0);
+          p->data = response;
+          conn->pending_cnt++;
+        }
+      }
+    }
+
+    memmove(conn->buf, conn->buf + head_len + len, conn->len - head_len - len);
+    conn->len -= head_len + len;
+  }
+  return true;
+}
+
+/* send the responses whose latency passed, return the ms until the next one or -1 */
+static int send_due(connection *conn)
+{
+  uint64_t now = time_us(CLOCK_MONOTONIC);
+  while (conn->pending_cnt > 0) {
+    pending_response *p = &conn->pending[conn->pending_head];
+    if (p->due > now) return (int)((p->due - now + 999) / 1000);
+    send_frame(conn->fd, 0x1, p->data, strlen(p->data));
+    free(p->data);
+    conn->pending_head = (conn->pending_head + 1) % MAX_PENDING;
+    conn->pending_cnt--;
+  }
+  return -1;
+}
+
+static void *connection_thread(void *arg)
+{
+  connection *conn = arg;
+  uint64_t cpu_start = time_us(CLOCK_THREAD_CPUTIME_ID);
+  bool open = handshake(conn);
+
+  while (open) {
+    struct pollfd pfd = { conn->fd, POLLIN, 0 };
+    int timeout = send_due(conn);
+    int ret = poll(&pfd, 1, timeout);
+    if (ret < 0 && errno != EINTR) break;
+    if (ret > 0) {
+      ssize_t n = recv(conn->fd, conn->buf + conn->len, RECV_BUFFER_SIZE - 1 - conn->len, 0);
+      if (n <= 0) break;
+      conn->len += n;
+      open = handle_frames(conn);
+    }
+
+    uint64_t cpu = time_us(CLOCK_THREAD_CPUTIME_ID);
+    pthread_mutex_lock(&stats_mutex);
+    stats.cpu_us += cpu - cpu_start;
+    pthread_mutex_unlock(&stats_mutex);
+    cpu_start = cpu;
+  }
+
+  while (conn->pending_cnt > 0) {
+    free(conn->pending[conn->pending_head].data);
+    conn->pending_head = (conn->pending_head + 1) % MAX_PENDING;
+    conn->pending_cnt--;
+  }
+  close(conn->fd);
+  free(conn->buf);
+  free(conn);
+  return NULL;
+}
+
+static void *accept_thread_cb(void *arg)
+{
+  (void)arg;
+  while (true) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    connection *conn = calloc(1, sizeof(connection));
+    if (conn != NULL) conn->buf = malloc(RECV_BUFFER_SIZE);
+    if (conn == NULL || conn->buf == NULL) {
+      free(conn);
+      close(fd);
+      continue;
+    }
+    conn->fd = fd;
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, connection_thread, conn) != 0) {
+      close(fd);
+      free(conn->buf);
+      free(conn);
+      continue;
+    }
+    pthread_detach(thread);
+    pthread_mutex_lock(&stats_mutex);
+    stats.connections++;
+    pthread_mutex_unlock(&stats_mutex);
+  }
+  return NULL;
+}
+
+int fm_standin_start(const fm_standin_config_t * cfg)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int one = 1;
+
+  config = *cfg;
+  if (config.rate == 0) config.rate = 1;
+  start_time = time_us(CLOCK_MONOTONIC);
+
+  listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    fprintf(stderr, "FreeMASTER stand-in: socket failed: %s\n", strerror(errno));
+    return -1;
+  }
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(config.port);
+  if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 8) < 0 ||
+      getsockname(listen_fd, (struct sockaddr *)&addr, &addr_len) < 0) {
+    fprintf(stderr, "FreeMASTER stand-in: cannot listen on port %d: %s\n", config.port, strerror(errno));
+    close(listen_fd);
+    listen_fd = -1;
+    return -1;
+  }
+
+  if (pthread_create(&accept_thread, NULL, accept_thread_cb, NULL) != 0) {
+    close(listen_fd);
+    listen_fd = -1;
+    return -1;
+  }
+  return ntohs(addr.sin_port);
+}
+
+void fm_standin_stop(void)
+{
+  if (listen_fd < 0) return;
+  shutdown(listen_fd, SHUT_RDWR);
+  close(listen_fd);
+  pthread_join(accept_thread, NULL);
+  listen_fd = -1;
+}
+
+uint64_t fm_standin_change_time(uint32_t value, uint64_t now)
+{
+  uint64_t cnt = update_count(now);
+  uint64_t back = (cnt % FM_STANDIN_VALUE_WRAP + FM_STANDIN_VALUE_WRAP - value) % FM_STANDIN_VALUE_WRAP;
+  if (back > cnt) return start_time;
+  /* the update count reached cnt - back at this time */
+  return start_time + ((cnt - back) * 1000000 + config.rate - 1) / config.rate;
+}
+
+void fm_standin_get_stats(fm_standin_stats_t * out)
+{
+  pthread_mutex_lock(&stats_mutex);
+  *out = stats;
+  pthread_mutex_unlock(&stats_mutex);
+}
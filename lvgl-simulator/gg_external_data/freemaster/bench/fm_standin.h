@@ -0,0 +1,61 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+#ifndef FM_STANDIN_H
+#define FM_STANDIN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* The values count up to this and start again from 0, so they fit into a chart point */
+#define FM_STANDIN_VALUE_WRAP 30000
+
+typedef struct {
+   uint16_t port;                /* 0: any free port */
+   const char ** var_names;      /* the variables the server knows, NULL: any name is accepted */
+   uint32_t var_cnt;
+   uint32_t rate;                /* value updates per second */
+   uint32_t latency_us;          /* delay of every response, like a network would add it */
+   uint32_t jitter_us;           /* random extra delay of a response, at most this much */
+   uint32_t service_us;          /* time to serve a request, requests of a connection are served one by one */
+} fm_standin_config_t;
+
+typedef struct {
+   uint32_t connections;
+   uint64_t requests;
+   uint64_t errors;              /* unknown variables and methods */
+   uint64_t cpu_us;              /* CPU time of the server threads */
+} fm_standin_stats_t;
+
+/*
+   * Start a loopback websocket JSON-RPC server which answers ReadVariable and WriteVariable
+   * like the FreeMASTER server. Every variable reads the number of updates since the start.
+   * @param   {const fm_standin_config_t *} config   the configuration, it's copied.
+   * @returns {int} the port the server listens on, -1 on error.
+*/
+int fm_standin_start(const fm_standin_config_t * config);
+
+/*
+   * Stop accepting connections. The open ones are served until the client closes them.
+*/
+void fm_standin_stop(void);
+
+/*
+   * @returns {uint64_t} the CLOCK_MONOTONIC time in us (as gg_get_us_time()) of the last update to a value.
+   * @param   {uint32_t} value   a value which was read from the server.
+   * @param   {uint64_t} now     the time it was seen, the last update before it is searched.
+*/
+uint64_t fm_standin_change_time(uint32_t value, uint64_t now);
+
+/*
+   * @param   {fm_standin_stats_t *} stats   the counters are stored here.
+*/
+void fm_standin_get_stats(fm_standin_stats_t * stats);
+
+#endif
@@ -0,0 +1,93 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+/*
+ * Stand-in for the FreeMASTER server, to run the simulator without a board:
+ *   fm_standin_server --port 41000 --vars counter,speed --rate 50 --latency-us 2000
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include "fm_standin.h"
+
+#define MAX_VARS 256
+
+static volatile sig_atomic_t running = 1;
+
+static void on_signal(int sig)
+{
+  (void)sig;
+  running = 0;
+}
+
+static void usage(const char *name)
+{
+  fprintf(stderr,
+          "usage: %s [--port N] [--vars a,b,...] [--rate HZ] [--latency-us N] [--jitter-us N] [--service-us N]\n"
+          "  --port        port on 127.0.0.1, default 41000\n"
+          "  --vars        the known variables, default: any name\n"
+          "  --rate        value updates per second, default 10\n"
+          "  --latency-us  delay of every response\n"
+          "  --jitter-us   random extra delay of a response\n"
+          "  --service-us  time to serve a request, one request at a time\n", name);
+}
+
+int main(int argc, char **argv)
+{
+  static const char *vars[MAX_VARS];
+  fm_standin_config_t config = { .port = 41000, .rate = 10 };
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (value == NULL) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (strcmp(arg, "--port") == 0) config.port = (uint16_t)atoi(value);
+    else if (strcmp(arg, "--rate") == 0) config.rate = (uint32_t)atoi(value);
+    else if (strcmp(arg, "--latency-us") == 0) config.latency_us = (uint32_t)atoi(value);
+    else if (strcmp(arg, "--jitter-us") == 0) config.jitter_us = (uint32_t)atoi(value);
+    else if (strcmp(arg, "--service-us") == 0) config.service_us = (uint32_t)atoi(value);
+    else if (strcmp(arg, "--vars") == 0) {
+      char *list = strdup(value);
+      char *name;
+      for (name = strtok(list, ","); name != NULL && config.var_cnt < MAX_VARS; name = strtok(NULL, ",")) {
+        vars[config.var_cnt++] = name;
+      }
+      config.var_names = vars;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+    i++;
+  }
+
+  int port = fm_standin_start(&config);
+  if (port < 0) return 1;
+  fprintf(stdout, "FreeMASTER stand-in listening on ws://127.0.0.1:%d\n", port);
+  fflush(stdout);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  while (running) {
+    pause();
+  }
+
+  fm_standin_stats_t stats;
+  fm_standin_stop();
+  fm_standin_get_stats(&stats);
+  fprintf(stdout, "connections %u, requests %llu, errors %llu, cpu %.1f ms\n", stats.connections,
+          (unsigned long long)stats.requests, (unsigned long long)stats.errors, stats.cpu_us / 1000.0);
+  return 0;
+}
@@ -0,0 +1,29 @@
+/*
+* Copyright 2024 NXP
+* NXP Confidential and Proprietary. This software is owned or controlled by NXP and may only be used strictly in
+* accordance with the applicable license terms. By expressly accepting such terms or by downloading, installing,
+* activating and/or otherwise using the software, you are agreeing that you have read, and that you agree to
+* comply with and are bound by, such license terms.  If you do not agree to be bound by the applicable license
+* terms, then you may not retain, install, activate or otherwise use the software.
+*/
+
+/* The configuration of the simulator with the FreeMASTER data path, without SDL for the tick */
+#ifndef FM_BENCH_LV_CONF_H
+#define FM_BENCH_LV_CONF_H
+
+#include "../../../lv_conf.h"
+
+#undef LV_USE_FREEMASTER
+#define LV_USE_FREEMASTER 1
+
+uint32_t fm_bench_tick_get(void);
+#undef LV_TICK_CUSTOM
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (fm_bench_tick_get())
+
+/* Room for many charts and meters */
+#undef LV_MEM_SIZE
+#define LV_MEM_SIZE (4U * 1024U * 1024U)
+
+#endif
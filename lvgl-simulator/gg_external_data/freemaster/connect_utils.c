@@ -8,6 +8,9 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <time.h>
 #include <pthread.h>
 #include "connect_utils.h"
@@ -20,6 +23,8 @@
 #if LV_USE_FREEMASTER
 extern pthread_mutex_t jsonrpc_mutex;
 
+static uint32_t next_request_id = 1;
+
 /*define the result struct.*/
 struct write_result {
   char *data;
@@ -40,6 +45,30 @@ void websocket_error(CURLcode res, char *message)
   }
 }
 
+/* reserve consecutive jsonrpc ids for the requests */
+static uint32_t take_request_ids(int cnt)
+{
+  uint32_t id;
+  pthread_mutex_lock(&jsonrpc_mutex);
+  if (next_request_id > UINT_MAX - cnt) {
+    next_request_id = 1;
+  }
+  id = next_request_id;
+  next_request_id += cnt;
+  pthread_mutex_unlock(&jsonrpc_mutex);
+  return id;
+}
+
+/* get the id of a jsonrpc response, 0 if it has none*/
+static uint32_t response_id(const char *response)
+{
+  const char *p = strstr(response, "\"id\"");
+  if (p == NULL) return 0;
+  p += 4;
+  while (*p == ' ' || *p == ':' || *p == '"') p++;
+  return (uint32_t)strtoul(p, NULL, 10);
+}
+
 /* init and connect the websocket instance*/
 CURL * websocket_connect(const char *ws_url)
 {
@@ -84,7 +113,6 @@ void websocket_close(CURL *ws_curl)
 /*send and got the receive*/
 char *websocket_request(CURL *ws_curl, char *params)
 {
-  static uint32_t id = 1;
   const struct curl_ws_frame *meta;
   size_t send, rlen;
   char recv_buffer[BUFFER_SIZE];
@@ -95,16 +123,11 @@ char *websocket_request(CURL *ws_curl, char *params)
     connect_init();
     return NULL;
   }
-  pthread_mutex_lock(&jsonrpc_mutex);
+  uint32_t id = take_request_ids(1);
   char request_head[50];
   snprintf(request_head, 50, "\"jsonrpc\":\"2.0\",\"id\":\"%d\"", id);
   char request_data[500];
   snprintf(request_data, 500, "{%s, %s}", request_head, params);
-  id++;
-  if (id == UINT_MAX) {
-    id = 1;
-  }
-  pthread_mutex_unlock(&jsonrpc_mutex);
   #ifdef DEBUG
   fprintf(stdout, "Sending request: %s\n", request_data);
   #endif
@@ -164,6 +187,75 @@ char *websocket_request(CURL *ws_curl, char *params)
   return data;
 }
 
+/*send all requests, then receive the responses in any order*/
+int websocket_request_batch(CURL *ws_curl, char **params, int cnt, char **responses)
+{
+  const struct curl_ws_frame *meta;
+  size_t send, rlen;
+  char request_data[500];
+  CURLcode res = CURLE_OK;
+  int i;
+  for (i = 0; i < cnt; i++) responses[i] = NULL;
+  if (ws_curl == NULL)
+  {
+    websocket_error(CURLE_COULDNT_CONNECT, NULL);
+    connect_init();
+    return -1;
+  }
+  uint32_t first_id = take_request_ids(cnt);
+  for (i = 0; i < cnt; i++) {
+    snprintf(request_data, 500, "{\"jsonrpc\":\"2.0\",\"id\":\"%u\", %s}", first_id + i, params[i]);
+    #ifdef DEBUG
+    fprintf(stdout, "Sending request: %s\n", request_data);
+    #endif
+    res = curl_ws_send(ws_curl, request_data, strlen(request_data), &send, 0, CURLWS_TEXT);
+    if (res != CURLE_OK)
+    {
+      websocket_error(res, NULL);
+      curl_easy_cleanup(ws_curl);
+      connect_init();
+      return -1;
+    }
+  }
+
+  char *recv_buffer = malloc(BUFFER_SIZE);
+  if (recv_buffer == NULL)
+  {
+    fprintf(stderr, "\nERROR: Failed to alloc memory.\n");
+    return 0;
+  }
+  /* retry until ws server is ready, every response restarts the wait*/
+  int received = 0;
+  int count = 1;
+  while (received < cnt && count < RECV_RETRY_COUNT) {
+    res = curl_ws_recv(ws_curl, recv_buffer, BUFFER_SIZE - 1, &rlen, &meta);
+    if (res == CURLE_OK) {
+      recv_buffer[rlen] = '\0';
+      uint32_t id = response_id(recv_buffer);
+      if (id >= first_id && id < first_id + cnt && responses[id - first_id] == NULL) {
+        responses[id - first_id] = strdup(recv_buffer);
+        if (responses[id - first_id] != NULL) received++;
+      }
+      count = 1;
+      continue;
+    } else if (res != CURLE_AGAIN) {
+      /*an error occurred, but no signal to retry again*/
+      break;
+    }
+    gg_nanosleep(RECV_RETRY_INTERVAL);
+    count++;
+  }
+  free(recv_buffer);
+  /*an error occurred, the received responses are still valid*/
+  if (res != CURLE_OK && res != CURLE_AGAIN)
+  {
+    websocket_error(res, NULL);
+    curl_easy_cleanup(ws_curl);
+    connect_init();
+  }
+  return received;
+}
+
 /* Define the function how to write http response.*/
 static size_t write_response(void *ptr, size_t size, size_t nmemb, void *stream) {
     struct write_result *result = (struct write_result *)stream;
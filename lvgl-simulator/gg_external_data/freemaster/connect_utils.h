@@ -25,6 +25,16 @@ CURL * websocket_connect(const char *ws_url);
 */
 char *websocket_request(CURL *ws_curl, char *parm);
 
+/*
+   * Send several requests back to back, then receive their responses, so they take one round trip.
+   * @param   {CURL *} ws_curl: the pointer of the curl connection.
+   * @param   {char **} params: the request data of each request with json string.
+   * @param   {int} cnt: the number of requests.
+   * @param   {char **} responses: the response of each request, NULL if it didn't arrive. Free them with free().
+   * @returns {int} the number of responses received, -1 if the connection failed.
+*/
+int websocket_request_batch(CURL *ws_curl, char **params, int cnt, char **responses);
+
 /*
    * for close the websocket connection.
    * @param  {CURL *} ws_curl: the pointer of the curl connection.
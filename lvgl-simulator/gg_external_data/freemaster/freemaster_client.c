@@ -15,7 +15,23 @@
 #include "external_data_init.h"
 CURL *ws_connect;
 lv_obj_t * gg_msgbox = NULL;
-extern pthread_mutex_t lvgl_mutex;
+
+/* Values read for a widget which are not shown yet */
+typedef struct {
+    readVariableParm *param;
+    double *samples;    /* FM_SNAPSHOT_DEPTH rows of arrayLen values, the oldest first */
+    int sample_cnt;
+} fm_snapshot_t;
+
+/* Written by the data threads, applied to the widgets by the LVGL thread */
+static fm_snapshot_t *fm_snapshot = NULL;
+static int fm_snapshot_cnt = 0;
+static int fm_snapshot_size = 0;
+static char fm_snapshot_error[128];
+static pthread_mutex_t fm_snapshot_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* The curl handle is used by one thread at a time, and a response must not be taken by another request */
+static pthread_mutex_t fm_ws_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 void connect_init()
 {
@@ -28,91 +44,209 @@ bool equal_to_double_max(double a)
     return abs(DBL_MAX - fabs(a)) < 0.000001;
 }
 
-void freeMasterParse(void *param)
+/* display the extern data according to widget type. */
+static void apply_values(readVariableParm *user_parm, const double *dataArray)
 {
     char result[20];
-    if (strcmp(((readVariableParm *)param)->apiName, "ReadVariable") == 0)
+    switch (user_parm->widget_type)
+    {
+    case GG_LABEL:
     {
-        readVariableParm *user_parm = param;
-        double dataArray[user_parm->arrayLen];
-        read_variable(user_parm->varArray, user_parm->arrayLen, dataArray);
-        /* use timedlock to avoid dead loop when there is screen transition event*/
-        struct timespec timeout = { 0, LV_DISP_DEF_REFR_PERIOD * 1000 * 1000 };
-        int err = pthread_mutex_timedlock(&lvgl_mutex, &timeout);
-        if (0 != err) return;
-        /* display the extern data according to widget type. */
-        switch (user_parm->widget_type)
-        {
-        case GG_LABEL:
-        {
-            if (equal_to_double_max(dataArray[0])) break;
-            if (strcmp(user_parm->varArray[0].varType, "Fixed point number") == 0) {
-                //itoa(dataArray[0], result, 10);
-                sprintf(result, "%d", (int)dataArray[0]);
-            } else if (strcmp(user_parm->varArray[0].varType, "IEEE floating point") == 0) {
-                sprintf(result, "%.2lf", (double)dataArray[0]);
-            } else {
-                break;
-            }
-            lv_label_set_text(user_parm->parentObj, result);
+        if (equal_to_double_max(dataArray[0])) break;
+        if (strcmp(user_parm->varArray[0].varType, "Fixed point number") == 0) {
+            //itoa(dataArray[0], result, 10);
+            sprintf(result, "%d", (int)dataArray[0]);
+        } else if (strcmp(user_parm->varArray[0].varType, "IEEE floating point") == 0) {
+            sprintf(result, "%.2lf", (double)dataArray[0]);
+        } else {
             break;
         }
-        case GG_CHART:
-        {
-            lv_chart_series_t *childObj = NULL;
-            for (int i = 0; i < user_parm->arrayLen; i++) {
-                if (equal_to_double_max(dataArray[i])) continue;
-                childObj = (user_parm->childObjArray)[i];
-                lv_chart_set_next_value(user_parm->parentObj, childObj, (int)dataArray[i]);
-            }
-            lv_chart_refresh(user_parm->parentObj);
-            break;
+        lv_label_set_text(user_parm->parentObj, result);
+        break;
+    }
+    case GG_CHART:
+    {
+        lv_chart_series_t *childObj = NULL;
+        for (int i = 0; i < user_parm->arrayLen; i++) {
+            if (equal_to_double_max(dataArray[i])) continue;
+            childObj = (user_parm->childObjArray)[i];
+            lv_chart_set_next_value(user_parm->parentObj, childObj, (int)dataArray[i]);
         }
-        case GG_BAR:
-        {
-            if (equal_to_double_max(dataArray[0])) break;
-            lv_bar_set_value(user_parm->parentObj, (int)dataArray[0], LV_ANIM_OFF);
-            break;
+        lv_chart_refresh(user_parm->parentObj);
+        break;
+    }
+    case GG_BAR:
+    {
+        if (equal_to_double_max(dataArray[0])) break;
+        lv_bar_set_value(user_parm->parentObj, (int)dataArray[0], LV_ANIM_OFF);
+        break;
+    }
+    case GG_METER:
+    {
+        lv_meter_indicator_t *childObj = NULL;
+        for (int i = 0; i < user_parm->arrayLen; i++) {
+            if (equal_to_double_max(dataArray[i])) continue;
+            childObj = (user_parm->childObjArray)[i];
+            lv_meter_set_indicator_value(user_parm->parentObj, childObj, (int)dataArray[i]);
         }
-        case GG_METER:
-        {
-            lv_meter_indicator_t *childObj = NULL;
-            for (int i = 0; i < user_parm->arrayLen; i++) {
-                if (equal_to_double_max(dataArray[i])) continue;
-                childObj = (user_parm->childObjArray)[i];
-                lv_meter_set_indicator_value(user_parm->parentObj, childObj, (int)dataArray[i]);
-            }
-            break;
+        break;
+    }
+    case GG_ARC:
+    {
+        if (equal_to_double_max(dataArray[0])) break;
+        lv_arc_set_value(user_parm->parentObj, (int)dataArray[0]);
+        break;
+    }
+    case GG_SLIDER:
+    {
+        if (equal_to_double_max(dataArray[0])) break;
+        lv_slider_set_value(user_parm->parentObj, (int)dataArray[0], LV_ANIM_OFF);
+        break;
+    }
+    case GG_SWITCH:
+    {
+        if (equal_to_double_max(dataArray[0])) break;
+        if((int)dataArray[0] == 0 && lv_obj_has_state(user_parm->parentObj, LV_STATE_CHECKED)) {
+            lv_obj_clear_state(user_parm->parentObj, LV_STATE_CHECKED);
         }
-        case GG_ARC:
-        {
-            if (equal_to_double_max(dataArray[0])) break;
-            lv_arc_set_value(user_parm->parentObj, (int)dataArray[0]);
-            break;
+        if((int)dataArray[0] == 1 && !lv_obj_has_state(user_parm->parentObj, LV_STATE_CHECKED)) {
+            lv_obj_add_state(user_parm->parentObj, LV_STATE_CHECKED);
         }
-        case GG_SLIDER:
-        {
-            if (equal_to_double_max(dataArray[0])) break;
-            lv_slider_set_value(user_parm->parentObj, (int)dataArray[0], LV_ANIM_OFF);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/* store the values read for a widget, call it with fm_snapshot_mutex locked */
+static void snapshot_push(readVariableParm *param, const double *dataArray)
+{
+    fm_snapshot_t *entry = NULL;
+    for (int i = 0; i < fm_snapshot_cnt; i++) {
+        if (fm_snapshot[i].param == param) {
+            entry = &fm_snapshot[i];
             break;
         }
-        case GG_SWITCH:
-        {
-            if (equal_to_double_max(dataArray[0])) break;
-            if((int)dataArray[0] == 0 && lv_obj_has_state(user_parm->parentObj, LV_STATE_CHECKED)) {
-                lv_obj_clear_state(user_parm->parentObj, LV_STATE_CHECKED);
-            }
-            if((int)dataArray[0] == 1 && !lv_obj_has_state(user_parm->parentObj, LV_STATE_CHECKED)) {
-                lv_obj_add_state(user_parm->parentObj, LV_STATE_CHECKED);
-            }
-            break;
+    }
+    if (entry == NULL) {
+        if (fm_snapshot_cnt == fm_snapshot_size) {
+            int new_size = fm_snapshot_size ? fm_snapshot_size * 2 : 16;
+            fm_snapshot_t *new_snapshot = realloc(fm_snapshot, new_size * sizeof(fm_snapshot_t));
+            if (new_snapshot == NULL) return;
+            fm_snapshot = new_snapshot;
+            fm_snapshot_size = new_size;
         }
-        default:
-            break;
+        double *samples = malloc(FM_SNAPSHOT_DEPTH * param->arrayLen * sizeof(double));
+        if (samples == NULL) return;
+        entry = &fm_snapshot[fm_snapshot_cnt++];
+        entry->param = param;
+        entry->samples = samples;
+        entry->sample_cnt = 0;
+    }
+    /* if the LVGL thread falls behind drop the oldest sample */
+    if (entry->sample_cnt == FM_SNAPSHOT_DEPTH) {
+        memmove(entry->samples, entry->samples + param->arrayLen,
+                (FM_SNAPSHOT_DEPTH - 1) * param->arrayLen * sizeof(double));
+        entry->sample_cnt--;
+    }
+    memcpy(entry->samples + entry->sample_cnt * param->arrayLen, dataArray, param->arrayLen * sizeof(double));
+    entry->sample_cnt++;
+}
+
+/* remember an error to show it from the LVGL thread */
+static void snapshot_error(const char *message)
+{
+    pthread_mutex_lock(&fm_snapshot_mutex);
+    snprintf(fm_snapshot_error, sizeof(fm_snapshot_error), "%s", message);
+    pthread_mutex_unlock(&fm_snapshot_mutex);
+}
+
+static void snapshot_apply_timer_cb(lv_timer_t *timer)
+{
+    LV_UNUSED(timer);
+    pthread_mutex_lock(&fm_snapshot_mutex);
+    for (int i = 0; i < fm_snapshot_cnt; i++) {
+        fm_snapshot_t *entry = &fm_snapshot[i];
+        if (entry->sample_cnt == 0) continue;
+        /* a chart shows every sample, the others only the latest one */
+        int first = (entry->param->widget_type == GG_CHART) ? 0 : entry->sample_cnt - 1;
+        for (int s = first; s < entry->sample_cnt; s++) {
+            apply_values(entry->param, entry->samples + s * entry->param->arrayLen);
         }
-        pthread_mutex_unlock(&lvgl_mutex);
+        entry->sample_cnt = 0;
     }
-    return;
+    if (fm_snapshot_error[0] != '\0') {
+        message_display(fm_snapshot_error);
+        fm_snapshot_error[0] = '\0';
+    }
+    pthread_mutex_unlock(&fm_snapshot_mutex);
+}
+
+void freemaster_apply_init(void)
+{
+    lv_timer_create(snapshot_apply_timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+}
+
+void freemaster_snapshot_drop(lv_obj_t *screen)
+{
+    pthread_mutex_lock(&fm_snapshot_mutex);
+    int cnt = 0;
+    for (int i = 0; i < fm_snapshot_cnt; i++) {
+        if (fm_snapshot[i].param->screen == screen) {
+            free(fm_snapshot[i].samples);
+        } else {
+            fm_snapshot[cnt++] = fm_snapshot[i];
+        }
+    }
+    fm_snapshot_cnt = cnt;
+    pthread_mutex_unlock(&fm_snapshot_mutex);
+}
+
+void freeMasterParse(void *param)
+{
+    freeMasterParseBatch(&param, 1);
+}
+
+void freeMasterParseBatch(void **params, uint32_t cnt)
+{
+    /* read the variables of every widget with one round trip */
+    int var_cnt = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        readVariableParm *user_parm = params[i];
+        if (strcmp(user_parm->apiName, "ReadVariable") == 0) var_cnt += user_parm->arrayLen;
+    }
+    if (var_cnt == 0) return;
+
+    fm_var *varArray = malloc(var_cnt * sizeof(fm_var));
+    double *dataArray = malloc(var_cnt * sizeof(double));
+    if (varArray == NULL || dataArray == NULL) {
+        free(varArray);
+        free(dataArray);
+        return;
+    }
+    int ofs = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        readVariableParm *user_parm = params[i];
+        if (strcmp(user_parm->apiName, "ReadVariable") != 0) continue;
+        memcpy(varArray + ofs, user_parm->varArray, user_parm->arrayLen * sizeof(fm_var));
+        ofs += user_parm->arrayLen;
+    }
+    read_variables(varArray, var_cnt, dataArray);
+
+    /* the LVGL thread shows them before the next refresh */
+    pthread_mutex_lock(&fm_snapshot_mutex);
+    ofs = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        readVariableParm *user_parm = params[i];
+        if (strcmp(user_parm->apiName, "ReadVariable") != 0) continue;
+        snapshot_push(user_parm, dataArray + ofs);
+        ofs += user_parm->arrayLen;
+    }
+    pthread_mutex_unlock(&fm_snapshot_mutex);
+
+    free(varArray);
+    free(dataArray);
 }
 
 void message_display(char *message)
@@ -131,10 +265,12 @@ json_t * callAPI(char *params, char* method_name)
     json_t *json_obj;
 
     /* try to connect*/
+    pthread_mutex_lock(&fm_ws_mutex);
     if (ws_connect == NULL) {
         connect_init();
     }
     if (ws_connect == NULL) {
+        pthread_mutex_unlock(&fm_ws_mutex);
         message_display("websocket connect failed.");
         return NULL;
     }
@@ -143,6 +279,7 @@ json_t * callAPI(char *params, char* method_name)
     snprintf(request_data, 500, "\"method\": \"%s\", \"params\": [%s]", method_name, params);
     /* get the json data from FreeMaster server JSONRPC with websocket.*/
     char * origin_response = websocket_request(ws_connect, request_data);
+    pthread_mutex_unlock(&fm_ws_mutex);
     if (origin_response == NULL)
     {
         fprintf(stderr, "No data returned from jsonrpc server.\n");
@@ -164,9 +301,40 @@ json_t * callAPI(char *params, char* method_name)
     return json_obj;
 }
 
+/* get the value of a ReadVariable response, DBL_MAX if it failed */
+static double parse_read_result(json_t *result_json, fm_var *var, char *error_message, size_t error_size)
+{
+    int success = 0, retval = 0, errorCode = 0;
+    double data = DBL_MAX;
+    double value = DBL_MAX;
+    char *id, *dataFormatted = NULL, *errorMessage = NULL;
+    json_error_t error;
+    int res = json_unpack_ex(result_json, &error, 0, "{s:s, s:{s:b, s?F, s:{s:b, s?:s}, s?{s:i, s:s}}}",
+        "id", &id, "result", "success", &success, "data", &data,
+        "xtra", "retval", &retval, "formatted", &dataFormatted,
+        "error", "code", &errorCode, "msg", &errorMessage);
+    if (res == -1) {
+        fprintf(stderr, "Failed to parse json: %s\n", error.text);
+    }
+
+    if (!success) {
+        if (errorMessage != NULL) {
+            fprintf(stderr, "%s\n", errorMessage);
+            snprintf(error_message, error_size, "%s", errorMessage);
+        }
+    } else if (strcmp(var->varType, "Fixed point number") == 0) {
+        if (dataFormatted != NULL) value = (double)atoi(dataFormatted);
+    } else if (strcmp(var->varType, "IEEE floating point") == 0) {
+        value = (double)data;
+    }
+    json_decref(result_json);
+    return value;
+}
+
 void read_variable(fm_var * varArray, int arrayLen, double* dataArray) {
     json_t *result_json;
     char rpcParams[50];
+    char errorMessage[128];
     for (int i = 0; i < arrayLen; i++)
     {
         char *variable_name = varArray[i].varName;
@@ -176,30 +344,62 @@ void read_variable(fm_var * varArray, int arrayLen, double* dataArray) {
             dataArray[i] = DBL_MAX;
             continue;
         }
-        int success = 0, retval = 0, errorCode = 0;
-        double data = DBL_MAX;
-        char *id, *dataFormatted, *errorMessage;
-        json_error_t error;
-        int res = json_unpack_ex(result_json, &error, 0, "{s:s, s:{s:b, s?F, s:{s:b, s?:s}, s?{s:i, s:s}}}",
-            "id", &id, "result", "success", &success, "data", &data,
-            "xtra", "retval", &retval, "formatted", &dataFormatted,
-            "error", "code", &errorCode, "msg", &errorMessage);
-        if (res == -1) {
-            fprintf(stderr, "Failed to parse json: %s\n", error.text);
-        }
+        errorMessage[0] = '\0';
+        dataArray[i] = parse_read_result(result_json, &varArray[i], errorMessage, sizeof(errorMessage));
+        if (errorMessage[0] != '\0') message_display(errorMessage);
+    }
+}
 
-        if (!success) {
-            fprintf(stderr, "%s\n", errorMessage);
-            message_display(errorMessage);
+void read_variables(fm_var * varArray, int arrayLen, double* dataArray) {
+    char **requests = malloc(arrayLen * sizeof(char *));
+    char **responses = malloc(arrayLen * sizeof(char *));
+    char *requestData = malloc(arrayLen * 500);
+    char errorMessage[128] = "";
+    int i;
+
+    for (i = 0; i < arrayLen; i++) dataArray[i] = DBL_MAX;
+    if (requests == NULL || responses == NULL || requestData == NULL) goto out;
+
+    for (i = 0; i < arrayLen; i++) {
+        requests[i] = requestData + i * 500;
+        snprintf(requests[i], 500, "\"method\": \"ReadVariable\", \"params\": [\"%s\"]", varArray[i].varName);
+    }
+
+    /* try to connect*/
+    pthread_mutex_lock(&fm_ws_mutex);
+    if (ws_connect == NULL) {
+        connect_init();
+    }
+    if (ws_connect == NULL) {
+        pthread_mutex_unlock(&fm_ws_mutex);
+        snapshot_error("websocket connect failed.");
+        goto out;
+    }
+    int received = websocket_request_batch(ws_connect, requests, arrayLen, responses);
+    pthread_mutex_unlock(&fm_ws_mutex);
+    if (received < arrayLen) {
+        fprintf(stderr, "No data returned from jsonrpc server for %d variables.\n", arrayLen - LV_MAX(received, 0));
+        snapshot_error("No data returned from jsonrpc server.\n");
+    }
+
+    for (i = 0; i < arrayLen; i++) {
+        if (received < 0 || responses[i] == NULL) continue;
+
+        json_error_t error;
+        json_t *result_json = json_loads(responses[i], 0, &error);
+        free(responses[i]);
+        if (result_json == NULL) {
+            fprintf(stderr, "Failed to decode json: %s\n", error.text);
             continue;
         }
-        if (strcmp(varArray[i].varType, "Fixed point number") == 0) {
-            dataArray[i] = (double)atoi(dataFormatted);
-        } else if (strcmp(varArray[i].varType, "IEEE floating point") == 0) {
-            dataArray[i] = (double)data;
-        }
-        json_decref(result_json);
+        dataArray[i] = parse_read_result(result_json, &varArray[i], errorMessage, sizeof(errorMessage));
     }
+    if (errorMessage[0] != '\0') snapshot_error(errorMessage);
+
+out:
+    free(requests);
+    free(responses);
+    free(requestData);
 }
 
 void write_variable(char *varName, int value) {
@@ -19,6 +19,11 @@
 #include "gg_external_data.h"
 #include <pthread.h>
 
+/* Number of reads kept for a widget until the LVGL thread shows them */
+#ifndef FM_SNAPSHOT_DEPTH
+#define FM_SNAPSHOT_DEPTH 8
+#endif
+
 typedef struct  {
    char * varName;
    char * varType;
@@ -52,8 +57,32 @@ void connect_init();
 */
 json_t * callAPI(char *params, char* method_name);
 
+/*
+   * Read the variables of a widget. Same as freeMasterParseBatch() with one widget.
+   * @param   {readVariableParm *} params   the widget and its variables.
+*/
 void freeMasterParse(void *params);
 
+/*
+   * Read the variables of several widgets with one round trip and store the values.
+   * They are shown by the timer of freemaster_apply_init() in the LVGL thread.
+   * @param   {readVariableParm **} params   the widgets and their variables.
+   * @param   {uint32_t} cnt   the number of widgets.
+*/
+void freeMasterParseBatch(void **params, uint32_t cnt);
+
+/*
+   * Create the timer which shows the values read since its last run on the widgets.
+   * Call it in the LVGL thread after the display is registered, so it runs before the refresh.
+*/
+void freemaster_apply_init(void);
+
+/*
+   * Forget the values read for the widgets of a screen, e.g. before it's deleted.
+   * @param   {lv_obj_t *} screen   the screen.
+*/
+void freemaster_snapshot_drop(lv_obj_t *screen);
+
 /*
    * Show the freeMaster except info based on the LVGL msgbox widget.
    * @param   {char*} params  For show the message box info.
@@ -66,6 +95,14 @@ void message_display(char *message);
 */
 void read_variable(fm_var * varArray, int arrayLen, double* dataArray);
 
+/*
+   * Read several variables with one round trip: the requests are sent back to back.
+   * @param   {fm_var *} varArray   the binding variables.
+   * @param   {int} arrayLen   the number of variables.
+   * @param   {double *} dataArray   the values, DBL_MAX if a read failed.
+*/
+void read_variables(fm_var * varArray, int arrayLen, double* dataArray);
+
 /*
    * @param   {char} variable_name   the binding variable name.
    * @param   {int} value Value to be written.
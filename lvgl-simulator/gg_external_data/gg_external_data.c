@@ -13,18 +13,192 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include "lv_ll.h"
 #include "gg_external_data.h"
 #include "freemaster_client.h"
 #include <pthread.h>
 
 #if LV_USE_FREEMASTER
-/* Define a global variables */
-lv_ll_t GG_EDATA_TASK_LN;
+#define GG_EDATA_NOT_IN_HEAP UINT32_MAX
+
+/* Tasks waiting for their deadline, a min-heap by next_time */
+static gg_edata_task_t ** gg_edata_heap;
+static uint32_t gg_edata_heap_cnt;
+static uint32_t gg_edata_heap_size;
+
+/* Tasks run by each worker */
+static gg_edata_task_t * gg_edata_running[GG_EDATA_WORKER_NUM][GG_EDATA_BATCH_MAX];
+static uint32_t gg_edata_running_cnt[GG_EDATA_WORKER_NUM];
+static pthread_t gg_edata_worker[GG_EDATA_WORKER_NUM];
+
+/* The tasks with this callback are run in batches */
+static gg_edata_task_cb_t gg_edata_batch_task_cb;
+static gg_edata_batch_cb_t gg_edata_batch_cb;
+
+/* Signalled if the earliest deadline changed */
+static pthread_cond_t gg_edata_sched_cond;
+/* Signalled if a deleted task finished its callback */
+static pthread_cond_t gg_edata_done_cond;
+static bool gg_edata_inited = false;
 
 extern pthread_mutex_t gg_edata_ll_mutex;
-extern pthread_cond_t gg_edata_ll_cond;
-bool gg_edata_ll_changed = false;
+
+static void heap_set(uint32_t index, gg_edata_task_t * task)
+{
+    gg_edata_heap[index] = task;
+    task->heap_index = index;
+}
+
+static void heap_sift_up(uint32_t index)
+{
+    gg_edata_task_t * task = gg_edata_heap[index];
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (gg_edata_heap[parent]->next_time <= task->next_time) break;
+        heap_set(index, gg_edata_heap[parent]);
+        index = parent;
+    }
+    heap_set(index, task);
+}
+
+static void heap_sift_down(uint32_t index)
+{
+    gg_edata_task_t * task = gg_edata_heap[index];
+    while (true) {
+        uint32_t child = index * 2 + 1;
+        if (child >= gg_edata_heap_cnt) break;
+        if (child + 1 < gg_edata_heap_cnt && gg_edata_heap[child + 1]->next_time < gg_edata_heap[child]->next_time) {
+            child++;
+        }
+        if (task->next_time <= gg_edata_heap[child]->next_time) break;
+        heap_set(index, gg_edata_heap[child]);
+        index = child;
+    }
+    heap_set(index, task);
+}
+
+static bool heap_insert(gg_edata_task_t * task)
+{
+    if (gg_edata_heap_cnt == gg_edata_heap_size) {
+        uint32_t new_size = gg_edata_heap_size ? gg_edata_heap_size * 2 : 16;
+        gg_edata_task_t ** new_heap = realloc(gg_edata_heap, new_size * sizeof(gg_edata_task_t *));
+        if (new_heap == NULL) return false;
+        gg_edata_heap = new_heap;
+        gg_edata_heap_size = new_size;
+    }
+    heap_set(gg_edata_heap_cnt, task);
+    gg_edata_heap_cnt++;
+    heap_sift_up(task->heap_index);
+    return true;
+}
+
+static void heap_remove(gg_edata_task_t * task)
+{
+    uint32_t index = task->heap_index;
+    gg_edata_task_t * last = gg_edata_heap[--gg_edata_heap_cnt];
+    task->heap_index = GG_EDATA_NOT_IN_HEAP;
+    if (last == task) return;
+
+    heap_set(index, last);
+    if (index > 0 && gg_edata_heap[(index - 1) / 2]->next_time > last->next_time) {
+        heap_sift_up(index);
+    } else {
+        heap_sift_down(index);
+    }
+}
+
+/* Return true if a worker is running a deleted task which isn't the caller itself */
+static bool deleted_task_running(void)
+{
+    int i;
+    uint32_t j;
+    for (i = 0; i < GG_EDATA_WORKER_NUM; i++) {
+        if (pthread_equal(gg_edata_worker[i], pthread_self())) continue;
+        for (j = 0; j < gg_edata_running_cnt[i]; j++) {
+            if (gg_edata_running[i][j]->deleted) return true;
+        }
+    }
+    return false;
+}
+
+static void * gg_edata_worker_exec(void * arg)
+{
+    int id = (int)(intptr_t)arg;
+
+    pthread_mutex_lock(&gg_edata_ll_mutex);
+    while (true) {
+        /* always check the heap. After screen transition, old screen is
+         * deleted and new screen may have NO external data task
+         */
+        if (gg_edata_heap_cnt == 0) {
+            #ifdef DEBUG
+            fprintf(stdout, "External data: wait for task...\n");
+            #endif
+            pthread_cond_wait(&gg_edata_sched_cond, &gg_edata_ll_mutex);
+            continue;
+        }
+
+        /* sleep until the earliest deadline, or until an earlier one is added */
+        gg_edata_task_t * task = gg_edata_heap[0];
+        uint64_t now = gg_get_us_time();
+        if (task->next_time > now) {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            uint64_t ns = (uint64_t)ts.tv_nsec + (task->next_time - now) * 1000;
+            ts.tv_sec += ns / 1000000000;
+            ts.tv_nsec = ns % 1000000000;
+            pthread_cond_timedwait(&gg_edata_sched_cond, &gg_edata_ll_mutex, &ts);
+            continue;
+        }
+
+        /* take the tasks of the same batch callback which are due soon too */
+        gg_edata_task_t ** batch = gg_edata_running[id];
+        gg_edata_batch_cb_t batch_cb = (task->cb == gg_edata_batch_task_cb) ? gg_edata_batch_cb : NULL;
+        uint32_t cnt = 0;
+        uint32_t i;
+        heap_remove(task);
+        batch[cnt++] = task;
+        while (batch_cb && cnt < GG_EDATA_BATCH_MAX && gg_edata_heap_cnt > 0 &&
+               gg_edata_heap[0]->cb == task->cb &&
+               gg_edata_heap[0]->next_time <= now + GG_EDATA_BATCH_WINDOW * 1000) {
+            batch[cnt] = gg_edata_heap[0];
+            heap_remove(batch[cnt]);
+            cnt++;
+        }
+        gg_edata_running_cnt[id] = cnt;
+
+        /* run the callback without the lock so the others can be scheduled meanwhile */
+        void * params[GG_EDATA_BATCH_MAX];
+        for (i = 0; i < cnt; i++) {
+            params[i] = batch[i]->param;
+        }
+        pthread_mutex_unlock(&gg_edata_ll_mutex);
+
+        if (batch_cb) {
+            batch_cb(params, cnt);
+        } else {
+            task->cb(task->param);
+        }
+
+        pthread_mutex_lock(&gg_edata_ll_mutex);
+        gg_edata_running_cnt[id] = 0;
+        for (i = 0; i < cnt; i++) {
+            task = batch[i];
+            if (task->deleted) {
+                free(task);
+                pthread_cond_broadcast(&gg_edata_done_cond);
+                continue;
+            }
+            task->last_time = now / 1000;
+            task->next_time = now + (uint64_t)task->period * 1000;
+            if (!heap_insert(task)) {
+                fprintf(stderr, "External data: failed to reschedule task.\n");
+                free(task);
+            }
+        }
+    }
+
+    return NULL;
+}
 
 uint64_t gg_get_us_time() {
     struct timespec ts;
@@ -54,7 +228,19 @@ void gg_nanosleep(int ns) {
 }
 
 void gg_edata_task_init(void) {
-    _lv_ll_init(&GG_EDATA_TASK_LN, sizeof(gg_edata_task_t));
+    if (gg_edata_inited) return;
+
+    /* the deadlines are on the monotonic clock */
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gg_edata_sched_cond, &attr);
+    pthread_cond_init(&gg_edata_done_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    gg_edata_inited = true;
+
+    /* the variables due together are read with one round trip */
+    gg_edata_task_set_batch_cb(freeMasterParse, freeMasterParseBatch);
 }
 
 void gg_edata_task_clear(lv_obj_t * act_scr) {
@@ -62,23 +248,40 @@ void gg_edata_task_clear(lv_obj_t * act_scr) {
     fprintf(stdout, "External data: clear task list...\n");
     #endif
     pthread_mutex_lock(&gg_edata_ll_mutex);
-    //_lv_ll_clear(&GG_EDATA_TASK_LN);
-    gg_edata_task_t * head;
-    head = _lv_ll_get_head(&GG_EDATA_TASK_LN);
-    while (head) {
-        bool task_deleted = false;
-        readVariableParm *param = head->param;
+    /* drop the waiting tasks of the screen and rebuild the heap in O(n) */
+    uint32_t i;
+    uint32_t cnt = 0;
+    for (i = 0; i < gg_edata_heap_cnt; i++) {
+        gg_edata_task_t * task = gg_edata_heap[i];
+        readVariableParm *param = task->param;
         if (param->screen == act_scr) {
-            task_deleted = true;
-            gg_edata_ll_changed = true;
-            _lv_ll_remove(&GG_EDATA_TASK_LN, head);
+            free(task);
+        } else {
+            heap_set(cnt++, task);
         }
-        if(task_deleted)
-            head = _lv_ll_get_head(&GG_EDATA_TASK_LN);
-        else
-            head = _lv_ll_get_next(&GG_EDATA_TASK_LN, head);
+    }
+    gg_edata_heap_cnt = cnt;
+    for (i = cnt / 2; i > 0; i--) {
+        heap_sift_down(i - 1);
+    }
+
+    /* the running ones are freed by their worker */
+    for (i = 0; i < GG_EDATA_WORKER_NUM; i++) {
+        uint32_t j;
+        for (j = 0; j < gg_edata_running_cnt[i]; j++) {
+            gg_edata_task_t * task = gg_edata_running[i][j];
+            if (((readVariableParm *)task->param)->screen == act_scr) {
+                task->deleted = true;
+            }
+        }
+    }
+    while (deleted_task_running()) {
+        pthread_cond_wait(&gg_edata_done_cond, &gg_edata_ll_mutex);
     }
     pthread_mutex_unlock(&gg_edata_ll_mutex);
+
+    /* forget the values read for the widgets of the screen */
+    freemaster_snapshot_drop(act_scr);
     #ifdef DEBUG
     fprintf(stdout, "External data: clear task list [Done]\n");
     #endif
@@ -86,56 +289,70 @@ void gg_edata_task_clear(lv_obj_t * act_scr) {
 
 gg_edata_task_t * gg_edata_task_create(uint32_t period, gg_edata_task_cb_t cb, void * param)
 {
+    gg_edata_task_t * new_task = malloc(sizeof(gg_edata_task_t));
+    if (new_task == NULL) return NULL;
+
+    new_task->last_time = 0;
+    new_task->next_time = gg_get_us_time();
+    new_task->period = period;
+    new_task->cb = cb;
+    new_task->param = param;
+    new_task->deleted = false;
+
     pthread_mutex_lock(&gg_edata_ll_mutex);
-    gg_edata_task_t * new_task = NULL;
-    new_task = _lv_ll_ins_head(&GG_EDATA_TASK_LN);
-    if(new_task != NULL) {
-        new_task->last_time = 0;
-        new_task->period = period;
-        new_task->cb = cb;
-        new_task->param = param;
-        gg_edata_ll_changed = true;
-        pthread_cond_signal(&gg_edata_ll_cond);
-        #ifdef DEBUG
-        fprintf(stdout, "External data: create new task.\n");
-        #endif
+    if (!heap_insert(new_task)) {
+        free(new_task);
+        new_task = NULL;
+    } else if (new_task->heap_index == 0) {
+        /* it's due now, wake up a worker */
+        pthread_cond_signal(&gg_edata_sched_cond);
     }
+    #ifdef DEBUG
+    if (new_task) fprintf(stdout, "External data: create new task.\n");
+    #endif
     pthread_mutex_unlock(&gg_edata_ll_mutex);
     return new_task;
 }
 
-void *gg_edata_task_exec()
+void gg_edata_task_del(gg_edata_task_t * task)
 {
-    gg_edata_task_t * head;
-    head = _lv_ll_get_head(&GG_EDATA_TASK_LN);
-    while(true){
-        pthread_mutex_lock(&gg_edata_ll_mutex);
-        /* always check the link. After screen transition, old screen is
-         * deleted and new screen may have NO external data task
-         */
-        while (_lv_ll_is_empty(&GG_EDATA_TASK_LN)) {
-            #ifdef DEBUG
-            fprintf(stdout, "External data: wait for task...\n");
-            #endif
-            /*no task, wait for signal and release the lock*/
-            pthread_cond_wait(&gg_edata_ll_cond, &gg_edata_ll_mutex);
-        }
-        if (gg_edata_ll_changed || head == NULL) {
-            head = _lv_ll_get_head(&GG_EDATA_TASK_LN);
-        } else {
-            head = _lv_ll_get_next(&GG_EDATA_TASK_LN, head);
+    pthread_mutex_lock(&gg_edata_ll_mutex);
+    if (task->heap_index != GG_EDATA_NOT_IN_HEAP) {
+        heap_remove(task);
+        free(task);
+    } else {
+        task->deleted = true;
+        while (deleted_task_running()) {
+            pthread_cond_wait(&gg_edata_done_cond, &gg_edata_ll_mutex);
         }
-        if(head != NULL) {
-            gg_edata_ll_changed = false;
-            uint64_t currentTime = gg_get_ms_time();
-            uint64_t realExecTime = (head->period) + (head->last_time);
-            if(head->last_time == 0 || currentTime > realExecTime) {
-                head->cb(head->param);
-                head->last_time = currentTime;
-            }
+    }
+    pthread_mutex_unlock(&gg_edata_ll_mutex);
+}
+
+void gg_edata_task_set_batch_cb(gg_edata_task_cb_t cb, gg_edata_batch_cb_t batch_cb)
+{
+    pthread_mutex_lock(&gg_edata_ll_mutex);
+    gg_edata_batch_task_cb = cb;
+    gg_edata_batch_cb = batch_cb;
+    pthread_mutex_unlock(&gg_edata_ll_mutex);
+}
+
+void *gg_edata_task_exec()
+{
+    int i;
+
+    /* this thread is the first worker, the ids are read under the lock */
+    pthread_mutex_lock(&gg_edata_ll_mutex);
+    gg_edata_worker[0] = pthread_self();
+    for (i = 1; i < GG_EDATA_WORKER_NUM; i++) {
+        if (pthread_create(&gg_edata_worker[i], NULL, gg_edata_worker_exec, (void *)(intptr_t)i) != 0) {
+            fprintf(stderr, "External data: failed to create worker %d.\n", i);
+            break;
         }
-        pthread_mutex_unlock(&gg_edata_ll_mutex);
-        gg_nanosleep(100);
+        pthread_detach(gg_edata_worker[i]);
     }
+    pthread_mutex_unlock(&gg_edata_ll_mutex);
+
+    return gg_edata_worker_exec((void *)(intptr_t)0);
 }
 #endif
@@ -11,16 +11,36 @@
 #define GG_EXTERNAL_DATA_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "lvgl.h"
 
+/* Number of threads running the task callbacks, including the one of gg_edata_task_exec() */
+#ifndef GG_EDATA_WORKER_NUM
+#define GG_EDATA_WORKER_NUM 2
+#endif
+
+/* Tasks of a batch callback which are due within this many ms are run together */
+#ifndef GG_EDATA_BATCH_WINDOW
+#define GG_EDATA_BATCH_WINDOW 5
+#endif
+
+/* Max number of tasks in a batch */
+#ifndef GG_EDATA_BATCH_MAX
+#define GG_EDATA_BATCH_MAX 16
+#endif
+
 typedef void (*gg_edata_task_cb_t)(void * param);
+typedef void (*gg_edata_batch_cb_t)(void ** params, uint32_t cnt);
 
 typedef struct _gg_edata_task_t
 {
-    uint64_t last_time;
+    uint64_t last_time;     /* start of the last run in ms, 0 if it didn't run yet */
+    uint64_t next_time;     /* deadline of the next run in us */
     uint32_t period;
     gg_edata_task_cb_t cb;
     void * param;
+    uint32_t heap_index;    /* position in the deadline heap, UINT32_MAX while running */
+    bool deleted;           /* freed by the worker when its callback returns */
 } gg_edata_task_t;
 
 enum gg_widget_type {
@@ -55,7 +75,9 @@ void gg_nanosleep(int ns);
 void gg_edata_task_init(void);
 
 /**
- * clear edata task linked list, The list remain valid but become empty.
+ * delete the edata tasks of a screen.
+ * When it returns none of their callbacks is running.
+ * @param act_scr the screen whose tasks are deleted
  */
 void gg_edata_task_clear(lv_obj_t * act_scr);
 
@@ -69,7 +91,23 @@ void gg_edata_task_clear(lv_obj_t * act_scr);
 gg_edata_task_t * gg_edata_task_create(uint32_t period, gg_edata_task_cb_t cb, void * param);
 
 /**
- * routine which will be executed in a new thread
+ * Delete an edata task in O(log n).
+ * When it returns the callback isn't running, unless it's called from the callback itself.
+ * @param task pointer to the task
+ */
+void gg_edata_task_del(gg_edata_task_t * task);
+
+/**
+ * Run the tasks of a callback in batches: the ones due within GG_EDATA_BATCH_WINDOW
+ * are passed to one call of `batch_cb` instead of calling `cb` for each.
+ * @param cb the callback of the tasks to batch
+ * @param batch_cb called with the parameters of the tasks of a batch, NULL to not batch
+ */
+void gg_edata_task_set_batch_cb(gg_edata_task_cb_t cb, gg_edata_batch_cb_t batch_cb);
+
+/**
+ * routine which will be executed in a new thread.
+ * It starts the other workers and runs the tasks when their deadline comes.
  */
 void *gg_edata_task_exec();
 
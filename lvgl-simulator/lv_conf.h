@@ -175,6 +175,10 @@
 #define LV_GPU_SDL_INCLUDE_PATH <SDL2/SDL.h>
 /*Texture cache size, 8MB by default*/
 #define LV_GPU_SDL_LRU_SIZE (1024 * 1024 * 8)
+/*Width and height of the textures glyphs are packed into, 0 to use a texture per glyph*/
+#define LV_GPU_SDL_ATLAS_SIZE 512
+/*Maximal number of atlas textures of a pixel format*/
+#define LV_GPU_SDL_ATLAS_MAX_CNT 4
 /*Custom blend mode for mask drawing, disable if you need to link with older SDL2 lib*/
 #define LV_GPU_SDL_CUSTOM_BLEND_MODE (SDL_VERSION_ATLEAST(2, 0, 6))
 #endif    /* LV_USE_GPU_SDL */
@@ -497,6 +501,8 @@
 
 #define LV_USE_CHART 1
 
+#define LV_USE_STREAMCHART 1
+
 #define LV_USE_COLORWHEEL 1
 
 #define LV_USE_DCLOCK 1
@@ -509,6 +515,8 @@
 
 #define LV_USE_LIST 1
 
+#define LV_USE_VLIST 1
+
 #define LV_USE_MENU 1
 
 #define LV_USE_METER 1
@@ -25,6 +25,8 @@
 
 #if LV_USE_FREEMASTER
 #include "external_data_init.h"
+#include "freemaster_client.h"
+#include "gg_external_data.h"
 #endif
 
 /*********************
@@ -78,6 +80,8 @@ int main(int argc, char ** argv)
 #if LV_USE_FREEMASTER
     pthread_mutex_init(&gg_edata_ll_mutex, NULL);
     pthread_cond_init(&gg_edata_ll_cond, NULL);
+    /*Set up the task scheduler before any task is added*/
+    gg_edata_task_init();
     /*Initialize the external data */
     external_task_init(&guider_ui);
 #endif
@@ -86,6 +90,8 @@ int main(int argc, char ** argv)
     setup_ui(&guider_ui);
 	custom_init(&guider_ui);
 #if LV_USE_FREEMASTER
+    /*Show the read values on the widgets before each refresh*/
+    freemaster_apply_init();
     pthread_mutex_init(&jsonrpc_mutex, NULL);
     pthread_mutex_init(&lvgl_mutex, NULL);
     memset(&thread, 0, sizeof(thread));
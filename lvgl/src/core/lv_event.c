@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "../extra/others/latency/lv_latency.h"
 
 /*********************
  *      DEFINES
@@ -54,6 +55,7 @@ lv_res_t lv_event_send(lv_obj_t * obj, lv_event_code_t event_code, void * param)
     if(obj == NULL) return LV_RES_OK;
 
     LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_LATENCY_EVENT();
 
     lv_event_t e;
     e.target = obj;
@@ -263,6 +265,18 @@ void * lv_obj_get_event_user_data(struct _lv_obj_t * obj, lv_event_cb_t event_cb
     return NULL;
 }
 
+bool lv_obj_has_event_cb(const lv_obj_t * obj, lv_event_code_t code)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    if(obj->spec_attr == NULL) return false;
+
+    int32_t i = 0;
+    for(i = 0; i < obj->spec_attr->event_dsc_cnt; i++) {
+        if((obj->spec_attr->event_dsc[i].filter & ~LV_EVENT_PREPROCESS) == code) return true;
+    }
+    return false;
+}
+
 lv_indev_t * lv_event_get_indev(lv_event_t * e)
 {
 
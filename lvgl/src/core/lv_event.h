@@ -272,6 +272,15 @@ bool lv_obj_remove_event_dsc(struct _lv_obj_t * obj, struct _lv_event_dsc_t * ev
  */
 void * lv_obj_get_event_user_data(struct _lv_obj_t * obj, lv_event_cb_t event_cb);
 
+/**
+ * Tell whether an object has an event handler added specifically for an event.
+ * The handlers added with `LV_EVENT_ALL` are not considered.
+ * @param obj       pointer to an object
+ * @param code      an event code
+ * @return          true: an event handler was added with `code` as filter
+ */
+bool lv_obj_has_event_cb(const struct _lv_obj_t * obj, lv_event_code_t code);
+
 /**
  * Get the input device passed as parameter to indev related events.
  * @param e     pointer to an event
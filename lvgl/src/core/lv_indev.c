@@ -12,6 +12,7 @@
 #include "lv_indev_scroll.h"
 #include "lv_group.h"
 #include "lv_refr.h"
+#include "../extra/others/latency/lv_latency.h"
 
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_timer.h"
@@ -87,6 +88,7 @@ void lv_indev_read_timer_cb(lv_timer_t * timer)
         indev_proc_reset_query_handler(indev_act);
         indev_obj_act = NULL;
 
+        LV_LATENCY_INPUT(indev_act, &data);
         indev_act->proc.state = data.state;
 
         /*Save the last activity time*/
@@ -111,6 +113,7 @@ void lv_indev_read_timer_cb(lv_timer_t * timer)
         }
         /*Handle reset query if it happened in during processing*/
         indev_proc_reset_query_handler(indev_act);
+        LV_LATENCY_INPUT_END();
     } while(continue_reading);
 
     /*End of indev processing, so no act indev*/
@@ -377,6 +380,10 @@ static void indev_pointer_proc(lv_indev_t * i, lv_indev_data_t * data)
     i->proc.types.pointer.act_point.x = data->point.x;
     i->proc.types.pointer.act_point.y = data->point.y;
 
+#if LV_INDEV_SCROLL_PREDICT
+    _lv_indev_scroll_sample(&i->proc, data);
+#endif
+
     if(i->proc.state == LV_INDEV_STATE_PRESSED) {
         indev_proc_press(&i->proc);
     }
@@ -852,6 +859,18 @@ static void indev_proc_press(_lv_indev_proc_t * proc)
         if(indev_reset_check(proc)) return;
     }
 
+#if LV_INDEV_SCROLL_PREDICT
+    /*The momentum of the last throw is an animation. Stop it where it is*/
+    if(new_obj_searched && proc->types.pointer.throw_obj) {
+        lv_obj_t * throw_obj = proc->types.pointer.throw_obj;
+        proc->types.pointer.throw_obj = NULL;
+        if(_lv_obj_scroll_anim_del(throw_obj)) {
+            lv_event_send(throw_obj, LV_EVENT_SCROLL_END, indev_act);
+            if(indev_reset_check(proc)) return;
+        }
+    }
+#endif
+
     /*If a new object was found reset some variables and send a pressed event handler*/
     if(indev_obj_act != proc->types.pointer.act_obj) {
         proc->types.pointer.last_point.x = proc->types.pointer.act_point.x;
@@ -1003,6 +1022,9 @@ static void indev_proc_release(_lv_indev_proc_t * proc)
                 zoom = (256 * 256) / zoom;
                 lv_point_transform(&proc->types.pointer.scroll_throw_vect, angle, zoom, &pivot);
                 lv_point_transform(&proc->types.pointer.scroll_throw_vect_ori, angle, zoom, &pivot);
+#if LV_INDEV_SCROLL_PREDICT
+                lv_point_transform(&proc->types.pointer.velocity, angle, zoom, &pivot);
+#endif
             }
         }
 
@@ -1039,6 +1061,14 @@ static void indev_proc_reset_query_handler(lv_indev_t * indev)
         indev->proc.types.pointer.scroll_throw_vect.y = 0;
         indev->proc.types.pointer.gesture_sum.x     = 0;
         indev->proc.types.pointer.gesture_sum.y     = 0;
+#if LV_INDEV_SCROLL_PREDICT
+        indev->proc.types.pointer.sample_cnt        = 0;
+        indev->proc.types.pointer.velocity.x        = 0;
+        indev->proc.types.pointer.velocity.y        = 0;
+        indev->proc.types.pointer.predict_ofs.x     = 0;
+        indev->proc.types.pointer.predict_ofs.y     = 0;
+        indev->proc.types.pointer.throw_obj         = NULL;
+#endif
         indev->proc.reset_query                     = 0;
         indev_obj_act                               = NULL;
     }
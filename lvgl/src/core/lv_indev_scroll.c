@@ -8,12 +8,24 @@
  *********************/
 #include "lv_indev.h"
 #include "lv_indev_scroll.h"
+#include "lv_disp.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define ELASTIC_SLOWNESS_FACTOR 4   /*Scrolling on elastic parts are slower by this factor*/
 
+#if LV_INDEV_SCROLL_PREDICT
+#define VELOCITY_WINDOW         100000  /*Fit the velocity to the samples of this long [us]*/
+#define VELOCITY_STALE_TIME     40000   /*Without new samples for this long the finger has stopped [us]*/
+#define PREDICT_TIME_MAX        50      /*Extrapolate the finger at most this far in the future [ms]*/
+#define PREDICT_DIST_MAX        40      /*Extrapolate the finger at most this far [dpx]*/
+#define THROW_ANIM_TIME_MIN     100
+#define THROW_ANIM_TIME_MAX     1500
+#define SNAP_ANIM_TIME_MIN      100
+#define SNAP_ANIM_TIME_MAX      400
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,10 +38,20 @@ static void init_scroll_limits(_lv_indev_proc_t * proc);
 static lv_coord_t find_snap_point_x(const lv_obj_t * obj, lv_coord_t min, lv_coord_t max, lv_coord_t ofs);
 static lv_coord_t find_snap_point_y(const lv_obj_t * obj, lv_coord_t min, lv_coord_t max, lv_coord_t ofs);
 static void scroll_limit_diff(_lv_indev_proc_t * proc, lv_coord_t * diff_x, lv_coord_t * diff_y);
+#if LV_INDEV_SCROLL_PREDICT == 0
 static lv_coord_t scroll_throw_predict_y(_lv_indev_proc_t * proc);
 static lv_coord_t scroll_throw_predict_x(_lv_indev_proc_t * proc);
+#endif
 static lv_coord_t elastic_diff(lv_obj_t * scroll_obj, lv_coord_t diff, lv_coord_t scroll_start, lv_coord_t scroll_end,
                                lv_dir_t dir);
+#if LV_INDEV_SCROLL_PREDICT
+static void update_velocity(_lv_indev_proc_t * proc);
+static lv_coord_t predict_dist(lv_coord_t v);
+static lv_coord_t throw_dist(lv_indev_t * indev, lv_coord_t v);
+static uint32_t throw_time(lv_coord_t d, lv_coord_t v);
+static void throw_momentum(_lv_indev_proc_t * proc, lv_obj_t * scroll_obj, lv_dir_t dir);
+static void throw_snap(_lv_indev_proc_t * proc, lv_obj_t * scroll_obj, lv_dir_t dir);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -45,11 +67,29 @@ static lv_coord_t elastic_diff(lv_obj_t * scroll_obj, lv_coord_t diff, lv_coord_
 
 void _lv_indev_scroll_handler(_lv_indev_proc_t * proc)
 {
+    lv_obj_t * scroll_obj = proc->types.pointer.scroll_obj;
+#if LV_INDEV_SCROLL_PREDICT
+    /*With time stamps only the changes are sampled so the velocity isn't updated when the finger stops.
+     *Drop it if there were no samples for a while to scroll back the prediction.*/
+    if(proc->types.pointer.sample_stamped &&
+       lv_tick_elaps(proc->types.pointer.sample_tick) > VELOCITY_STALE_TIME / 1000) {
+        proc->types.pointer.velocity.x = 0;
+        proc->types.pointer.velocity.y = 0;
+    }
+
+    /*Follow the prediction even if the finger hasn't moved since the last read*/
+    if(proc->types.pointer.vect.x == 0 && proc->types.pointer.vect.y == 0) {
+        if(scroll_obj == NULL) return;
+        if(proc->types.pointer.velocity.x == 0 && proc->types.pointer.velocity.y == 0 &&
+           proc->types.pointer.predict_ofs.x == 0 && proc->types.pointer.predict_ofs.y == 0) return;
+    }
+#else
     if(proc->types.pointer.vect.x == 0 && proc->types.pointer.vect.y == 0) {
         return;
     }
+#endif
+
 
-    lv_obj_t * scroll_obj = proc->types.pointer.scroll_obj;
     /*If there is no scroll object yet try to find one*/
     if(scroll_obj == NULL) {
         scroll_obj = find_scroll_obj(proc);
@@ -78,19 +118,31 @@ void _lv_indev_scroll_handler(_lv_indev_proc_t * proc)
         lv_point_transform(&proc->types.pointer.vect, angle, zoom, &pivot);
     }
 
-
+    lv_point_t vect = proc->types.pointer.vect;
+#if LV_INDEV_SCROLL_PREDICT
+    /*Scroll to where the finger will be when the frame is shown.
+     *The earlier prediction is scrolled already so only its change is added.*/
+    lv_point_t predict = {0, 0};
+    if(angle == 0 && zoom == LV_IMG_ZOOM_NONE) {
+        if(proc->types.pointer.scroll_dir == LV_DIR_HOR) predict.x = predict_dist(proc->types.pointer.velocity.x);
+        else predict.y = predict_dist(proc->types.pointer.velocity.y);
+    }
+    vect.x += predict.x - proc->types.pointer.predict_ofs.x;
+    vect.y += predict.y - proc->types.pointer.predict_ofs.y;
+    proc->types.pointer.predict_ofs = predict;
+#endif
 
     lv_coord_t diff_x = 0;
     lv_coord_t diff_y = 0;
     if(proc->types.pointer.scroll_dir == LV_DIR_HOR) {
         lv_coord_t sr = lv_obj_get_scroll_right(scroll_obj);
         lv_coord_t sl = lv_obj_get_scroll_left(scroll_obj);
-        diff_x = elastic_diff(scroll_obj, proc->types.pointer.vect.x, sl, sr, LV_DIR_HOR);
+        diff_x = elastic_diff(scroll_obj, vect.x, sl, sr, LV_DIR_HOR);
     }
     else {
         lv_coord_t st = lv_obj_get_scroll_top(scroll_obj);
         lv_coord_t sb = lv_obj_get_scroll_bottom(scroll_obj);
-        diff_y = elastic_diff(scroll_obj, proc->types.pointer.vect.y, st, sb, LV_DIR_VER);
+        diff_y = elastic_diff(scroll_obj, vect.y, st, sb, LV_DIR_VER);
     }
 
     lv_dir_t scroll_dir = lv_obj_get_scroll_dir(scroll_obj);
@@ -108,6 +160,77 @@ void _lv_indev_scroll_handler(_lv_indev_proc_t * proc)
     proc->types.pointer.scroll_sum.y += diff_y;
 }
 
+#if LV_INDEV_SCROLL_PREDICT
+void _lv_indev_scroll_sample(_lv_indev_proc_t * proc, const lv_indev_data_t * data)
+{
+    _lv_indev_sample_t * samples = proc->types.pointer.samples;
+
+    if(data->state == LV_INDEV_STATE_RELEASED) {
+        if(proc->types.pointer.sample_end || proc->types.pointer.sample_cnt == 0) return;
+        proc->types.pointer.sample_end = 1;
+
+        /*Without time stamps the reads of a still finger are samples too so the fit shows that it stopped.
+         *With time stamps only the changes are sampled so check if the finger stopped before the release.*/
+        if(proc->types.pointer.sample_stamped == 0) return;
+
+        uint32_t age_us;
+        if(data->timestamp_us) {
+            age_us = (uint32_t)data->timestamp_us - samples[proc->types.pointer.sample_cnt - 1].time_us;
+        }
+        else {
+            /*The release can be read only in the next period*/
+            uint32_t period = lv_indev_get_act()->driver->read_timer->period;
+            uint32_t elaps = lv_tick_elaps(proc->types.pointer.sample_tick);
+            age_us = elaps > period ? (elaps - period) * 1000 : 0;
+        }
+
+        if(age_us > VELOCITY_STALE_TIME) {
+            proc->types.pointer.velocity.x = 0;
+            proc->types.pointer.velocity.y = 0;
+        }
+        return;
+    }
+
+    /*A new press*/
+    if(proc->types.pointer.sample_end) {
+        proc->types.pointer.sample_end = 0;
+        proc->types.pointer.sample_cnt = 0;
+        proc->types.pointer.velocity.x = 0;
+        proc->types.pointer.velocity.y = 0;
+        proc->types.pointer.predict_ofs.x = 0;
+        proc->types.pointer.predict_ofs.y = 0;
+    }
+
+    bool stamped = data->timestamp_us != 0;
+    if(proc->types.pointer.sample_cnt == 0) proc->types.pointer.sample_stamped = stamped;
+
+    uint32_t t;
+    if(proc->types.pointer.sample_stamped) {
+        if(stamped == false) return;
+        t = (uint32_t)data->timestamp_us;
+        /*The same frame of the driver is read again*/
+        if(proc->types.pointer.sample_cnt && samples[proc->types.pointer.sample_cnt - 1].time_us == t) return;
+    }
+    else {
+        t = lv_tick_get() * 1000;
+    }
+
+    if(proc->types.pointer.sample_cnt == _LV_INDEV_SAMPLE_CNT) {
+        uint32_t i;
+        for(i = 1; i < _LV_INDEV_SAMPLE_CNT; i++) samples[i - 1] = samples[i];
+        proc->types.pointer.sample_cnt--;
+    }
+
+    _lv_indev_sample_t * s = &samples[proc->types.pointer.sample_cnt];
+    s->point = proc->types.pointer.act_point;
+    s->time_us = t;
+    proc->types.pointer.sample_cnt++;
+    proc->types.pointer.sample_tick = lv_tick_get();
+
+    update_velocity(proc);
+}
+#endif
+
 
 void _lv_indev_scroll_throw_handler(_lv_indev_proc_t * proc)
 {
@@ -126,6 +249,21 @@ void _lv_indev_scroll_throw_handler(_lv_indev_proc_t * proc)
     lv_scroll_snap_t align_x = lv_obj_get_scroll_snap_x(scroll_obj);
     lv_scroll_snap_t align_y = lv_obj_get_scroll_snap_y(scroll_obj);
 
+#if LV_INDEV_SCROLL_PREDICT
+    LV_UNUSED(scroll_throw);
+    /*Continue with the velocity of the finger in one animation. The animations advance with the frames
+     *so it's smooth even if the input is read with a different period.*/
+    if(proc->types.pointer.scroll_dir == LV_DIR_VER) {
+        if(align_y == LV_SCROLL_SNAP_NONE) throw_momentum(proc, scroll_obj, LV_DIR_VER);
+        else throw_snap(proc, scroll_obj, LV_DIR_VER);
+    }
+    else if(proc->types.pointer.scroll_dir == LV_DIR_HOR) {
+        if(align_x == LV_SCROLL_SNAP_NONE) throw_momentum(proc, scroll_obj, LV_DIR_HOR);
+        else throw_snap(proc, scroll_obj, LV_DIR_HOR);
+    }
+    proc->types.pointer.scroll_throw_vect.x = 0;
+    proc->types.pointer.scroll_throw_vect.y = 0;
+#else
     if(proc->types.pointer.scroll_dir == LV_DIR_VER) {
         proc->types.pointer.scroll_throw_vect.x = 0;
         /*If no snapping "throw"*/
@@ -174,6 +312,7 @@ void _lv_indev_scroll_throw_handler(_lv_indev_proc_t * proc)
             lv_obj_scroll_by(scroll_obj, x + diff_x, 0, LV_ANIM_ON);
         }
     }
+#endif
 
     /*Check if the scroll has finished*/
     if(proc->types.pointer.scroll_throw_vect.x == 0 && proc->types.pointer.scroll_throw_vect.y == 0) {
@@ -235,6 +374,10 @@ lv_coord_t lv_indev_scroll_throw_predict(lv_indev_t * indev, lv_dir_t dir)
             return 0;
     }
 
+#if LV_INDEV_SCROLL_PREDICT
+    v = dir == LV_DIR_VER ? indev->proc.types.pointer.velocity.y : indev->proc.types.pointer.velocity.x;
+    return throw_dist(indev, v);
+#else
     lv_coord_t scroll_throw = indev->driver->scroll_throw;
     lv_coord_t sum = 0;
     while(v) {
@@ -243,6 +386,7 @@ lv_coord_t lv_indev_scroll_throw_predict(lv_indev_t * indev, lv_dir_t dir)
     }
 
     return sum;
+#endif
 }
 
 void lv_indev_scroll_get_snap_dist(lv_obj_t * obj, lv_point_t * p)
@@ -578,6 +722,7 @@ static void scroll_limit_diff(_lv_indev_proc_t * proc, lv_coord_t * diff_x, lv_c
 
 
 
+#if LV_INDEV_SCROLL_PREDICT == 0
 static lv_coord_t scroll_throw_predict_y(_lv_indev_proc_t * proc)
 {
     lv_coord_t y = proc->types.pointer.scroll_throw_vect.y;
@@ -608,6 +753,7 @@ static lv_coord_t scroll_throw_predict_x(_lv_indev_proc_t * proc)
     }
     return move;
 }
+#endif
 
 static lv_coord_t elastic_diff(lv_obj_t * scroll_obj, lv_coord_t diff, lv_coord_t scroll_start, lv_coord_t scroll_end,
                                lv_dir_t dir)
@@ -687,4 +833,164 @@ static lv_coord_t elastic_diff(lv_obj_t * scroll_obj, lv_coord_t diff, lv_coord_
     return diff;
 }
 
+#if LV_INDEV_SCROLL_PREDICT
+/**
+ * Fit a line to the recent samples with least squares. Its slope is the velocity.
+ * It's less sensitive to the noise of the touch controller than the difference of the last two samples.
+ * @param proc      pointer to an input device's proc field
+ */
+static void update_velocity(_lv_indev_proc_t * proc)
+{
+    const _lv_indev_sample_t * samples = proc->types.pointer.samples;
+    uint32_t cnt = proc->types.pointer.sample_cnt;
+    uint32_t t_last = samples[cnt - 1].time_us;
+
+    uint32_t first = cnt - 1;
+    while(first > 0 && t_last - samples[first - 1].time_us <= VELOCITY_WINDOW) first--;
+
+    int64_t n = cnt - first;
+    int64_t sum_t = 0;
+    int64_t sum_tt = 0;
+    int64_t sum_x = 0;
+    int64_t sum_y = 0;
+    int64_t sum_tx = 0;
+    int64_t sum_ty = 0;
+    uint32_t i;
+    for(i = first; i < cnt; i++) {
+        /*Relative to the last sample to keep the sums small*/
+        int64_t t = -(int64_t)(t_last - samples[i].time_us);
+        sum_t += t;
+        sum_tt += t * t;
+        sum_x += samples[i].point.x;
+        sum_y += samples[i].point.y;
+        sum_tx += t * samples[i].point.x;
+        sum_ty += t * samples[i].point.y;
+    }
+
+    int64_t den = n * sum_tt - sum_t * sum_t;
+    if(n < 2 || den == 0) {
+        proc->types.pointer.velocity.x = 0;
+        proc->types.pointer.velocity.y = 0;
+        return;
+    }
 
+    /*[px/us] -> [px/s]*/
+    int64_t vx = (n * sum_tx - sum_t * sum_x) * 1000000 / den;
+    int64_t vy = (n * sum_ty - sum_t * sum_y) * 1000000 / den;
+    proc->types.pointer.velocity.x = LV_CLAMP(-LV_COORD_MAX, vx, LV_COORD_MAX);
+    proc->types.pointer.velocity.y = LV_CLAMP(-LV_COORD_MAX, vy, LV_COORD_MAX);
+}
+
+/**
+ * Get how much the finger moves until the next frame is shown
+ * @param v         velocity of the finger [px/s]
+ * @return          the distance to add to the scrolling
+ */
+static lv_coord_t predict_dist(lv_coord_t v)
+{
+    if(v == 0) return 0;
+
+    /*The next refresh renders as long as the last one*/
+    lv_disp_t * disp = lv_indev_get_act()->driver->disp;
+    uint32_t t = disp->last_refr_time;
+    lv_timer_t * refr_timer = _lv_disp_get_refr_timer(disp);
+    if(refr_timer) {
+        uint32_t elaps = lv_tick_elaps(refr_timer->last_run);
+        if(elaps < refr_timer->period) t += refr_timer->period - elaps;
+    }
+    if(t > PREDICT_TIME_MAX) t = PREDICT_TIME_MAX;
+
+    /*Don't let the content run away if the finger stops suddenly*/
+    lv_coord_t max = lv_disp_dpx(disp, PREDICT_DIST_MAX);
+    int32_t d = (int32_t)v * (int32_t)t / 1000;
+    return LV_CLAMP(-max, d, max);
+}
+
+/**
+ * Get the distance of a throw. It's the same as the sum of the slowing moves of
+ * `scroll_throw` in every read period but without their rounding.
+ * @param indev     pointer to an input device
+ * @param v         velocity of the throw [px/s]
+ * @return          distance of the throw
+ */
+static lv_coord_t throw_dist(lv_indev_t * indev, lv_coord_t v)
+{
+    uint32_t scroll_throw = LV_MAX(indev->driver->scroll_throw, 1);
+    int32_t tau = indev->driver->read_timer->period * 100 / scroll_throw;
+    int32_t d = (int32_t)v * tau / 1000;
+    return LV_CLAMP(-LV_COORD_MAX, d, LV_COORD_MAX);
+}
+
+/**
+ * Get the time of an ease out animation which starts with a given velocity.
+ * `lv_anim_path_ease_out` starts with 21/8 times of its average speed.
+ * @param d         distance of the animation
+ * @param v         start velocity [px/s]
+ * @return          time of the animation [ms]
+ */
+static uint32_t throw_time(lv_coord_t d, lv_coord_t v)
+{
+    return (uint32_t)(2625 * LV_ABS((int32_t)d) / LV_ABS((int32_t)v));
+}
+
+static void throw_momentum(_lv_indev_proc_t * proc, lv_obj_t * scroll_obj, lv_dir_t dir)
+{
+    lv_indev_t * indev_act = lv_indev_get_act();
+    lv_coord_t v = dir == LV_DIR_VER ? proc->types.pointer.velocity.y : proc->types.pointer.velocity.x;
+    if(lv_obj_has_flag(scroll_obj, LV_OBJ_FLAG_SCROLL_MOMENTUM) == false) v = 0;
+
+    /*The prediction is scrolled already*/
+    lv_coord_t ofs = dir == LV_DIR_VER ? proc->types.pointer.predict_ofs.y : proc->types.pointer.predict_ofs.x;
+    lv_coord_t d = (v == 0 ? 0 : throw_dist(indev_act, v)) - ofs;
+
+    /*Stop at the edges. If it's scrolled in already it will be scrolled back.*/
+    lv_coord_t start = dir == LV_DIR_VER ? lv_obj_get_scroll_top(scroll_obj) : lv_obj_get_scroll_left(scroll_obj);
+    lv_coord_t end = dir == LV_DIR_VER ? lv_obj_get_scroll_bottom(scroll_obj) : lv_obj_get_scroll_right(scroll_obj);
+    if(start < 0 || end < 0) return;
+    d = LV_CLAMP(-end, d, start);
+    if(d == 0) return;
+
+    /*No throw, only scroll back the part of the prediction which the finger didn't follow*/
+    if(v == 0 || (d > 0) != (v > 0)) {
+        if(dir == LV_DIR_VER) lv_obj_scroll_by(scroll_obj, 0, d, LV_ANIM_ON);
+        else lv_obj_scroll_by(scroll_obj, d, 0, LV_ANIM_ON);
+        return;
+    }
+
+    uint32_t t = LV_CLAMP(THROW_ANIM_TIME_MIN, throw_time(d, v), THROW_ANIM_TIME_MAX);
+    if(dir == LV_DIR_VER) _lv_obj_scroll_by_anim(scroll_obj, 0, d, t);
+    else _lv_obj_scroll_by_anim(scroll_obj, d, 0, t);
+    proc->types.pointer.throw_obj = scroll_obj;
+}
+
+static void throw_snap(_lv_indev_proc_t * proc, lv_obj_t * scroll_obj, lv_dir_t dir)
+{
+    lv_indev_t * indev_act = lv_indev_get_act();
+    lv_coord_t v = dir == LV_DIR_VER ? proc->types.pointer.velocity.y : proc->types.pointer.velocity.x;
+    if(lv_obj_has_flag(scroll_obj, LV_OBJ_FLAG_SCROLL_MOMENTUM) == false) v = 0;
+
+    /*Snap to the point nearest to where the throw would end*/
+    lv_coord_t ofs = dir == LV_DIR_VER ? proc->types.pointer.predict_ofs.y : proc->types.pointer.predict_ofs.x;
+    lv_coord_t diff = throw_dist(indev_act, v) - ofs;
+    lv_coord_t d;
+    if(dir == LV_DIR_VER) {
+        scroll_limit_diff(proc, NULL, &diff);
+        d = diff + find_snap_point_y(scroll_obj, LV_COORD_MIN, LV_COORD_MAX, diff);
+    }
+    else {
+        scroll_limit_diff(proc, &diff, NULL);
+        d = diff + find_snap_point_x(scroll_obj, LV_COORD_MIN, LV_COORD_MAX, diff);
+    }
+
+    /*Keep the speed of the finger if the snap point is ahead*/
+    if(v != 0 && d != 0 && (d > 0) == (v > 0)) {
+        uint32_t t = LV_CLAMP(SNAP_ANIM_TIME_MIN, throw_time(d, v), SNAP_ANIM_TIME_MAX);
+        if(dir == LV_DIR_VER) _lv_obj_scroll_by_anim(scroll_obj, 0, d, t);
+        else _lv_obj_scroll_by_anim(scroll_obj, d, 0, t);
+    }
+    else {
+        if(dir == LV_DIR_VER) lv_obj_scroll_by(scroll_obj, 0, d, LV_ANIM_ON);
+        else lv_obj_scroll_by(scroll_obj, d, 0, LV_ANIM_ON);
+    }
+}
+#endif
@@ -33,6 +33,15 @@ extern "C" {
  */
 void _lv_indev_scroll_handler(_lv_indev_proc_t * proc);
 
+#if LV_INDEV_SCROLL_PREDICT
+/**
+ * Save a sample of a pointer to estimate its velocity. Called by LVGL during input device processing
+ * @param proc      pointer to an input device's proc field with the new `act_point`
+ * @param data      the data read from the input device
+ */
+void _lv_indev_scroll_sample(_lv_indev_proc_t * proc, const lv_indev_data_t * data);
+#endif
+
 /**
  * Handle throwing after scrolling. Called by LVGL during input device processing
  * @param proc      pointer to an input device's proc field
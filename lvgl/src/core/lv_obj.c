@@ -140,6 +140,7 @@ void lv_init(void)
     _lv_obj_style_init();
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
+    _lv_ll_init(&LV_GC_ROOT(_lv_layer_cache_ll), sizeof(_lv_obj_layer_cache_t));
 
     /*Initialize the screen refresh system*/
     _lv_refr_init();
@@ -476,6 +477,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+        if(obj->spec_attr->layer_cache) {
+            lv_obj_set_layer_cache(obj, false);
+        }
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -108,6 +108,9 @@ enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_SCROLL_BLIT     = (1L << 20), /**< On scroll move the rendered pixels and redraw only the uncovered part.
+                                                   Only for objects which draw nothing else than their styles and children,
+                                                   also not with event handlers added for `LV_EVENT_ALL`.*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -169,6 +172,7 @@ typedef struct {
     lv_dir_t scroll_dir : 4;                /**< The allowed scroll direction(s)*/
     uint8_t event_dsc_cnt : 6;              /**< Number of event callbacks stored in `event_dsc` array*/
     uint8_t layer_type : 2;    /**< Cache the layer type here. Element of @lv_intermediate_layer_type_t */
+    struct _lv_obj_layer_cache_t * layer_cache; /**< Retained rendering, see `lv_obj_set_layer_cache()`*/
 } _lv_obj_spec_attr_t;
 
 typedef struct _lv_obj_t {
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_theme.h"
+#include "../extra/others/profiler/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -43,9 +44,13 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p);
 lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * parent)
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
+    LV_PROFILER_OBJ_CREATE_BEGIN();
     uint32_t s = get_instance_size(class_p);
     lv_obj_t * obj = lv_mem_alloc(s);
-    if(obj == NULL) return NULL;
+    if(obj == NULL) {
+        LV_PROFILER_OBJ_CREATE_END(NULL);
+        return NULL;
+    }
     lv_memset_00(obj, s);
     obj->class_p = class_p;
     obj->parent = parent;
@@ -57,6 +62,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
             lv_mem_free(obj);
+            LV_PROFILER_OBJ_CREATE_END(NULL);
             return NULL;
         }
 
@@ -129,6 +135,8 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
         /*Invalidate the area if not screen created*/
         lv_obj_invalidate(obj);
     }
+
+    LV_PROFILER_OBJ_CREATE_END(obj->class_p);
 }
 
 void _lv_obj_destruct(lv_obj_t * obj)
@@ -10,12 +10,17 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_indev.h"
+#include "lv_refr.h"
+#include "../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+/*A layer cache changed or drawn more recently than this [ms] is considered to be in use*/
+#define LAYER_CACHE_HOT_TIME    300
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -23,10 +28,14 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool layer_cache_alloc(_lv_obj_layer_cache_t * cache, lv_coord_t w, lv_coord_t h);
+static void layer_cache_release(_lv_obj_layer_cache_t * cache);
+static bool layer_cache_get_bg_color(lv_obj_t * obj, lv_color_t * color);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t layer_cache_used;
 
 /**********************
  *      MACROS
@@ -393,6 +402,275 @@ lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    if(lv_obj_get_layer_cache(obj) == en) return;
+
+    if(en) {
+        lv_obj_allocate_spec_attr(obj);
+        _lv_obj_layer_cache_t * cache = _lv_ll_ins_head(&LV_GC_ROOT(_lv_layer_cache_ll));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return;
+
+        lv_memset_00(cache, sizeof(_lv_obj_layer_cache_t));
+        cache->obj = obj;
+        obj->spec_attr->layer_cache = cache;
+    }
+    else {
+        _lv_obj_layer_cache_t * cache = obj->spec_attr->layer_cache;
+        layer_cache_release(cache);
+        _lv_ll_remove(&LV_GC_ROOT(_lv_layer_cache_ll), cache);
+        lv_mem_free(cache);
+        obj->spec_attr->layer_cache = NULL;
+    }
+}
+
+bool lv_obj_get_layer_cache(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    return obj->spec_attr && obj->spec_attr->layer_cache;
+}
+
+uint32_t lv_obj_get_layer_cache_used_size(void)
+{
+    return layer_cache_used;
+}
+
+void _lv_obj_layer_cache_mark_dirty(const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_layer_cache_ll)) == NULL) return;
+
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->layer_cache) {
+            _lv_obj_layer_cache_t * cache = obj->spec_attr->layer_cache;
+            lv_area_t a;
+            if(_lv_area_intersect(&a, area, &obj->coords)) {
+                /*Store it relative to the object as the rendering moves together with the object*/
+                lv_area_move(&a, -obj->coords.x1, -obj->coords.y1);
+                if(cache->has_dirty) _lv_area_join(&cache->dirty, &cache->dirty, &a);
+                else cache->dirty = a;
+                cache->has_dirty = 1;
+                cache->dirty_time = lv_tick_get();
+            }
+        }
+        obj = obj->parent;
+    }
+}
+
+bool _lv_obj_layer_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    _lv_obj_layer_cache_t * cache = obj->spec_attr->layer_cache;
+
+    /*Only what's drawn inside the object is rendered into the cache*/
+    if(_lv_obj_get_ext_draw_size(obj) > 0 || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        layer_cache_release(cache);
+        return false;
+    }
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, &obj->coords)) return true;
+
+    lv_color_t bg_color;
+    if(!layer_cache_get_bg_color(obj, &bg_color)) {
+        layer_cache_release(cache);
+        return false;
+    }
+
+    lv_coord_t w = lv_obj_get_width(obj);
+    lv_coord_t h = lv_obj_get_height(obj);
+    bool full = false;
+    if(cache->img.data == NULL || cache->img.header.w != w || cache->img.header.h != h) {
+        if(!layer_cache_alloc(cache, w, h)) return false;
+        full = true;
+    }
+    else if(cache->bg_color.full != bg_color.full) {
+        full = true;
+    }
+
+    if(full) {
+        lv_area_set(&cache->dirty, 0, 0, w - 1, h - 1);
+        cache->has_dirty = 1;
+    }
+
+    if(cache->has_dirty) {
+        lv_area_t dirty_area;
+        lv_area_copy(&dirty_area, &cache->dirty);
+        lv_area_move(&dirty_area, obj->coords.x1, obj->coords.y1);
+
+        /*While the object is changing draw it directly if updating the cache would be more work*/
+        if(!full && lv_tick_elaps(cache->dirty_time) < LAYER_CACHE_HOT_TIME &&
+           lv_area_get_size(&dirty_area) > lv_area_get_size(&clip_area)) {
+            return false;
+        }
+
+        lv_draw_layer_ctx_t * layer_ctx = lv_draw_layer_create_retained(draw_ctx, &obj->coords, (void *)cache->img.data);
+        if(layer_ctx == NULL) {
+            layer_cache_release(cache);
+            return false;
+        }
+
+        /*Invalidations while rendering are already included*/
+        cache->has_dirty = 0;
+
+        draw_ctx->clip_area = &dirty_area;
+        lv_draw_rect_dsc_t bg_dsc;
+        lv_draw_rect_dsc_init(&bg_dsc);
+        bg_dsc.bg_color = bg_color;
+        lv_draw_rect(draw_ctx, &bg_dsc, &dirty_area);
+        lv_obj_redraw(draw_ctx, obj);
+        lv_draw_layer_destroy(draw_ctx, layer_ctx);
+
+        cache->bg_color = bg_color;
+    }
+
+    cache->last_used = lv_tick_get();
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_draw_img(draw_ctx, &img_dsc, &obj->coords, &cache->img);
+
+    return true;
+}
+
+bool _lv_obj_get_backdrop_color(lv_obj_t * obj, const lv_area_t * area, lv_color_t * color)
+{
+    lv_obj_t * base = obj;
+    while(1) {
+        /*Other widgets might draw anything on their background*/
+        if(base != obj && base->class_p != &lv_obj_class && !lv_obj_has_flag(base, LV_OBJ_FLAG_SCROLL_BLIT)) {
+            return false;
+        }
+        if(lv_obj_has_event_cb(base, LV_EVENT_DRAW_MAIN_BEGIN)) return false;
+        if(lv_obj_has_event_cb(base, LV_EVENT_DRAW_MAIN)) return false;
+        if(lv_obj_has_event_cb(base, LV_EVENT_DRAW_MAIN_END)) return false;
+        if(lv_obj_has_event_cb(base, LV_EVENT_DRAW_PART_BEGIN)) return false;
+        if(lv_obj_get_style_bg_img_src(base, LV_PART_MAIN)) return false;
+        if(lv_obj_get_style_blend_mode(base, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL) return false;
+
+        lv_area_t base_area;
+        _lv_obj_get_plain_area(base, &base_area);
+        if(!_lv_area_is_in(area, &base_area, 0)) return false;
+
+        lv_opa_t bg_opa = lv_obj_get_style_bg_opa(base, LV_PART_MAIN);
+        if(bg_opa >= LV_OPA_MAX) {
+            if(lv_obj_get_style_bg_grad_dir(base, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+            *color = lv_obj_get_style_bg_color(base, LV_PART_MAIN);
+            return true;
+        }
+        if(bg_opa > LV_OPA_MIN) return false;
+
+        /*The transparent background shows the earlier siblings*/
+        lv_obj_t * parent = lv_obj_get_parent(base);
+        if(parent == NULL) return false;
+        uint32_t idx = lv_obj_get_index(base);
+        uint32_t i;
+        for(i = 0; i < idx; i++) {
+            lv_obj_t * sibling = parent->spec_attr->children[i];
+            if(lv_obj_has_flag(sibling, LV_OBJ_FLAG_HIDDEN)) continue;
+            lv_area_t sibling_area;
+            lv_coord_t ext = _lv_obj_get_ext_draw_size(sibling);
+            lv_area_copy(&sibling_area, &sibling->coords);
+            lv_area_increase(&sibling_area, ext, ext);
+            if(_lv_area_is_on(&sibling_area, area)) return false;
+        }
+        base = parent;
+    }
+}
+
+void _lv_obj_get_plain_area(const lv_obj_t * obj, lv_area_t * area)
+{
+    lv_coord_t w = lv_obj_get_width(obj);
+    lv_coord_t h = lv_obj_get_height(obj);
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    r = LV_MIN(r, LV_MIN(w, h) / 2);
+    lv_coord_t bw = 0;
+    if(lv_obj_get_style_border_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) {
+        bw = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    }
+
+    lv_area_copy(area, &obj->coords);
+    lv_area_increase(area, -LV_MAX(r, bw), -LV_MAX(r, bw));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static bool layer_cache_alloc(_lv_obj_layer_cache_t * cache, lv_coord_t w, lv_coord_t h)
+{
+    layer_cache_release(cache);
+
+    uint32_t size = (uint32_t)w * h * sizeof(lv_color_t);
+    if(size == 0 || size > LV_LAYER_CACHE_SIZE) return false;
+
+    /*Drop the least recently drawn renderings to fit into the budget.
+     *Keep the ones in use to avoid evicting each other in every frame.*/
+    while(layer_cache_used + size > LV_LAYER_CACHE_SIZE) {
+        _lv_obj_layer_cache_t * lru = NULL;
+        _lv_obj_layer_cache_t * c;
+        _LV_LL_READ(&LV_GC_ROOT(_lv_layer_cache_ll), c) {
+            if(c->img.data == NULL) continue;
+            if(lv_tick_elaps(c->last_used) < LAYER_CACHE_HOT_TIME) continue;
+            if(lru == NULL || lv_tick_elaps(c->last_used) > lv_tick_elaps(lru->last_used)) lru = c;
+        }
+        if(lru == NULL) return false;
+        layer_cache_release(lru);
+    }
+
+    uint8_t * buf = lv_mem_alloc(size);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes for a layer cache", size);
+        return false;
+    }
+
+    cache->img.header.always_zero = 0;
+    cache->img.header.w = w;
+    cache->img.header.h = h;
+    cache->img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    cache->img.data_size = size;
+    cache->img.data = buf;
+    layer_cache_used += size;
+
+    return true;
+}
+
+static void layer_cache_release(_lv_obj_layer_cache_t * cache)
+{
+    if(cache->img.data == NULL) return;
+
+    lv_img_cache_invalidate_src(&cache->img);
+    lv_mem_free((void *)cache->img.data);
+    cache->img.data = NULL;
+    layer_cache_used -= cache->img.data_size;
+    cache->img.data_size = 0;
+    cache->has_dirty = 0;
+}
+
+static bool layer_cache_get_bg_color(lv_obj_t * obj, lv_color_t * color)
+{
+    /*Nothing is visible below the object if it covers its area*/
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &obj->coords;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_COVER) {
+        *color = lv_color_black();
+        return true;
+    }
+
+    /*Only the part inside the parents can be visible*/
+    lv_area_t area;
+    lv_area_copy(&area, &obj->coords);
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(!lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+            if(!_lv_area_intersect(&area, &area, &parent->coords)) return false;
+        }
+        parent = lv_obj_get_parent(parent);
+    }
+
+    return _lv_obj_get_backdrop_color(obj, &area, color);
+}
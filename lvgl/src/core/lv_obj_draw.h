@@ -66,6 +66,17 @@ typedef struct {
     const void * sub_part_ptr;    /**< A pointer the identifies something in the part. E.g. chart series. */
 } lv_obj_draw_part_dsc_t;
 
+/** Retained rendering of an object. See `lv_obj_set_layer_cache()`*/
+typedef struct _lv_obj_layer_cache_t {
+    struct _lv_obj_t * obj;
+    lv_img_dsc_t img;           /**< The rendering as a true color image. `img.data == NULL` if not allocated*/
+    lv_area_t dirty;            /**< Area to render again, relative to the object's coordinates*/
+    lv_color_t bg_color;        /**< The color the object was rendered on*/
+    uint32_t dirty_time;        /**< When `dirty` was extended last time*/
+    uint32_t last_used;         /**< When the rendering was drawn last time. Used to evict the least recently used*/
+    uint8_t has_dirty : 1;
+} _lv_obj_layer_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -161,6 +172,66 @@ lv_coord_t _lv_obj_get_ext_draw_size(const struct _lv_obj_t * obj);
 
 lv_layer_type_t _lv_obj_get_layer_type(const struct _lv_obj_t * obj);
 
+/**
+ * Keep a rendering of the object together with its children and draw it as a single image
+ * while nothing changes on them, e.g. while a tileview page is swiped in.
+ * Only the parts invalidated since the last rendering are rendered again.
+ * The buffers of all objects are limited by `LV_LAYER_CACHE_SIZE`, the least recently drawn ones are dropped.
+ * @param obj       pointer to an object
+ * @param en        true: enable the cache; false: disable it and free its buffer
+ * @note the object is cached only if it covers its area or only a single color is below it,
+ *       and nothing is drawn out of its area
+ */
+void lv_obj_set_layer_cache(struct _lv_obj_t * obj, bool en);
+
+/**
+ * Get whether the layer cache is enabled on an object
+ * @param obj       pointer to an object
+ * @return          true: the layer cache is enabled
+ */
+bool lv_obj_get_layer_cache(const struct _lv_obj_t * obj);
+
+/**
+ * Get the memory used by the buffers of the layer caches
+ * @return          the size of the allocated buffers in bytes
+ */
+uint32_t lv_obj_get_layer_cache_used_size(void);
+
+/**
+ * Mark an area of an object to be rendered again in the layer cache of the object and its parents
+ * @param obj       pointer to an object
+ * @param area      the changed area in absolute coordinates
+ */
+void _lv_obj_layer_cache_mark_dirty(const struct _lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Draw an object from its layer cache and update the cache if required
+ * @param draw_ctx  the current draw context
+ * @param obj       pointer to an object with enabled layer cache
+ * @return          true: the object was drawn; false: the object can't be drawn from the cache now
+ */
+bool _lv_obj_layer_cache_draw(lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+/**
+ * Get the color below an area of an object if only a single color can be there,
+ * i.e. the backgrounds of the object and its parents are either transparent or opaque and plain.
+ * Only plain `lv_obj`s and objects with `LV_OBJ_FLAG_SCROLL_BLIT` are considered as parents,
+ * and objects with own draw event handlers are never considered.
+ * @param obj       pointer to an object. Its own background is considered too,
+ *                  the caller has to know that it draws nothing else there which doesn't move.
+ * @param area      the area to check in absolute coordinates
+ * @param color     store the color here
+ * @return          true: `area` is on a single color
+ */
+bool _lv_obj_get_backdrop_color(struct _lv_obj_t * obj, const lv_area_t * area, lv_color_t * color);
+
+/**
+ * Get the area of an object where only its background is drawn, i.e. without the border and the rounded corners
+ * @param obj       pointer to an object
+ * @param area      store the area here
+ */
+void _lv_obj_get_plain_area(const struct _lv_obj_t * obj, lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
@@ -838,6 +838,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The cached renderings are outdated even if the change is not visible now*/
+    _lv_obj_layer_cache_mark_dirty(obj, area);
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -11,6 +11,7 @@
 #include "lv_indev.h"
 #include "lv_disp.h"
 #include "lv_indev_scroll.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -34,8 +35,16 @@
 static void scroll_x_anim(void * obj, int32_t v);
 static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
+static void scroll_anim_start(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, uint32_t time_x, uint32_t time_y);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool scroll_blit(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy);
+static bool draws_post(lv_obj_t * obj, const lv_area_t * area);
+static void get_ext_area(lv_obj_t * obj, lv_area_t * area);
+static void blit_invalidate_area(lv_disp_t * disp, const lv_area_t * area, const lv_area_t * blit_area,
+                                 lv_coord_t dx, lv_coord_t dy);
+static void blit_invalidate_obj(lv_disp_t * disp, lv_obj_t * obj, const lv_area_t * blit_area,
+                                lv_coord_t dx, lv_coord_t dy);
 
 /**********************
  *  STATIC VARIABLES
@@ -305,42 +314,11 @@ void lv_obj_scroll_by(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, lv_anim_enab
     if(dx == 0 && dy == 0) return;
     if(anim_en == LV_ANIM_ON) {
         lv_disp_t * d = lv_obj_get_disp(obj);
-        lv_anim_t a;
-        lv_anim_init(&a);
-        lv_anim_set_var(&a, obj);
-        lv_anim_set_ready_cb(&a, scroll_anim_ready_cb);
-
-        if(dx) {
-            uint32_t t = lv_anim_speed_to_time((lv_disp_get_hor_res(d) * 2) >> 2, 0, dx);
-            if(t < SCROLL_ANIM_TIME_MIN) t = SCROLL_ANIM_TIME_MIN;
-            if(t > SCROLL_ANIM_TIME_MAX) t = SCROLL_ANIM_TIME_MAX;
-            lv_anim_set_time(&a, t);
-            lv_coord_t sx = lv_obj_get_scroll_x(obj);
-            lv_anim_set_values(&a, -sx, -sx + dx);
-            lv_anim_set_exec_cb(&a, scroll_x_anim);
-            lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
-
-            lv_res_t res;
-            res = lv_event_send(obj, LV_EVENT_SCROLL_BEGIN, &a);
-            if(res != LV_RES_OK) return;
-            lv_anim_start(&a);
-        }
-
-        if(dy) {
-            uint32_t t = lv_anim_speed_to_time((lv_disp_get_ver_res(d) * 2) >> 2, 0, dy);
-            if(t < SCROLL_ANIM_TIME_MIN) t = SCROLL_ANIM_TIME_MIN;
-            if(t > SCROLL_ANIM_TIME_MAX) t = SCROLL_ANIM_TIME_MAX;
-            lv_anim_set_time(&a, t);
-            lv_coord_t sy = lv_obj_get_scroll_y(obj);
-            lv_anim_set_values(&a, -sy, -sy + dy);
-            lv_anim_set_exec_cb(&a,  scroll_y_anim);
-            lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
-
-            lv_res_t res;
-            res = lv_event_send(obj, LV_EVENT_SCROLL_BEGIN, &a);
-            if(res != LV_RES_OK) return;
-            lv_anim_start(&a);
-        }
+        uint32_t time_x = lv_anim_speed_to_time((lv_disp_get_hor_res(d) * 2) >> 2, 0, dx);
+        uint32_t time_y = lv_anim_speed_to_time((lv_disp_get_ver_res(d) * 2) >> 2, 0, dy);
+        time_x = LV_CLAMP(SCROLL_ANIM_TIME_MIN, time_x, SCROLL_ANIM_TIME_MAX);
+        time_y = LV_CLAMP(SCROLL_ANIM_TIME_MIN, time_y, SCROLL_ANIM_TIME_MAX);
+        scroll_anim_start(obj, dx, dy, time_x, time_y);
     }
     else {
         /*Remove pending animations*/
@@ -359,6 +337,19 @@ void lv_obj_scroll_by(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, lv_anim_enab
     }
 }
 
+void _lv_obj_scroll_by_anim(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, uint32_t time)
+{
+    if(dx == 0 && dy == 0) return;
+    scroll_anim_start(obj, dx, dy, time, time);
+}
+
+bool _lv_obj_scroll_anim_del(lv_obj_t * obj)
+{
+    bool del_x = lv_anim_del(obj, scroll_x_anim);
+    bool del_y = lv_anim_del(obj, scroll_y_anim);
+    return del_x || del_y;
+}
+
 void lv_obj_scroll_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_anim_enable_t anim_en)
 {
     lv_obj_scroll_to_x(obj, x, anim_en);
@@ -419,9 +410,16 @@ lv_res_t _lv_obj_scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
+
+    /*The content moved in the renderings of the cached parents too*/
+    _lv_obj_layer_cache_mark_dirty(obj, &obj->coords);
+
+    /*Before the SCROLL event as the areas invalidated from now are already on their new position*/
+    bool blit = scroll_blit(obj, x, y);
+
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return res;
-    lv_obj_invalidate(obj);
+    if(!blit) lv_obj_invalidate(obj);
     return LV_RES_OK;
 }
 
@@ -664,6 +662,78 @@ void lv_obj_readjust_scroll(lv_obj_t * obj, lv_anim_enable_t anim_en)
     }
 }
 
+bool _lv_obj_blit_area(lv_obj_t * obj, lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp->driver->copy_area_cb == NULL) return false;
+    if(lv_obj_get_screen(obj) != disp->act_scr || disp->prev_scr) return false;
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+    if(!_lv_area_intersect(area, area, &disp_area)) return false;
+
+    /*Nothing can be mixed with what's below the object and nothing can be drawn over it by the parents.
+     *Clip to the parents meanwhile.*/
+    lv_obj_t * parent = obj;
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return false;
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_get_style_opa(parent, LV_PART_MAIN) < LV_OPA_MAX) return false;
+        if(parent != obj && !lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+            if(!_lv_area_intersect(area, area, &parent->coords)) return false;
+        }
+        if(draws_post(parent, area)) return false;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    if(LV_ABS(dx) >= lv_area_get_width(area) || LV_ABS(dy) >= lv_area_get_height(area)) return false;
+
+    /*Only a single color can be below the content, as it looks the same after moving*/
+    lv_color_t bg_color;
+    if(!_lv_obj_get_backdrop_color(obj, area, &bg_color)) return false;
+
+    if(!_lv_refr_scroll_area(disp, area, dx, dy)) return false;
+
+    /*Redraw everything which is drawn over the area as it doesn't move*/
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) blit_invalidate_obj(disp, child, area, dx, dy);
+    }
+
+    lv_obj_t * child = obj;
+    parent = lv_obj_get_parent(obj);
+    while(parent) {
+        child_cnt = lv_obj_get_child_cnt(parent);
+        for(i = lv_obj_get_index(child) + 1; i < child_cnt; i++) {
+            blit_invalidate_obj(disp, parent->spec_attr->children[i], area, dx, dy);
+        }
+
+        /*The scrollbars of the parents are drawn after the children*/
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        blit_invalidate_area(disp, &hor_area, area, dx, dy);
+        blit_invalidate_area(disp, &ver_area, area, dx, dy);
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    lv_obj_t * layers[2] = {disp->top_layer, disp->sys_layer};
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        if(layers[l] == NULL) continue;
+        child_cnt = lv_obj_get_child_cnt(layers[l]);
+        for(i = 0; i < child_cnt; i++) {
+            blit_invalidate_obj(disp, layers[l]->spec_attr->children[i], area, dx, dy);
+        }
+    }
+
+    return true;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -684,6 +754,48 @@ static void scroll_anim_ready_cb(lv_anim_t * a)
     lv_event_send(a->var, LV_EVENT_SCROLL_END, NULL);
 }
 
+/**
+ * Start the animations of a scroll. `LV_EVENT_SCROLL_BEGIN` is sent for each axis.
+ * @param obj       pointer to an object to scroll
+ * @param dx        pixels to scroll horizontally
+ * @param dy        pixels to scroll vertically
+ * @param time_x    duration of the horizontal animation in ms
+ * @param time_y    duration of the vertical animation in ms
+ */
+static void scroll_anim_start(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, uint32_t time_x, uint32_t time_y)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_ready_cb(&a, scroll_anim_ready_cb);
+
+    if(dx) {
+        lv_anim_set_time(&a, time_x);
+        lv_coord_t sx = lv_obj_get_scroll_x(obj);
+        lv_anim_set_values(&a, -sx, -sx + dx);
+        lv_anim_set_exec_cb(&a, scroll_x_anim);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+
+        lv_res_t res;
+        res = lv_event_send(obj, LV_EVENT_SCROLL_BEGIN, &a);
+        if(res != LV_RES_OK) return;
+        lv_anim_start(&a);
+    }
+
+    if(dy) {
+        lv_anim_set_time(&a, time_y);
+        lv_coord_t sy = lv_obj_get_scroll_y(obj);
+        lv_anim_set_values(&a, -sy, -sy + dy);
+        lv_anim_set_exec_cb(&a,  scroll_y_anim);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+
+        lv_res_t res;
+        res = lv_event_send(obj, LV_EVENT_SCROLL_BEGIN, &a);
+        if(res != LV_RES_OK) return;
+        lv_anim_start(&a);
+    }
+}
+
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en)
 {
@@ -798,3 +910,159 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Try to scroll an object by moving its already rendered pixels on the display.
+ * Only the uncovered strips and the objects drawn over the moved area are invalidated.
+ * @param obj   pointer to an object whose children were already moved by (dx, dy)
+ * @param dx    horizontal movement
+ * @param dy    vertical movement
+ * @return      true: the pixels will be moved; false: the object needs to be redrawn
+ */
+static bool scroll_blit(lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy)
+{
+    if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLL_BLIT)) return false;
+    /*The children out of the object would be moved too*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    lv_area_t blit_area;
+    _lv_obj_get_plain_area(obj, &blit_area);
+
+    /*The scrollbars don't move together with the content*/
+    lv_coord_t sb_width = lv_obj_get_style_width(obj, LV_PART_SCROLLBAR);
+    if(sb_width > 0 && (lv_obj_get_style_bg_opa(obj, LV_PART_SCROLLBAR) > LV_OPA_MIN ||
+                        lv_obj_get_style_border_opa(obj, LV_PART_SCROLLBAR) > LV_OPA_MIN)) {
+        lv_dir_t dir = lv_obj_get_scroll_dir(obj);
+        if(dir & LV_DIR_VER) {
+            if(lv_obj_get_style_base_dir(obj, LV_PART_SCROLLBAR) == LV_BASE_DIR_RTL) {
+                lv_coord_t x1 = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_SCROLLBAR) + sb_width;
+                blit_area.x1 = LV_MAX(blit_area.x1, x1);
+            }
+            else {
+                lv_coord_t x2 = obj->coords.x2 - lv_obj_get_style_pad_right(obj, LV_PART_SCROLLBAR) - sb_width;
+                blit_area.x2 = LV_MIN(blit_area.x2, x2);
+            }
+        }
+        if(dir & LV_DIR_HOR) {
+            lv_coord_t y2 = obj->coords.y2 - lv_obj_get_style_pad_bottom(obj, LV_PART_SCROLLBAR) - sb_width;
+            blit_area.y2 = LV_MIN(blit_area.y2, y2);
+        }
+    }
+
+    if(!_lv_obj_blit_area(obj, &blit_area, dx, dy)) return false;
+
+    /*Redraw the border, the rounded corners and the scrollbars around the moved area*/
+    lv_area_t a;
+    a = obj->coords;
+    a.y2 = blit_area.y1 - 1;
+    if(a.y2 >= a.y1) lv_obj_invalidate_area(obj, &a);
+    a = obj->coords;
+    a.y1 = blit_area.y2 + 1;
+    if(a.y2 >= a.y1) lv_obj_invalidate_area(obj, &a);
+    a.y1 = blit_area.y1;
+    a.y2 = blit_area.y2;
+    a.x1 = obj->coords.x1;
+    a.x2 = blit_area.x1 - 1;
+    if(a.x2 >= a.x1) lv_obj_invalidate_area(obj, &a);
+    a.x1 = blit_area.x2 + 1;
+    a.x2 = obj->coords.x2;
+    if(a.x2 >= a.x1) lv_obj_invalidate_area(obj, &a);
+
+    /*Redraw the uncovered strips*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(dx != 0) {
+        a = blit_area;
+        if(dx > 0) a.x2 = a.x1 + dx - 1;
+        else a.x1 = a.x2 + dx + 1;
+        _lv_inv_area(disp, &a);
+    }
+    if(dy != 0) {
+        a = blit_area;
+        if(dy > 0) a.y2 = a.y1 + dy - 1;
+        else a.y1 = a.y2 + dy + 1;
+        _lv_inv_area(disp, &a);
+    }
+
+    return true;
+}
+
+/**
+ * Tell whether an object might draw something over an area after its children
+ * @param obj   pointer to an object
+ * @param area  an area in absolute coordinates
+ * @return      true: `obj` has a post draw handler or its post border is on `area`
+ */
+static bool draws_post(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(lv_obj_has_event_cb(obj, LV_EVENT_DRAW_POST_BEGIN)) return true;
+    if(lv_obj_has_event_cb(obj, LV_EVENT_DRAW_POST)) return true;
+    if(lv_obj_has_event_cb(obj, LV_EVENT_DRAW_POST_END)) return true;
+
+    if(lv_obj_get_style_border_post(obj, LV_PART_MAIN) &&
+       lv_obj_get_style_border_width(obj, LV_PART_MAIN) > 0 &&
+       lv_obj_get_style_border_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) {
+        lv_area_t inner;
+        _lv_obj_get_plain_area(obj, &inner);
+        if(!_lv_area_is_in(area, &inner, 0)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Get the coordinates of an object extended with its extra draw size (shadow, outline, etc) and transformed
+ * @param obj       pointer to an object
+ * @param area      store the area here
+ */
+static void get_ext_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(area, &obj->coords);
+    lv_area_increase(area, ext, ext);
+    lv_obj_get_transformed_area(obj, area, true, false);
+}
+
+/**
+ * Invalidate an area drawn over a moved area and where its pixels are moved to
+ * @param disp      pointer to the display
+ * @param area      the area drawn over the moved area
+ * @param blit_area the moved area
+ * @param dx        horizontal movement
+ * @param dy        vertical movement
+ */
+static void blit_invalidate_area(lv_disp_t * disp, const lv_area_t * area, const lv_area_t * blit_area,
+                                 lv_coord_t dx, lv_coord_t dy)
+{
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, area, blit_area)) return;
+    _lv_inv_area(disp, &a);
+    lv_area_move(&a, dx, dy);
+    if(_lv_area_intersect(&a, &a, blit_area)) _lv_inv_area(disp, &a);
+}
+
+/**
+ * Invalidate an object drawn over a moved area and where its pixels are moved to
+ * @param disp      pointer to the display
+ * @param obj       an object drawn after the moved area
+ * @param blit_area the moved area
+ * @param dx        horizontal movement
+ * @param dy        vertical movement
+ */
+static void blit_invalidate_obj(lv_disp_t * disp, lv_obj_t * obj, const lv_area_t * blit_area,
+                                lv_coord_t dx, lv_coord_t dy)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t area;
+    get_ext_area(obj, &area);
+    blit_invalidate_area(disp, &area, blit_area, dx, dy);
+
+    /*The children are clipped to the object otherwise*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+        for(i = 0; i < child_cnt; i++) {
+            blit_invalidate_obj(disp, obj->spec_attr->children[i], blit_area, dx, dy);
+        }
+    }
+}
@@ -261,6 +261,23 @@ void lv_obj_scroll_to_view_recursive(struct _lv_obj_t * obj, lv_anim_enable_t an
  */
 lv_res_t _lv_obj_scroll_by_raw(struct _lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
 
+/**
+ * Scroll by given x and y coordinates with an animation of the given time.
+ * Used to continue a throw with the speed of the finger.
+ * @param obj       pointer to an object to scroll
+ * @param dx        pixels to scroll horizontally
+ * @param dy        pixels to scroll vertically
+ * @param time      duration of the animation in ms
+ */
+void _lv_obj_scroll_by_anim(struct _lv_obj_t * obj, lv_coord_t dx, lv_coord_t dy, uint32_t time);
+
+/**
+ * Stop the scroll animations of an object where they are. `LV_EVENT_SCROLL_END` is not sent.
+ * @param obj       pointer to an object, it can be deleted already
+ * @return          true: there was an animation to stop
+ */
+bool _lv_obj_scroll_anim_del(struct _lv_obj_t * obj);
+
 /**
  * Tell whether an object is being scrolled or not at this moment
  * @param obj   pointer to an object
@@ -296,6 +313,18 @@ void lv_obj_scrollbar_invalidate(struct _lv_obj_t * obj);
  */
 void lv_obj_readjust_scroll(struct _lv_obj_t * obj, lv_anim_enable_t anim_en);
 
+/**
+ * Move the rendered pixels of an area of an object on the display instead of redrawing them.
+ * The objects drawn over the area are invalidated on their old and moved position.
+ * The caller has to invalidate the uncovered part of the area.
+ * @param obj   pointer to an object whose drawing in `area` looks the same after moving
+ * @param area  the area to move in absolute coordinates. Clipped to the visible part.
+ * @param dx    horizontal movement
+ * @param dy    vertical movement
+ * @return      true: the pixels will be moved; false: the area needs to be redrawn
+ */
+bool _lv_obj_blit_area(struct _lv_obj_t * obj, lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+
 /**********************
  *      MACROS
  **********************/
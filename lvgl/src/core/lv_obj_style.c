@@ -9,6 +9,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include "../extra/others/profiler/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -75,6 +76,7 @@ void _lv_obj_style_init(void)
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
 {
+    LV_PROFILER_BEGIN(LV_PROFILER_CAT_STYLE);
     trans_del(obj, selector, LV_STYLE_PROP_ANY, NULL);
 
     uint32_t i;
@@ -101,6 +103,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     obj->styles[i].selector = selector;
 
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
+    LV_PROFILER_END(LV_PROFILER_CAT_STYLE);
 }
 
 void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -270,9 +273,11 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
                                  lv_style_selector_t selector)
 {
+    LV_PROFILER_BEGIN(LV_PROFILER_CAT_STYLE);
     lv_style_t * style = get_local_style(obj, selector);
     lv_style_set_prop(style, prop, value);
     lv_obj_refresh_style(obj, selector, prop);
+    LV_PROFILER_END(LV_PROFILER_CAT_STYLE);
 }
 
 void lv_obj_set_local_style_prop_meta(lv_obj_t * obj, lv_style_prop_t prop, uint16_t meta,
@@ -380,6 +380,11 @@ static void obj_del_core(lv_obj_t * obj)
         if(indev->proc.types.pointer.last_pressed == obj) {
             indev->proc.types.pointer.last_pressed = NULL;
         }
+#if LV_INDEV_SCROLL_PREDICT
+        if(indev->proc.types.pointer.throw_obj == obj) {
+            indev->proc.types.pointer.throw_obj = NULL;
+        }
+#endif
 
         if(indev->group == group && obj == lv_indev_get_obj_act()) {
             lv_indev_reset(indev, obj);
@@ -18,6 +18,9 @@
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
+#include "../extra/others/profiler/lv_profiler.h"
+#include "../extra/others/latency/lv_latency.h"
+#include "../extra/others/binding/lv_binding.h"
 
 #if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
     #include "../widgets/lv_label.h"
@@ -26,6 +29,15 @@
 /*********************
  *      DEFINES
  *********************/
+/*Rotate 8x8 blocks of 16 bit pixels with GCC's vector extensions (compiled to SSE2 or NEON shuffles)*/
+#if LV_COLOR_DEPTH == 16 && defined(__GNUC__) && !defined(__clang__)
+    #define ROT_SIMD    1
+#else
+    #define ROT_SIMD    0
+#endif
+
+/*Size of the blocks in pixels to rotate without SIMD*/
+#define ROT_BLOCK   16
 
 /**********************
  *      TYPEDEFS
@@ -54,6 +66,7 @@ typedef struct {
 static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void refr_scroll_area(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
@@ -232,6 +245,8 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     suc = _lv_area_intersect(&com_area, area_p, &scr_area);
     if(suc == false)  return; /*Out of the screen*/
 
+    LV_LATENCY_INVALIDATE(disp);
+
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->driver->full_refresh) {
         disp->inv_areas[0] = scr_area;
@@ -260,6 +275,61 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
+/**
+ * Scroll an area of the display by moving its already flushed pixels before the next refresh.
+ * The invalidated areas overlapping with `area` are invalidated on their moved position too.
+ * Only one area can be scrolled per refresh but it can be scrolled several times.
+ * @param disp  pointer to a display (NULL: use the default display)
+ * @param area  the area to scroll
+ * @param dx    horizontal movement
+ * @param dy    vertical movement
+ * @return      true: the pixels will be moved; false: not supported, the area needs to be redrawn
+ */
+bool _lv_refr_scroll_area(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return false;
+    if(!lv_disp_is_invalidation_enabled(disp)) return false;
+    if(disp->rendering_in_progress) return false;
+
+    lv_disp_drv_t * drv = disp->driver;
+    if(drv->copy_area_cb == NULL) return false;
+    if(drv->full_refresh || drv->screen_transp || drv->rotated != LV_DISP_ROT_NONE) return false;
+    /*The other buffer is synchronized from the invalidated areas only*/
+    if(drv->direct_mode && drv->draw_buf->buf2) return false;
+
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t h = lv_area_get_height(area);
+    if(disp->scroll_pending) {
+        if(!_lv_area_is_equal(&disp->scroll_area, area)) return false;
+        /*Limit the sum, nothing will be copied anyway if it's larger than the area*/
+        dx = LV_CLAMP(-w, disp->scroll_dx + dx, w) - disp->scroll_dx;
+        dy = LV_CLAMP(-h, disp->scroll_dy + dy, h) - disp->scroll_dy;
+    }
+    else {
+        disp->scroll_area = *area;
+        disp->scroll_dx = 0;
+        disp->scroll_dy = 0;
+        disp->scroll_pending = 1;
+    }
+    disp->scroll_dx += dx;
+    disp->scroll_dy += dy;
+    LV_LATENCY_INVALIDATE(disp);
+
+    /*The pixels of the not refreshed areas will be copied too, so redraw them on their new position as well*/
+    uint16_t inv_p = disp->inv_p;
+    uint16_t i;
+    for(i = 0; i < inv_p; i++) {
+        lv_area_t moved;
+        if(!_lv_area_intersect(&moved, &disp->inv_areas[i], area)) continue;
+        lv_area_move(&moved, dx, dy);
+        if(_lv_area_intersect(&moved, &moved, area)) _lv_inv_area(disp, &moved);
+    }
+
+    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -287,6 +357,7 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
 void _lv_disp_refr_timer(lv_timer_t * tmr)
 {
     REFR_TRACE("begin");
+    LV_PROFILER_BEGIN(LV_PROFILER_CAT_RENDER);
 
     uint32_t start = lv_tick_get();
     volatile uint32_t elaps = 0;
@@ -305,6 +376,14 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+#if LV_INDEV_SCROLL_PREDICT
+    /*Show the animations at the time of this frame, not at the last run of their timer*/
+    lv_anim_refr_now();
+#endif
+
+    /*Write the changes of the model, so the layout and the invalidation see them in this frame*/
+    LV_BINDING_APPLY();
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -315,13 +394,17 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->scroll_pending = 0;
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
+        LV_PROFILER_END(LV_PROFILER_CAT_RENDER);
         return;
     }
 
+    refr_scroll_area();
     lv_refr_join_area();
     refr_sync_areas();
+    LV_LATENCY_REFR_BEGIN(disp_refr);
     refr_invalid_areas();
 
     /*If refresh happened ...*/
@@ -346,6 +429,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr->inv_p = 0;
 
         elaps = lv_tick_elaps(start);
+        disp_refr->last_refr_time = elaps;
 
         /*Call monitor cb if present*/
         if(disp_refr->driver->monitor_cb) {
@@ -449,6 +533,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 #endif
 
     REFR_TRACE("finished");
+    LV_PROFILER_END(LV_PROFILER_CAT_RENDER);
 }
 
 #if LV_USE_PERF_MONITOR
@@ -581,6 +666,39 @@ static void refr_sync_areas(void)
     _lv_ll_clear(&disp_refr->sync_areas);
 }
 
+/**
+ * Move the pixels of the scrolled area on the display
+ */
+static void refr_scroll_area(void)
+{
+    if(!disp_refr->scroll_pending) return;
+    disp_refr->scroll_pending = 0;
+
+    lv_coord_t dx = disp_refr->scroll_dx;
+    lv_coord_t dy = disp_refr->scroll_dy;
+    if(dx == 0 && dy == 0) return;
+
+    lv_area_t dest = disp_refr->scroll_area;
+    lv_area_move(&dest, dx, dy);
+    if(!_lv_area_intersect(&dest, &dest, &disp_refr->scroll_area)) return;
+
+    /*No need to copy if the destination will be redrawn anyway*/
+    uint16_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(_lv_area_is_in(&dest, &disp_refr->inv_areas[i], 0)) return;
+    }
+
+    /*The previous frame has to be completely on the display before moving its pixels*/
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    while(draw_buf->flushing) {
+        if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+    }
+
+    if(!disp_refr->driver->copy_area_cb(disp_refr->driver, &dest, dx, dy)) {
+        _lv_inv_area(disp_refr, &disp_refr->scroll_area);
+    }
+}
+
 /**
  * Refresh the joined areas
  */
@@ -971,6 +1089,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
+        if(obj->spec_attr && obj->spec_attr->layer_cache && _lv_obj_layer_cache_draw(draw_ctx, obj)) return;
         lv_obj_redraw(draw_ctx, obj);
     }
     else {
@@ -1113,68 +1232,124 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     area->x1 = drv->hor_res - tmp_coord - 1;
 }
 
-static void LV_ATTRIBUTE_FAST_MEM draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
-                                                     lv_color_t * orig_color_p, lv_color_t * rot_buf)
+/**
+ * Rotate a part of an image by 90 or 270 degrees pixel by pixel.
+ * `src` is `w` x `h` pixels, `dst` is `h` x `w` pixels. Only the `[x1..x2] x [y1..y2]` part of `src` is rotated.
+ */
+static void draw_buf_rotate_90_part(bool is_270, const lv_color_t * src, lv_color_t * dst, lv_coord_t w, lv_coord_t h,
+                                    lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
 {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = y1; y <= y2; y++) {
+        const lv_color_t * src_row = &src[y * w];
+        if(is_270) {
+            lv_color_t * dst_col = &dst[h - 1 - y];
+            for(x = x1; x <= x2; x++) dst_col[x * h] = src_row[x];
+        }
+        else {
+            lv_color_t * dst_col = &dst[(w - 1) * h + y];
+            for(x = x1; x <= x2; x++) dst_col[-x * h] = src_row[x];
         }
     }
 }
 
+#if ROT_SIMD
 /**
- * Helper function for draw_buf_rotate_90_sqr. Given a list of four numbers, rotate the entire list to the left.
+ * Rotate an 8x8 block of 16 bit pixels with vector shuffles (SSE2 or NEON)
+ * @param src       the top left pixel of the block
+ * @param src_w     stride of `src` in pixels
+ * @param dst       the first pixel of the first rotated row
+ * @param dst_w     stride of `dst` in pixels. Negative to write the rows upward.
  */
-static inline void draw_buf_rotate4(lv_color_t * a, lv_color_t * b, lv_color_t * c, lv_color_t * d)
+static inline void draw_buf_rotate_8x8(bool is_270, const lv_color_t * src, lv_coord_t src_w,
+                                       lv_color_t * dst, int32_t dst_w)
 {
-    lv_color_t tmp;
-    tmp = *a;
-    *a = *b;
-    *b = *c;
-    *c = *d;
-    *d = tmp;
+    typedef uint16_t vec_t __attribute__((vector_size(16)));
+    typedef int16_t mask_t __attribute__((vector_size(16)));
+
+    /*With 270 degree the columns are read bottom-up so load the rows in reverse order*/
+    vec_t r[8];
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        uint32_t row = is_270 ? 7 - i : i;
+        __builtin_memcpy(&r[i], &src[row * src_w], sizeof(vec_t));
+    }
+
+    /*Transpose: interleave 16, 32 and 64 bit units*/
+    const mask_t lo16 = {0, 8, 1, 9, 2, 10, 3, 11};
+    const mask_t hi16 = {4, 12, 5, 13, 6, 14, 7, 15};
+    const mask_t lo32 = {0, 1, 8, 9, 2, 3, 10, 11};
+    const mask_t hi32 = {4, 5, 12, 13, 6, 7, 14, 15};
+    const mask_t lo64 = {0, 1, 2, 3, 8, 9, 10, 11};
+    const mask_t hi64 = {4, 5, 6, 7, 12, 13, 14, 15};
+
+    vec_t t[8];
+    for(i = 0; i < 8; i += 2) {
+        t[i] = __builtin_shuffle(r[i], r[i + 1], lo16);
+        t[i + 1] = __builtin_shuffle(r[i], r[i + 1], hi16);
+    }
+
+    vec_t u[8];
+    for(i = 0; i < 8; i += 4) {
+        u[i] = __builtin_shuffle(t[i], t[i + 2], lo32);
+        u[i + 1] = __builtin_shuffle(t[i], t[i + 2], hi32);
+        u[i + 2] = __builtin_shuffle(t[i + 1], t[i + 3], lo32);
+        u[i + 3] = __builtin_shuffle(t[i + 1], t[i + 3], hi32);
+    }
+
+    for(i = 0; i < 4; i++) {
+        vec_t c0 = __builtin_shuffle(u[i], u[i + 4], lo64);
+        vec_t c1 = __builtin_shuffle(u[i], u[i + 4], hi64);
+        __builtin_memcpy(&dst[(int32_t)(2 * i) * dst_w], &c0, sizeof(vec_t));
+        __builtin_memcpy(&dst[(int32_t)(2 * i + 1) * dst_w], &c1, sizeof(vec_t));
+    }
 }
+#endif
 
 /**
- * Rotate a square image 90/270 degrees in place.
- * @note inspired by https://stackoverflow.com/a/43694906
+ * Rotate an image by 90 or 270 degrees into an other buffer.
+ * The image is processed in blocks to read and write whole cache lines instead of
+ * reading rows and writing columns pixel by pixel.
+ * @param is_270    true: rotate by 270 degrees; false: rotate by 90 degrees
+ * @param w         width of the source image
+ * @param h         height of the source image
+ * @param src       the source image
+ * @param dst       buffer for the rotated `h` x `w` image
  */
-static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color_p)
+static void LV_ATTRIBUTE_FAST_MEM draw_buf_rotate_90(bool is_270, lv_coord_t w, lv_coord_t h,
+                                                     const lv_color_t * src, lv_color_t * dst)
 {
-    for(lv_coord_t i = 0; i < w / 2; i++) {
-        for(lv_coord_t j = 0; j < (w + 1) / 2; j++) {
-            lv_coord_t inv_i = (w - 1) - i;
-            lv_coord_t inv_j = (w - 1) - j;
-            if(is_270) {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[inv_j * w + i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[j * w + inv_i]
-                );
-            }
-            else {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[j * w + inv_i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[inv_j * w + i]
-                );
+    lv_coord_t bx;
+    lv_coord_t by;
+#if ROT_SIMD
+    /*32 rows make a 64 byte long part of a rotated row, i.e. a whole cache line*/
+    lv_coord_t w8 = w & ~7;
+    lv_coord_t h8 = h & ~7;
+    for(by = 0; by < h8; by += 32) {
+        lv_coord_t by_end = LV_MIN(by + 32, h8);
+        for(bx = 0; bx < w8; bx += 8) {
+            lv_coord_t y;
+            for(y = by; y < by_end; y += 8) {
+                const lv_color_t * src_block = &src[y * w + bx];
+                if(is_270) draw_buf_rotate_8x8(true, src_block, w, &dst[bx * h + h - 8 - y], h);
+                else draw_buf_rotate_8x8(false, src_block, w, &dst[(w - 1 - bx) * h + y], -h);
             }
+        }
+    }
 
+    /*Rotate the edges which are not multiple of 8*/
+    if(w8 < w && h8 > 0) draw_buf_rotate_90_part(is_270, src, dst, w, h, w8, 0, w - 1, h8 - 1);
+    if(h8 < h) draw_buf_rotate_90_part(is_270, src, dst, w, h, 0, h8, w - 1, h - 1);
+#else
+    for(by = 0; by < h; by += ROT_BLOCK) {
+        lv_coord_t by_end = LV_MIN(by + ROT_BLOCK, h) - 1;
+        for(bx = 0; bx < w; bx += ROT_BLOCK) {
+            lv_coord_t bx_end = LV_MIN(bx + ROT_BLOCK, w) - 1;
+            draw_buf_rotate_90_part(is_270, src, dst, w, h, bx, by, bx_end, by_end);
         }
     }
+#endif
 }
 
 /**
@@ -1183,22 +1358,32 @@ static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color
 static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
 {
     lv_disp_drv_t * drv = disp_refr->driver;
-    if(disp_refr->driver->full_refresh && drv->sw_rotate) {
-        LV_LOG_ERROR("cannot rotate a full refreshed display!");
-        return;
-    }
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
     if(drv->rotated == LV_DISP_ROT_180) {
         draw_buf_rotate_180(drv, area, color_p);
         call_flush_cb(drv, area, color_p);
+        /*In direct mode the next areas are drawn into the same buffer, so rotate it back*/
+        if(drv->direct_mode) {
+            while(draw_buf->flushing) {
+                if(drv->wait_cb) drv->wait_cb(drv);
+            }
+            draw_buf_rotate_180(drv, area, color_p);
+        }
     }
     else if(drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
-        /*Allocate a temporary buffer to store rotated image*/
-        lv_color_t * rot_buf = NULL;
-        lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+        bool is_270 = drv->rotated == LV_DISP_ROT_270;
         lv_coord_t area_w = lv_area_get_width(area);
         lv_coord_t area_h = lv_area_get_height(area);
         /*Determine the maximum number of rows that can be rotated at a time*/
-        lv_coord_t max_row = LV_MIN((lv_coord_t)((LV_DISP_ROT_MAX_BUF / sizeof(lv_color_t)) / area_w), area_h);
+        uint32_t max_row_buf = (LV_DISP_ROT_MAX_BUF / sizeof(lv_color_t)) / area_w;
+        lv_coord_t max_row = (lv_coord_t)LV_MIN(max_row_buf, (uint32_t)area_h);
+        /*With full refresh the whole screen needs to be rotated at once*/
+        if(max_row == 0 || (drv->full_refresh && max_row < area_h)) {
+            LV_LOG_ERROR("LV_DISP_ROT_MAX_BUF is too small to rotate the draw buffer");
+            draw_buf->flushing = 0;
+            return;
+        }
+
         lv_coord_t init_y_off;
         init_y_off = area->y1;
         if(drv->rotated == LV_DISP_ROT_90) {
@@ -1210,37 +1395,48 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             area->y2 = area->y1 + area_w - 1;
         }
 
+        lv_color_t * rot_buf = lv_mem_buf_get(max_row * area_w * sizeof(lv_color_t));
+        LV_ASSERT_MALLOC(rot_buf);
+        if(rot_buf == NULL) {
+            draw_buf->flushing = 0;
+            return;
+        }
+
+        if(max_row == area_h && !drv->direct_mode && !drv->full_refresh) {
+            /*The whole area fits into the rotation buffer. Copy the result back to flush the draw buffer
+             *as usual, so the driver can keep it and rendering can continue in the other buffer.
+             *In direct mode and with full refresh the draw buffer holds the whole frame, which is kept unrotated
+             *and flushed from the rotation buffer instead.*/
+            draw_buf_rotate_90(is_270, area_w, area_h, color_p, rot_buf);
+            lv_memcpy(color_p, rot_buf, area_w * area_h * sizeof(lv_color_t));
+            lv_mem_buf_release(rot_buf);
+
+            if(drv->rotated == LV_DISP_ROT_90) {
+                area->x1 = init_y_off;
+                area->x2 = init_y_off + area_h - 1;
+            }
+            else {
+                area->x2 = drv->hor_res - 1 - init_y_off;
+                area->x1 = area->x2 - area_h + 1;
+            }
+            call_flush_cb(drv, area, color_p);
+            return;
+        }
+
         /*Rotate the screen in chunks, flushing after each one*/
         lv_coord_t row = 0;
         while(row < area_h) {
             lv_coord_t height = LV_MIN(max_row, area_h - row);
             draw_buf->flushing = 1;
-            if((row == 0) && (area_h >= area_w)) {
-                /*Rotate the initial area as a square*/
-                height = area_w;
-                draw_buf_rotate_90_sqr(drv->rotated == LV_DISP_ROT_270, area_w, color_p);
-                if(drv->rotated == LV_DISP_ROT_90) {
-                    area->x1 = init_y_off;
-                    area->x2 = init_y_off + area_w - 1;
-                }
-                else {
-                    area->x2 = drv->hor_res - 1 - init_y_off;
-                    area->x1 = area->x2 - area_w + 1;
-                }
+            draw_buf_rotate_90(is_270, area_w, height, color_p, rot_buf);
+
+            if(drv->rotated == LV_DISP_ROT_90) {
+                area->x1 = init_y_off + row;
+                area->x2 = init_y_off + row + height - 1;
             }
             else {
-                /*Rotate other areas using a maximum buffer size*/
-                if(rot_buf == NULL) rot_buf = lv_mem_buf_get(LV_DISP_ROT_MAX_BUF);
-                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, rot_buf);
-
-                if(drv->rotated == LV_DISP_ROT_90) {
-                    area->x1 = init_y_off + row;
-                    area->x2 = init_y_off + row + height - 1;
-                }
-                else {
-                    area->x2 = drv->hor_res - 1 - init_y_off - row;
-                    area->x1 = area->x2 - height + 1;
-                }
+                area->x2 = drv->hor_res - 1 - init_y_off - row;
+                area->x1 = area->x2 - height + 1;
             }
 
             /* The original part (chunk of the current area) were split into more parts here.
@@ -1253,16 +1449,15 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             }
 
             /*Flush the completed area to the display*/
-            call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
-            /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
+            call_flush_cb(drv, area, rot_buf);
+            /*The rotation buffer is reused for the next chunk so wait until it's flushed*/
             while(draw_buf->flushing) {
                 if(drv->wait_cb) drv->wait_cb(drv);
             }
             color_p += area_w * height;
             row += height;
         }
-        /*Free the allocated buffer at the end if necessary*/
-        if(rot_buf != NULL) lv_mem_buf_release(rot_buf);
+        lv_mem_buf_release(rot_buf);
     }
 }
 
@@ -1324,6 +1519,8 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    LV_PROFILER_FLUSH();
+    LV_LATENCY_FLUSH(drv);
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
@@ -71,6 +71,17 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Scroll an area of the display by moving its already flushed pixels before the next refresh.
+ * Requires `copy_area_cb` in the display driver. The caller has to invalidate the uncovered parts.
+ * @param disp  pointer to a display (NULL: use the default display)
+ * @param area  the area to scroll
+ * @param dx    horizontal movement
+ * @param dy    vertical movement
+ * @return      true: the pixels will be moved; false: not supported, the area needs to be redrawn
+ */
+bool _lv_refr_scroll_area(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -29,6 +29,7 @@ typedef enum {
     LV_DRAW_LAYER_FLAG_NONE,
     LV_DRAW_LAYER_FLAG_HAS_ALPHA,
     LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE,
+    LV_DRAW_LAYER_FLAG_RETAINED = 0x04,    /**< Render into a buffer owned by the caller. See `lv_draw_layer_create_retained()`*/
 } lv_draw_layer_flags_t;
 
 /**********************
@@ -46,6 +47,18 @@ typedef enum {
 struct _lv_draw_layer_ctx_t * lv_draw_layer_create(struct _lv_draw_ctx_t * draw_ctx, const lv_area_t * layer_area,
                                                    lv_draw_layer_flags_t flags);
 
+/**
+ * Create a layer context which renders into a buffer kept by the caller, e.g. to cache the rendering of a widget.
+ * The buffer is neither cleared when the layer is created nor freed when it's destroyed,
+ * so the earlier content can be updated partially by limiting `draw_ctx->clip_area`.
+ * @param draw_ctx      pointer to the current draw context
+ * @param layer_area    the coordinates of the layer
+ * @param buf           buffer of `lv_color_t` pixels with the size of `layer_area`
+ * @return              pointer to the layer context, or NULL if the draw unit can't render into memory
+ */
+struct _lv_draw_layer_ctx_t * lv_draw_layer_create_retained(struct _lv_draw_ctx_t * draw_ctx,
+                                                            const lv_area_t * layer_area, void * buf);
+
 /**
  * Adjust the layer_ctx and/or draw_ctx based on the `layer_ctx->area_act`.
  * It's called only if flags has `LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE`
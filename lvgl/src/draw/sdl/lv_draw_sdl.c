@@ -15,6 +15,7 @@
 #include "lv_draw_sdl.h"
 #include "lv_draw_sdl_utils.h"
 #include "lv_draw_sdl_texture_cache.h"
+#include "lv_draw_sdl_atlas.h"
 #include "lv_draw_sdl_layer.h"
 
 /*********************
@@ -47,6 +48,22 @@ void lv_draw_sdl_draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * ds
  *  STATIC PROTOTYPES
  **********************/
 
+static void draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static lv_res_t draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords,
+                         const void * src);
+static void draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                      const lv_point_t * point2);
+static void draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                     uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t * points,
+                         uint16_t point_cnt);
+static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static lv_draw_layer_ctx_t * layer_init(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                                        lv_draw_layer_flags_t flags);
+static void layer_blend(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx, const lv_draw_img_dsc_t * draw_dsc);
+static void layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx);
+static void wait_for_finish(lv_draw_ctx_t * draw_ctx);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -63,28 +80,33 @@ void lv_draw_sdl_init_ctx(lv_disp_drv_t * disp_drv, lv_draw_ctx_t * draw_ctx)
 {
     _lv_draw_sdl_utils_init();
     lv_memset_00(draw_ctx, sizeof(lv_draw_sdl_ctx_t));
-    draw_ctx->draw_rect = lv_draw_sdl_draw_rect;
-    draw_ctx->draw_img = lv_draw_sdl_img_core;
+    /*The letters are drawn in batches, the other functions draw the pending batch first*/
+    draw_ctx->draw_rect = draw_rect;
+    draw_ctx->draw_img = draw_img;
     draw_ctx->draw_letter = lv_draw_sdl_draw_letter;
-    draw_ctx->draw_line = lv_draw_sdl_draw_line;
-    draw_ctx->draw_arc = lv_draw_sdl_draw_arc;
-    draw_ctx->draw_polygon = lv_draw_sdl_polygon;
-    draw_ctx->draw_bg = lv_draw_sdl_draw_bg;
-    draw_ctx->layer_init = lv_draw_sdl_layer_init;
-    draw_ctx->layer_blend = lv_draw_sdl_layer_blend;
-    draw_ctx->layer_destroy = lv_draw_sdl_layer_destroy;
+    draw_ctx->draw_line = draw_line;
+    draw_ctx->draw_arc = draw_arc;
+    draw_ctx->draw_polygon = draw_polygon;
+    draw_ctx->draw_bg = draw_bg;
+    draw_ctx->layer_init = layer_init;
+    draw_ctx->layer_blend = layer_blend;
+    draw_ctx->layer_destroy = layer_destroy;
     draw_ctx->layer_instance_size = sizeof(lv_draw_sdl_layer_ctx_t);
+    draw_ctx->wait_for_finish = wait_for_finish;
     lv_draw_sdl_ctx_t * draw_ctx_sdl = (lv_draw_sdl_ctx_t *) draw_ctx;
     draw_ctx_sdl->renderer = ((lv_draw_sdl_drv_param_t *) disp_drv->user_data)->renderer;
     draw_ctx_sdl->internals = lv_mem_alloc(sizeof(lv_draw_sdl_context_internals_t));
     lv_memset_00(draw_ctx_sdl->internals, sizeof(lv_draw_sdl_context_internals_t));
     lv_draw_sdl_texture_cache_init(draw_ctx_sdl);
+    lv_draw_sdl_atlas_init(draw_ctx_sdl);
 }
 
 void lv_draw_sdl_deinit_ctx(lv_disp_drv_t * disp_drv, lv_draw_ctx_t * draw_ctx)
 {
     lv_draw_sdl_ctx_t * draw_ctx_sdl = (lv_draw_sdl_ctx_t *) draw_ctx;
+    /*The cached areas of the atlases are freed first*/
     lv_draw_sdl_texture_cache_deinit(draw_ctx_sdl);
+    lv_draw_sdl_atlas_deinit(draw_ctx_sdl);
     lv_mem_free(draw_ctx_sdl->internals);
     _lv_draw_sdl_utils_deinit();
 }
@@ -100,4 +122,68 @@ SDL_Texture * lv_draw_sdl_create_screen_texture(SDL_Renderer * renderer, lv_coor
  *   STATIC FUNCTIONS
  **********************/
 
+static void draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_draw_rect(draw_ctx, dsc, coords);
+}
+
+static lv_res_t draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords,
+                         const void * src)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    return lv_draw_sdl_img_core(draw_ctx, draw_dsc, coords, src);
+}
+
+static void draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                      const lv_point_t * point2)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_draw_line(draw_ctx, dsc, point1, point2);
+}
+
+static void draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                     uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+}
+
+static void draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t * points,
+                         uint16_t point_cnt)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_polygon(draw_ctx, draw_dsc, points, point_cnt);
+}
+
+static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_draw_bg(draw_ctx, dsc, coords);
+}
+
+static lv_draw_layer_ctx_t * layer_init(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                                        lv_draw_layer_flags_t flags)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    return lv_draw_sdl_layer_init(draw_ctx, layer_ctx, flags);
+}
+
+static void layer_blend(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx, const lv_draw_img_dsc_t * draw_dsc)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_layer_blend(draw_ctx, layer_ctx, draw_dsc);
+}
+
+static void layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+    lv_draw_sdl_layer_destroy(draw_ctx, layer_ctx);
+}
+
+static void wait_for_finish(lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sdl_batch_flush((lv_draw_sdl_ctx_t *) draw_ctx);
+}
+
 #endif /*LV_USE_GPU_SDL*/
@@ -0,0 +1,343 @@
+/**
+ * @file lv_draw_sdl_atlas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_GPU_SDL
+
+#include "lv_draw_sdl_atlas.h"
+#include "lv_draw_sdl_utils.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Empty pixels between the areas*/
+#define ATLAS_PADDING       1
+
+#define ATLAS_MAX_SHELVES   64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A row of areas with the same height, filled from the left*/
+typedef struct {
+    lv_coord_t y;
+    lv_coord_t h;
+    lv_coord_t x;           /*Left of the free space*/
+} atlas_shelf_t;
+
+typedef struct {
+    lv_draw_sdl_cache_atlas_t state;
+    SDL_Texture * texture;
+    Uint32 format;
+    uint32_t entry_cnt;     /*Areas in the texture cache*/
+    lv_coord_t free_y;      /*Top of the free space below the shelves*/
+    uint32_t shelf_cnt;
+    atlas_shelf_t shelves[ATLAS_MAX_SHELVES];
+} atlas_page_t;
+
+typedef struct {
+    lv_draw_sdl_cache_area_t area;
+    atlas_page_t * page;
+} atlas_entry_t;
+
+typedef struct lv_draw_sdl_batch_t {
+    SDL_Texture * texture;
+    int tex_w;
+    int tex_h;
+    uint32_t cnt;
+#if LV_DRAW_SDL_BATCH_GEOMETRY
+    SDL_Vertex vertices[LV_DRAW_SDL_BATCH_SIZE * 4];
+    int indices[LV_DRAW_SDL_BATCH_SIZE * 6];
+#endif
+} lv_draw_sdl_batch_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+#if LV_GPU_SDL_ATLAS_SIZE
+static atlas_page_t * page_create(lv_draw_sdl_ctx_t * ctx, Uint32 format);
+static void page_clear(lv_draw_sdl_ctx_t * ctx, atlas_page_t * page);
+static bool page_alloc(atlas_page_t * page, int w, int h, SDL_Rect * rect);
+static void atlas_entry_free(void * p);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sdl_atlas_init(lv_draw_sdl_ctx_t * ctx)
+{
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    _lv_ll_init(&internals->atlas_ll, sizeof(atlas_page_t));
+
+    lv_draw_sdl_batch_t * batch = SDL_malloc(sizeof(lv_draw_sdl_batch_t));
+    LV_ASSERT_MALLOC(batch);
+    SDL_memset(batch, 0, sizeof(lv_draw_sdl_batch_t));
+#if LV_DRAW_SDL_BATCH_GEOMETRY
+    for(int i = 0; i < LV_DRAW_SDL_BATCH_SIZE; i++) {
+        int * idx = &batch->indices[i * 6];
+        idx[0] = i * 4;
+        idx[1] = i * 4 + 1;
+        idx[2] = i * 4 + 2;
+        idx[3] = i * 4;
+        idx[4] = i * 4 + 2;
+        idx[5] = i * 4 + 3;
+    }
+#endif
+    internals->batch = batch;
+}
+
+void lv_draw_sdl_atlas_deinit(lv_draw_sdl_ctx_t * ctx)
+{
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    atlas_page_t * page;
+    _LV_LL_READ(&internals->atlas_ll, page) {
+        SDL_DestroyTexture(page->texture);
+    }
+    _lv_ll_clear(&internals->atlas_ll);
+    SDL_free(internals->batch);
+    internals->batch = NULL;
+}
+
+SDL_Texture * lv_draw_sdl_atlas_add(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length,
+                                    SDL_Surface * surface, SDL_Rect * rect)
+{
+#if LV_GPU_SDL_ATLAS_SIZE
+    if(surface->w > LV_GPU_SDL_ATLAS_SIZE / 4 || surface->h > LV_GPU_SDL_ATLAS_SIZE / 4) return NULL;
+
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    Uint32 format = surface->format->format;
+    atlas_page_t * page;
+    atlas_page_t * oldest = NULL;
+    uint32_t page_cnt = 0;
+    _LV_LL_READ(&internals->atlas_ll, page) {
+        if(page->format != format) continue;
+        page_cnt++;
+        /*Reuse the space if every area was evicted from the cache*/
+        if(page->entry_cnt == 0 && page->shelf_cnt > 0) page_clear(ctx, page);
+        if(page_alloc(page, surface->w, surface->h, rect)) break;
+        if(!oldest || (int32_t)(page->state.use_stamp - oldest->state.use_stamp) < 0) oldest = page;
+    }
+
+    if(page == NULL) {
+        if(page_cnt < LV_GPU_SDL_ATLAS_MAX_CNT) {
+            page = page_create(ctx, format);
+        }
+        else {
+            page = oldest;
+            page_clear(ctx, page);
+        }
+        if(page == NULL || !page_alloc(page, surface->w, surface->h, rect)) return NULL;
+    }
+
+    if(SDL_UpdateTexture(page->texture, rect, surface->pixels, surface->pitch) != 0) return NULL;
+
+    atlas_entry_t * entry = SDL_malloc(sizeof(atlas_entry_t));
+    LV_ASSERT_MALLOC(entry);
+    entry->area.rect = *rect;
+    entry->area.atlas = &page->state;
+    entry->area.generation = page->state.generation;
+    entry->page = page;
+    page->entry_cnt++;
+    page->state.use_stamp = ++internals->atlas_stamp;
+    if(!lv_draw_sdl_texture_cache_put_advanced(ctx, key, key_length, page->texture, entry, atlas_entry_free,
+                                               LV_DRAW_SDL_CACHE_FLAG_ATLAS)) {
+        atlas_entry_free(entry);
+        return NULL;
+    }
+    return page->texture;
+#else
+    LV_UNUSED(ctx);
+    LV_UNUSED(key);
+    LV_UNUSED(key_length);
+    LV_UNUSED(surface);
+    LV_UNUSED(rect);
+    return NULL;
+#endif
+}
+
+void lv_draw_sdl_batch_copy(lv_draw_sdl_ctx_t * ctx, SDL_Texture * texture, const SDL_Rect * src,
+                            const SDL_Rect * dst, lv_color_t color, lv_opa_t opa)
+{
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    SDL_Color sdl_color;
+    lv_color_to_sdl_color(&color, &sdl_color);
+    sdl_color.a = opa;
+#if LV_DRAW_SDL_BATCH_GEOMETRY
+    lv_draw_sdl_batch_t * batch = internals->batch;
+    if(batch->texture != texture || batch->cnt == LV_DRAW_SDL_BATCH_SIZE) {
+        lv_draw_sdl_batch_flush(ctx);
+        if(batch->texture != texture) {
+            batch->texture = texture;
+            SDL_QueryTexture(texture, NULL, NULL, &batch->tex_w, &batch->tex_h);
+        }
+    }
+
+    float x1 = (float) dst->x, y1 = (float) dst->y;
+    float x2 = (float)(dst->x + dst->w), y2 = (float)(dst->y + dst->h);
+    float u1 = (float) src->x / batch->tex_w, v1 = (float) src->y / batch->tex_h;
+    float u2 = (float)(src->x + src->w) / batch->tex_w, v2 = (float)(src->y + src->h) / batch->tex_h;
+    SDL_Vertex * v = &batch->vertices[batch->cnt * 4];
+    v[0].position.x = x1;
+    v[0].position.y = y1;
+    v[0].tex_coord.x = u1;
+    v[0].tex_coord.y = v1;
+    v[1].position.x = x2;
+    v[1].position.y = y1;
+    v[1].tex_coord.x = u2;
+    v[1].tex_coord.y = v1;
+    v[2].position.x = x2;
+    v[2].position.y = y2;
+    v[2].tex_coord.x = u2;
+    v[2].tex_coord.y = v2;
+    v[3].position.x = x1;
+    v[3].position.y = y2;
+    v[3].tex_coord.x = u1;
+    v[3].tex_coord.y = v2;
+    v[0].color = v[1].color = v[2].color = v[3].color = sdl_color;
+    batch->cnt++;
+#else
+    /* Without SDL_RenderGeometry the renderer still avoids switching textures between the copies */
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureAlphaMod(texture, sdl_color.a);
+    SDL_SetTextureColorMod(texture, sdl_color.r, sdl_color.g, sdl_color.b);
+    SDL_RenderCopy(ctx->renderer, texture, src, dst);
+    internals->glyph_draw_cnt++;
+#endif
+}
+
+void lv_draw_sdl_atlas_get_stats(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_texture_cache_stats_t * stats)
+{
+    atlas_page_t * page;
+    _LV_LL_READ(&ctx->internals->atlas_ll, page) {
+        stats->atlas_cnt++;
+        stats->atlas_entry_cnt += page->entry_cnt;
+        stats->atlas_size += (size_t) LV_GPU_SDL_ATLAS_SIZE * LV_GPU_SDL_ATLAS_SIZE * SDL_BYTESPERPIXEL(page->format);
+    }
+}
+
+void lv_draw_sdl_batch_flush(lv_draw_sdl_ctx_t * ctx)
+{
+#if LV_DRAW_SDL_BATCH_GEOMETRY
+    lv_draw_sdl_batch_t * batch = ctx->internals->batch;
+    if(batch == NULL || batch->cnt == 0) return;
+
+    /* The vertex colors are used instead of the modulation of the texture */
+    SDL_SetTextureBlendMode(batch->texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureAlphaMod(batch->texture, 0xFF);
+    SDL_SetTextureColorMod(batch->texture, 0xFF, 0xFF, 0xFF);
+    SDL_RenderGeometry(ctx->renderer, batch->texture, batch->vertices, (int)(batch->cnt * 4), batch->indices,
+                       (int)(batch->cnt * 6));
+    ctx->internals->glyph_draw_cnt++;
+    batch->cnt = 0;
+#else
+    LV_UNUSED(ctx);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_GPU_SDL_ATLAS_SIZE
+
+static atlas_page_t * page_create(lv_draw_sdl_ctx_t * ctx, Uint32 format)
+{
+    SDL_Texture * texture = SDL_CreateTexture(ctx->renderer, format, SDL_TEXTUREACCESS_STATIC, LV_GPU_SDL_ATLAS_SIZE,
+                                              LV_GPU_SDL_ATLAS_SIZE);
+    if(texture == NULL) return NULL;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    /* Clear the padding between the areas */
+    int pitch = LV_GPU_SDL_ATLAS_SIZE * SDL_BYTESPERPIXEL(format);
+    void * zeros = SDL_calloc(LV_GPU_SDL_ATLAS_SIZE, pitch);
+    if(zeros) {
+        SDL_UpdateTexture(texture, NULL, zeros, pitch);
+        SDL_free(zeros);
+    }
+
+    atlas_page_t * page = _lv_ll_ins_tail(&ctx->internals->atlas_ll);
+    LV_ASSERT_MALLOC(page);
+    if(page == NULL) {
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
+    SDL_memset(page, 0, sizeof(atlas_page_t));
+    page->texture = texture;
+    page->format = format;
+    LV_LOG_INFO("atlas texture %p created", texture);
+    return page;
+}
+
+static void page_clear(lv_draw_sdl_ctx_t * ctx, atlas_page_t * page)
+{
+    /* The quads to draw may use the areas */
+    lv_draw_sdl_batch_flush(ctx);
+    page->state.generation++;
+    page->entry_cnt = 0;
+    page->shelf_cnt = 0;
+    page->free_y = 0;
+}
+
+static bool page_alloc(atlas_page_t * page, int w, int h, SDL_Rect * rect)
+{
+    lv_coord_t pw = (lv_coord_t)(w + ATLAS_PADDING), ph = (lv_coord_t)(h + ATLAS_PADDING);
+
+    /* Use the lowest shelf where the area fits */
+    atlas_shelf_t * shelf = NULL;
+    for(uint32_t i = 0; i < page->shelf_cnt; i++) {
+        atlas_shelf_t * s = &page->shelves[i];
+        if(s->h < ph || LV_GPU_SDL_ATLAS_SIZE - s->x < pw) continue;
+        if(shelf == NULL || s->h < shelf->h) shelf = s;
+    }
+
+    /* Start a new shelf if the best one would waste more than half of its height */
+    bool room = page->shelf_cnt < ATLAS_MAX_SHELVES && LV_GPU_SDL_ATLAS_SIZE - page->free_y >= ph;
+    if(room && (shelf == NULL || shelf->h > ph * 2)) {
+        shelf = &page->shelves[page->shelf_cnt++];
+        shelf->y = page->free_y;
+        shelf->h = ph;
+        shelf->x = 0;
+        page->free_y += ph;
+    }
+    if(shelf == NULL) return false;
+
+    rect->x = shelf->x;
+    rect->y = shelf->y;
+    rect->w = w;
+    rect->h = h;
+    shelf->x += pw;
+    return true;
+}
+
+/* Called when the area was removed from the texture cache */
+static void atlas_entry_free(void * p)
+{
+    atlas_entry_t * entry = p;
+    if(entry->area.generation == entry->page->state.generation) {
+        entry->page->entry_cnt--;
+    }
+    SDL_free(entry);
+}
+
+#endif /*LV_GPU_SDL_ATLAS_SIZE*/
+
+#endif /*LV_USE_GPU_SDL*/
@@ -0,0 +1,96 @@
+/**
+ * @file lv_draw_sdl_atlas.h
+ * Small masks like glyphs packed into shared textures, and draws from them batched into few render calls.
+ */
+
+#ifndef LV_DRAW_SDL_ATLAS_H
+#define LV_DRAW_SDL_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_GPU_SDL
+
+#include LV_GPU_SDL_INCLUDE_PATH
+
+#include "lv_draw_sdl.h"
+#include "lv_draw_sdl_texture_cache.h"
+#include "../../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*SDL_RenderGeometry draws many quads of a texture with one call*/
+#define LV_DRAW_SDL_BATCH_GEOMETRY  SDL_VERSION_ATLEAST(2, 0, 18)
+
+/*Quads collected before a batch is drawn*/
+#define LV_DRAW_SDL_BATCH_SIZE      256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void lv_draw_sdl_atlas_init(lv_draw_sdl_ctx_t * ctx);
+
+void lv_draw_sdl_atlas_deinit(lv_draw_sdl_ctx_t * ctx);
+
+/**
+ * Pack a surface into an atlas texture of its format and put it into the texture cache.
+ * If every atlas is full, the least recently used one is cleared.
+ * @param ctx       drawing context
+ * @param key       key of the texture cache
+ * @param key_length size of `key`
+ * @param surface   the pixels to add. If it's larger than a quarter of the atlas, it's not added.
+ * @param rect      store the area of the pixels in the atlas here
+ * @return          the atlas texture, or NULL if the surface can't be added
+ */
+SDL_Texture * lv_draw_sdl_atlas_add(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length,
+                                    SDL_Surface * surface, SDL_Rect * rect);
+
+/**
+ * Draw an area of an atlas colored and blended like `SDL_RenderCopy()` with color and alpha mod.
+ * Consecutive draws of the same atlas are sent in one render call.
+ * @param ctx       drawing context
+ * @param texture   an atlas returned by `lv_draw_sdl_atlas_add()` or the texture cache
+ * @param src       area of the texture
+ * @param dst       area on the render target, the same size as `src`
+ * @param color     color to multiply the texture with
+ * @param opa       opacity to multiply the texture with
+ */
+void lv_draw_sdl_batch_copy(lv_draw_sdl_ctx_t * ctx, SDL_Texture * texture, const SDL_Rect * src,
+                            const SDL_Rect * dst, lv_color_t color, lv_opa_t opa);
+
+/**
+ * Add the counters of the atlases to the statistics of the texture cache
+ */
+void lv_draw_sdl_atlas_get_stats(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_texture_cache_stats_t * stats);
+
+/**
+ * Draw the collected quads. Has to be called before anything else is rendered or the render target is changed.
+ * @param ctx       drawing context
+ */
+void lv_draw_sdl_batch_flush(lv_draw_sdl_ctx_t * ctx);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_GPU_SDL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SDL_ATLAS_H*/
@@ -18,6 +18,7 @@
 
 #include "lv_draw_sdl_utils.h"
 #include "lv_draw_sdl_texture_cache.h"
+#include "lv_draw_sdl_atlas.h"
 #include "lv_draw_sdl_composite.h"
 #include "lv_draw_sdl_layer.h"
 
@@ -116,7 +117,10 @@ void lv_draw_sdl_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t
 
     lv_font_glyph_key_t glyph_key = font_key_glyph_create(font_p, letter);
     bool glyph_found = false;
-    SDL_Texture * texture = lv_draw_sdl_texture_cache_get(ctx, &glyph_key, sizeof(glyph_key), &glyph_found);
+    SDL_Rect glyph_rect;
+    bool in_atlas = false;
+    SDL_Texture * texture = lv_draw_sdl_texture_cache_get_area(ctx, &glyph_key, sizeof(glyph_key), &glyph_found,
+                                                               &glyph_rect, &in_atlas);
     bool in_cache = false;
     if(!glyph_found) {
         if(g.resolved_font) {
@@ -126,10 +130,18 @@ void lv_draw_sdl_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t
         uint8_t * buf = lv_mem_alloc(g.box_w * g.box_h);
         lv_sdl_to_8bpp(buf, bmp, g.box_w, g.box_h, g.box_w, g.bpp);
         SDL_Surface * mask = lv_sdl_create_opa_surface(buf, g.box_w, g.box_h, g.box_w);
-        texture = SDL_CreateTextureFromSurface(renderer, mask);
+        /*Small glyphs share atlas textures, so a label is drawn with a few render calls*/
+        texture = lv_draw_sdl_atlas_add(ctx, &glyph_key, sizeof(glyph_key), mask, &glyph_rect);
+        in_atlas = texture != NULL;
+        in_cache = in_atlas;
+        if(!in_atlas) {
+            texture = SDL_CreateTextureFromSurface(renderer, mask);
+            glyph_rect.x = 0;
+            glyph_rect.y = 0;
+            in_cache = lv_draw_sdl_texture_cache_put(ctx, &glyph_key, sizeof(glyph_key), texture);
+        }
         SDL_FreeSurface(mask);
         lv_mem_free(buf);
-        in_cache = lv_draw_sdl_texture_cache_put(ctx, &glyph_key, sizeof(glyph_key), texture);
     }
     else {
         in_cache = true;
@@ -138,6 +150,11 @@ void lv_draw_sdl_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t
         return;
     }
 
+    /*Masks and blend modes change the render target*/
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL || lv_draw_mask_is_any(&draw_area)) {
+        lv_draw_sdl_batch_flush(ctx);
+    }
+
     lv_area_t t_letter = letter_area, t_clip = *clip_area, apply_area;
     bool has_composite = lv_draw_sdl_composite_begin(ctx, &letter_area, clip_area, NULL, dsc->blend_mode, &t_letter,
                                                      &t_clip, &apply_area);
@@ -154,14 +171,22 @@ void lv_draw_sdl_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t
     }
     SDL_Rect srcrect, dstrect;
     lv_area_to_sdl_rect(&draw_area, &dstrect);
-    srcrect.x = draw_area.x1 - t_letter.x1;
-    srcrect.y = draw_area.y1 - t_letter.y1;
+    srcrect.x = glyph_rect.x + draw_area.x1 - t_letter.x1;
+    srcrect.y = glyph_rect.y + draw_area.y1 - t_letter.y1;
     srcrect.w = dstrect.w;
     srcrect.h = dstrect.h;
-    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-    SDL_SetTextureAlphaMod(texture, opa);
-    SDL_SetTextureColorMod(texture, color.ch.red, color.ch.green, color.ch.blue);
-    SDL_RenderCopy(renderer, texture, &srcrect, &dstrect);
+    ctx->internals->glyph_cnt++;
+    if(in_atlas && !has_composite) {
+        lv_draw_sdl_batch_copy(ctx, texture, &srcrect, &dstrect, color, opa);
+    }
+    else {
+        lv_draw_sdl_batch_flush(ctx);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureAlphaMod(texture, opa);
+        SDL_SetTextureColorMod(texture, color.ch.red, color.ch.green, color.ch.blue);
+        SDL_RenderCopy(renderer, texture, &srcrect, &dstrect);
+        ctx->internals->glyph_draw_cnt++;
+    }
 
     lv_draw_sdl_composite_end(ctx, &apply_area, dsc->blend_mode);
 
@@ -45,6 +45,9 @@
 lv_draw_layer_ctx_t * lv_draw_sdl_layer_init(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
                                              lv_draw_layer_flags_t flags)
 {
+    /*The layers are rendered into textures, not into memory buffers*/
+    if(flags & LV_DRAW_LAYER_FLAG_RETAINED) return NULL;
+
     lv_draw_sdl_ctx_t * ctx = (lv_draw_sdl_ctx_t *) draw_ctx;
     SDL_Renderer * renderer = ctx->renderer;
 
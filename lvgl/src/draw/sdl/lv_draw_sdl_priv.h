@@ -22,6 +22,7 @@ extern "C" {
 
 #include "../lv_draw.h"
 #include "../../misc/lv_lru.h"
+#include "../../misc/lv_ll.h"
 
 /*********************
  *      DEFINES
@@ -33,6 +34,15 @@ extern "C" {
 
 typedef struct lv_draw_sdl_context_internals_t {
     lv_lru_t * texture_cache;
+    uint32_t cache_hit_cnt;
+    uint32_t cache_miss_cnt;
+    uint32_t cache_evict_cnt;
+    bool cache_putting;
+    lv_ll_t atlas_ll;
+    uint32_t atlas_stamp;
+    struct lv_draw_sdl_batch_t * batch;
+    uint32_t glyph_cnt;
+    uint32_t glyph_draw_cnt;
     SDL_Texture * mask;
     SDL_Texture * composition;
     bool composition_cached;
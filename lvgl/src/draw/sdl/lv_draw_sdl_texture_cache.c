@@ -14,6 +14,7 @@
 #include "lv_draw_sdl_texture_cache.h"
 
 #include "lv_draw_sdl_utils.h"
+#include "lv_draw_sdl_atlas.h"
 
 /*********************
  *      DEFINES
@@ -28,6 +29,7 @@ typedef struct {
     void * userdata;
     lv_lru_free_t * userdata_free;
     lv_draw_sdl_cache_flag_t flags;
+    lv_draw_sdl_context_internals_t * internals;
 } draw_cache_value_t;
 
 typedef struct {
@@ -63,6 +65,7 @@ void lv_draw_sdl_texture_cache_init(lv_draw_sdl_ctx_t * ctx)
 void lv_draw_sdl_texture_cache_deinit(lv_draw_sdl_ctx_t * ctx)
 {
     lv_lru_del(ctx->internals->texture_cache);
+    ctx->internals->texture_cache = NULL;
 }
 
 SDL_Texture * lv_draw_sdl_texture_cache_get(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length, bool * found)
@@ -81,6 +84,25 @@ SDL_Texture * lv_draw_sdl_texture_cache_get_with_userdata(lv_draw_sdl_ctx_t * ct
     return value->texture;
 }
 
+SDL_Texture * lv_draw_sdl_texture_cache_get_area(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length,
+                                                 bool * found, SDL_Rect * rect, bool * in_atlas)
+{
+    draw_cache_value_t * value = draw_cache_get_entry(ctx, key, key_length, found);
+    if(!value || !value->texture) return NULL;
+    *in_atlas = (value->flags & LV_DRAW_SDL_CACHE_FLAG_ATLAS) != 0;
+    if(*in_atlas) {
+        lv_draw_sdl_cache_area_t * area = value->userdata;
+        area->atlas->use_stamp = ++ctx->internals->atlas_stamp;
+        *rect = area->rect;
+    }
+    else {
+        rect->x = 0;
+        rect->y = 0;
+        SDL_QueryTexture(value->texture, NULL, NULL, &rect->w, &rect->h);
+    }
+    return value->texture;
+}
+
 bool lv_draw_sdl_texture_cache_put(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length, SDL_Texture * texture)
 {
     return lv_draw_sdl_texture_cache_put_advanced(ctx, key, key_length, texture, NULL, NULL, 0);
@@ -96,6 +118,7 @@ bool lv_draw_sdl_texture_cache_put_advanced(lv_draw_sdl_ctx_t * ctx, const void
     value->userdata = userdata;
     value->userdata_free = userdata_free;
     value->flags = flags;
+    value->internals = ctx->internals;
     if(!texture) {
         return lv_lru_set(lru, key, key_length, value, 1) == LV_LRU_OK;
     }
@@ -107,10 +130,44 @@ bool lv_draw_sdl_texture_cache_put_advanced(lv_draw_sdl_ctx_t * ctx, const void
     Uint32 format;
     int access, width, height;
     if(SDL_QueryTexture(texture, &format, &access, &width, &height) != 0) {
+        SDL_free(value);
         return false;
     }
+    if(flags & LV_DRAW_SDL_CACHE_FLAG_ATLAS) {
+        /* Only the used area of an atlas counts into cache size */
+        const lv_draw_sdl_cache_area_t * area = userdata;
+        width = area->rect.w;
+        height = area->rect.h;
+    }
     LV_LOG_INFO("cache texture %p, %d*%d@%dbpp", texture, width, height, SDL_BITSPERPIXEL(format));
-    return lv_lru_set(lru, key, key_length, value, width * height * SDL_BITSPERPIXEL(format) / 8) == LV_LRU_OK;
+    ctx->internals->cache_putting = true;
+    lv_lru_res_t res = lv_lru_set(lru, key, key_length, value, width * height * SDL_BITSPERPIXEL(format) / 8);
+    ctx->internals->cache_putting = false;
+    return res == LV_LRU_OK;
+}
+
+void lv_draw_sdl_texture_cache_get_stats(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_texture_cache_stats_t * stats)
+{
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    SDL_memset(stats, 0, sizeof(lv_draw_sdl_texture_cache_stats_t));
+    stats->hit_cnt = internals->cache_hit_cnt;
+    stats->miss_cnt = internals->cache_miss_cnt;
+    stats->evict_cnt = internals->cache_evict_cnt;
+    stats->size = internals->texture_cache->total_memory - internals->texture_cache->free_memory;
+    stats->max_size = internals->texture_cache->total_memory;
+    stats->glyph_cnt = internals->glyph_cnt;
+    stats->glyph_draw_cnt = internals->glyph_draw_cnt;
+    lv_draw_sdl_atlas_get_stats(ctx, stats);
+}
+
+void lv_draw_sdl_texture_cache_reset_stats(lv_draw_sdl_ctx_t * ctx)
+{
+    lv_draw_sdl_context_internals_t * internals = ctx->internals;
+    internals->cache_hit_cnt = 0;
+    internals->cache_miss_cnt = 0;
+    internals->cache_evict_cnt = 0;
+    internals->glyph_cnt = 0;
+    internals->glyph_draw_cnt = 0;
 }
 
 lv_draw_sdl_cache_key_head_img_t * lv_draw_sdl_texture_img_key_create(const void * src, int32_t frame_id, size_t * size)
@@ -144,7 +201,11 @@ lv_draw_sdl_cache_key_head_img_t * lv_draw_sdl_texture_img_key_create(const void
 
 static void draw_cache_free_value(draw_cache_value_t * value)
 {
-    if(value->texture && !(value->flags & LV_DRAW_SDL_CACHE_FLAG_MANAGED)) {
+    /* Values are freed while putting only to make room, or if the key is put again */
+    if(value->internals->cache_putting) {
+        value->internals->cache_evict_cnt++;
+    }
+    if(value->texture && !(value->flags & (LV_DRAW_SDL_CACHE_FLAG_MANAGED | LV_DRAW_SDL_CACHE_FLAG_ATLAS))) {
         LV_LOG_INFO("destroy texture %p", value->texture);
         SDL_DestroyTexture(value->texture);
     }
@@ -160,12 +221,22 @@ static draw_cache_value_t * draw_cache_get_entry(lv_draw_sdl_ctx_t * ctx, const
     lv_lru_t * lru = ctx->internals->texture_cache;
     draw_cache_value_t * value = NULL;
     lv_lru_get(lru, key, key_length, (void **) &value);
+    if(value && (value->flags & LV_DRAW_SDL_CACHE_FLAG_ATLAS)) {
+        /* The area was overwritten if the atlas has been cleared since */
+        const lv_draw_sdl_cache_area_t * area = value->userdata;
+        if(area->atlas->generation != area->generation) {
+            lv_lru_remove(lru, key, key_length);
+            value = NULL;
+        }
+    }
     if(!value) {
+        ctx->internals->cache_miss_cnt++;
         if(found) {
             *found = false;
         }
         return NULL;
     }
+    ctx->internals->cache_hit_cnt++;
     if(found) {
         *found = true;
     }
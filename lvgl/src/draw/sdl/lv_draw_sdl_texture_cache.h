@@ -58,8 +58,34 @@ typedef enum {
 typedef enum {
     LV_DRAW_SDL_CACHE_FLAG_NONE = 0,
     LV_DRAW_SDL_CACHE_FLAG_MANAGED = 1,
+    LV_DRAW_SDL_CACHE_FLAG_ATLAS = 2,   /*The texture is an atlas, the userdata starts with the used area*/
 } lv_draw_sdl_cache_flag_t;
 
+typedef struct {
+    uint32_t generation;    /*Incremented when the atlas is cleared*/
+    uint32_t use_stamp;     /*Updated when an area of the atlas is found in the cache*/
+} lv_draw_sdl_cache_atlas_t;
+
+/*The area of an atlas texture used by a cache entry*/
+typedef struct {
+    SDL_Rect rect;
+    lv_draw_sdl_cache_atlas_t * atlas;
+    uint32_t generation;    /*The entry is dropped if the atlas was cleared since*/
+} lv_draw_sdl_cache_area_t;
+
+typedef struct {
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+    uint32_t evict_cnt;         /**< Entries removed to make room for others*/
+    size_t size;                /**< Bytes of the cached textures and atlas areas*/
+    size_t max_size;            /**< `LV_GPU_SDL_LRU_SIZE`*/
+    uint32_t atlas_cnt;         /**< Atlas textures*/
+    uint32_t atlas_entry_cnt;   /**< Cached areas in them*/
+    size_t atlas_size;          /**< Bytes of the atlas textures*/
+    uint32_t glyph_cnt;         /**< Glyphs drawn*/
+    uint32_t glyph_draw_cnt;    /**< Render calls which drew them*/
+} lv_draw_sdl_texture_cache_stats_t;
+
 typedef struct {
     lv_sdl_cache_key_magic_t magic;
     lv_img_src_t type;
@@ -82,6 +108,13 @@ SDL_Texture * lv_draw_sdl_texture_cache_get(lv_draw_sdl_ctx_t * ctx, const void
 SDL_Texture * lv_draw_sdl_texture_cache_get_with_userdata(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length,
                                                           bool * found, void ** userdata);
 
+/**
+ * Find cached texture by key, with the area of the texture to use.
+ * The area is a part of an atlas (`in_atlas` is set to true) or the whole texture.
+ */
+SDL_Texture * lv_draw_sdl_texture_cache_get_area(lv_draw_sdl_ctx_t * ctx, const void * key, size_t key_length,
+                                                 bool * found, SDL_Rect * rect, bool * in_atlas);
+
 /**
  * @return Whether the texture has been put in the cache
  */
@@ -94,6 +127,13 @@ bool lv_draw_sdl_texture_cache_put_advanced(lv_draw_sdl_ctx_t * ctx, const void
                                             SDL_Texture * texture, void * userdata, void userdata_free(void *),
                                             lv_draw_sdl_cache_flag_t flags);
 
+/**
+ * Get the counters of the texture cache, the atlases and the glyph draws
+ */
+void lv_draw_sdl_texture_cache_get_stats(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_texture_cache_stats_t * stats);
+
+void lv_draw_sdl_texture_cache_reset_stats(lv_draw_sdl_ctx_t * ctx);
+
 lv_draw_sdl_cache_key_head_img_t * lv_draw_sdl_texture_img_key_create(const void * src, int32_t frame_id,
                                                                       size_t * size);
 
@@ -39,8 +39,9 @@ typedef struct {
 typedef struct {
     lv_draw_layer_ctx_t base_draw;
 
-    uint32_t buf_size_bytes: 31;
+    uint32_t buf_size_bytes: 30;
     uint32_t has_alpha : 1;
+    uint32_t retained : 1;      /**< The buffer is owned by the caller*/
 } lv_draw_sw_layer_ctx_t;
 
 /**********************
@@ -0,0 +1,163 @@
+/**
+ * @file lv_draw_sw_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_cache.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_assert.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#undef ALIGN
+#if defined(LV_ARCH_64)
+    #define ALIGN(X)    (((X) + 7) & ~7)
+#else
+    #define ALIGN(X)    (((X) + 3) & ~3)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t hash;
+    uint32_t key_size;
+    size_t size;        /*Bytes counted in the budget*/
+    uint8_t * buf;      /*The key and then the data*/
+} cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void free_entry(_lv_draw_sw_cache_t * cache, cache_entry_t * entry);
+static uint32_t compute_hash(const void * key, uint32_t key_size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_draw_sw_cache_init(_lv_draw_sw_cache_t * cache, size_t max_size)
+{
+    if(cache->entries.n_size) return;
+    _lv_ll_init(&cache->entries, sizeof(cache_entry_t));
+    cache->stats.max_size = max_size;
+}
+
+void _lv_draw_sw_cache_set_size(_lv_draw_sw_cache_t * cache, size_t max_size)
+{
+    _lv_draw_sw_cache_init(cache, max_size);
+    cache->stats.max_size = max_size;
+
+    cache_entry_t * entry = _lv_ll_get_tail(&cache->entries);
+    while(entry && cache->stats.size > max_size) {
+        cache_entry_t * prev = _lv_ll_get_prev(&cache->entries, entry);
+        free_entry(cache, entry);
+        cache->stats.evict_cnt++;
+        entry = prev;
+    }
+}
+
+void _lv_draw_sw_cache_clean(_lv_draw_sw_cache_t * cache)
+{
+    if(cache->entries.n_size == 0) return;
+
+    cache_entry_t * entry = _lv_ll_get_head(&cache->entries);
+    while(entry) {
+        cache_entry_t * next = _lv_ll_get_next(&cache->entries, entry);
+        free_entry(cache, entry);
+        entry = next;
+    }
+}
+
+void * _lv_draw_sw_cache_get(_lv_draw_sw_cache_t * cache, const void * key, uint32_t key_size)
+{
+    if(cache->stats.max_size == 0) return NULL;
+
+    uint32_t hash = compute_hash(key, key_size);
+    cache_entry_t * entry;
+    _LV_LL_READ(&cache->entries, entry) {
+        if(entry->hash == hash && entry->key_size == key_size && memcmp(entry->buf, key, key_size) == 0) break;
+    }
+
+    if(entry == NULL) {
+        cache->stats.miss_cnt++;
+        return NULL;
+    }
+
+    cache->stats.hit_cnt++;
+    cache_entry_t * head = _lv_ll_get_head(&cache->entries);
+    if(entry != head) _lv_ll_move_before(&cache->entries, entry, head);
+    return entry->buf + ALIGN(key_size);
+}
+
+void * _lv_draw_sw_cache_add(_lv_draw_sw_cache_t * cache, const void * key, uint32_t key_size, size_t data_size)
+{
+    size_t size = sizeof(cache_entry_t) + ALIGN(key_size) + data_size;
+    if(size > cache->stats.max_size) return NULL;
+
+    /*Make room by freeing the least recently used entries*/
+    while(cache->stats.size + size > cache->stats.max_size) {
+        free_entry(cache, _lv_ll_get_tail(&cache->entries));
+        cache->stats.evict_cnt++;
+    }
+
+    uint8_t * buf = lv_mem_alloc(ALIGN(key_size) + data_size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return NULL;
+
+    cache_entry_t * entry = _lv_ll_ins_head(&cache->entries);
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+
+    entry->hash = compute_hash(key, key_size);
+    entry->key_size = key_size;
+    entry->size = size;
+    entry->buf = buf;
+    lv_memcpy(buf, key, key_size);
+
+    cache->stats.size += size;
+    cache->stats.entry_cnt++;
+    return buf + ALIGN(key_size);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void free_entry(_lv_draw_sw_cache_t * cache, cache_entry_t * entry)
+{
+    cache->stats.size -= entry->size;
+    cache->stats.entry_cnt--;
+    lv_mem_free(entry->buf);
+    _lv_ll_remove(&cache->entries, entry);
+    lv_mem_free(entry);
+}
+
+/*FNV-1a*/
+static uint32_t compute_hash(const void * key, uint32_t key_size)
+{
+    const uint8_t * p = key;
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < key_size; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file lv_draw_sw_cache.h
+ * A keyed cache of computed drawing data with least recently used eviction under a byte budget.
+ * Used for the gradient color maps, the blurred shadow corners and the coverage of rounded corners.
+ */
+
+#ifndef LV_DRAW_SW_CACHE_H
+#define LV_DRAW_SW_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_ll.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Lookups which found the data*/
+    uint32_t miss_cnt;      /**< Lookups which had to compute the data*/
+    uint32_t evict_cnt;     /**< Entries removed to make room for new ones*/
+    uint32_t entry_cnt;     /**< Entries in the cache now*/
+    size_t size;            /**< Bytes used by the entries now*/
+    size_t max_size;        /**< The byte budget*/
+} lv_draw_sw_cache_stats_t;
+
+typedef struct {
+    lv_ll_t entries;        /**< The most recently used first*/
+    lv_draw_sw_cache_stats_t stats;
+} _lv_draw_sw_cache_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a zeroed cache, e.g. a GC root after `lv_init()`.
+ * Does nothing if the cache is initialized already, e.g. its size was set.
+ * @param cache     pointer to a cache
+ * @param max_size  the budget in bytes, 0 to disable the cache
+ */
+void _lv_draw_sw_cache_init(_lv_draw_sw_cache_t * cache, size_t max_size);
+
+/**
+ * Set the byte budget of a cache. The least recently used entries are freed until the others fit.
+ * @param cache     pointer to a cache, zeroed or used before
+ * @param max_size  the new budget in bytes, 0 to disable the cache
+ */
+void _lv_draw_sw_cache_set_size(_lv_draw_sw_cache_t * cache, size_t max_size);
+
+/**
+ * Free every entry of a cache. The statistics are kept.
+ * @param cache     pointer to a cache
+ */
+void _lv_draw_sw_cache_clean(_lv_draw_sw_cache_t * cache);
+
+/**
+ * Find the data of a key and make it the most recently used
+ * @param cache     pointer to a cache
+ * @param key       the bytes identifying the data. Zero the padding of structures.
+ * @param key_size  size of `key` in bytes
+ * @return          the data or NULL if it's not in the cache
+ */
+void * _lv_draw_sw_cache_get(_lv_draw_sw_cache_t * cache, const void * key, uint32_t key_size);
+
+/**
+ * Add an entry for a key. The least recently used entries are freed to make room for it.
+ * The returned data is valid until the next call of `_lv_draw_sw_cache_add()` or `_lv_draw_sw_cache_set_size()`.
+ * @param cache     pointer to a cache
+ * @param key       the bytes identifying the data. It shouldn't be in the cache yet.
+ * @param key_size  size of `key` in bytes
+ * @param data_size size of the data in bytes
+ * @return          uninitialized data to fill, or NULL if it doesn't fit into the budget
+ */
+void * _lv_draw_sw_cache_add(_lv_draw_sw_cache_t * cache, const void * key, uint32_t key_size, size_t data_size);
+
+#if LV_DRAW_COMPLEX
+/**
+ * Set the byte budget of the shadow cache. The least recently used corners are freed if the others don't fit.
+ * Only shadows with `shadow_width + radius <= LV_SHADOW_CACHE_SIZE` are cached.
+ * @param max_bytes the new budget, 0 to disable the cache
+ */
+void lv_draw_sw_shadow_cache_set_size(size_t max_bytes);
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stats     store the statistics here
+ */
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_cache_stats_t * stats);
+
+/**
+ * Set the byte budget of the rounded corner cache. The least recently used radii are freed if the others don't fit.
+ * @param max_bytes the new budget, 0 to disable the cache
+ */
+void lv_draw_sw_corner_cache_set_size(size_t max_bytes);
+
+/**
+ * Get the statistics of the rounded corner cache
+ * @param stats     store the statistics here
+ */
+void lv_draw_sw_corner_cache_get_stats(lv_draw_sw_cache_stats_t * stats);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_CACHE_H*/
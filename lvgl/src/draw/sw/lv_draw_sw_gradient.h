@@ -16,6 +16,7 @@ extern "C" {
 #include "../../misc/lv_color.h"
 #include "../../misc/lv_style.h"
 #include "lv_draw_sw_dither.h"
+#include "lv_draw_sw_cache.h"
 
 /*********************
  *      DEFINES
@@ -38,10 +39,6 @@ typedef lv_color_t lv_grad_color_t;
  *  it's possible to cache the computation in this structure instance.
  *  Whenever possible, this structure is reused instead of recomputing the gradient map */
 typedef struct _lv_gradient_cache_t {
-    uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
-                                   * If the key does not match, the cache item is not used */
-    uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
     uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
     uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
     lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
@@ -73,7 +70,7 @@ lv_grad_color_t /* LV_ATTRIBUTE_FAST_MEM */ lv_gradient_calculate(const lv_grad_
                                                                   lv_coord_t frac);
 
 /**
- * Set the gradient cache size
+ * Set the gradient cache size. The least recently used maps are freed if the others don't fit.
  * @param max_bytes Max cahce size
  */
 void lv_gradient_set_cache_size(size_t max_bytes);
@@ -81,6 +78,12 @@ void lv_gradient_set_cache_size(size_t max_bytes);
 /** Free the gradient cache */
 void lv_gradient_free_cache(void);
 
+/**
+ * Get the statistics of the gradient cache
+ * @param stats     store the statistics here
+ */
+void lv_gradient_get_cache_stats(lv_draw_sw_cache_stats_t * stats);
+
 /** Get a gradient cache from the given parameters */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, lv_coord_t w, lv_coord_t h);
 
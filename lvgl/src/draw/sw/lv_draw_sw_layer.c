@@ -50,7 +50,21 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
 
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
     uint32_t px_size = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
-    if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
+    if(flags & LV_DRAW_LAYER_FLAG_RETAINED) {
+        /*Keep the content of the caller's buffer to allow partial updates*/
+        if(layer_sw_ctx->base_draw.buf == NULL) return NULL;
+        layer_sw_ctx->base_draw.area_act = layer_sw_ctx->base_draw.area_full;
+        layer_sw_ctx->buf_size_bytes = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
+        layer_sw_ctx->retained = 1;
+
+        draw_ctx->buf = layer_sw_ctx->base_draw.buf;
+        draw_ctx->buf_area = &layer_sw_ctx->base_draw.area_act;
+        draw_ctx->clip_area = &layer_sw_ctx->base_draw.area_act;
+
+        lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
+        disp_refr->driver->screen_transp = 0;
+    }
+    else if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
         layer_sw_ctx->buf_size_bytes = LV_LAYER_SIMPLE_BUF_SIZE;
         uint32_t full_size = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
         if(layer_sw_ctx->buf_size_bytes > full_size) layer_sw_ctx->buf_size_bytes = full_size;
@@ -141,6 +155,9 @@ void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * la
 {
     LV_UNUSED(draw_ctx);
 
+    lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+    if(layer_sw_ctx->retained) return;
+
     lv_mem_free(layer_ctx->buf);
 }
 
@@ -11,6 +11,7 @@
 #include "../../misc/lv_txt_ap.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
+#include "../../misc/lv_gc.h"
 #include "lv_draw_sw_dither.h"
 
 /*********************
@@ -24,6 +25,24 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_COMPLEX
+/*Everything a blurred corner depends on. Beyond twice the corner size
+ *the other corners of the rectangle don't reach into the corner buffer.*/
+typedef struct {
+    int32_t shadow_width;
+    int32_t radius;
+    int32_t w;
+    int32_t h;
+} shadow_key_t;
+
+/*A row of a rounded corner counted from the outer edge of the rectangle.
+ *The pixels before `x_start` are transparent and the pixels from `x_full` are fully covered.*/
+typedef struct {
+    uint16_t x_start;
+    uint16_t x_full;
+    uint32_t ofs;       /*Index of the coverage of the row in the table. The mirrored coverage follows it.*/
+} corner_row_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -40,6 +59,9 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ draw_shadow(lv_draw_ctx_t * draw_ctx, co
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf,
                                                                lv_coord_t s, lv_coord_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+static bool draw_bg_round_flat(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                               lv_coord_t r, lv_opa_t opa);
+static uint8_t * corner_table_create(lv_coord_t r, bool * cached);
 #endif
 
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -52,11 +74,6 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
-#endif
 
 /**********************
  *      MACROS
@@ -92,6 +109,28 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
     draw_bg_img(draw_ctx, dsc, coords);
 }
 
+#if LV_DRAW_COMPLEX
+void lv_draw_sw_shadow_cache_set_size(size_t max_bytes)
+{
+    _lv_draw_sw_cache_set_size(&LV_GC_ROOT(_lv_shadow_cache), max_bytes);
+}
+
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_cache_stats_t * stats)
+{
+    *stats = LV_GC_ROOT(_lv_shadow_cache).stats;
+}
+
+void lv_draw_sw_corner_cache_set_size(size_t max_bytes)
+{
+    _lv_draw_sw_cache_set_size(&LV_GC_ROOT(_lv_corner_cache), max_bytes);
+}
+
+void lv_draw_sw_corner_cache_get_stats(lv_draw_sw_cache_stats_t * stats)
+{
+    *stats = LV_GC_ROOT(_lv_corner_cache).stats;
+}
+#endif
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -144,6 +183,11 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     int32_t short_side = LV_MIN(coords_bg_w, coords_bg_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+    /*Only the own radius masks a flat rectangle: draw its corners from coverage tables and fill the rest*/
+    if(!mask_any && rout > 0 && grad_dir == LV_GRAD_DIR_NONE) {
+        if(draw_bg_round_flat(draw_ctx, &blend_dsc, &bg_coords, rout, opa)) return;
+    }
+
     /*Add a radius mask if there is radius*/
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     int16_t mask_rout_id = LV_MASK_ID_INV;
@@ -327,6 +371,201 @@ bg_clean_up:
 #endif
 }
 
+#if LV_DRAW_COMPLEX
+/**
+ * Draw a rounded rectangle with a single color and no other masks.
+ * The corner rows are blended with the coverage of the radius only where it's anti-aliased,
+ * every other part of the rectangle is a simple fill.
+ * With opacity the corner rows are blended as a whole with the opacity in the mask, as it's faster than a fill with opacity.
+ * @param draw_ctx      pointer to a draw context
+ * @param blend_dsc     blend descriptor with the color and blend mode set
+ * @param coords        the coordinates of the rectangle
+ * @param r             the radius, not larger than the half of the shorter side
+ * @param opa           opacity of the rectangle
+ * @return              false if the coverage table couldn't be allocated
+ */
+static bool draw_bg_round_flat(lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                               lv_coord_t r, lv_opa_t opa)
+{
+    _lv_draw_sw_cache_init(&LV_GC_ROOT(_lv_corner_cache), LV_CORNER_CACHE_MEM_SIZE);
+
+    int32_t key = r;
+    bool cached = true;
+    uint8_t * table = _lv_draw_sw_cache_get(&LV_GC_ROOT(_lv_corner_cache), &key, sizeof(key));
+    if(table == NULL) {
+        table = corner_table_create(r, &cached);
+        if(table == NULL) return false;
+    }
+
+    const corner_row_t * rows = (const corner_row_t *)table;
+    const lv_opa_t * cov = table + r * sizeof(corner_row_t);
+
+    /*The blending might modify the mask (e.g. without anti-aliasing) so always pass a copy*/
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_opa_t * mask_buf = lv_mem_buf_get(opa >= LV_OPA_MAX ? r * 2 : w);
+    const lv_area_t * clip = draw_ctx->clip_area;
+    lv_area_t area;
+    blend_dsc->blend_area = &area;
+    blend_dsc->mask_area = &area;
+
+    lv_coord_t y;
+    for(y = 0; y < r; y++) {
+        lv_coord_t row_y[2] = {coords->y1 + y, coords->y2 - y};
+        bool top_in = row_y[0] >= clip->y1 && row_y[0] <= clip->y2;
+        bool bottom_in = row_y[1] >= clip->y1 && row_y[1] <= clip->y2;
+        if(!top_in && !bottom_in) continue;
+
+        const corner_row_t * row = &rows[y];
+        int32_t len = row->x_full - row->x_start;
+        const lv_opa_t * row_cov = cov + row->ofs;
+        int32_t i;
+
+        if(opa < LV_OPA_MAX) {
+            /*The mask of the row from `x_start` to `w - x_start`*/
+            int32_t mid_len = w - row->x_full * 2;
+            for(i = 0; i < len; i++) mask_buf[i] = LV_UDIV255(row_cov[i] * opa);
+            lv_memset(mask_buf + len, opa, mid_len);
+            for(i = 0; i < len; i++) mask_buf[len + mid_len + i] = LV_UDIV255(row_cov[len + i] * opa);
+
+            blend_dsc->opa = LV_OPA_COVER;
+            blend_dsc->mask_buf = mask_buf;
+            blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+            area.x1 = coords->x1 + row->x_start;
+            area.x2 = coords->x2 - row->x_start;
+            for(i = 0; i < 2; i++) {
+                if(i == 0 && !top_in) continue;
+                if(i == 1 && !bottom_in) continue;
+                area.y1 = row_y[i];
+                area.y2 = row_y[i];
+                lv_draw_sw_blend(draw_ctx, blend_dsc);
+            }
+            continue;
+        }
+
+        lv_memcpy(mask_buf, row_cov, len * 2);
+        for(i = 0; i < 2; i++) {
+            if(i == 0 && !top_in) continue;
+            if(i == 1 && !bottom_in) continue;
+            area.y1 = row_y[i];
+            area.y2 = row_y[i];
+
+            if(len > 0) {
+                blend_dsc->opa = LV_OPA_COVER;
+                blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+                /*Left anti-aliased part*/
+                blend_dsc->mask_buf = mask_buf;
+                area.x1 = coords->x1 + row->x_start;
+                area.x2 = coords->x1 + row->x_full - 1;
+                lv_draw_sw_blend(draw_ctx, blend_dsc);
+
+                /*Right anti-aliased part, mirrored*/
+                blend_dsc->mask_buf = mask_buf + len;
+                area.x1 = coords->x2 - row->x_full + 1;
+                area.x2 = coords->x2 - row->x_start;
+                lv_draw_sw_blend(draw_ctx, blend_dsc);
+            }
+
+            /*Fully covered middle part*/
+            area.x1 = coords->x1 + row->x_full;
+            area.x2 = coords->x2 - row->x_full;
+            if(area.x1 <= area.x2) {
+                blend_dsc->opa = LV_OPA_COVER;
+                blend_dsc->mask_buf = NULL;
+                blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+                lv_draw_sw_blend(draw_ctx, blend_dsc);
+            }
+        }
+    }
+
+    /*The rows between the corners*/
+    area.x1 = coords->x1;
+    area.x2 = coords->x2;
+    area.y1 = coords->y1 + r;
+    area.y2 = coords->y2 - r;
+    if(area.y1 <= area.y2) {
+        blend_dsc->opa = opa;
+        blend_dsc->mask_buf = NULL;
+        blend_dsc->mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+        lv_draw_sw_blend(draw_ctx, blend_dsc);
+    }
+
+    lv_mem_buf_release(mask_buf);
+    if(!cached) lv_mem_buf_release(table);
+    return true;
+}
+
+/**
+ * Calculate the coverage of the rows of a rounded corner with the radius mask.
+ * It's the same for every corner, just mirrored.
+ * @param r         the radius
+ * @param cached    set to false if the table is not in the corner cache and should be released with `lv_mem_buf_release()`
+ * @return          the table: `r` `corner_row_t`s and the coverage they refer to, or NULL on error
+ */
+static uint8_t * corner_table_create(lv_coord_t r, bool * cached)
+{
+    lv_area_t rect = {0, 0, 2 * r - 1, 2 * r - 1};
+    lv_draw_mask_radius_param_t param;
+    lv_draw_mask_radius_init(&param, &rect, r, false);
+
+    lv_opa_t * quarter = lv_mem_buf_get(r * r);
+    if(quarter == NULL) {
+        lv_draw_mask_free_param(&param);
+        return NULL;
+    }
+
+    lv_coord_t y;
+    uint32_t cov_size = 0;
+    for(y = 0; y < r; y++) {
+        lv_opa_t * line = quarter + y * r;
+        lv_memset_ff(line, r);
+        param.dsc.cb(line, 0, y, r, &param);
+
+        lv_coord_t x_start = 0;
+        while(x_start < r && line[x_start] == LV_OPA_TRANSP) x_start++;
+        lv_coord_t x_full = r;
+        while(x_full > x_start && line[x_full - 1] == LV_OPA_COVER) x_full--;
+        cov_size += (x_full - x_start) * 2;
+    }
+    lv_draw_mask_free_param(&param);
+
+    int32_t key = r;
+    size_t size = r * sizeof(corner_row_t) + cov_size;
+    uint8_t * table = _lv_draw_sw_cache_add(&LV_GC_ROOT(_lv_corner_cache), &key, sizeof(key), size);
+    *cached = table != NULL;
+    if(table == NULL) table = lv_mem_buf_get(size);
+    if(table == NULL) {
+        lv_mem_buf_release(quarter);
+        return NULL;
+    }
+
+    corner_row_t * rows = (corner_row_t *)table;
+    lv_opa_t * cov = table + r * sizeof(corner_row_t);
+    uint32_t ofs = 0;
+    for(y = 0; y < r; y++) {
+        lv_opa_t * line = quarter + y * r;
+        lv_coord_t x_start = 0;
+        while(x_start < r && line[x_start] == LV_OPA_TRANSP) x_start++;
+        lv_coord_t x_full = r;
+        while(x_full > x_start && line[x_full - 1] == LV_OPA_COVER) x_full--;
+
+        int32_t len = x_full - x_start;
+        rows[y].x_start = x_start;
+        rows[y].x_full = x_full;
+        rows[y].ofs = ofs;
+        int32_t i;
+        for(i = 0; i < len; i++) {
+            cov[ofs + i] = line[x_start + i];
+            cov[ofs + len + i] = line[x_full - 1 - i];
+        }
+        ofs += len * 2;
+    }
+
+    lv_mem_buf_release(quarter);
+    return table;
+}
+#endif
+
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_img_src == NULL) return;
@@ -486,21 +725,34 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
+    _lv_draw_sw_cache_init(&LV_GC_ROOT(_lv_shadow_cache), LV_SHADOW_CACHE_MEM_SIZE);
+
+    shadow_key_t sh_key;
+    sh_key.shadow_width = dsc->shadow_width;
+    sh_key.radius = r_sh;
+    sh_key.w = LV_MIN(lv_area_get_width(&core_area), 2 * corner_size);
+    sh_key.h = LV_MIN(lv_area_get_height(&core_area), 2 * corner_size);
+
+    const lv_opa_t * sh_cached = NULL;
+    if(corner_size <= LV_SHADOW_CACHE_SIZE) {
+        sh_cached = _lv_draw_sw_cache_get(&LV_GC_ROOT(_lv_shadow_cache), &sh_key, sizeof(sh_key));
+    }
+
+    if(sh_cached) {
+        /*Use the cache if available. It's copied because the corner is mirrored while drawing.*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, sh_cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
+        /*Cache the corner if it's not too large*/
+        if(corner_size <= LV_SHADOW_CACHE_SIZE) {
+            lv_opa_t * sh_entry = _lv_draw_sw_cache_add(&LV_GC_ROOT(_lv_shadow_cache), &sh_key, sizeof(sh_key),
+                                                        corner_size * corner_size);
+            if(sh_entry) lv_memcpy(sh_entry, sh_buf, corner_size * corner_size);
         }
     }
 #else
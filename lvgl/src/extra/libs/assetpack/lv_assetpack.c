@@ -0,0 +1,719 @@
+/**
+ * @file lv_assetpack.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_assetpack.h"
+#if LV_USE_ASSETPACK
+
+#include "../../../misc/lv_utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define ASSETPACK_HAS_MMAP  1
+#else
+    #define ASSETPACK_HAS_MMAP  0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Everything of a font which has pointers. The arrays are used from the pack.*/
+typedef struct {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_glyph_cache_t cache;
+    union {
+        lv_font_fmt_txt_kern_pair_t pair;
+        lv_font_fmt_txt_kern_classes_t classes;
+    } kern;
+    lv_font_fmt_txt_cmap_t cmaps[];
+} pack_font_t;
+
+/*Growing buffer to build a pack in*/
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t cap;
+    bool error;         /*An allocation failed, nothing is added anymore*/
+} blob_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool is_big_endian(void);
+static const void * get_range(const lv_assetpack_t * pack, uint32_t offset, uint32_t size, uint32_t align);
+static lv_img_dsc_t * load_img(const lv_assetpack_t * pack, const lv_assetpack_entry_t * entry);
+static lv_font_t * load_font(const lv_assetpack_t * pack, const lv_assetpack_entry_t * entry);
+static const void * find_asset(const lv_assetpack_t * pack, const char * name, lv_assetpack_type_t type);
+static int src_name_compare(const void * a, const void * b);
+static int32_t entry_name_compare(const void * ref, const void * element);
+static uint32_t font_get_glyph_cnt(const lv_font_fmt_txt_dsc_t * dsc);
+static uint32_t blob_add(blob_t * blob, const void * data, uint32_t size, uint32_t align);
+static lv_res_t write_file(const char * path, const void * data, uint32_t size);
+static bool write_img(blob_t * blob, const lv_img_dsc_t * img, uint32_t * offset);
+static bool write_font(blob_t * blob, const lv_font_t * font, uint32_t * offset);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_assetpack_t * lv_assetpack_open(const char * path)
+{
+#if ASSETPACK_HAS_MMAP
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        LV_LOG_WARN("Couldn't open %s", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(lv_assetpack_header_t) || st.st_size > (off_t)UINT32_MAX) {
+        LV_LOG_WARN("Invalid asset pack size: %s", path);
+        close(fd);
+        return NULL;
+    }
+
+    void * data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  /*The mapping stays valid*/
+    if(data == MAP_FAILED) {
+        LV_LOG_WARN("Couldn't map %s", path);
+        return NULL;
+    }
+
+    lv_assetpack_t * pack = lv_assetpack_open_mem(data, (uint32_t)st.st_size);
+    if(pack == NULL) {
+        munmap(data, (size_t)st.st_size);
+        return NULL;
+    }
+    pack->mapped = 1;
+
+    LV_LOG_INFO("%s: %"LV_PRIu32" assets mapped", path, pack->entry_cnt);
+    return pack;
+#else
+    LV_UNUSED(path);
+    LV_LOG_WARN("Memory mapping is not supported, use lv_assetpack_open_mem()");
+    return NULL;
+#endif
+}
+
+lv_assetpack_t * lv_assetpack_open_mem(const void * data, uint32_t size)
+{
+    LV_ASSERT_NULL(data);
+
+    if((lv_uintptr_t)data % LV_ASSETPACK_ALIGN) {
+        LV_LOG_WARN("The asset pack is not aligned to %d bytes", LV_ASSETPACK_ALIGN);
+        return NULL;
+    }
+
+    if(size < sizeof(lv_assetpack_header_t)) return NULL;
+    const lv_assetpack_header_t * header = data;
+    if(header->magic != LV_ASSETPACK_MAGIC || header->version != LV_ASSETPACK_VERSION) {
+        LV_LOG_WARN("Not an asset pack or unknown version");
+        return NULL;
+    }
+    if(header->color_depth != LV_COLOR_DEPTH || header->color_16_swap != LV_COLOR_16_SWAP ||
+       header->big_endian != is_big_endian() || header->glyph_dsc_size != sizeof(lv_font_fmt_txt_glyph_dsc_t)) {
+        LV_LOG_WARN("The asset pack was written for a different LVGL configuration");
+        return NULL;
+    }
+    if(header->file_size != size) {
+        LV_LOG_WARN("The asset pack is truncated");
+        return NULL;
+    }
+
+    lv_assetpack_t * pack = lv_mem_alloc(sizeof(lv_assetpack_t));
+    LV_ASSERT_MALLOC(pack);
+    if(pack == NULL) return NULL;
+    lv_memset_00(pack, sizeof(lv_assetpack_t));
+    pack->data = data;
+    pack->size = size;
+
+    if(header->entry_cnt > UINT32_MAX / sizeof(lv_assetpack_entry_t)) {
+        lv_assetpack_close(pack);
+        return NULL;
+    }
+    pack->toc = get_range(pack, header->toc_offset, header->entry_cnt * sizeof(lv_assetpack_entry_t), 4);
+    if(pack->toc == NULL || header->entry_cnt == 0) {
+        LV_LOG_WARN("Invalid table of contents");
+        lv_assetpack_close(pack);
+        return NULL;
+    }
+
+    pack->assets = lv_mem_alloc(header->entry_cnt * sizeof(void *));
+    LV_ASSERT_MALLOC(pack->assets);
+    if(pack->assets == NULL) {
+        lv_assetpack_close(pack);
+        return NULL;
+    }
+    lv_memset_00(pack->assets, header->entry_cnt * sizeof(void *));
+
+    /*Only the small descriptors are created, the images and glyphs are used from the pack*/
+    uint32_t i;
+    for(i = 0; i < header->entry_cnt; i++) {
+        const lv_assetpack_entry_t * entry = &pack->toc[i];
+        pack->entry_cnt = i + 1;    /*To free the assets created so far on error*/
+        if(entry->name[LV_ASSETPACK_NAME_MAX - 1] != '\0' ||
+           get_range(pack, entry->offset, entry->size, 4) == NULL) {
+            pack->assets[i] = NULL;
+        }
+        else if(entry->type == LV_ASSETPACK_TYPE_IMG) {
+            pack->assets[i] = load_img(pack, entry);
+        }
+        else if(entry->type == LV_ASSETPACK_TYPE_FONT) {
+            pack->assets[i] = load_font(pack, entry);
+        }
+
+        if(pack->assets[i] == NULL) {
+            LV_LOG_WARN("Invalid asset %"LV_PRIu32" in the pack", i);
+            lv_assetpack_close(pack);
+            return NULL;
+        }
+    }
+
+    return pack;
+}
+
+void lv_assetpack_close(lv_assetpack_t * pack)
+{
+    if(pack == NULL) return;
+
+    if(pack->assets) {
+        uint32_t i;
+        for(i = 0; i < pack->entry_cnt; i++) {
+            if(pack->assets[i] == NULL) continue;
+            if(pack->toc[i].type == LV_ASSETPACK_TYPE_IMG) lv_img_cache_invalidate_src(pack->assets[i]);
+            lv_mem_free(pack->assets[i]);
+        }
+        lv_mem_free(pack->assets);
+    }
+
+#if ASSETPACK_HAS_MMAP
+    if(pack->mapped) munmap((void *)pack->data, pack->size);
+#endif
+
+    lv_mem_free(pack);
+}
+
+const lv_img_dsc_t * lv_assetpack_get_img(const lv_assetpack_t * pack, const char * name)
+{
+    LV_ASSERT_NULL(pack);
+    return find_asset(pack, name, LV_ASSETPACK_TYPE_IMG);
+}
+
+const lv_font_t * lv_assetpack_get_font(const lv_assetpack_t * pack, const char * name)
+{
+    LV_ASSERT_NULL(pack);
+    return find_asset(pack, name, LV_ASSETPACK_TYPE_FONT);
+}
+
+lv_res_t lv_assetpack_write(const char * path, const lv_assetpack_src_t * srcs, uint32_t cnt)
+{
+    if(cnt == 0) return LV_RES_INV;
+
+    /*The table of contents is sorted to find the assets with binary search*/
+    lv_assetpack_src_t * sorted = lv_mem_alloc(cnt * sizeof(lv_assetpack_src_t));
+    LV_ASSERT_MALLOC(sorted);
+    if(sorted == NULL) return LV_RES_INV;
+    lv_memcpy(sorted, srcs, cnt * sizeof(lv_assetpack_src_t));
+    qsort(sorted, cnt, sizeof(lv_assetpack_src_t), src_name_compare);
+
+    blob_t blob = {NULL, 0, 0, false};
+    lv_assetpack_header_t header;
+    lv_memset_00(&header, sizeof(header));
+    uint32_t header_ofs = blob_add(&blob, NULL, sizeof(lv_assetpack_header_t), LV_ASSETPACK_ALIGN);
+    header.toc_offset = blob_add(&blob, NULL, cnt * sizeof(lv_assetpack_entry_t), 4);
+
+    lv_res_t res = LV_RES_OK;
+    uint32_t i;
+    for(i = 0; i < cnt && res == LV_RES_OK; i++) {
+        lv_assetpack_entry_t entry;
+        lv_memset_00(&entry, sizeof(entry));
+
+        size_t name_len = strlen(sorted[i].name);
+        if(name_len >= LV_ASSETPACK_NAME_MAX || (i > 0 && strcmp(sorted[i - 1].name, sorted[i].name) == 0)) {
+            LV_LOG_WARN("Too long or duplicated asset name: %s", sorted[i].name);
+            res = LV_RES_INV;
+            break;
+        }
+        lv_memcpy(entry.name, sorted[i].name, name_len);
+        entry.type = sorted[i].type;
+
+        bool ok = false;
+        if(entry.type == LV_ASSETPACK_TYPE_IMG) ok = write_img(&blob, sorted[i].asset, &entry.offset);
+        else if(entry.type == LV_ASSETPACK_TYPE_FONT) ok = write_font(&blob, sorted[i].asset, &entry.offset);
+        if(!ok || blob.error) {
+            LV_LOG_WARN("Couldn't add %s to the asset pack", sorted[i].name);
+            res = LV_RES_INV;
+            break;
+        }
+        entry.size = blob.size - entry.offset;
+        lv_memcpy(blob.data + header.toc_offset + i * sizeof(lv_assetpack_entry_t), &entry, sizeof(entry));
+    }
+
+    if(res == LV_RES_OK) {
+        header.magic = LV_ASSETPACK_MAGIC;
+        header.version = LV_ASSETPACK_VERSION;
+        header.color_depth = LV_COLOR_DEPTH;
+        header.color_16_swap = LV_COLOR_16_SWAP;
+        header.big_endian = is_big_endian();
+        header.glyph_dsc_size = sizeof(lv_font_fmt_txt_glyph_dsc_t);
+        header.entry_cnt = cnt;
+        header.file_size = blob.size;
+        lv_memcpy(blob.data + header_ofs, &header, sizeof(header));
+
+        res = write_file(path, blob.data, blob.size);
+    }
+
+    lv_mem_free(blob.data);
+    lv_mem_free(sorted);
+    return res;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool is_big_endian(void)
+{
+    const uint16_t v = 1;
+    return *((const uint8_t *)&v) == 0;
+}
+
+/**
+ * Get a part of the pack if it's inside the pack and aligned
+ * @return pointer to the part or NULL if it's invalid
+ */
+static const void * get_range(const lv_assetpack_t * pack, uint32_t offset, uint32_t size, uint32_t align)
+{
+    if(offset % align) return NULL;
+    if(offset > pack->size || size > pack->size - offset) return NULL;
+    return pack->data + offset;
+}
+
+static lv_img_dsc_t * load_img(const lv_assetpack_t * pack, const lv_assetpack_entry_t * entry)
+{
+    const lv_assetpack_img_t * pimg = get_range(pack, entry->offset, sizeof(lv_assetpack_img_t), 4);
+    if(pimg == NULL) return NULL;
+
+    if(pimg->data_size < lv_img_buf_get_img_size(pimg->header.w, pimg->header.h, pimg->header.cf)) return NULL;
+    const uint8_t * data = get_range(pack, pimg->data_offset, pimg->data_size, LV_ASSETPACK_ALIGN);
+    if(data == NULL) return NULL;
+
+    lv_img_dsc_t * img = lv_mem_alloc(sizeof(lv_img_dsc_t));
+    LV_ASSERT_MALLOC(img);
+    if(img == NULL) return NULL;
+
+    img->header = pimg->header;
+    img->data_size = pimg->data_size;
+    img->data = data;
+    return img;
+}
+
+static lv_font_t * load_font(const lv_assetpack_t * pack, const lv_assetpack_entry_t * entry)
+{
+    const lv_assetpack_font_t * pfont = get_range(pack, entry->offset, sizeof(lv_assetpack_font_t), 4);
+    if(pfont == NULL) return NULL;
+    if(pfont->glyph_cnt == 0 || pfont->glyph_cnt > UINT32_MAX / sizeof(lv_font_fmt_txt_glyph_dsc_t)) return NULL;
+    if(pfont->cmap_num > 511 || pfont->bpp == 0 || pfont->bpp > 8) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = get_range(pack, pfont->glyph_dsc_offset,
+                                                              pfont->glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t), 4);
+    const uint8_t * glyph_bitmap = get_range(pack, pfont->glyph_bitmap_offset, pfont->glyph_bitmap_size,
+                                             LV_ASSETPACK_ALIGN);
+    const lv_assetpack_cmap_t * pcmaps = get_range(pack, pfont->cmaps_offset,
+                                                   pfont->cmap_num * sizeof(lv_assetpack_cmap_t), 4);
+    if(glyph_dsc == NULL || glyph_bitmap == NULL || pcmaps == NULL) return NULL;
+
+    /*The glyphs are read without bound checks while drawing so check them once here*/
+    uint32_t i;
+    for(i = 1; i < pfont->glyph_cnt; i++) {
+        uint32_t bitmap_size = ((uint32_t)glyph_dsc[i].box_w * glyph_dsc[i].box_h * pfont->bpp + 7) >> 3;
+        if(glyph_dsc[i].bitmap_index > pfont->glyph_bitmap_size ||
+           bitmap_size > pfont->glyph_bitmap_size - glyph_dsc[i].bitmap_index) return NULL;
+    }
+
+    pack_font_t * pf = lv_mem_alloc(sizeof(pack_font_t) + pfont->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+    LV_ASSERT_MALLOC(pf);
+    if(pf == NULL) return NULL;
+    lv_memset_00(pf, sizeof(pack_font_t));
+
+    for(i = 0; i < pfont->cmap_num; i++) {
+        const lv_assetpack_cmap_t * pcmap = &pcmaps[i];
+        lv_font_fmt_txt_cmap_t * cmap = &pf->cmaps[i];
+        cmap->range_start = pcmap->range_start;
+        cmap->range_length = pcmap->range_length;
+        cmap->glyph_id_start = pcmap->glyph_id_start;
+        cmap->list_length = pcmap->list_length;
+        cmap->type = pcmap->type;
+        cmap->unicode_list = NULL;
+        cmap->glyph_id_ofs_list = NULL;
+
+        /*The largest glyph id this cmap can map to*/
+        uint32_t gid_max = 0;
+        uint32_t j;
+        bool ok = true;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                gid_max = cmap->glyph_id_start + cmap->range_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                    const uint8_t * ofs_list = get_range(pack, pcmap->glyph_id_ofs_list_offset, cmap->range_length, 1);
+                    ok = ofs_list != NULL;
+                    for(j = 0; ok && j < cmap->range_length; j++) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + ofs_list[j]);
+                    cmap->glyph_id_ofs_list = ofs_list;
+                    break;
+                }
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                gid_max = cmap->glyph_id_start + cmap->list_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+                    const uint16_t * ofs_list = get_range(pack, pcmap->glyph_id_ofs_list_offset,
+                                                          cmap->list_length * sizeof(uint16_t), 2);
+                    ok = ofs_list != NULL;
+                    for(j = 0; ok && j < cmap->list_length; j++) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + ofs_list[j]);
+                    cmap->glyph_id_ofs_list = ofs_list;
+                    break;
+                }
+            default:
+                ok = false;
+                break;
+        }
+
+        if(ok && (cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL)) {
+            cmap->unicode_list = get_range(pack, pcmap->unicode_list_offset, cmap->list_length * sizeof(uint16_t), 2);
+            if(cmap->unicode_list == NULL) ok = false;
+        }
+
+        if(!ok || gid_max >= pfont->glyph_cnt) {
+            lv_mem_free(pf);
+            return NULL;
+        }
+    }
+
+    if(pfont->kern_offset) {
+        if(pfont->kern_classes) {
+            const lv_assetpack_kern_classes_t * pkern = get_range(pack, pfont->kern_offset,
+                                                                  sizeof(lv_assetpack_kern_classes_t), 4);
+            lv_font_fmt_txt_kern_classes_t * kern = &pf->kern.classes;
+            if(pkern) {
+                kern->left_class_cnt = pkern->left_class_cnt;
+                kern->right_class_cnt = pkern->right_class_cnt;
+                kern->class_pair_values = get_range(pack, pkern->class_pair_values_offset,
+                                                    (uint32_t)pkern->left_class_cnt * pkern->right_class_cnt, 1);
+                kern->left_class_mapping = get_range(pack, pkern->left_class_mapping_offset, pfont->glyph_cnt, 1);
+                kern->right_class_mapping = get_range(pack, pkern->right_class_mapping_offset, pfont->glyph_cnt, 1);
+            }
+            bool ok = pkern && kern->class_pair_values && kern->left_class_mapping && kern->right_class_mapping;
+            for(i = 0; ok && i < pfont->glyph_cnt; i++) {
+                if(kern->left_class_mapping[i] > kern->left_class_cnt ||
+                   kern->right_class_mapping[i] > kern->right_class_cnt) ok = false;
+            }
+            if(!ok) {
+                lv_mem_free(pf);
+                return NULL;
+            }
+        }
+        else {
+            const lv_assetpack_kern_pair_t * pkern = get_range(pack, pfont->kern_offset,
+                                                               sizeof(lv_assetpack_kern_pair_t), 4);
+            lv_font_fmt_txt_kern_pair_t * kern = &pf->kern.pair;
+            if(pkern && pkern->glyph_ids_size <= 1 && pkern->pair_cnt < (1UL << 28)) {
+                uint32_t id_size = pkern->glyph_ids_size == 0 ? 2 : 4;
+                kern->pair_cnt = pkern->pair_cnt;
+                kern->glyph_ids_size = pkern->glyph_ids_size;
+                kern->glyph_ids = get_range(pack, pkern->glyph_ids_offset, pkern->pair_cnt * id_size, id_size);
+                kern->values = get_range(pack, pkern->values_offset, pkern->pair_cnt, 1);
+            }
+            if(pkern == NULL || kern->glyph_ids == NULL || kern->values == NULL) {
+                lv_mem_free(pf);
+                return NULL;
+            }
+        }
+        pf->dsc.kern_dsc = &pf->kern;
+    }
+
+    pf->dsc.glyph_bitmap = glyph_bitmap;
+    pf->dsc.glyph_dsc = glyph_dsc;
+    pf->dsc.cmaps = pf->cmaps;
+    pf->dsc.kern_scale = pfont->kern_scale;
+    pf->dsc.cmap_num = pfont->cmap_num;
+    pf->dsc.bpp = pfont->bpp;
+    pf->dsc.kern_classes = pfont->kern_classes ? 1 : 0;
+    pf->dsc.bitmap_format = LV_FONT_FMT_TXT_PLAIN;
+    pf->dsc.cache = &pf->cache;
+
+    pf->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    pf->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    pf->font.line_height = pfont->line_height;
+    pf->font.base_line = pfont->base_line;
+    pf->font.subpx = pfont->subpx;
+    pf->font.underline_position = pfont->underline_position;
+    pf->font.underline_thickness = pfont->underline_thickness;
+    pf->font.dsc = &pf->dsc;
+
+    return &pf->font;
+}
+
+static const void * find_asset(const lv_assetpack_t * pack, const char * name, lv_assetpack_type_t type)
+{
+    const lv_assetpack_entry_t * entry = _lv_utils_bsearch(name, pack->toc, pack->entry_cnt,
+                                                           sizeof(lv_assetpack_entry_t), entry_name_compare);
+    if(entry == NULL || entry->type != type) return NULL;
+
+    return pack->assets[entry - pack->toc];
+}
+
+static int src_name_compare(const void * a, const void * b)
+{
+    const lv_assetpack_src_t * src_a = a;
+    const lv_assetpack_src_t * src_b = b;
+    return strcmp(src_a->name, src_b->name);
+}
+
+static int32_t entry_name_compare(const void * ref, const void * element)
+{
+    const lv_assetpack_entry_t * entry = element;
+    return strncmp(ref, entry->name, LV_ASSETPACK_NAME_MAX);
+}
+
+/**
+ * Get the number of glyph descriptors from the largest glyph id the character maps can refer to
+ */
+static uint32_t font_get_glyph_cnt(const lv_font_fmt_txt_dsc_t * dsc)
+{
+    uint32_t gid_max = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        uint32_t j;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                if(cmap->range_length) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + cmap->range_length - 1U);
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                    const uint8_t * ofs_list = cmap->glyph_id_ofs_list;
+                    for(j = 0; j < cmap->range_length; j++) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + ofs_list[j]);
+                    break;
+                }
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                if(cmap->list_length) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + cmap->list_length - 1U);
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+                    const uint16_t * ofs_list = cmap->glyph_id_ofs_list;
+                    for(j = 0; j < cmap->list_length; j++) gid_max = LV_MAX(gid_max, cmap->glyph_id_start + ofs_list[j]);
+                    break;
+                }
+        }
+    }
+
+    return gid_max + 1;
+}
+
+/**
+ * Append data to a blob
+ * @param blob      pointer to a blob
+ * @param data      the data to append or NULL to append zeros
+ * @param size      size of the data
+ * @param align     align the start of the data to this
+ * @return          offset of the data in the blob. 0 and `blob->error` is set if it's out of memory.
+ */
+static uint32_t blob_add(blob_t * blob, const void * data, uint32_t size, uint32_t align)
+{
+    if(blob->error) return 0;
+
+    uint32_t ofs = (blob->size + align - 1) / align * align;
+    uint32_t new_size = ofs + size;
+    if(new_size > blob->cap) {
+        uint32_t cap = LV_MAX(new_size, blob->cap * 2);
+        uint8_t * new_data = lv_mem_realloc(blob->data, cap);
+        if(new_data == NULL) {
+            lv_mem_free(blob->data);
+            blob->data = NULL;
+            blob->size = 0;
+            blob->cap = 0;
+            blob->error = true;
+            return 0;
+        }
+        blob->data = new_data;
+        blob->cap = cap;
+    }
+
+    lv_memset_00(blob->data + blob->size, new_size - blob->size);
+    if(data) lv_memcpy(blob->data + ofs, data, size);
+    blob->size = new_size;
+    return ofs;
+}
+
+/**
+ * Replace a file with new content. The content is written to `<path>.tmp` first and renamed,
+ * so the programs which mapped the old file keep using the old content.
+ * @param path      path of the file
+ * @param data      the content
+ * @param size      size of the content
+ * @return          LV_RES_OK: the file is replaced; LV_RES_INV: error, the old file is kept
+ */
+static lv_res_t write_file(const char * path, const void * data, uint32_t size)
+{
+    size_t path_len = strlen(path);
+    char * tmp_path = lv_mem_alloc(path_len + sizeof(".tmp"));
+    LV_ASSERT_MALLOC(tmp_path);
+    if(tmp_path == NULL) return LV_RES_INV;
+    lv_memcpy(tmp_path, path, path_len);
+    lv_memcpy(tmp_path + path_len, ".tmp", sizeof(".tmp"));
+
+    lv_res_t res = LV_RES_OK;
+    FILE * f = fopen(tmp_path, "wb");
+    if(f == NULL) {
+        LV_LOG_WARN("Couldn't create %s", tmp_path);
+        lv_mem_free(tmp_path);
+        return LV_RES_INV;
+    }
+
+    if(fwrite(data, 1, size, f) != size) res = LV_RES_INV;
+    if(fflush(f) != 0) res = LV_RES_INV;
+#if ASSETPACK_HAS_MMAP
+    /*Be sure the content is on the disk before the new name is*/
+    if(res == LV_RES_OK && fsync(fileno(f)) != 0) res = LV_RES_INV;
+#endif
+    if(fclose(f) != 0) res = LV_RES_INV;
+    if(res == LV_RES_OK && rename(tmp_path, path) != 0) res = LV_RES_INV;
+
+    if(res != LV_RES_OK) {
+        LV_LOG_WARN("Couldn't write %s", path);
+        remove(tmp_path);
+    }
+
+    lv_mem_free(tmp_path);
+    return res;
+}
+
+static bool write_img(blob_t * blob, const lv_img_dsc_t * img, uint32_t * offset)
+{
+    if(lv_img_src_get_type(img) != LV_IMG_SRC_VARIABLE || img->data == NULL) return false;
+
+    lv_assetpack_img_t pimg;
+    lv_memset_00(&pimg, sizeof(pimg));
+    pimg.header = img->header;
+    pimg.data_size = img->data_size;
+
+    *offset = blob_add(blob, NULL, sizeof(pimg), 4);
+    pimg.data_offset = blob_add(blob, img->data, img->data_size, LV_ASSETPACK_ALIGN);
+    if(blob->error) return false;
+
+    lv_memcpy(blob->data + *offset, &pimg, sizeof(pimg));
+    return true;
+}
+
+static bool write_font(blob_t * blob, const lv_font_t * font, uint32_t * offset)
+{
+    if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return false;
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) return false;
+
+    lv_assetpack_font_t pfont;
+    lv_memset_00(&pfont, sizeof(pfont));
+    pfont.line_height = font->line_height;
+    pfont.base_line = font->base_line;
+    pfont.underline_position = font->underline_position;
+    pfont.underline_thickness = font->underline_thickness;
+    pfont.subpx = font->subpx;
+    pfont.bpp = dsc->bpp;
+    pfont.kern_scale = dsc->kern_scale;
+    pfont.cmap_num = dsc->cmap_num;
+    pfont.kern_classes = dsc->kern_classes;
+    pfont.glyph_cnt = font_get_glyph_cnt(dsc);
+
+    /*The bitmaps are stored in glyph order, the end of the last one is the size*/
+    uint32_t i;
+    for(i = 1; i < pfont.glyph_cnt; i++) {
+        const lv_font_fmt_txt_glyph_dsc_t * g = &dsc->glyph_dsc[i];
+        uint32_t end = g->bitmap_index + (((uint32_t)g->box_w * g->box_h * dsc->bpp + 7) >> 3);
+        pfont.glyph_bitmap_size = LV_MAX(pfont.glyph_bitmap_size, end);
+    }
+
+    *offset = blob_add(blob, NULL, sizeof(pfont), 4);
+    pfont.cmaps_offset = blob_add(blob, NULL, dsc->cmap_num * sizeof(lv_assetpack_cmap_t), 4);
+    pfont.glyph_dsc_offset = blob_add(blob, dsc->glyph_dsc, pfont.glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t), 4);
+    pfont.glyph_bitmap_offset = blob_add(blob, dsc->glyph_bitmap, pfont.glyph_bitmap_size, LV_ASSETPACK_ALIGN);
+
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        lv_assetpack_cmap_t pcmap;
+        lv_memset_00(&pcmap, sizeof(pcmap));
+        pcmap.range_start = cmap->range_start;
+        pcmap.range_length = cmap->range_length;
+        pcmap.glyph_id_start = cmap->glyph_id_start;
+        pcmap.list_length = cmap->list_length;
+        pcmap.type = cmap->type;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            pcmap.unicode_list_offset = blob_add(blob, cmap->unicode_list, cmap->list_length * sizeof(uint16_t), 4);
+        }
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            pcmap.glyph_id_ofs_list_offset = blob_add(blob, cmap->glyph_id_ofs_list, cmap->range_length, 4);
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            pcmap.glyph_id_ofs_list_offset = blob_add(blob, cmap->glyph_id_ofs_list,
+                                                      cmap->list_length * sizeof(uint16_t), 4);
+        }
+        if(blob->error) return false;
+        lv_memcpy(blob->data + pfont.cmaps_offset + i * sizeof(lv_assetpack_cmap_t), &pcmap, sizeof(pcmap));
+    }
+
+    if(dsc->kern_dsc) {
+        if(dsc->kern_classes) {
+            const lv_font_fmt_txt_kern_classes_t * kern = dsc->kern_dsc;
+            lv_assetpack_kern_classes_t pkern;
+            lv_memset_00(&pkern, sizeof(pkern));
+            pkern.left_class_cnt = kern->left_class_cnt;
+            pkern.right_class_cnt = kern->right_class_cnt;
+            pfont.kern_offset = blob_add(blob, NULL, sizeof(pkern), 4);
+            pkern.class_pair_values_offset = blob_add(blob, kern->class_pair_values,
+                                                      (uint32_t)kern->left_class_cnt * kern->right_class_cnt, 4);
+            pkern.left_class_mapping_offset = blob_add(blob, kern->left_class_mapping, pfont.glyph_cnt, 4);
+            pkern.right_class_mapping_offset = blob_add(blob, kern->right_class_mapping, pfont.glyph_cnt, 4);
+            if(blob->error) return false;
+            lv_memcpy(blob->data + pfont.kern_offset, &pkern, sizeof(pkern));
+        }
+        else {
+            const lv_font_fmt_txt_kern_pair_t * kern = dsc->kern_dsc;
+            lv_assetpack_kern_pair_t pkern;
+            lv_memset_00(&pkern, sizeof(pkern));
+            pkern.pair_cnt = kern->pair_cnt;
+            pkern.glyph_ids_size = kern->glyph_ids_size;
+            uint32_t id_size = kern->glyph_ids_size == 0 ? 2 : 4;
+            pfont.kern_offset = blob_add(blob, NULL, sizeof(pkern), 4);
+            pkern.glyph_ids_offset = blob_add(blob, kern->glyph_ids, kern->pair_cnt * id_size, 4);
+            pkern.values_offset = blob_add(blob, kern->values, kern->pair_cnt, 4);
+            if(blob->error) return false;
+            lv_memcpy(blob->data + pfont.kern_offset, &pkern, sizeof(pkern));
+        }
+    }
+
+    if(blob->error) return false;
+    lv_memcpy(blob->data + *offset, &pfont, sizeof(pfont));
+    return true;
+}
+
+#endif /*LV_USE_ASSETPACK*/
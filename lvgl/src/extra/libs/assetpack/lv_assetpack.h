@@ -0,0 +1,203 @@
+/**
+ * @file lv_assetpack.h
+ *
+ */
+
+#ifndef LV_ASSETPACK_H
+#define LV_ASSETPACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_ASSETPACK
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_ASSETPACK_MAGIC      0x5041564CU     /*"LVAP"*/
+#define LV_ASSETPACK_VERSION    1
+#define LV_ASSETPACK_NAME_MAX   32
+#define LV_ASSETPACK_ALIGN      64              /*Alignment of the image and glyph bitmaps in the file*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum {
+    LV_ASSETPACK_TYPE_IMG = 1,
+    LV_ASSETPACK_TYPE_FONT = 2,
+};
+typedef uint32_t lv_assetpack_type_t;
+
+/*
+ * File format
+ *
+ * The pack holds the assets in the native format of the LVGL build which wrote it
+ * (color depth, byte order, glyph descriptor layout) so they can be used directly from a memory mapping.
+ * All offsets are from the beginning of the file.
+ *
+ *  lv_assetpack_header_t
+ *  lv_assetpack_entry_t[entry_cnt]    table of contents, sorted by name
+ *  payloads                            lv_assetpack_img_t or lv_assetpack_font_t and their arrays
+ */
+
+typedef struct {
+    uint32_t magic;                 /**< LV_ASSETPACK_MAGIC*/
+    uint16_t version;               /**< LV_ASSETPACK_VERSION*/
+    uint8_t color_depth;            /**< LV_COLOR_DEPTH of the writer*/
+    uint8_t color_16_swap;          /**< LV_COLOR_16_SWAP of the writer*/
+    uint8_t big_endian;
+    uint8_t glyph_dsc_size;         /**< sizeof(lv_font_fmt_txt_glyph_dsc_t) of the writer*/
+    uint16_t reserved;
+    uint32_t entry_cnt;
+    uint32_t toc_offset;
+    uint32_t file_size;
+} lv_assetpack_header_t;
+
+typedef struct {
+    char name[LV_ASSETPACK_NAME_MAX];   /**< Zero terminated*/
+    lv_assetpack_type_t type;
+    uint32_t offset;                    /**< Offset of the `lv_assetpack_img_t` or `lv_assetpack_font_t`*/
+    uint32_t size;                      /**< Size of the payload with its arrays*/
+    uint32_t reserved;
+} lv_assetpack_entry_t;
+
+typedef struct {
+    lv_img_header_t header;
+    uint32_t data_size;
+    uint32_t data_offset;               /**< Pixels, aligned to LV_ASSETPACK_ALIGN*/
+} lv_assetpack_img_t;
+
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint16_t list_length;
+    uint8_t type;                       /**< Element of `LV_FONT_FMT_TXT_CMAP_...`*/
+    uint8_t reserved;
+    uint32_t unicode_list_offset;       /**< 0: no list*/
+    uint32_t glyph_id_ofs_list_offset;  /**< 0: no list*/
+} lv_assetpack_cmap_t;
+
+typedef struct {
+    int32_t line_height;
+    int32_t base_line;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    uint8_t subpx;
+    uint8_t bpp;
+    uint16_t kern_scale;
+    uint16_t cmap_num;
+    uint8_t kern_classes;               /**< 0: `kern_offset` points to `lv_assetpack_kern_pair_t`, 1: `lv_assetpack_kern_classes_t`*/
+    uint8_t reserved[3];
+    uint32_t glyph_cnt;                 /**< Number of glyph descriptors (glyph id 0 is reserved)*/
+    uint32_t glyph_dsc_offset;          /**< `lv_font_fmt_txt_glyph_dsc_t[glyph_cnt]`*/
+    uint32_t glyph_bitmap_offset;       /**< Aligned to LV_ASSETPACK_ALIGN*/
+    uint32_t glyph_bitmap_size;
+    uint32_t cmaps_offset;              /**< `lv_assetpack_cmap_t[cmap_num]`*/
+    uint32_t kern_offset;               /**< 0: no kerning*/
+} lv_assetpack_font_t;
+
+typedef struct {
+    uint32_t pair_cnt;
+    uint32_t glyph_ids_size;            /**< 0: `uint8_t` pairs; 1: `uint16_t` pairs*/
+    uint32_t glyph_ids_offset;
+    uint32_t values_offset;
+} lv_assetpack_kern_pair_t;
+
+typedef struct {
+    uint8_t left_class_cnt;
+    uint8_t right_class_cnt;
+    uint16_t reserved;
+    uint32_t class_pair_values_offset;
+    uint32_t left_class_mapping_offset; /**< `glyph_cnt` bytes*/
+    uint32_t right_class_mapping_offset;/**< `glyph_cnt` bytes*/
+} lv_assetpack_kern_classes_t;
+
+/** An opened asset pack*/
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    const lv_assetpack_entry_t * toc;
+    uint32_t entry_cnt;
+    void ** assets;                     /**< `lv_img_dsc_t *` or `lv_font_t *` of the entries*/
+    uint8_t mapped : 1;                 /**< `data` is mapped by `lv_assetpack_open()`*/
+} lv_assetpack_t;
+
+/** An asset to write into a pack*/
+typedef struct {
+    const char * name;
+    lv_assetpack_type_t type;
+    const void * asset;                 /**< `const lv_img_dsc_t *` or `const lv_font_t *`*/
+} lv_assetpack_src_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Open an asset pack file by mapping it into the memory. The assets are not read or copied,
+ * the images and the glyphs are paged in when they are drawn first.
+ * Requires a POSIX system.
+ * @param path      path of the file (not an `lv_fs` path)
+ * @return          the opened pack or NULL if the file can't be mapped or it's not compatible with this build
+ */
+lv_assetpack_t * lv_assetpack_open(const char * path);
+
+/**
+ * Open an asset pack which is already in the memory, e.g. in a memory mapped flash
+ * @param data      pointer to the pack. Must be aligned to LV_ASSETPACK_ALIGN and kept valid until closing the pack.
+ * @param size      size of the pack in bytes
+ * @return          the opened pack or NULL if it's not compatible with this build
+ */
+lv_assetpack_t * lv_assetpack_open_mem(const void * data, uint32_t size);
+
+/**
+ * Close an asset pack. None of its images and fonts can be used anymore.
+ * @param pack      pointer to an opened pack
+ */
+void lv_assetpack_close(lv_assetpack_t * pack);
+
+/**
+ * Get an image of a pack
+ * @param pack      pointer to an opened pack
+ * @param name      name of the image
+ * @return          an image descriptor to use as image source or NULL if not found
+ */
+const lv_img_dsc_t * lv_assetpack_get_img(const lv_assetpack_t * pack, const char * name);
+
+/**
+ * Get a font of a pack
+ * @param pack      pointer to an opened pack
+ * @param name      name of the font
+ * @return          the font or NULL if not found
+ */
+const lv_font_t * lv_assetpack_get_font(const lv_assetpack_t * pack, const char * name);
+
+/**
+ * Write images and fonts into an asset pack file.
+ * The file is replaced by renaming so the programs which use the old pack are not affected.
+ * @param path      path of the file to create (not an `lv_fs` path). `<path>.tmp` is used while writing.
+ * @param srcs      the assets. The names have to be unique.
+ *                  Only variable images and uncompressed `lv_font_fmt_txt` fonts are supported.
+ * @param cnt       number of elements in `srcs`
+ * @return          LV_RES_OK: the pack is written; LV_RES_INV: an asset is not supported or the file can't be written
+ */
+lv_res_t lv_assetpack_write(const char * path, const lv_assetpack_src_t * srcs, uint32_t cnt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_ASSETPACK*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ASSETPACK_H*/
@@ -23,6 +23,7 @@ extern "C" {
 #include "freetype/lv_freetype.h"
 #include "rlottie/lv_rlottie.h"
 #include "ffmpeg/lv_ffmpeg.h"
+#include "assetpack/lv_assetpack.h"
 
 /*********************
  *      DEFINES
@@ -1,5 +1,6 @@
 CSRCS += lv_flex.c
 CSRCS += lv_grid.c
+CSRCS += lv_assetpack.c
 CSRCS += lv_barcode.c
 CSRCS += code128.c
 CSRCS += lv_bmp.c
@@ -20,13 +21,16 @@ CSRCS += lv_rlottie.c
 CSRCS += lv_sjpg.c
 CSRCS += tjpgd.c
 CSRCS += lv_extra.c
+CSRCS += lv_binding.c
 CSRCS += lv_fragment.c
 CSRCS += lv_fragment_manager.c
 CSRCS += lv_gridnav.c
 CSRCS += lv_ime_pinyin.c
 CSRCS += lv_imgfont.c
+CSRCS += lv_latency.c
 CSRCS += lv_monkey.c
 CSRCS += lv_msg.c
+CSRCS += lv_profiler.c
 CSRCS += lv_snapshot.c
 CSRCS += lv_theme_basic.c
 CSRCS += lv_theme_default.c
@@ -39,12 +43,14 @@ CSRCS += lv_calendar_header_arrow.c
 CSRCS += lv_calendar_header_dropdown.c
 CSRCS += lv_carousel.c
 CSRCS += lv_chart.c
+CSRCS += lv_streamchart.c
 CSRCS += lv_colorwheel.c
 CSRCS += lv_dclock.c
 CSRCS += lv_imgbtn.c
 CSRCS += lv_keyboard.c
 CSRCS += lv_led.c
 CSRCS += lv_list.c
+CSRCS += lv_vlist.c
 CSRCS += lv_menu.c
 CSRCS += lv_meter.c
 CSRCS += lv_msgbox.c
@@ -61,6 +67,7 @@ CSRCS += lv_zh_keyboard.c
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/layouts/flex
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/layouts/grid
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/assetpack
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/barcode
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/bmp
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/ffmpeg
@@ -71,12 +78,15 @@ VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/png
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/qrcode
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/rlottie
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/libs/sjpg
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/binding
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/fragment
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/gridnav
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/ime
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/imgfont
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/latency
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/monkey
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/msg
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/profiler
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/others/snapshot
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/themes/basic
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/themes/default
@@ -86,12 +96,14 @@ VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/animimg
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/calendar
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/carousel
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/chart
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/streamchart
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/colorwheel
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/dclock
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/imgbtn
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/keyboard
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/led
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/list
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/vlist
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/menu
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/meter
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra/widgets/msgbox
@@ -0,0 +1,229 @@
+/**
+ * @file lv_binding.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_binding.h"
+#if LV_USE_BINDING
+
+#include "../../../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BUCKET_CNT          64      /*Power of 2*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_binding_t {
+    lv_obj_t * obj;                     /*NULL if deleted while it was marked*/
+    lv_binding_get_cb_t get_cb;
+    void * user_data;
+    const char * fmt;
+    struct _lv_binding_t * next;        /*The next binding in the bucket of `src_id`*/
+    struct _lv_binding_t * next_dirty;  /*The next marked binding*/
+    uint32_t src_id;
+    int32_t value;                      /*The last written value*/
+    uint8_t prop;
+    uint8_t dirty : 1;
+    uint8_t written : 1;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void mark(lv_binding_t * binding);
+static void write_binding(lv_binding_t * binding);
+static bool write_state(lv_obj_t * obj, lv_state_t state, bool on);
+static bool write_value(lv_obj_t * obj, int32_t value);
+static void obj_delete_event_cb(lv_event_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+lv_binding_t * _lv_binding_dirty;
+
+static lv_binding_t * buckets[BUCKET_CNT];
+static lv_binding_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+#define BUCKET(src_id)      (&buckets[((src_id) * 2654435761u) >> 26 & (BUCKET_CNT - 1)])
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_binding_t * lv_binding_create(lv_obj_t * obj, lv_binding_prop_t prop, uint32_t src_id,
+                                 lv_binding_get_cb_t get_cb, void * user_data)
+{
+    LV_ASSERT_NULL(obj);
+    LV_ASSERT_NULL(get_cb);
+
+    lv_binding_t * binding = lv_mem_alloc(sizeof(lv_binding_t));
+    LV_ASSERT_MALLOC(binding);
+    if(binding == NULL) return NULL;
+    lv_memset_00(binding, sizeof(lv_binding_t));
+
+    binding->obj = obj;
+    binding->prop = prop;
+    binding->src_id = src_id;
+    binding->get_cb = get_cb;
+    binding->user_data = user_data;
+
+    lv_binding_t ** bucket = BUCKET(src_id);
+    binding->next = *bucket;
+    *bucket = binding;
+
+    lv_obj_add_event_cb(obj, obj_delete_event_cb, LV_EVENT_DELETE, binding);
+    mark(binding);
+    return binding;
+}
+
+void lv_binding_del(lv_binding_t * binding)
+{
+    lv_binding_t ** p = BUCKET(binding->src_id);
+    while(*p != binding) p = &(*p)->next;
+    *p = binding->next;
+
+    if(binding->obj) lv_obj_remove_event_cb_with_user_data(binding->obj, obj_delete_event_cb, binding);
+
+    /*A marked binding is freed by the next apply, it can't be removed from the middle of the list*/
+    if(binding->dirty) binding->obj = NULL;
+    else lv_mem_free(binding);
+}
+
+void lv_binding_set_text_fmt(lv_binding_t * binding, const char * fmt)
+{
+    binding->fmt = fmt;
+    binding->written = 0;
+    mark(binding);
+}
+
+void lv_binding_notify(uint32_t src_id)
+{
+    stats.notify_cnt++;
+
+    lv_binding_t * binding;
+    for(binding = *BUCKET(src_id); binding; binding = binding->next) {
+        if(binding->src_id == src_id) mark(binding);
+    }
+}
+
+void lv_binding_apply(void)
+{
+    stats.apply_cnt++;
+
+    /*Bindings marked by the writes are written at the next refresh*/
+    lv_binding_t * binding = _lv_binding_dirty;
+    _lv_binding_dirty = NULL;
+
+    while(binding) {
+        lv_binding_t * next = binding->next_dirty;
+        binding->dirty = 0;
+        if(binding->obj) write_binding(binding);
+        else lv_mem_free(binding);
+        binding = next;
+    }
+}
+
+void lv_binding_get_stats(lv_binding_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void mark(lv_binding_t * binding)
+{
+    if(binding->dirty) return;
+    binding->dirty = 1;
+    binding->next_dirty = _lv_binding_dirty;
+    _lv_binding_dirty = binding;
+}
+
+static void write_binding(lv_binding_t * binding)
+{
+    int32_t value = binding->get_cb(binding->src_id, binding->user_data);
+    lv_obj_t * obj = binding->obj;
+    bool changed = false;
+
+    switch(binding->prop) {
+        case LV_BINDING_PROP_CHECKED:
+            changed = write_state(obj, LV_STATE_CHECKED, value != 0);
+            break;
+        case LV_BINDING_PROP_DISABLED:
+            changed = write_state(obj, LV_STATE_DISABLED, value != 0);
+            break;
+        case LV_BINDING_PROP_HIDDEN:
+            if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) != (value != 0)) {
+                if(value) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+                else lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+                changed = true;
+            }
+            break;
+        case LV_BINDING_PROP_VALUE:
+            changed = write_value(obj, value);
+            break;
+        case LV_BINDING_PROP_TEXT:
+#if LV_USE_LABEL
+            /*Formatting and comparing the text would cost about as much as setting it*/
+            if(!binding->written || binding->value != value) {
+                lv_label_set_text_fmt(obj, binding->fmt ? binding->fmt : "%" LV_PRId32, value);
+                changed = true;
+            }
+#endif
+            break;
+    }
+
+    binding->value = value;
+    binding->written = 1;
+    if(changed) stats.write_cnt++;
+    else stats.skip_cnt++;
+}
+
+static bool write_state(lv_obj_t * obj, lv_state_t state, bool on)
+{
+    if(lv_obj_has_state(obj, state) == on) return false;
+
+    if(on) lv_obj_add_state(obj, state);
+    else lv_obj_clear_state(obj, state);
+    return true;
+}
+
+static bool write_value(lv_obj_t * obj, int32_t value)
+{
+#if LV_USE_ARC
+    if(lv_obj_check_type(obj, &lv_arc_class)) {
+        if(lv_arc_get_value(obj) == value) return false;
+        lv_arc_set_value(obj, value);
+        return true;
+    }
+#endif
+#if LV_USE_BAR
+    /*The slider is a bar too*/
+    if(lv_obj_has_class(obj, &lv_bar_class)) {
+        if(lv_bar_get_value(obj) == value) return false;
+        lv_bar_set_value(obj, value, LV_ANIM_OFF);
+        return true;
+    }
+#endif
+    LV_LOG_WARN("the widget has no value");
+    return false;
+}
+
+static void obj_delete_event_cb(lv_event_t * e)
+{
+    lv_binding_t * binding = lv_event_get_user_data(e);
+    binding->obj = NULL;    /*Don't remove the event from the deleted widget*/
+    lv_binding_del(binding);
+}
+
+#endif /*LV_USE_BINDING*/
@@ -0,0 +1,127 @@
+/**
+ * @file lv_binding.h
+ * Bind a property of a widget to a value of the application's model.
+ * A change of the model only marks the bindings of the value. They are written
+ * once per frame, before the layout is updated, and only if the widget shows something else.
+ */
+#ifndef LV_BINDING_H
+#define LV_BINDING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+/*Included by the core, so it doesn't include lvgl.h*/
+#include "../../../lv_conf_internal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_BINDING
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_obj_t;
+
+typedef enum {
+    LV_BINDING_PROP_CHECKED,    /**< `LV_STATE_CHECKED` if the value is not 0*/
+    LV_BINDING_PROP_DISABLED,   /**< `LV_STATE_DISABLED` if the value is not 0*/
+    LV_BINDING_PROP_HIDDEN,     /**< `LV_OBJ_FLAG_HIDDEN` if the value is not 0*/
+    LV_BINDING_PROP_VALUE,      /**< The value of a bar, slider or arc*/
+    LV_BINDING_PROP_TEXT,       /**< The text of a label, see `lv_binding_set_text_fmt()`*/
+} lv_binding_prop_t;
+
+/**
+ * Get the current value of a source from the model
+ * @param src_id        id of the source, e.g. a device
+ * @param user_data     the `user_data` of the binding
+ * @return              the value
+ */
+typedef int32_t (*lv_binding_get_cb_t)(uint32_t src_id, void * user_data);
+
+struct _lv_binding_t;
+typedef struct _lv_binding_t lv_binding_t;
+
+typedef struct {
+    uint32_t notify_cnt;        /**< Changes of the sources*/
+    uint32_t apply_cnt;         /**< Frames with marked bindings*/
+    uint32_t write_cnt;         /**< Bindings which changed their widget*/
+    uint32_t skip_cnt;          /**< Bindings whose widget showed the value already*/
+} lv_binding_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Bind a property of a widget to a source. The value is written at the next refresh.
+ * The binding is deleted with the widget.
+ * @param obj           pointer to a widget
+ * @param prop          the property to set
+ * @param src_id        id of the source, passed to `lv_binding_notify()` when it changes
+ * @param get_cb        returns the value of the source
+ * @param user_data     passed to `get_cb`
+ * @return              the new binding or NULL on error
+ */
+lv_binding_t * lv_binding_create(struct _lv_obj_t * obj, lv_binding_prop_t prop, uint32_t src_id,
+                                 lv_binding_get_cb_t get_cb, void * user_data);
+
+/**
+ * Delete a binding. The widget keeps its current state.
+ * @param binding       pointer to a binding
+ */
+void lv_binding_del(lv_binding_t * binding);
+
+/**
+ * Set the format of a `LV_BINDING_PROP_TEXT` binding
+ * @param binding       pointer to a binding
+ * @param fmt           `printf`-like format with one `int32_t` argument, e.g. `"%" LV_PRId32 " %%"`.
+ *                      Only the pointer is saved. The default is `"%" LV_PRId32`.
+ */
+void lv_binding_set_text_fmt(lv_binding_t * binding, const char * fmt);
+
+/**
+ * Mark the bindings of a source to be written at the next refresh.
+ * Several changes before the refresh cost one write. Call it from the thread of `lv_timer_handler()`.
+ * @param src_id        id of the source
+ */
+void lv_binding_notify(uint32_t src_id);
+
+/**
+ * Write the marked bindings now. It's called by the refresh before updating the layout.
+ */
+void lv_binding_apply(void);
+
+/**
+ * Get the statistics of the bindings
+ * @param stats         store the statistics here
+ */
+void lv_binding_get_stats(lv_binding_stats_t * stats);
+
+/*Used by the LV_BINDING_APPLY macro*/
+extern lv_binding_t * _lv_binding_dirty;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_BINDING_APPLY()      do { if(_lv_binding_dirty) lv_binding_apply(); } while(0)
+
+#else /*LV_USE_BINDING*/
+
+#define LV_BINDING_APPLY()
+
+#endif /*LV_USE_BINDING*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BINDING_H*/
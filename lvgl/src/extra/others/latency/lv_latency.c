@@ -0,0 +1,579 @@
+/**
+ * @file lv_latency.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_latency.h"
+#if LV_USE_LATENCY
+
+#include "../../../lvgl.h"
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+    #include <time.h>
+    #define LATENCY_HAS_CLOCK   1
+#else
+    #define LATENCY_HAS_CLOCK   0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MAX_PENDING         32          /*Inputs answered on the screen but not flushed yet*/
+#define MAX_DISPS           4           /*Displays whose flushes are followed*/
+#define FLUSH_RING          4           /*Flush times kept until the LVGL thread matches them to the inputs*/
+#define STAMP_MAX_AGE_US    10000000    /*Older time stamps are from an other clock so the read time is used*/
+
+#define SYNTH_MIN_PERIOD_MS 400
+#define SYNTH_TAP_US        100000      /*Time to hold a tap*/
+#define SYNTH_SWIPE_US      250000      /*Time to move during a swipe*/
+#define SYNTH_SAMPLE_US     16667       /*Moves are sampled at 60 Hz*/
+#define SYNTH_COLS          5           /*The actions start from the centers of a grid*/
+#define SYNTH_ROWS          4
+
+/*`lv_disp_flush_ready()` may run in an interrupt or an other thread.
+ *Without GCC/Clang atomics it has to be called from the LVGL thread.*/
+#if defined(__GNUC__) || defined(__clang__)
+#define FLUSH_LOAD_ACQUIRE(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define FLUSH_STORE_RELEASE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define FLUSH_LOAD_ACQUIRE(p)       (*(volatile uint32_t *)(p))
+#define FLUSH_STORE_RELEASE(p, v)   (*(volatile uint32_t *)(p) = (v))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * scr;                 /*NULL if deleted or for the screens which didn't fit into the table*/
+    const char * name;
+    uint32_t input_cnt;
+    uint32_t sample_cnt;
+    uint32_t max_us;
+    uint32_t samples[LV_LATENCY_MAX_SAMPLES];   /*The last samples in a ring*/
+    uint64_t stage_sum_us[_LV_LATENCY_STAGE_NUM];
+} screen_t;
+
+/*The time stamps of the stages, the stage `i` lasts from `time[i]` to `time[i + 1]`*/
+typedef struct {
+    screen_t * screen;
+    lv_disp_t * disp;
+    uint64_t time[_LV_LATENCY_STAGE_NUM];
+    bool rendering;                 /*The refresh with the response started*/
+    uint32_t flush_cnt;             /*The last area of the frame is the display's `flush_cnt`th, 0 until it's flushed*/
+} sample_t;
+
+/*The last areas of the frames of a display. The frames are flushed in order, so they are matched by count.*/
+typedef struct {
+    lv_disp_drv_t * drv;
+    uint32_t start_cnt;             /*Given to `flush_cb`, LVGL thread only*/
+    uint32_t done_cnt;              /*Flushed, written only in `lv_disp_flush_ready()`*/
+    uint64_t done_time[FLUSH_RING]; /*The time of the flush `n` is at `(n - 1) % FLUSH_RING`*/
+} flush_t;
+
+typedef struct {
+    lv_indev_drv_t drv;             /*Must be the first to get the state from the driver*/
+    uint64_t start_us;
+    uint32_t period_us;
+} synthetic_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool input_changed(lv_indev_t * indev, const lv_indev_data_t * data);
+static screen_t * screen_get(lv_obj_t * scr);
+static void screen_delete_event_cb(lv_event_t * e);
+static void sample_add(const sample_t * s, uint64_t now);
+static flush_t * flush_get(lv_disp_drv_t * disp_drv, bool add);
+static void flushed_collect(void);
+static uint32_t percentile(const uint32_t * sorted, uint32_t cnt, uint32_t p);
+static void synthetic_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
+static void print_line(lv_latency_print_cb_t print_cb, const char * format, ...) LV_FORMAT_ATTRIBUTE(2, 3);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+bool _lv_latency_running;
+bool _lv_latency_input_active;
+uint32_t _lv_latency_pending_cnt;
+
+static screen_t screens[LV_LATENCY_MAX_SCREENS];
+static uint32_t screen_cnt;
+
+/*The input being processed, its first invalidation makes it pending*/
+static sample_t input_act;
+static bool input_answered;
+
+static sample_t pending[MAX_PENDING];
+static uint32_t lost_cnt;
+
+static flush_t flushes[MAX_DISPS];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_latency_start(void)
+{
+    _lv_latency_running = true;
+}
+
+void lv_latency_stop(void)
+{
+    _lv_latency_running = false;
+    _lv_latency_input_active = false;
+    _lv_latency_pending_cnt = 0;
+}
+
+void lv_latency_reset(void)
+{
+    uint32_t i;
+    for(i = 0; i < screen_cnt; i++) {
+        screen_t * s = &screens[i];
+        s->input_cnt = 0;
+        s->sample_cnt = 0;
+        s->max_us = 0;
+        lv_memset_00(s->stage_sum_us, sizeof(s->stage_sum_us));
+    }
+    _lv_latency_input_active = false;
+    _lv_latency_pending_cnt = 0;
+    lost_cnt = 0;
+}
+
+void lv_latency_set_screen_name(lv_obj_t * scr, const char * name)
+{
+    LV_ASSERT_OBJ(scr, &lv_obj_class);
+
+    screen_t * s = screen_get(scr);
+    if(s->scr == scr) s->name = name;
+}
+
+uint32_t lv_latency_get_screen_cnt(void)
+{
+    return screen_cnt;
+}
+
+bool lv_latency_get_stats(uint32_t id, lv_latency_stats_t * stats)
+{
+    if(id >= screen_cnt) return false;
+
+    if(_lv_latency_pending_cnt) flushed_collect();
+
+    const screen_t * s = &screens[id];
+    lv_memset_00(stats, sizeof(*stats));
+    stats->name = s->name;
+    stats->input_cnt = s->input_cnt;
+    stats->sample_cnt = s->sample_cnt;
+    stats->max_us = s->max_us;
+    if(s->sample_cnt == 0) return true;
+
+    uint32_t i;
+    for(i = 0; i < _LV_LATENCY_STAGE_NUM; i++) stats->stage_avg_us[i] = (uint32_t)(s->stage_sum_us[i] / s->sample_cnt);
+
+    uint32_t cnt = LV_MIN(s->sample_cnt, LV_LATENCY_MAX_SAMPLES);
+    uint32_t * sorted = lv_mem_alloc(cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(sorted);
+    if(sorted == NULL) return true;
+
+    /*Insertion sort, there are a few hundred samples only*/
+    for(i = 0; i < cnt; i++) {
+        uint32_t v = s->samples[i];
+        uint32_t j = i;
+        while(j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    stats->p50_us = percentile(sorted, cnt, 50);
+    stats->p95_us = percentile(sorted, cnt, 95);
+    stats->p99_us = percentile(sorted, cnt, 99);
+    lv_mem_free(sorted);
+    return true;
+}
+
+uint64_t lv_latency_time_us(void)
+{
+#if LATENCY_HAS_CLOCK
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return (uint64_t)lv_tick_get() * 1000;
+#endif
+}
+
+void lv_latency_report(lv_latency_print_cb_t print_cb)
+{
+    LV_ASSERT_NULL(print_cb);
+
+    print_line(print_cb, "Touch-to-photon latency of %"LV_PRIu32" screens, %"LV_PRIu32" responses lost",
+               screen_cnt, lost_cnt);
+    print_line(print_cb, "%-16s %7s %7s %8s %8s %8s %8s %8s %8s %8s %8s %8s", "screen", "inputs", "samples",
+               "p50[us]", "p95[us]", "p99[us]", "max[us]", "read", "event", "inval", "wait", "render");
+
+    uint32_t i;
+    for(i = 0; i < screen_cnt; i++) {
+        lv_latency_stats_t st;
+        lv_latency_get_stats(i, &st);
+
+        char id_buf[16];
+        const char * name = st.name;
+        if(name == NULL && i == LV_LATENCY_MAX_SCREENS - 1) {
+            name = "other";
+        }
+        else if(name == NULL) {
+            lv_snprintf(id_buf, sizeof(id_buf), "#%"LV_PRIu32, i);
+            name = id_buf;
+        }
+
+        print_line(print_cb, "%-16s %7"LV_PRIu32" %7"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32
+                   " %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32,
+                   name, st.input_cnt, st.sample_cnt, st.p50_us, st.p95_us, st.p99_us, st.max_us,
+                   st.stage_avg_us[LV_LATENCY_STAGE_READ], st.stage_avg_us[LV_LATENCY_STAGE_EVENT],
+                   st.stage_avg_us[LV_LATENCY_STAGE_INVALIDATE], st.stage_avg_us[LV_LATENCY_STAGE_WAIT],
+                   st.stage_avg_us[LV_LATENCY_STAGE_RENDER]);
+    }
+}
+
+lv_indev_t * lv_latency_synthetic_create(lv_disp_t * disp, uint32_t period_ms)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return NULL;
+
+    synthetic_t * synth = lv_mem_alloc(sizeof(synthetic_t));
+    LV_ASSERT_MALLOC(synth);
+    if(synth == NULL) return NULL;
+
+    lv_indev_drv_init(&synth->drv);
+    synth->drv.type = LV_INDEV_TYPE_POINTER;
+    synth->drv.read_cb = synthetic_read;
+    synth->drv.disp = disp;
+    synth->start_us = lv_latency_time_us();
+    synth->period_us = LV_MAX(period_ms, SYNTH_MIN_PERIOD_MS) * 1000;
+
+    return lv_indev_drv_register(&synth->drv);
+}
+
+void _lv_latency_input(lv_indev_t * indev, const lv_indev_data_t * data)
+{
+    if(!input_changed(indev, data)) return;
+
+    uint64_t now = lv_latency_time_us();
+    uint64_t stamp = data->timestamp_us;
+    if(stamp == 0 || stamp > now || now - stamp > STAMP_MAX_AGE_US) stamp = now;
+
+    lv_disp_t * disp = indev->driver->disp;
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    if(scr == NULL) return;
+
+    screen_t * s = screen_get(scr);
+    s->input_cnt++;
+
+    lv_memset_00(&input_act, sizeof(input_act));
+    input_act.screen = s;
+    input_act.disp = disp;
+    input_act.time[LV_LATENCY_STAGE_READ] = stamp;
+    input_act.time[LV_LATENCY_STAGE_EVENT] = now;
+    input_answered = false;
+    _lv_latency_input_active = true;
+}
+
+void _lv_latency_input_end(void)
+{
+    _lv_latency_input_active = false;
+}
+
+void _lv_latency_event(void)
+{
+    if(input_answered || input_act.time[LV_LATENCY_STAGE_INVALIDATE]) return;
+    input_act.time[LV_LATENCY_STAGE_INVALIDATE] = lv_latency_time_us();
+}
+
+void _lv_latency_invalidate(lv_disp_t * disp)
+{
+    if(input_answered) return;
+    input_answered = true;
+
+    if(_lv_latency_pending_cnt >= MAX_PENDING) {
+        lost_cnt++;
+        return;
+    }
+
+    sample_t * s = &pending[_lv_latency_pending_cnt];
+    *s = input_act;
+    s->disp = disp;
+    /*The input was answered without an event, e.g. by scrolling*/
+    if(s->time[LV_LATENCY_STAGE_INVALIDATE] == 0) {
+        s->time[LV_LATENCY_STAGE_INVALIDATE] = s->time[LV_LATENCY_STAGE_EVENT];
+    }
+    s->time[LV_LATENCY_STAGE_WAIT] = lv_latency_time_us();
+    _lv_latency_pending_cnt++;
+}
+
+void _lv_latency_refr_begin(lv_disp_t * disp)
+{
+    flushed_collect();
+    if(disp->inv_p == 0) return;
+
+    uint64_t now = lv_latency_time_us();
+    uint32_t i;
+    for(i = 0; i < _lv_latency_pending_cnt; i++) {
+        sample_t * s = &pending[i];
+        if(s->disp != disp || s->rendering) continue;
+        s->time[LV_LATENCY_STAGE_RENDER] = now;
+        s->rendering = true;
+    }
+}
+
+void _lv_latency_flush(lv_disp_drv_t * disp_drv)
+{
+    flush_t * f = flush_get(disp_drv, true);
+    if(f == NULL) return;
+
+    f->start_cnt++;
+    uint32_t i;
+    for(i = 0; i < _lv_latency_pending_cnt; i++) {
+        sample_t * s = &pending[i];
+        if(s->rendering && s->flush_cnt == 0 && s->disp->driver == disp_drv) s->flush_cnt = f->start_cnt;
+    }
+}
+
+void _lv_latency_flush_ready(lv_disp_drv_t * disp_drv)
+{
+    /*Only the time is saved here, the samples are updated in the LVGL thread*/
+    flush_t * f = flush_get(disp_drv, false);
+    if(f == NULL) return;
+
+    uint32_t cnt = f->done_cnt;
+    f->done_time[cnt % FLUSH_RING] = lv_latency_time_us();
+    FLUSH_STORE_RELEASE(&f->done_cnt, cnt + 1);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Tell if the read data is a new input: a press, a release, a move or a key
+ * @param indev     the input device, not updated with `data` yet
+ * @param data      the data just read
+ * @return          true: the data differs from the previous one
+ */
+static bool input_changed(lv_indev_t * indev, const lv_indev_data_t * data)
+{
+    bool pressed = data->state == LV_INDEV_STATE_PRESSED;
+    if(data->state != indev->proc.state) return true;
+
+    switch(indev->driver->type) {
+        case LV_INDEV_TYPE_POINTER:
+            return pressed && (data->point.x != indev->proc.types.pointer.last_raw_point.x ||
+                               data->point.y != indev->proc.types.pointer.last_raw_point.y);
+        case LV_INDEV_TYPE_KEYPAD:
+            return pressed && data->key != indev->proc.types.keypad.last_key;
+        case LV_INDEV_TYPE_ENCODER:
+            return data->enc_diff != 0;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Find the statistics of a screen or add it
+ * @param scr       pointer to a screen
+ * @return          the statistics of the screen or the common one of the screens which didn't fit
+ */
+static screen_t * screen_get(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < screen_cnt; i++) {
+        if(screens[i].scr == scr) return &screens[i];
+    }
+
+    /*The last slot collects the screens which don't fit*/
+    if(screen_cnt >= LV_LATENCY_MAX_SCREENS - 1) {
+        screen_cnt = LV_LATENCY_MAX_SCREENS;
+        return &screens[LV_LATENCY_MAX_SCREENS - 1];
+    }
+
+    screen_t * s = &screens[screen_cnt];
+    screen_cnt++;
+    s->scr = scr;
+    /*Keep the statistics of deleted screens but don't let a new screen at the same address use them*/
+    lv_obj_add_event_cb(scr, screen_delete_event_cb, LV_EVENT_DELETE, s);
+    return s;
+}
+
+static void screen_delete_event_cb(lv_event_t * e)
+{
+    screen_t * s = lv_event_get_user_data(e);
+    s->scr = NULL;
+}
+
+/**
+ * Add a sample whose last area was just flushed
+ * @param s         the sample
+ * @param now       the end of the rendering
+ */
+static void sample_add(const sample_t * s, uint64_t now)
+{
+    screen_t * scr = s->screen;
+    uint32_t latency = (uint32_t)(now - s->time[LV_LATENCY_STAGE_READ]);
+
+    scr->samples[scr->sample_cnt % LV_LATENCY_MAX_SAMPLES] = latency;
+    scr->sample_cnt++;
+    if(latency > scr->max_us) scr->max_us = latency;
+
+    uint32_t i;
+    for(i = 0; i < _LV_LATENCY_STAGE_NUM; i++) {
+        uint64_t end = i + 1 < _LV_LATENCY_STAGE_NUM ? s->time[i + 1] : now;
+        scr->stage_sum_us[i] += end - s->time[i];
+    }
+}
+
+/**
+ * Find the flushes of a display driver
+ * @param disp_drv  pointer to a display driver
+ * @param add       true: add the driver if it's not followed yet. Only in the LVGL thread.
+ * @return          the flushes of the driver or NULL if it's not followed
+ */
+static flush_t * flush_get(lv_disp_drv_t * disp_drv, bool add)
+{
+    uint32_t i;
+    for(i = 0; i < MAX_DISPS; i++) {
+        if(flushes[i].drv == disp_drv) return &flushes[i];
+    }
+    if(!add) return NULL;
+
+    for(i = 0; i < MAX_DISPS; i++) {
+        if(flushes[i].drv == NULL) {
+            flushes[i].drv = disp_drv;
+            return &flushes[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Add the samples whose frame was flushed since the last call
+ */
+static void flushed_collect(void)
+{
+    uint32_t i = 0;
+    while(i < _lv_latency_pending_cnt) {
+        sample_t * s = &pending[i];
+        flush_t * f = s->flush_cnt ? flush_get(s->disp->driver, false) : NULL;
+        if(f == NULL || (int32_t)(FLUSH_LOAD_ACQUIRE(&f->done_cnt) - s->flush_cnt) < 0) {
+            i++;
+            continue;
+        }
+
+        uint64_t t = f->done_time[(s->flush_cnt - 1) % FLUSH_RING];
+        /*The time is valid if it wasn't overwritten by a later flush meanwhile*/
+        if(FLUSH_LOAD_ACQUIRE(&f->done_cnt) - s->flush_cnt < FLUSH_RING) sample_add(s, t);
+        else lost_cnt++;
+
+        _lv_latency_pending_cnt--;
+        *s = pending[_lv_latency_pending_cnt];
+    }
+}
+
+/**
+ * Get a percentile with the nearest-rank method
+ * @param sorted    the samples in increasing order
+ * @param cnt       number of samples, at least 1
+ * @param p         the percentile [1..100]
+ */
+static uint32_t percentile(const uint32_t * sorted, uint32_t cnt, uint32_t p)
+{
+    uint32_t rank = (p * cnt + 99) / 100;
+    if(rank == 0) rank = 1;
+    return sorted[rank - 1];
+}
+
+/**
+ * Play taps and swipes. Every action starts from the next center of a grid on the display.
+ * Every 4th action is a swipe to the left, right, up or down in turn, the others are taps.
+ */
+static void synthetic_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
+{
+    synthetic_t * synth = (synthetic_t *)drv;
+    lv_coord_t hor_res = lv_disp_get_hor_res(drv->disp);
+    lv_coord_t ver_res = lv_disp_get_ver_res(drv->disp);
+
+    uint64_t elapsed = lv_latency_time_us() - synth->start_us;
+    uint32_t action = (uint32_t)(elapsed / synth->period_us);
+    uint64_t action_start = synth->start_us + (uint64_t)action * synth->period_us;
+    uint32_t t = (uint32_t)(elapsed - (uint64_t)action * synth->period_us);
+
+    uint32_t cell = action % (SYNTH_COLS * SYNTH_ROWS);
+    data->point.x = (lv_coord_t)(((cell % SYNTH_COLS) * 2 + 1) * hor_res / (SYNTH_COLS * 2));
+    data->point.y = (lv_coord_t)(((cell / SYNTH_COLS) * 2 + 1) * ver_res / (SYNTH_ROWS * 2));
+
+    if(action % 4 != 3) {
+        if(t < SYNTH_TAP_US) {
+            data->state = LV_INDEV_STATE_PRESSED;
+            data->timestamp_us = action_start;
+        }
+        else {
+            data->state = LV_INDEV_STATE_RELEASED;
+            data->timestamp_us = action_start + SYNTH_TAP_US;
+        }
+        return;
+    }
+
+    /*Swipe a third of the display from the center of the cell, sampled like a touch controller*/
+    uint32_t sample = LV_MIN(t, SYNTH_SWIPE_US) / SYNTH_SAMPLE_US;
+    uint32_t sample_cnt = SYNTH_SWIPE_US / SYNTH_SAMPLE_US;
+    lv_coord_t dx = 0;
+    lv_coord_t dy = 0;
+    switch((action / 4) % 4) {
+        case 0:
+            dx = -hor_res / 3;
+            break;
+        case 1:
+            dx = hor_res / 3;
+            break;
+        case 2:
+            dy = -ver_res / 3;
+            break;
+        default:
+            dy = ver_res / 3;
+            break;
+    }
+    data->point.x = LV_CLAMP(0, data->point.x + (lv_coord_t)(dx * (int32_t)sample / (int32_t)sample_cnt), hor_res - 1);
+    data->point.y = LV_CLAMP(0, data->point.y + (lv_coord_t)(dy * (int32_t)sample / (int32_t)sample_cnt), ver_res - 1);
+
+    if(sample < sample_cnt) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        data->timestamp_us = action_start + (uint64_t)sample * SYNTH_SAMPLE_US;
+    }
+    else {
+        data->state = LV_INDEV_STATE_RELEASED;
+        data->timestamp_us = action_start + (uint64_t)sample_cnt * SYNTH_SAMPLE_US;
+    }
+}
+
+static void print_line(lv_latency_print_cb_t print_cb, const char * format, ...)
+{
+    char buf[160];
+    va_list args;
+    va_start(args, format);
+    lv_vsnprintf(buf, sizeof(buf) - 1, format, args);
+    va_end(args);
+
+    /*Every line is printed with a new line like the logs*/
+    size_t len = strlen(buf);
+    buf[len] = '\n';
+    buf[len + 1] = '\0';
+    print_cb(buf);
+}
+
+#endif /*LV_USE_LATENCY*/
@@ -0,0 +1,167 @@
+/**
+ * @file lv_latency.h
+ * Measure the touch-to-photon latency: the time from an input event until the frame
+ * showing its first visible response is flushed, with percentiles per screen.
+ * `lv_disp_flush_ready()` can be called from an interrupt or an other thread too, it only saves the time of the flush.
+ */
+#ifndef LV_LATENCY_H
+#define LV_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+/*Included by the core, so it doesn't include lvgl.h*/
+#include "../../../lv_conf_internal.h"
+#include "../../../hal/lv_hal_indev.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_LATENCY
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_obj_t;
+struct _lv_disp_t;
+struct _lv_disp_drv_t;
+struct _lv_indev_t;
+
+/**
+ * The stages of the path from an input to the display.
+ * They follow each other so their sum is the latency.
+ */
+typedef enum {
+    LV_LATENCY_STAGE_READ,          /**< From the time stamp of the input until the input device read it*/
+    LV_LATENCY_STAGE_EVENT,         /**< Until the first event was sent for it*/
+    LV_LATENCY_STAGE_INVALIDATE,    /**< Until the first area was invalidated*/
+    LV_LATENCY_STAGE_WAIT,          /**< Until the refresh of the display started*/
+    LV_LATENCY_STAGE_RENDER,        /**< Until the last area of the frame was flushed*/
+    _LV_LATENCY_STAGE_NUM
+} lv_latency_stage_t;
+
+typedef struct {
+    const char * name;
+    uint32_t input_cnt;                             /**< Inputs while the screen was active*/
+    uint32_t sample_cnt;                            /**< Inputs with a visible response*/
+    uint32_t p50_us;                                /**< Percentiles of the last `LV_LATENCY_MAX_SAMPLES` samples*/
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t stage_avg_us[_LV_LATENCY_STAGE_NUM];   /**< Average of all samples*/
+} lv_latency_stats_t;
+
+typedef void (*lv_latency_print_cb_t)(const char * buf);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start measuring. The earlier measurements are kept.
+ */
+void lv_latency_start(void);
+
+/**
+ * Stop measuring. The inputs waiting for a flush are dropped.
+ */
+void lv_latency_stop(void);
+
+/**
+ * Clear the measurements of every screen
+ */
+void lv_latency_reset(void);
+
+/**
+ * Name a screen in the report. By default the screens are numbered in the order of the first input.
+ * @param scr       pointer to a screen
+ * @param name      name of the screen. Only the pointer is saved.
+ */
+void lv_latency_set_screen_name(struct _lv_obj_t * scr, const char * name);
+
+/**
+ * Get the number of screens with measurements
+ * @return          number of screens which were active during an input
+ */
+uint32_t lv_latency_get_screen_cnt(void);
+
+/**
+ * Get the statistics of a screen
+ * @param id        index of the screen in the order of the first input
+ * @param stats     store the statistics here
+ * @return          true: `stats` is filled; false: there is no such screen
+ */
+bool lv_latency_get_stats(uint32_t id, lv_latency_stats_t * stats);
+
+/**
+ * Get the time stamp used by the measurement. The input drivers should stamp the inputs with this clock.
+ * @return          a monotonic time in microseconds (`CLOCK_MONOTONIC` on Linux)
+ */
+uint64_t lv_latency_time_us(void);
+
+/**
+ * Print the statistics of every screen as a table
+ * @param print_cb  called with every line of the report
+ */
+void lv_latency_report(lv_latency_print_cb_t print_cb);
+
+/**
+ * Create a pointer input device which taps and swipes on its own to drive the measurement.
+ * The actions follow each other in a fixed order from the top-left to the bottom-right of the display.
+ * Moves are sampled at 60 Hz like a touch controller and stamped with the time of the sample.
+ * @param disp      the display to use, NULL to use the default
+ * @param period_ms time between the starts of two actions
+ * @return          the new input device or NULL on error
+ */
+struct _lv_indev_t * lv_latency_synthetic_create(struct _lv_disp_t * disp, uint32_t period_ms);
+
+/*Called via the LV_LATENCY_... macros in the library*/
+void _lv_latency_input(struct _lv_indev_t * indev, const lv_indev_data_t * data);
+void _lv_latency_input_end(void);
+void _lv_latency_event(void);
+void _lv_latency_invalidate(struct _lv_disp_t * disp);
+void _lv_latency_refr_begin(struct _lv_disp_t * disp);
+void _lv_latency_flush(struct _lv_disp_drv_t * disp_drv);
+void _lv_latency_flush_ready(struct _lv_disp_drv_t * disp_drv);
+
+extern bool _lv_latency_running;
+extern bool _lv_latency_input_active;
+extern uint32_t _lv_latency_pending_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_LATENCY_INPUT(indev, data)           do { if(_lv_latency_running) _lv_latency_input(indev, data); } while(0)
+#define LV_LATENCY_INPUT_END()                  do { if(_lv_latency_input_active) _lv_latency_input_end(); } while(0)
+#define LV_LATENCY_EVENT()                      do { if(_lv_latency_input_active) _lv_latency_event(); } while(0)
+#define LV_LATENCY_INVALIDATE(disp)             do { if(_lv_latency_input_active) _lv_latency_invalidate(disp); } while(0)
+#define LV_LATENCY_REFR_BEGIN(disp)             do { if(_lv_latency_pending_cnt) _lv_latency_refr_begin(disp); } while(0)
+/*The last areas are counted also when not measuring, so the flushes in progress stay matched*/
+#define LV_LATENCY_FLUSH(disp_drv)              do { if((disp_drv)->draw_buf->flushing_last) _lv_latency_flush(disp_drv); } while(0)
+#define LV_LATENCY_FLUSH_READY(disp_drv)        do { if((disp_drv)->draw_buf->flushing_last) _lv_latency_flush_ready(disp_drv); } while(0)
+
+#else /*LV_USE_LATENCY*/
+
+#define LV_LATENCY_INPUT(indev, data)
+#define LV_LATENCY_INPUT_END()
+#define LV_LATENCY_EVENT()
+#define LV_LATENCY_INVALIDATE(disp)
+#define LV_LATENCY_REFR_BEGIN(disp)
+#define LV_LATENCY_FLUSH(disp_drv)
+#define LV_LATENCY_FLUSH_READY(disp_drv)
+
+#endif /*LV_USE_LATENCY*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_LATENCY_H*/
@@ -20,6 +20,9 @@ extern "C" {
 #include "imgfont/lv_imgfont.h"
 #include "msg/lv_msg.h"
 #include "ime/lv_ime_pinyin.h"
+#include "profiler/lv_profiler.h"
+#include "latency/lv_latency.h"
+#include "binding/lv_binding.h"
 
 /*********************
  *      DEFINES
@@ -0,0 +1,474 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+#if LV_USE_PROFILER
+
+#include "../../../lvgl.h"
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+    #include <time.h>
+    #define PROFILER_HAS_CLOCK  1
+#else
+    #define PROFILER_HAS_CLOCK  0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define OBJ_CREATE_DEPTH    16  /*Nesting of the creations made by constructors which is timed*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_obj_class_t * class_p;
+    const char * name;
+} class_name_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_profiler_phase_t * phase_act(void);
+static void print_line(lv_profiler_print_cb_t print_cb, const char * format, ...) LV_FORMAT_ATTRIBUTE(2, 3);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+bool _lv_profiler_running;
+
+static lv_profiler_phase_t phases[LV_PROFILER_MAX_PHASES];
+static uint32_t phase_cnt;
+static uint64_t start_time;
+static int64_t first_flush_time = -1;
+
+static lv_profiler_class_t classes[LV_PROFILER_MAX_CLASSES];
+static uint32_t class_cnt;
+
+/*The outermost activity is timed, the nested ones only counted*/
+static uint32_t busy_depth;
+static lv_profiler_cat_t busy_cat;
+static uint64_t busy_start;
+
+static uint64_t obj_create_start[OBJ_CREATE_DEPTH];
+static uint32_t obj_create_depth;
+
+#if LV_USE_ROLLER
+    extern const lv_obj_class_t lv_roller_label_class;
+#endif
+
+static const class_name_t class_names[] = {
+    {&lv_obj_class, "obj"},
+#if LV_USE_ARC
+    {&lv_arc_class, "arc"},
+#endif
+#if LV_USE_BAR
+    {&lv_bar_class, "bar"},
+#endif
+#if LV_USE_BTN
+    {&lv_btn_class, "btn"},
+#endif
+#if LV_USE_BTNMATRIX
+    {&lv_btnmatrix_class, "btnmatrix"},
+#endif
+#if LV_USE_CANVAS
+    {&lv_canvas_class, "canvas"},
+#endif
+#if LV_USE_CHECKBOX
+    {&lv_checkbox_class, "checkbox"},
+#endif
+#if LV_USE_DROPDOWN
+    {&lv_dropdown_class, "dropdown"},
+    {&lv_dropdownlist_class, "dropdown list"},
+#endif
+#if LV_USE_IMG
+    {&lv_img_class, "img"},
+#endif
+#if LV_USE_LABEL
+    {&lv_label_class, "label"},
+#endif
+#if LV_USE_LINE
+    {&lv_line_class, "line"},
+#endif
+#if LV_USE_ROLLER
+    {&lv_roller_class, "roller"},
+    {&lv_roller_label_class, "roller label"},
+#endif
+#if LV_USE_SLIDER
+    {&lv_slider_class, "slider"},
+#endif
+#if LV_USE_SWITCH
+    {&lv_switch_class, "switch"},
+#endif
+#if LV_USE_TABLE
+    {&lv_table_class, "table"},
+#endif
+#if LV_USE_TEXTAREA
+    {&lv_textarea_class, "textarea"},
+#endif
+#if LV_USE_ANALOGCLOCK
+    {&lv_analogclock_class, "analogclock"},
+#endif
+#if LV_USE_ANIMIMG
+    {&lv_animimg_class, "animimg"},
+#endif
+#if LV_USE_CALENDAR
+    {&lv_calendar_class, "calendar"},
+#if LV_USE_CALENDAR_HEADER_ARROW
+    {&lv_calendar_header_arrow_class, "calendar header arrow"},
+#endif
+#if LV_USE_CALENDAR_HEADER_DROPDOWN
+    {&lv_calendar_header_dropdown_class, "calendar header dropdown"},
+#endif
+#endif
+#if LV_USE_CAROUSEL
+    {&lv_carousel_class, "carousel"},
+    {&lv_carousel_element_class, "carousel element"},
+#endif
+#if LV_USE_CHART
+    {&lv_chart_class, "chart"},
+#endif
+#if LV_USE_COLORWHEEL
+    {&lv_colorwheel_class, "colorwheel"},
+#endif
+#if LV_USE_DCLOCK
+    {&lv_dclock_class, "dclock"},
+#endif
+#if LV_USE_IMGBTN
+    {&lv_imgbtn_class, "imgbtn"},
+#endif
+#if LV_USE_KEYBOARD
+    {&lv_keyboard_class, "keyboard"},
+#endif
+#if LV_USE_ZH_KEYBOARD
+    {&lv_zh_keyboard_class, "zh keyboard"},
+#endif
+#if LV_USE_LED
+    {&lv_led_class, "led"},
+#endif
+#if LV_USE_LIST
+    {&lv_list_class, "list"},
+    {&lv_list_btn_class, "list btn"},
+    {&lv_list_text_class, "list text"},
+#endif
+#if LV_USE_MENU
+    {&lv_menu_class, "menu"},
+    {&lv_menu_page_class, "menu page"},
+    {&lv_menu_cont_class, "menu cont"},
+    {&lv_menu_section_class, "menu section"},
+    {&lv_menu_separator_class, "menu separator"},
+    {&lv_menu_sidebar_cont_class, "menu sidebar cont"},
+    {&lv_menu_main_cont_class, "menu main cont"},
+    {&lv_menu_sidebar_header_cont_class, "menu sidebar header"},
+    {&lv_menu_main_header_cont_class, "menu main header"},
+#endif
+#if LV_USE_METER
+    {&lv_meter_class, "meter"},
+#endif
+#if LV_USE_MSGBOX
+    {&lv_msgbox_class, "msgbox"},
+    {&lv_msgbox_content_class, "msgbox content"},
+    {&lv_msgbox_backdrop_class, "msgbox backdrop"},
+#endif
+#if LV_USE_RADIOBTN
+    {&lv_radiobtn_class, "radiobtn"},
+    {&lv_radiobtn_item_class, "radiobtn item"},
+#endif
+#if LV_USE_SPAN
+    {&lv_spangroup_class, "spangroup"},
+#endif
+#if LV_USE_SPINBOX
+    {&lv_spinbox_class, "spinbox"},
+#endif
+#if LV_USE_SPINNER
+    {&lv_spinner_class, "spinner"},
+#endif
+#if LV_USE_STREAMCHART
+    {&lv_streamchart_class, "streamchart"},
+#endif
+#if LV_USE_TABVIEW
+    {&lv_tabview_class, "tabview"},
+#endif
+#if LV_USE_TEXTPROGRESS
+    {&lv_textprogress_class, "textprogress"},
+#endif
+#if LV_USE_TILEVIEW
+    {&lv_tileview_class, "tileview"},
+    {&lv_tileview_tile_class, "tileview tile"},
+#endif
+#if LV_USE_VLIST
+    {&lv_vlist_class, "vlist"},
+#endif
+#if LV_USE_WIN
+    {&lv_win_class, "win"},
+#endif
+#if LV_USE_BARCODE
+    {&lv_barcode_class, "barcode"},
+#endif
+#if LV_USE_QRCODE
+    {&lv_qrcode_class, "qrcode"},
+#endif
+#if LV_USE_GIF
+    {&lv_gif_class, "gif"},
+#endif
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_profiler_phase(const char * name)
+{
+    uint64_t now = lv_profiler_time_us();
+    if(!_lv_profiler_running && phase_cnt == 0) start_time = now;
+
+    lv_profiler_phase_t * act = phase_act();
+    if(act) act->time_us = now - start_time - act->start_us;
+
+    if(phase_cnt >= LV_PROFILER_MAX_PHASES) {
+        LV_LOG_WARN("too many phases, %s is counted for %s. Increase LV_PROFILER_MAX_PHASES", name, act->name);
+        _lv_profiler_running = true;
+        return;
+    }
+
+    act = &phases[phase_cnt];
+    phase_cnt++;
+    lv_memset_00(act, sizeof(*act));
+    act->name = name;
+    act->start_us = now - start_time;
+    _lv_profiler_running = true;
+}
+
+void lv_profiler_stop(void)
+{
+    if(!_lv_profiler_running) return;
+
+    lv_profiler_phase_t * act = phase_act();
+    if(act) act->time_us = lv_profiler_time_us() - start_time - act->start_us;
+    _lv_profiler_running = false;
+    busy_depth = 0;
+    obj_create_depth = 0;
+}
+
+uint32_t lv_profiler_get_phase_cnt(void)
+{
+    return phase_cnt;
+}
+
+const lv_profiler_phase_t * lv_profiler_get_phase(uint32_t id)
+{
+    if(id >= phase_cnt) return NULL;
+
+    /*Let the current phase last until now*/
+    if(_lv_profiler_running && id == phase_cnt - 1) {
+        phases[id].time_us = lv_profiler_time_us() - start_time - phases[id].start_us;
+    }
+    return &phases[id];
+}
+
+uint32_t lv_profiler_get_class_cnt(void)
+{
+    return class_cnt;
+}
+
+const lv_profiler_class_t * lv_profiler_get_class(uint32_t id)
+{
+    if(id >= class_cnt) return NULL;
+    return &classes[id];
+}
+
+const char * lv_profiler_get_class_name(const struct _lv_obj_class_t * class_p)
+{
+    if(class_p == NULL) return "other";
+
+    uint32_t i;
+    for(i = 0; i < sizeof(class_names) / sizeof(class_names[0]); i++) {
+        if(class_names[i].class_p == class_p) return class_names[i].name;
+    }
+    return "?";
+}
+
+int64_t lv_profiler_get_first_flush_time(void)
+{
+    return first_flush_time;
+}
+
+uint64_t lv_profiler_time_us(void)
+{
+#if PROFILER_HAS_CLOCK
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return (uint64_t)lv_tick_get() * 1000;
+#endif
+}
+
+void lv_profiler_report(lv_profiler_print_cb_t print_cb)
+{
+    LV_ASSERT_NULL(print_cb);
+
+    uint64_t total = 0;
+    if(phase_cnt) {
+        const lv_profiler_phase_t * last = lv_profiler_get_phase(phase_cnt - 1);
+        total = last->start_us + last->time_us;
+    }
+
+    print_line(print_cb, "Profile of %"LV_PRIu32" phases, %"LV_PRIu32" us in total", phase_cnt, (uint32_t)total);
+    if(first_flush_time >= 0) {
+        print_line(print_cb, "First flush after %"LV_PRIu32" us", (uint32_t)first_flush_time);
+    }
+    else {
+        print_line(print_cb, "Nothing was flushed");
+    }
+
+    print_line(print_cb, "%-16s %10s %10s %7s %10s %7s %10s %5s %10s %7s %10s %7s",
+               "phase", "start[us]", "time[us]", "objs", "create[us]", "styles", "style[us]", "refrs", "render[us]",
+               "allocs", "bytes", "frees");
+    uint32_t i;
+    for(i = 0; i < phase_cnt; i++) {
+        const lv_profiler_phase_t * p = lv_profiler_get_phase(i);
+        print_line(print_cb, "%-16s %10"LV_PRIu32" %10"LV_PRIu32" %7"LV_PRIu32" %10"LV_PRIu32" %7"LV_PRIu32" %10"LV_PRIu32
+                   " %5"LV_PRIu32" %10"LV_PRIu32" %7"LV_PRIu32" %10"LV_PRIu32" %7"LV_PRIu32,
+                   p->name, (uint32_t)p->start_us, (uint32_t)p->time_us,
+                   p->obj_cnt, (uint32_t)p->cat_time_us[LV_PROFILER_CAT_OBJ_CREATE],
+                   p->style_cnt, (uint32_t)p->cat_time_us[LV_PROFILER_CAT_STYLE],
+                   p->refr_cnt, (uint32_t)p->cat_time_us[LV_PROFILER_CAT_RENDER],
+                   p->alloc_cnt, (uint32_t)p->alloc_size, p->free_cnt);
+    }
+
+    print_line(print_cb, "%-24s %7s %10s %8s", "class", "count", "time[us]", "avg[us]");
+    for(i = 0; i < class_cnt; i++) {
+        const lv_profiler_class_t * c = &classes[i];
+        print_line(print_cb, "%-24s %7"LV_PRIu32" %10"LV_PRIu32" %8"LV_PRIu32, lv_profiler_get_class_name(c->class_p),
+                   c->cnt, (uint32_t)c->time_us, (uint32_t)(c->time_us / c->cnt));
+    }
+}
+
+void _lv_profiler_begin(lv_profiler_cat_t cat)
+{
+    if(busy_depth == 0) {
+        busy_cat = cat;
+        busy_start = lv_profiler_time_us();
+    }
+    busy_depth++;
+}
+
+void _lv_profiler_end(lv_profiler_cat_t cat)
+{
+    /*Ignore the end of an activity which began before the profiler started*/
+    if(busy_depth == 0) return;
+
+    busy_depth--;
+    lv_profiler_phase_t * act = phase_act();
+    if(cat == LV_PROFILER_CAT_STYLE) act->style_cnt++;
+    else if(cat == LV_PROFILER_CAT_RENDER) act->refr_cnt++;
+
+    if(busy_depth == 0) {
+        act->cat_time_us[busy_cat] += lv_profiler_time_us() - busy_start;
+    }
+}
+
+void _lv_profiler_obj_create_begin(void)
+{
+    if(obj_create_depth < OBJ_CREATE_DEPTH) {
+        obj_create_start[obj_create_depth] = lv_profiler_time_us();
+    }
+    obj_create_depth++;
+    _lv_profiler_begin(LV_PROFILER_CAT_OBJ_CREATE);
+}
+
+void _lv_profiler_obj_create_end(const struct _lv_obj_class_t * class_p)
+{
+    if(obj_create_depth == 0) return;
+
+    obj_create_depth--;
+    _lv_profiler_end(LV_PROFILER_CAT_OBJ_CREATE);
+
+    /*The creation failed*/
+    if(class_p == NULL) return;
+
+    phase_act()->obj_cnt++;
+
+    lv_profiler_class_t * c = NULL;
+    uint32_t i;
+    for(i = 0; i < class_cnt; i++) {
+        if(classes[i].class_p == class_p) {
+            c = &classes[i];
+            break;
+        }
+    }
+
+    if(c == NULL) {
+        /*The last slot collects the classes which don't fit*/
+        if(class_cnt < LV_PROFILER_MAX_CLASSES - 1) {
+            c = &classes[class_cnt];
+            c->class_p = class_p;
+            class_cnt++;
+        }
+        else {
+            c = &classes[LV_PROFILER_MAX_CLASSES - 1];
+            c->class_p = NULL;
+            class_cnt = LV_PROFILER_MAX_CLASSES;
+        }
+    }
+
+    c->cnt++;
+    if(obj_create_depth < OBJ_CREATE_DEPTH) {
+        c->time_us += lv_profiler_time_us() - obj_create_start[obj_create_depth];
+    }
+}
+
+void _lv_profiler_alloc(size_t size)
+{
+    lv_profiler_phase_t * act = phase_act();
+    act->alloc_cnt++;
+    act->alloc_size += size;
+}
+
+void _lv_profiler_free(void)
+{
+    phase_act()->free_cnt++;
+}
+
+void _lv_profiler_flush(void)
+{
+    phase_act()->flush_cnt++;
+    if(first_flush_time < 0) first_flush_time = (int64_t)(lv_profiler_time_us() - start_time);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_profiler_phase_t * phase_act(void)
+{
+    if(phase_cnt == 0) return NULL;
+    return &phases[phase_cnt - 1];
+}
+
+static void print_line(lv_profiler_print_cb_t print_cb, const char * format, ...)
+{
+    char buf[160];
+    va_list args;
+    va_start(args, format);
+    lv_vsnprintf(buf, sizeof(buf) - 1, format, args);
+    va_end(args);
+
+    /*Every line is printed with a new line like the logs*/
+    size_t len = strlen(buf);
+    buf[len] = '\n';
+    buf[len + 1] = '\0';
+    print_cb(buf);
+}
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,174 @@
+/**
+ * @file lv_profiler.h
+ * Split the run time of the application into named phases and measure in each phase
+ * how long the object creation, the style setting and the rendering take,
+ * how many objects of each class are created and how many allocations are made.
+ */
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+/*Included by lv_mem.c and the core too, so it doesn't include lvgl.h*/
+#include "../../../lv_conf_internal.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if LV_USE_PROFILER
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_obj_class_t;
+
+/**
+ * What the time of a phase is spent on.
+ * Nested work is counted for the outermost activity only,
+ * e.g. the styles set by a constructor are part of the object creation.
+ */
+typedef enum {
+    LV_PROFILER_CAT_OBJ_CREATE,     /**< `lv_..._create()`*/
+    LV_PROFILER_CAT_STYLE,          /**< `lv_obj_add_style()`, `lv_obj_set_style_...()`*/
+    LV_PROFILER_CAT_RENDER,         /**< Refreshing the displays, including the flushes*/
+    _LV_PROFILER_CAT_NUM
+} lv_profiler_cat_t;
+
+typedef struct {
+    const char * name;
+    uint64_t start_us;                          /**< Since the first phase started*/
+    uint64_t time_us;                           /**< Until now for the current phase*/
+    uint64_t cat_time_us[_LV_PROFILER_CAT_NUM];
+    uint32_t obj_cnt;                           /**< Created objects*/
+    uint32_t style_cnt;                         /**< Styles added or set*/
+    uint32_t refr_cnt;                          /**< Refreshes of a display*/
+    uint32_t flush_cnt;                         /**< Flushed areas*/
+    uint32_t alloc_cnt;                         /**< `lv_mem_alloc()` and `lv_mem_realloc()` calls*/
+    uint32_t free_cnt;
+    uint64_t alloc_size;                        /**< Bytes requested by the allocations*/
+} lv_profiler_phase_t;
+
+typedef struct {
+    const struct _lv_obj_class_t * class_p;     /**< NULL: the classes which didn't fit into the table*/
+    uint32_t cnt;
+    uint64_t time_us;                           /**< Including the children created by the constructor*/
+} lv_profiler_class_t;
+
+typedef void (*lv_profiler_print_cb_t)(const char * buf);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * End the current phase and start a new one. The first call starts the profiler.
+ * Can be called before `lv_init()`.
+ * @param name      name of the phase. Only the pointer is saved.
+ */
+void lv_profiler_phase(const char * name);
+
+/**
+ * End the current phase and stop collecting.
+ */
+void lv_profiler_stop(void);
+
+/**
+ * Get the number of phases
+ * @return          number of phases started so far
+ */
+uint32_t lv_profiler_get_phase_cnt(void);
+
+/**
+ * Get the data of a phase
+ * @param id        index of the phase, 0 is the first one
+ * @return          pointer to the phase or NULL if there is no such phase
+ */
+const lv_profiler_phase_t * lv_profiler_get_phase(uint32_t id);
+
+/**
+ * Get the number of object classes
+ * @return          number of different classes created so far
+ */
+uint32_t lv_profiler_get_class_cnt(void);
+
+/**
+ * Get the creation statistics of an object class
+ * @param id        index of the class in the order of the first creation
+ * @return          pointer to the class or NULL if there is no such class
+ */
+const lv_profiler_class_t * lv_profiler_get_class(uint32_t id);
+
+/**
+ * Get the name of a built-in object class
+ * @param class_p   pointer to a class
+ * @return          name of the class e.g. "label", or "?" for custom classes
+ */
+const char * lv_profiler_get_class_name(const struct _lv_obj_class_t * class_p);
+
+/**
+ * Get when the first area was flushed to a display
+ * @return          time since the first phase started in microseconds, or -1 if nothing was flushed yet
+ */
+int64_t lv_profiler_get_first_flush_time(void);
+
+/**
+ * Get the time stamp used by the profiler
+ * @return          a monotonic time in microseconds
+ */
+uint64_t lv_profiler_time_us(void);
+
+/**
+ * Print the phases and the object classes as a table
+ * @param print_cb  called with every line of the report
+ */
+void lv_profiler_report(lv_profiler_print_cb_t print_cb);
+
+/*Called via the LV_PROFILER_... macros in the library*/
+void _lv_profiler_begin(lv_profiler_cat_t cat);
+void _lv_profiler_end(lv_profiler_cat_t cat);
+void _lv_profiler_obj_create_begin(void);
+void _lv_profiler_obj_create_end(const struct _lv_obj_class_t * class_p);
+void _lv_profiler_alloc(size_t size);
+void _lv_profiler_free(void);
+void _lv_profiler_flush(void);
+
+extern bool _lv_profiler_running;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN(cat)                  do { if(_lv_profiler_running) _lv_profiler_begin(cat); } while(0)
+#define LV_PROFILER_END(cat)                    do { if(_lv_profiler_running) _lv_profiler_end(cat); } while(0)
+#define LV_PROFILER_OBJ_CREATE_BEGIN()          do { if(_lv_profiler_running) _lv_profiler_obj_create_begin(); } while(0)
+#define LV_PROFILER_OBJ_CREATE_END(class_p)     do { if(_lv_profiler_running) _lv_profiler_obj_create_end(class_p); } while(0)
+#define LV_PROFILER_ALLOC(size)                 do { if(_lv_profiler_running) _lv_profiler_alloc(size); } while(0)
+#define LV_PROFILER_FREE()                      do { if(_lv_profiler_running) _lv_profiler_free(); } while(0)
+#define LV_PROFILER_FLUSH()                     do { if(_lv_profiler_running) _lv_profiler_flush(); } while(0)
+
+#else /*LV_USE_PROFILER*/
+
+#define LV_PROFILER_BEGIN(cat)
+#define LV_PROFILER_END(cat)
+#define LV_PROFILER_OBJ_CREATE_BEGIN()
+#define LV_PROFILER_OBJ_CREATE_END(class_p)
+#define LV_PROFILER_ALLOC(size)
+#define LV_PROFILER_FREE()
+#define LV_PROFILER_FLUSH()
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROFILER_H*/
@@ -19,9 +19,11 @@ extern "C" {
 #include "calendar/lv_calendar_header_dropdown.h"
 #include "carousel/lv_carousel.h"
 #include "chart/lv_chart.h"
+#include "streamchart/lv_streamchart.h"
 #include "keyboard/lv_keyboard.h"
 #include "keyboard/lv_zh_keyboard.h"
 #include "list/lv_list.h"
+#include "vlist/lv_vlist.h"
 #include "menu/lv_menu.h"
 #include "msgbox/lv_msgbox.h"
 #include "meter/lv_meter.h"
@@ -0,0 +1,691 @@
+/**
+ * @file lv_streamchart.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_streamchart.h"
+#if LV_USE_STREAMCHART != 0
+
+#include "../../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_streamchart_class
+
+#define LV_STREAMCHART_HDIV_DEF         3
+#define LV_STREAMCHART_RING_SIZE_MIN    16
+#define LV_STREAMCHART_COL_PERIOD_DEF   100
+
+/*The plot is stored as LV_IMG_CF_TRUE_COLOR_ALPHA*/
+#define PX_SIZE     LV_IMG_PX_SIZE_ALPHA_BYTE
+
+/*Producers may run on other threads. Without GCC/Clang atomics only
+ *pushing from the LVGL thread is safe.*/
+#if defined(__GNUC__) || defined(__clang__)
+#define RING_LOAD_RELAXED(p)        __atomic_load_n((p), __ATOMIC_RELAXED)
+#define RING_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define RING_CAS(p, exp, v)         __atomic_compare_exchange_n((p), (exp), (v), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define RING_INC(p)                 __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#else
+#define RING_LOAD_RELAXED(p)        (*(volatile uint32_t *)(p))
+#define RING_LOAD_ACQUIRE(p)        (*(volatile uint32_t *)(p))
+#define RING_STORE_RELEASE(p, v)    (*(volatile uint32_t *)(p) = (v))
+#define RING_CAS(p, exp, v)         (*(p) == *(exp) ? (*(p) = (v), true) : (*(exp) = *(p), false))
+#define RING_INC(p)                 ((*(p))++)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_streamchart_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_streamchart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_streamchart_event(const lv_obj_class_t * class_p, lv_event_t * e);
+
+static void stream_timer_cb(lv_timer_t * t);
+static bool ring_init(lv_streamchart_ring_t * ring, uint32_t size);
+static void series_drain(lv_streamchart_series_t * ser);
+static void series_free(lv_streamchart_series_t * ser);
+static bool series_cols_realloc(lv_streamchart_t * chart, lv_streamchart_series_t * ser, lv_coord_t col_cnt);
+static void commit_columns(lv_streamchart_t * chart, uint32_t n);
+static void resize_plot(lv_obj_t * obj);
+static void render_plot(lv_obj_t * obj);
+static void render_column(lv_obj_t * obj, lv_coord_t x, lv_coord_t line_w);
+static void draw_div_lines(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_streamchart_class = {
+    .constructor_cb = lv_streamchart_constructor,
+    .destructor_cb = lv_streamchart_destructor,
+    .event_cb = lv_streamchart_event,
+    .width_def = LV_PCT(100),
+    .height_def = LV_DPI_DEF * 2,
+    .instance_size = sizeof(lv_streamchart_t),
+    .base_class = &lv_obj_class
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_streamchart_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+lv_streamchart_series_t * lv_streamchart_add_series(lv_obj_t * obj, lv_color_t color, uint32_t ring_size)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    lv_streamchart_series_t * ser = _lv_ll_ins_tail(&chart->series_ll);
+    LV_ASSERT_MALLOC(ser);
+    if(ser == NULL) return NULL;
+
+    lv_memset_00(ser, sizeof(lv_streamchart_series_t));
+    ser->color = color;
+    ser->acc_min = LV_STREAMCHART_POINT_NONE;
+    ser->acc_max = LV_STREAMCHART_POINT_NONE;
+    ser->last = LV_STREAMCHART_POINT_NONE;
+
+    if(!ring_init(&ser->ring, ring_size) || !series_cols_realloc(chart, ser, chart->col_cnt)) {
+        series_free(ser);
+        _lv_ll_remove(&chart->series_ll, ser);
+        lv_mem_free(ser);
+        return NULL;
+    }
+
+    return ser;
+}
+
+void lv_streamchart_remove_series(lv_obj_t * obj, lv_streamchart_series_t * ser)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(ser);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    series_free(ser);
+    _lv_ll_remove(&chart->series_ll, ser);
+    lv_mem_free(ser);
+
+    chart->plot_valid = 0;
+    render_plot(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_streamchart_hide_series(lv_obj_t * obj, lv_streamchart_series_t * ser, bool hide)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(ser);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    if(ser->hidden == (hide ? 1 : 0)) return;
+
+    ser->hidden = hide ? 1 : 0;
+    chart->plot_valid = 0;
+    render_plot(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_streamchart_set_range(lv_obj_t * obj, lv_coord_t min, lv_coord_t max)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    max = max == min ? max + 1 : max;
+    if(chart->ymin == min && chart->ymax == max) return;
+
+    chart->ymin = min;
+    chart->ymax = max;
+    chart->plot_valid = 0;
+    render_plot(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_streamchart_set_column_period(lv_obj_t * obj, uint32_t period)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    chart->col_period = period == 0 ? 1 : period;
+    chart->col_start = lv_tick_get();
+}
+
+void lv_streamchart_set_div_line_count(lv_obj_t * obj, uint8_t hdiv)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    if(chart->hdiv_cnt == hdiv) return;
+
+    chart->hdiv_cnt = hdiv;
+    lv_obj_invalidate(obj);
+}
+
+void lv_streamchart_clear(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    lv_streamchart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        series_drain(ser);
+        ser->acc_min = LV_STREAMCHART_POINT_NONE;
+        ser->acc_max = LV_STREAMCHART_POINT_NONE;
+        ser->last = LV_STREAMCHART_POINT_NONE;
+        lv_coord_t i;
+        for(i = 0; i < chart->col_cnt; i++) {
+            ser->col_min[i] = LV_STREAMCHART_POINT_NONE;
+            ser->col_max[i] = LV_STREAMCHART_POINT_NONE;
+        }
+    }
+
+    chart->col_start = lv_tick_get();
+    chart->plot_valid = 0;
+    render_plot(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_streamchart_refresh(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+
+    lv_streamchart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        series_drain(ser);
+    }
+
+    uint32_t n = lv_tick_elaps(chart->col_start) / chart->col_period;
+    if(n == 0) return;
+    chart->col_start += n * chart->col_period;
+
+    if(chart->col_cnt <= 0) return;
+    if(n > (uint32_t)chart->col_cnt) n = chart->col_cnt;
+
+    commit_columns(chart, n);
+    chart->col_pending = LV_MIN(chart->col_pending + (lv_coord_t)n, chart->col_cnt);
+    render_plot(obj);
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    /*Move the plot on the display too and redraw only the new columns.
+     *The div lines are horizontal so they look the same after moving, the children wouldn't.*/
+    lv_area_t blit_area = content;
+    if(lv_obj_get_child_cnt(obj) == 0 && _lv_obj_blit_area(obj, &blit_area, -(lv_coord_t)n, 0)) {
+        _lv_obj_layer_cache_mark_dirty(obj, &content);
+        blit_area.x1 = blit_area.x2 - (lv_coord_t)n + 1;
+        lv_obj_invalidate_area(obj, &blit_area);
+    }
+    else {
+        lv_obj_invalidate_area(obj, &content);
+    }
+}
+
+bool lv_streamchart_push(lv_streamchart_series_t * ser, lv_coord_t value)
+{
+    lv_streamchart_ring_t * ring = &ser->ring;
+    uint32_t pos = RING_LOAD_RELAXED(&ring->head);
+
+    while(1) {
+        uint32_t seq = RING_LOAD_ACQUIRE(&ring->seq[pos & ring->mask]);
+        int32_t diff = (int32_t)(seq - pos);
+        if(diff == 0) {
+            /*The slot is free: try to reserve it. On failure `pos` is reloaded by the CAS.*/
+            if(RING_CAS(&ring->head, &pos, pos + 1)) break;
+        }
+        else if(diff < 0) {
+            /*The consumer hasn't released this slot yet: the ring is full*/
+            RING_INC(&ring->dropped);
+            return false;
+        }
+        else {
+            pos = RING_LOAD_RELAXED(&ring->head);
+        }
+    }
+
+    ring->values[pos & ring->mask] = value;
+    RING_STORE_RELEASE(&ring->seq[pos & ring->mask], pos + 1);
+    return true;
+}
+
+uint32_t lv_streamchart_get_dropped(const lv_streamchart_series_t * ser)
+{
+    return RING_LOAD_RELAXED(&ser->ring.dropped);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_streamchart_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+
+    _lv_ll_init(&chart->series_ll, sizeof(lv_streamchart_series_t));
+
+    chart->ymin = 0;
+    chart->ymax = 100;
+    chart->hdiv_cnt = LV_STREAMCHART_HDIV_DEF;
+    chart->col_period = LV_STREAMCHART_COL_PERIOD_DEF;
+    chart->col_start = lv_tick_get();
+    chart->col_cnt = 0;
+    chart->col_head = 0;
+    chart->col_pending = 0;
+    chart->plot_valid = 0;
+    lv_memset_00(&chart->plot, sizeof(chart->plot));
+    chart->plot.header.always_zero = 0;
+    chart->plot.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+
+    chart->timer = lv_timer_create(stream_timer_cb, LV_DISP_DEF_REFR_PERIOD, obj);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_streamchart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+
+    lv_timer_del(chart->timer);
+    chart->timer = NULL;
+
+    lv_streamchart_series_t * ser;
+    while(chart->series_ll.head) {
+        ser = _lv_ll_get_head(&chart->series_ll);
+        series_free(ser);
+        _lv_ll_remove(&chart->series_ll, ser);
+        lv_mem_free(ser);
+    }
+    _lv_ll_clear(&chart->series_ll);
+
+    if(chart->plot.data) {
+        lv_img_cache_invalidate_src(&chart->plot);
+        lv_mem_free((void *)chart->plot.data);
+        chart->plot.data = NULL;
+    }
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_streamchart_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+
+    if(code == LV_EVENT_SIZE_CHANGED) {
+        resize_plot(obj);
+    }
+    else if(code == LV_EVENT_STYLE_CHANGED) {
+        /*Paddings, border or line width might have changed*/
+        resize_plot(obj);
+        chart->plot_valid = 0;
+        render_plot(obj);
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+        draw_div_lines(obj, draw_ctx);
+
+        if(chart->plot.data == NULL) return;
+
+        lv_area_t content;
+        lv_obj_get_content_coords(obj, &content);
+
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+        lv_draw_img(draw_ctx, &img_dsc, &content, &chart->plot);
+    }
+}
+
+static void stream_timer_cb(lv_timer_t * t)
+{
+    lv_streamchart_refresh(t->user_data);
+}
+
+static bool ring_init(lv_streamchart_ring_t * ring, uint32_t size)
+{
+    uint32_t cap = LV_STREAMCHART_RING_SIZE_MIN;
+    while(cap < size && cap < 0x80000000) cap <<= 1;
+
+    ring->values = lv_mem_alloc(sizeof(lv_coord_t) * cap);
+    ring->seq = lv_mem_alloc(sizeof(uint32_t) * cap);
+    LV_ASSERT_MALLOC(ring->values);
+    LV_ASSERT_MALLOC(ring->seq);
+    if(ring->values == NULL || ring->seq == NULL) return false;
+
+    uint32_t i;
+    for(i = 0; i < cap; i++) ring->seq[i] = i;
+
+    ring->mask = cap - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    return true;
+}
+
+/**
+ * Move the published samples of the ring into the column accumulator.
+ * Only the LVGL thread consumes so `tail` needs no atomic access.
+ */
+static void series_drain(lv_streamchart_series_t * ser)
+{
+    lv_streamchart_ring_t * ring = &ser->ring;
+    uint32_t pos = ring->tail;
+
+    while(1) {
+        uint32_t idx = pos & ring->mask;
+        if(RING_LOAD_ACQUIRE(&ring->seq[idx]) != pos + 1) break;
+
+        lv_coord_t v = ring->values[idx];
+        /*Release the slot for the producer one lap later*/
+        RING_STORE_RELEASE(&ring->seq[idx], pos + ring->mask + 1);
+        pos++;
+
+        if(v == LV_STREAMCHART_POINT_NONE) continue;
+        if(ser->acc_min == LV_STREAMCHART_POINT_NONE) {
+            ser->acc_min = v;
+            ser->acc_max = v;
+        }
+        else {
+            if(v < ser->acc_min) ser->acc_min = v;
+            if(v > ser->acc_max) ser->acc_max = v;
+        }
+        ser->last = v;
+    }
+
+    ring->tail = pos;
+}
+
+static void series_free(lv_streamchart_series_t * ser)
+{
+    lv_mem_free(ser->ring.values);
+    lv_mem_free(ser->ring.seq);
+    lv_mem_free(ser->col_min);
+    lv_mem_free(ser->col_max);
+    ser->ring.values = NULL;
+    ser->ring.seq = NULL;
+    ser->col_min = NULL;
+    ser->col_max = NULL;
+}
+
+/**
+ * Resize the column history of a series, keeping the newest columns
+ */
+static bool series_cols_realloc(lv_streamchart_t * chart, lv_streamchart_series_t * ser, lv_coord_t col_cnt)
+{
+    lv_coord_t * new_min = NULL;
+    lv_coord_t * new_max = NULL;
+
+    if(col_cnt > 0) {
+        new_min = lv_mem_alloc(sizeof(lv_coord_t) * col_cnt);
+        new_max = lv_mem_alloc(sizeof(lv_coord_t) * col_cnt);
+        LV_ASSERT_MALLOC(new_min);
+        LV_ASSERT_MALLOC(new_max);
+        if(new_min == NULL || new_max == NULL) {
+            lv_mem_free(new_min);
+            lv_mem_free(new_max);
+            return false;
+        }
+
+        lv_coord_t i;
+        for(i = 0; i < col_cnt; i++) {
+            new_min[i] = LV_STREAMCHART_POINT_NONE;
+            new_max[i] = LV_STREAMCHART_POINT_NONE;
+        }
+
+        /*Copy the newest columns aligned to the right*/
+        if(ser->col_min && chart->col_cnt > 0) {
+            lv_coord_t keep = LV_MIN(col_cnt, chart->col_cnt);
+            for(i = 0; i < keep; i++) {
+                lv_coord_t src = (chart->col_head + chart->col_cnt - keep + i) % chart->col_cnt;
+                new_min[col_cnt - keep + i] = ser->col_min[src];
+                new_max[col_cnt - keep + i] = ser->col_max[src];
+            }
+        }
+    }
+
+    lv_mem_free(ser->col_min);
+    lv_mem_free(ser->col_max);
+    ser->col_min = new_min;
+    ser->col_max = new_max;
+    return true;
+}
+
+/**
+ * Close `n` columns on every series. If the timer ran slower than the column period
+ * the drained samples belong to the newest column, the older ones repeat the last value.
+ */
+static void commit_columns(lv_streamchart_t * chart, uint32_t n)
+{
+    lv_streamchart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        /*Without new samples hold the last value, else continue from the newest column*/
+        lv_coord_t newest = (chart->col_head + chart->col_cnt - 1) % chart->col_cnt;
+        lv_coord_t hold = ser->acc_min == LV_STREAMCHART_POINT_NONE ? ser->last : ser->col_max[newest];
+
+        uint32_t k;
+        for(k = 0; k < n; k++) {
+            lv_coord_t idx = (chart->col_head + k) % chart->col_cnt;
+            if(k == n - 1 && ser->acc_min != LV_STREAMCHART_POINT_NONE) {
+                ser->col_min[idx] = ser->acc_min;
+                ser->col_max[idx] = ser->acc_max;
+            }
+            else {
+                ser->col_min[idx] = hold;
+                ser->col_max[idx] = hold;
+            }
+        }
+        ser->acc_min = LV_STREAMCHART_POINT_NONE;
+        ser->acc_max = LV_STREAMCHART_POINT_NONE;
+    }
+
+    chart->col_head = (chart->col_head + n) % chart->col_cnt;
+}
+
+/**
+ * Follow the content size: reallocate the plot buffer and the column histories
+ */
+static void resize_plot(lv_obj_t * obj)
+{
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    lv_coord_t w = lv_obj_get_content_width(obj);
+    lv_coord_t h = lv_obj_get_content_height(obj);
+    if(w < 0) w = 0;
+    if(h < 0) h = 0;
+
+    if(w == chart->plot.header.w && h == chart->plot.header.h && (chart->plot.data || w * h == 0)) return;
+
+    lv_streamchart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        if(!series_cols_realloc(chart, ser, w)) {
+            /*Not enough memory: keep the series but without history*/
+            lv_mem_free(ser->col_min);
+            lv_mem_free(ser->col_max);
+            ser->col_min = NULL;
+            ser->col_max = NULL;
+            w = 0;
+        }
+    }
+
+    if(chart->plot.data) {
+        lv_img_cache_invalidate_src(&chart->plot);
+        lv_mem_free((void *)chart->plot.data);
+        chart->plot.data = NULL;
+    }
+
+    chart->col_cnt = w;
+    chart->col_head = 0;
+    chart->col_pending = 0;
+    chart->plot_valid = 0;
+    chart->plot.header.w = w;
+    chart->plot.header.h = h;
+    chart->plot.data_size = 0;
+
+    if(w > 0 && h > 0) {
+        uint32_t size = (uint32_t)w * h * PX_SIZE;
+        uint8_t * buf = lv_mem_alloc(size);
+        LV_ASSERT_MALLOC(buf);
+        if(buf) {
+            chart->plot.data = buf;
+            chart->plot.data_size = size;
+        }
+    }
+
+    render_plot(obj);
+}
+
+/**
+ * Bring the plot up to date. If only a few new columns arrived the existing rendering is
+ * scrolled to the left and only the new columns are drawn.
+ */
+static void render_plot(lv_obj_t * obj)
+{
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    uint8_t * buf = (uint8_t *)chart->plot.data;
+    if(buf == NULL || chart->col_cnt <= 0) return;
+
+    lv_coord_t w = chart->plot.header.w;
+    lv_coord_t h = chart->plot.header.h;
+    uint32_t stride = (uint32_t)w * PX_SIZE;
+    lv_coord_t line_w = LV_MAX(lv_obj_get_style_line_width(obj, LV_PART_ITEMS), 1);
+    lv_coord_t x_start;
+
+    if(!chart->plot_valid || chart->col_pending >= w) {
+        lv_memset_00(buf, stride * h);
+        x_start = 0;
+    }
+    else if(chart->col_pending > 0) {
+        uint32_t shift = (uint32_t)chart->col_pending * PX_SIZE;
+        lv_coord_t y;
+        for(y = 0; y < h; y++) {
+            uint8_t * row = buf + y * stride;
+            lv_memcpy(row, row + shift, stride - shift);
+            lv_memset_00(row + stride - shift, shift);
+        }
+        x_start = w - chart->col_pending;
+    }
+    else {
+        return;
+    }
+
+    lv_coord_t x;
+    for(x = x_start; x < w; x++) {
+        render_column(obj, x, line_w);
+    }
+
+    chart->col_pending = 0;
+    chart->plot_valid = 1;
+
+    /*The content of the buffer changed but its address didn't*/
+    lv_img_cache_invalidate_src(&chart->plot);
+}
+
+static lv_coord_t value_to_y(lv_streamchart_t * chart, lv_coord_t v, lv_coord_t h)
+{
+    int32_t y = (int32_t)(v - chart->ymin) * (h - 1) / (chart->ymax - chart->ymin);
+    return (lv_coord_t)(h - 1 - y);
+}
+
+/**
+ * Draw the vertical min-max span of every series into a pixel column of the plot.
+ * The span is extended to touch the previous column to keep the line continuous.
+ */
+static void render_column(lv_obj_t * obj, lv_coord_t x, lv_coord_t line_w)
+{
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    lv_coord_t w = chart->plot.header.w;
+    lv_coord_t h = chart->plot.header.h;
+    uint32_t stride = (uint32_t)w * PX_SIZE;
+    uint8_t * buf = (uint8_t *)chart->plot.data;
+    lv_coord_t idx = (chart->col_head + x) % chart->col_cnt;
+    lv_coord_t idx_prev = (idx + chart->col_cnt - 1) % chart->col_cnt;
+
+    lv_streamchart_series_t * ser;
+    _LV_LL_READ(&chart->series_ll, ser) {
+        if(ser->hidden) continue;
+
+        lv_coord_t vmin = ser->col_min[idx];
+        lv_coord_t vmax = ser->col_max[idx];
+        if(vmin == LV_STREAMCHART_POINT_NONE) continue;
+
+        if(x > 0 && ser->col_min[idx_prev] != LV_STREAMCHART_POINT_NONE) {
+            if(vmin > ser->col_max[idx_prev]) vmin = ser->col_max[idx_prev];
+            if(vmax < ser->col_min[idx_prev]) vmax = ser->col_min[idx_prev];
+        }
+
+        lv_coord_t y1 = value_to_y(chart, vmax, h) - (line_w - 1) / 2;
+        lv_coord_t y2 = value_to_y(chart, vmin, h) + line_w / 2;
+        if(y1 < 0) y1 = 0;
+        if(y2 > h - 1) y2 = h - 1;
+
+        uint8_t * px = buf + y1 * stride + x * PX_SIZE;
+        lv_coord_t y;
+        for(y = y1; y <= y2; y++) {
+            lv_memcpy_small(px, &ser->color, sizeof(lv_color_t));
+            px[PX_SIZE - 1] = LV_OPA_COVER;
+            px += stride;
+        }
+    }
+}
+
+static void draw_div_lines(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
+{
+    lv_streamchart_t * chart = (lv_streamchart_t *)obj;
+    if(chart->hdiv_cnt == 0) return;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(obj, LV_PART_MAIN, &line_dsc);
+    if(line_dsc.width == 0 || line_dsc.opa <= LV_OPA_MIN) return;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_coord_t h = lv_area_get_height(&content);
+
+    lv_point_t p1;
+    lv_point_t p2;
+    p1.x = content.x1;
+    p2.x = content.x2;
+
+    uint16_t i;
+    for(i = 0; i < chart->hdiv_cnt; i++) {
+        p1.y = content.y1 + (int32_t)h * i / (chart->hdiv_cnt - 1 > 0 ? chart->hdiv_cnt - 1 : 1);
+        p2.y = p1.y;
+        lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
+    }
+}
+
+#endif
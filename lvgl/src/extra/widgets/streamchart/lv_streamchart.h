@@ -0,0 +1,181 @@
+/**
+ * @file lv_streamchart.h
+ *
+ */
+
+#ifndef LV_STREAMCHART_H
+#define LV_STREAMCHART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_STREAMCHART != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**Marks a pixel column without any sample. Such columns are not drawn.*/
+#if LV_USE_LARGE_COORD
+#define LV_STREAMCHART_POINT_NONE (INT32_MAX)
+#else
+#define LV_STREAMCHART_POINT_NONE (INT16_MAX)
+#endif
+LV_EXPORT_CONST_INT(LV_STREAMCHART_POINT_NONE);
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Bounded multi-producer / single-consumer ring of samples.
+ * Producers reserve a slot by advancing `head` with a CAS and publish it through the slot's
+ * sequence number, so `lv_streamchart_push()` can be called from any thread without a lock.
+ */
+typedef struct {
+    lv_coord_t * values;
+    uint32_t * seq;
+    uint32_t mask;              /**< Capacity - 1, the capacity is a power of 2*/
+    uint32_t head;              /**< Next slot to reserve (producers)*/
+    uint32_t tail;              /**< Next slot to read (LVGL thread only)*/
+    uint32_t dropped;           /**< Samples rejected because the ring was full*/
+} lv_streamchart_ring_t;
+
+/**
+ * Descriptor of a streaming series
+ */
+typedef struct {
+    lv_streamchart_ring_t ring;
+    lv_coord_t * col_min;       /**< Min. value of every pixel column (circular, `col_cnt` long)*/
+    lv_coord_t * col_max;       /**< Max. value of every pixel column (circular, `col_cnt` long)*/
+    lv_coord_t acc_min;         /**< Min. of the samples of the column being collected*/
+    lv_coord_t acc_max;         /**< Max. of the samples of the column being collected*/
+    lv_coord_t last;            /**< Last drained sample. Used to fill columns without samples*/
+    lv_color_t color;
+    uint8_t hidden : 1;
+} lv_streamchart_series_t;
+
+/*Data of stream chart*/
+typedef struct {
+    lv_obj_t obj;
+    lv_ll_t series_ll;          /**< Linked list of the series (stores lv_streamchart_series_t)*/
+    lv_img_dsc_t plot;          /**< Retained rendering of the series (true color + alpha)*/
+    lv_timer_t * timer;         /**< Drains the rings and scrolls the plot*/
+    uint32_t col_period;        /**< Time covered by one pixel column [ms]*/
+    uint32_t col_start;         /**< Start time of the column being collected*/
+    lv_coord_t ymin;
+    lv_coord_t ymax;
+    lv_coord_t col_cnt;         /**< Number of pixel columns (content width)*/
+    lv_coord_t col_head;        /**< Index of the oldest column in `col_min/max`*/
+    lv_coord_t col_pending;     /**< Columns committed but not rendered yet*/
+    uint16_t hdiv_cnt;          /**< Number of horizontal division lines*/
+    uint8_t plot_valid : 1;     /**< 0: the whole plot has to be re-rendered*/
+} lv_streamchart_t;
+
+extern const lv_obj_class_t lv_streamchart_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a stream chart object
+ * @param parent    pointer to an object, it will be the parent of the new chart
+ * @return          pointer to the created chart
+ */
+lv_obj_t * lv_streamchart_create(lv_obj_t * parent);
+
+/**
+ * Add a series to the chart
+ * @param obj       pointer to a stream chart object
+ * @param color     color of the series
+ * @param ring_size number of samples which can be buffered between two refreshes.
+ *                  Rounded up to a power of 2.
+ * @return          pointer to the new series or NULL on error
+ */
+lv_streamchart_series_t * lv_streamchart_add_series(lv_obj_t * obj, lv_color_t color, uint32_t ring_size);
+
+/**
+ * Remove a series from the chart.
+ * No producer may push into the series while or after it's removed.
+ * @param obj       pointer to a stream chart object
+ * @param ser       pointer to a series of `obj`
+ */
+void lv_streamchart_remove_series(lv_obj_t * obj, lv_streamchart_series_t * ser);
+
+/**
+ * Hide/Unhide a series
+ * @param obj       pointer to a stream chart object
+ * @param ser       pointer to a series of `obj`
+ * @param hide      true: hide the series
+ */
+void lv_streamchart_hide_series(lv_obj_t * obj, lv_streamchart_series_t * ser, bool hide);
+
+/**
+ * Set the minimal and maximal values of the y axis
+ * @param obj       pointer to a stream chart object
+ * @param min       minimum value of the y axis
+ * @param max       maximum value of the y axis
+ */
+void lv_streamchart_set_range(lv_obj_t * obj, lv_coord_t min, lv_coord_t max);
+
+/**
+ * Set how much time one pixel column represents.
+ * All the samples pushed in this period are decimated to their min. and max. value.
+ * @param obj       pointer to a stream chart object
+ * @param period    time of a column in milliseconds
+ */
+void lv_streamchart_set_column_period(lv_obj_t * obj, uint32_t period);
+
+/**
+ * Set the number of horizontal division lines
+ * @param obj       pointer to a stream chart object
+ * @param hdiv      number of horizontal division lines
+ */
+void lv_streamchart_set_div_line_count(lv_obj_t * obj, uint8_t hdiv);
+
+/**
+ * Remove all the collected samples of every series
+ * @param obj       pointer to a stream chart object
+ */
+void lv_streamchart_clear(lv_obj_t * obj);
+
+/**
+ * Drain the sample rings and render the new columns immediately
+ * instead of waiting for the internal timer.
+ * @param obj       pointer to a stream chart object
+ */
+void lv_streamchart_refresh(lv_obj_t * obj);
+
+/**
+ * Append a sample to a series. Lock-free, can be called from any thread.
+ * @param ser       pointer to a series
+ * @param value     the new sample
+ * @return          true: the sample was stored; false: the ring was full and the sample was dropped
+ */
+bool lv_streamchart_push(lv_streamchart_series_t * ser, lv_coord_t value);
+
+/**
+ * Get the number of samples dropped because the ring of the series was full
+ * @param ser       pointer to a series
+ * @return          number of dropped samples
+ */
+uint32_t lv_streamchart_get_dropped(const lv_streamchart_series_t * ser);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_STREAMCHART*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_STREAMCHART_H*/
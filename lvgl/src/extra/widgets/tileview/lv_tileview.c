@@ -145,6 +145,10 @@ static void lv_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_obj_
 
     lv_tileview_tile_t * tile = (lv_tileview_tile_t *)obj;
     tile->dir = create_dir;
+#if LV_LAYER_CACHE_SIZE
+    /*Swiping the pages is then only blending images*/
+    lv_obj_set_layer_cache(obj, true);
+#endif
 
     if(create_col_id == 0 && create_row_id == 0) {
         lv_obj_set_scroll_dir(parent, create_dir);
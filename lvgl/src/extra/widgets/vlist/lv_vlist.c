@@ -0,0 +1,600 @@
+/**
+ * @file lv_vlist.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_vlist.h"
+#if LV_USE_VLIST
+
+#include "../../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_vlist_class
+
+#define LV_VLIST_ROW_H_DEF      (LV_DPI_DEF / 3)
+
+/*The rows are placed with normal object coordinates which are limited to LV_COORD_MAX.
+ *Longer lists are scrolled in a window of this height which is moved (rebased) in the virtual space.*/
+#define LV_VLIST_WINDOW_MAX     (LV_COORD_MAX / 2)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_vlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_vlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_vlist_event(const lv_obj_class_t * class_p, lv_event_t * e);
+
+static void update_rows(lv_obj_t * obj, bool rebind);
+static void release_all_rows(lv_obj_t * obj);
+static int32_t acquire_row(lv_obj_t * obj);
+static bool heights_rebuild(lv_obj_t * obj);
+static void heights_free(lv_obj_t * obj);
+static lv_coord_t get_row_h(lv_obj_t * obj, uint32_t row_id);
+static int32_t get_row_y(lv_obj_t * obj, uint32_t row_id);
+static int32_t get_total_h(lv_obj_t * obj);
+static uint32_t get_row_at(lv_obj_t * obj, int32_t y);
+static void measure_row(lv_obj_t * obj, uint32_t row_id);
+static void draw_scrollbar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_vlist_class = {
+    .constructor_cb = lv_vlist_constructor,
+    .destructor_cb = lv_vlist_destructor,
+    .event_cb = lv_vlist_event,
+    .width_def = LV_PCT(100),
+    .height_def = LV_PCT(100),
+    .instance_size = sizeof(lv_vlist_t),
+    .base_class = &lv_obj_class
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_vlist_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void lv_vlist_set_data_source(lv_obj_t * obj, uint32_t row_cnt, lv_vlist_create_row_cb_t create_cb,
+                              lv_vlist_bind_row_cb_t bind_cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(create_cb);
+    LV_ASSERT_NULL(bind_cb);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    /*The old row objects might have a different structure*/
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) lv_obj_del(vlist->pool[i]);
+    lv_mem_free(vlist->pool);
+    lv_mem_free(vlist->pool_ids);
+    vlist->pool = NULL;
+    vlist->pool_ids = NULL;
+    vlist->pool_cnt = 0;
+
+    vlist->create_cb = create_cb;
+    vlist->bind_cb = bind_cb;
+    lv_vlist_set_row_count(obj, row_cnt);
+}
+
+void lv_vlist_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->row_cnt = row_cnt;
+    if(vlist->height_cb) heights_rebuild(obj);
+
+    update_rows(obj, true);
+}
+
+void lv_vlist_set_row_height(lv_obj_t * obj, lv_coord_t h)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(h < 1) h = 1;
+    if(vlist->row_h_def == h) return;
+
+    vlist->row_h_def = h;
+    if(vlist->height_cb) heights_rebuild(obj);
+
+    update_rows(obj, false);
+}
+
+void lv_vlist_set_row_height_cb(lv_obj_t * obj, lv_vlist_row_height_cb_t height_cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->height_cb = height_cb;
+    if(height_cb) heights_rebuild(obj);
+    else heights_free(obj);
+
+    update_rows(obj, false);
+}
+
+void lv_vlist_refresh_row(lv_obj_t * obj, uint32_t row_id)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(row_id >= vlist->row_cnt) return;
+
+    if(vlist->row_h && vlist->row_h[row_id] != 0) {
+        /*Fall back to the estimated height. It will be measured again when the row is visible.*/
+        int32_t d = vlist->row_h_def - vlist->row_h[row_id];
+        vlist->row_h[row_id] = 0;
+        uint32_t i;
+        for(i = row_id + 1; i <= vlist->row_cnt; i += i & (~i + 1)) vlist->row_y_tree[i] += d;
+    }
+
+    lv_obj_t * row = lv_vlist_get_row_obj(obj, row_id);
+    if(row) vlist->bind_cb(obj, row, row_id);
+
+    update_rows(obj, false);
+}
+
+void lv_vlist_refresh(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    update_rows(obj, true);
+}
+
+void lv_vlist_scroll_to_row(lv_obj_t * obj, uint32_t row_id, lv_anim_enable_t anim_en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_cnt == 0) return;
+    if(row_id >= vlist->row_cnt) row_id = vlist->row_cnt - 1;
+
+    lv_coord_t view_h = lv_obj_get_content_height(obj);
+    int32_t total = get_total_h(obj);
+    int32_t y = get_row_y(obj, row_id);
+    if(y > total - view_h) y = LV_MAX(total - view_h, 0);
+
+    if(y < vlist->base_y || y > vlist->base_y + vlist->win_h - view_h) {
+        /*Out of the current window: jump to a new window without animation*/
+        int32_t base = y - (vlist->win_h - view_h) / 2;
+        vlist->base_y = LV_CLAMP(0, base, LV_MAX(total - vlist->win_h, 0));
+
+        /*Scroll in the new window first and bind the rows only after that*/
+        vlist->updating = 1;
+        lv_obj_scroll_to_y(obj, (lv_coord_t)(y - vlist->base_y), LV_ANIM_OFF);
+        vlist->updating = 0;
+        update_rows(obj, false);
+        return;
+    }
+
+    lv_obj_scroll_to_y(obj, (lv_coord_t)(y - vlist->base_y), anim_en);
+}
+
+lv_obj_t * lv_vlist_get_row_obj(lv_obj_t * obj, uint32_t row_id)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        if(vlist->pool_ids[i] == row_id) return vlist->pool[i];
+    }
+    return NULL;
+}
+
+uint32_t lv_vlist_get_row_id(lv_obj_t * obj, lv_obj_t * row)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        if(vlist->pool[i] == row) return vlist->pool_ids[i];
+    }
+    return LV_VLIST_ROW_NONE;
+}
+
+uint32_t lv_vlist_get_row_count(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    return vlist->row_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_vlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->create_cb = NULL;
+    vlist->bind_cb = NULL;
+    vlist->height_cb = NULL;
+    vlist->pool = NULL;
+    vlist->pool_ids = NULL;
+    vlist->pool_cnt = 0;
+    vlist->row_h = NULL;
+    vlist->row_y_tree = NULL;
+    vlist->row_cnt = 0;
+    vlist->first_row = LV_VLIST_ROW_NONE;
+    vlist->last_row = LV_VLIST_ROW_NONE;
+    vlist->base_y = 0;
+    vlist->win_h = 0;
+    vlist->row_h_def = LV_VLIST_ROW_H_DEF;
+    vlist->updating = 0;
+
+    /*The built-in scrollbar would show the position in the window. Draw one for the whole list instead.*/
+    lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_scroll_dir(obj, LV_DIR_VER);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_vlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    /*The row objects are deleted as normal children*/
+    lv_mem_free(vlist->pool);
+    lv_mem_free(vlist->pool_ids);
+    vlist->pool = NULL;
+    vlist->pool_ids = NULL;
+    vlist->pool_cnt = 0;
+    heights_free(obj);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_vlist_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    if(code == LV_EVENT_SCROLL) {
+        update_rows(obj, false);
+    }
+    else if(code == LV_EVENT_SIZE_CHANGED || code == LV_EVENT_STYLE_CHANGED) {
+        update_rows(obj, false);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t * p = lv_event_get_param(e);
+        p->y = LV_MAX(p->y, vlist->win_h);
+    }
+    else if(code == LV_EVENT_DRAW_POST) {
+        draw_scrollbar(obj, lv_event_get_draw_ctx(e));
+    }
+}
+
+/**
+ * Bind row objects to the visible rows and recycle the others.
+ * Also moves the scroll window if the list is taller than `LV_VLIST_WINDOW_MAX`.
+ * @param obj       pointer to a virtual list
+ * @param rebind    true: bind the already visible rows again too
+ */
+static void update_rows(lv_obj_t * obj, bool rebind)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->updating || vlist->create_cb == NULL) return;
+    vlist->updating = 1;
+
+    lv_coord_t view_h = lv_obj_get_content_height(obj);
+    int32_t total = get_total_h(obj);
+    lv_coord_t win_h = (lv_coord_t)LV_MIN(total, LV_VLIST_WINDOW_MAX);
+
+    if(win_h != vlist->win_h) {
+        vlist->win_h = win_h;
+        lv_obj_refresh_self_size(obj);
+    }
+
+    if(view_h <= 0 || vlist->row_cnt == 0) {
+        vlist->base_y = 0;
+        release_all_rows(obj);
+        vlist->updating = 0;
+        return;
+    }
+
+    /*Move the window if the scroll position gets close to its edges.
+     *Not while a scroll animation runs as it works with absolute positions.*/
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(obj);
+    int32_t vtop = vlist->base_y + scroll_y;
+    int32_t base_max = LV_MAX(total - win_h, 0);
+    int32_t base = vlist->base_y;
+    if(base > base_max) base = base_max;
+    if(total > win_h && lv_anim_get(obj, NULL) == NULL) {
+        if((scroll_y < view_h && base > 0) || (scroll_y > win_h - 2 * view_h && base < base_max)) {
+            base = LV_CLAMP(0, vtop - (win_h - view_h) / 2, base_max);
+        }
+    }
+    if(base != vlist->base_y) {
+        vlist->base_y = base;
+        lv_obj_scroll_to_y(obj, (lv_coord_t)(vtop - base), LV_ANIM_OFF);
+        vtop = vlist->base_y + lv_obj_get_scroll_y(obj);
+    }
+
+    /*Find the visible range. Measuring a row can move the rows below it so go row by row.*/
+    uint32_t first = get_row_at(obj, LV_MAX(vtop, 0));
+    uint32_t last = first;
+    int32_t y = get_row_y(obj, first);
+    while(last < vlist->row_cnt) {
+        measure_row(obj, last);
+        y += get_row_h(obj, last);
+        if(y >= vtop + view_h) break;
+        last++;
+    }
+    if(last >= vlist->row_cnt) last = vlist->row_cnt - 1;
+
+    /*Recycle the rows which are not visible anymore*/
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        uint32_t id = vlist->pool_ids[i];
+        if(id == LV_VLIST_ROW_NONE) continue;
+        if(id < first || id > last) {
+            vlist->pool_ids[i] = LV_VLIST_ROW_NONE;
+            lv_obj_add_flag(vlist->pool[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        else if(rebind) {
+            vlist->bind_cb(obj, vlist->pool[i], id);
+        }
+    }
+
+    /*Bind the newly visible rows*/
+    uint32_t id;
+    for(id = first; id <= last; id++) {
+        if(lv_vlist_get_row_obj(obj, id)) continue;
+        int32_t slot = acquire_row(obj);
+        if(slot < 0) break;
+        lv_obj_t * row = vlist->pool[slot];
+        vlist->pool_ids[slot] = id;
+        vlist->bind_cb(obj, row, id);
+        lv_obj_clear_flag(row, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    vlist->first_row = first;
+    vlist->last_row = last;
+
+    /*Place the bound rows in the window*/
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        id = vlist->pool_ids[i];
+        if(id == LV_VLIST_ROW_NONE) continue;
+        lv_obj_t * row = vlist->pool[i];
+        lv_coord_t row_y = (lv_coord_t)(get_row_y(obj, id) - vlist->base_y);
+        lv_coord_t row_h = get_row_h(obj, id);
+        if(lv_obj_get_style_y(row, LV_PART_MAIN) != row_y) lv_obj_set_y(row, row_y);
+        if(lv_obj_get_style_height(row, LV_PART_MAIN) != row_h) lv_obj_set_height(row, row_h);
+    }
+
+    vlist->updating = 0;
+}
+
+static void release_all_rows(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        if(vlist->pool_ids[i] == LV_VLIST_ROW_NONE) continue;
+        vlist->pool_ids[i] = LV_VLIST_ROW_NONE;
+        lv_obj_add_flag(vlist->pool[i], LV_OBJ_FLAG_HIDDEN);
+    }
+    vlist->first_row = LV_VLIST_ROW_NONE;
+    vlist->last_row = LV_VLIST_ROW_NONE;
+}
+
+/**
+ * Get a free row object from the pool or create a new one
+ * @return      index of the row object in the pool or -1 on error
+ */
+static int32_t acquire_row(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint16_t i;
+    for(i = 0; i < vlist->pool_cnt; i++) {
+        if(vlist->pool_ids[i] == LV_VLIST_ROW_NONE) return i;
+    }
+
+    lv_obj_t ** pool = lv_mem_realloc(vlist->pool, sizeof(lv_obj_t *) * (vlist->pool_cnt + 1));
+    LV_ASSERT_MALLOC(pool);
+    if(pool == NULL) return -1;
+    vlist->pool = pool;
+
+    uint32_t * ids = lv_mem_realloc(vlist->pool_ids, sizeof(uint32_t) * (vlist->pool_cnt + 1));
+    LV_ASSERT_MALLOC(ids);
+    if(ids == NULL) return -1;
+    vlist->pool_ids = ids;
+
+    lv_obj_t * row = vlist->create_cb(obj);
+    LV_ASSERT_NULL(row);
+    if(row == NULL) return -1;
+
+    lv_obj_set_width(row, LV_PCT(100));
+    lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+
+    vlist->pool[vlist->pool_cnt] = row;
+    vlist->pool_ids[vlist->pool_cnt] = LV_VLIST_ROW_NONE;
+    vlist->pool_cnt++;
+
+    return vlist->pool_cnt - 1;
+}
+
+/**
+ * (Re)build the height cache with the default height for every row
+ */
+static bool heights_rebuild(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    heights_free(obj);
+    if(vlist->row_cnt == 0) return true;
+
+    vlist->row_h = lv_mem_alloc(sizeof(lv_coord_t) * vlist->row_cnt);
+    vlist->row_y_tree = lv_mem_alloc(sizeof(int32_t) * (vlist->row_cnt + 1));
+    LV_ASSERT_MALLOC(vlist->row_h);
+    LV_ASSERT_MALLOC(vlist->row_y_tree);
+    if(vlist->row_h == NULL || vlist->row_y_tree == NULL) {
+        heights_free(obj);
+        return false;
+    }
+
+    lv_memset_00(vlist->row_h, sizeof(lv_coord_t) * vlist->row_cnt);
+
+    /*Build the Fenwick tree in O(n)*/
+    uint32_t n = vlist->row_cnt;
+    uint32_t i;
+    vlist->row_y_tree[0] = 0;
+    for(i = 1; i <= n; i++) vlist->row_y_tree[i] = vlist->row_h_def;
+    for(i = 1; i <= n; i++) {
+        uint32_t parent = i + (i & (~i + 1));
+        if(parent <= n) vlist->row_y_tree[parent] += vlist->row_y_tree[i];
+    }
+
+    return true;
+}
+
+static void heights_free(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    lv_mem_free(vlist->row_h);
+    lv_mem_free(vlist->row_y_tree);
+    vlist->row_h = NULL;
+    vlist->row_y_tree = NULL;
+}
+
+static lv_coord_t get_row_h(lv_obj_t * obj, uint32_t row_id)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_h == NULL || vlist->row_h[row_id] == 0) return vlist->row_h_def;
+    return vlist->row_h[row_id];
+}
+
+/**
+ * Get the virtual y coordinate of the top of a row
+ */
+static int32_t get_row_y(lv_obj_t * obj, uint32_t row_id)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_y_tree == NULL) return (int32_t)row_id * vlist->row_h_def;
+
+    int32_t y = 0;
+    uint32_t i;
+    for(i = row_id; i > 0; i -= i & (~i + 1)) y += vlist->row_y_tree[i];
+    return y;
+}
+
+static int32_t get_total_h(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    return get_row_y(obj, vlist->row_cnt);
+}
+
+/**
+ * Get the row which contains a virtual y coordinate
+ */
+static uint32_t get_row_at(lv_obj_t * obj, int32_t y)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_cnt == 0) return 0;
+
+    uint32_t id;
+    if(vlist->row_y_tree == NULL) {
+        id = y / vlist->row_h_def;
+    }
+    else {
+        /*Descend the Fenwick tree: find the last row starting at or above `y`*/
+        uint32_t step = 1;
+        while((step << 1) <= vlist->row_cnt) step <<= 1;
+        id = 0;
+        for(; step > 0; step >>= 1) {
+            if(id + step <= vlist->row_cnt && vlist->row_y_tree[id + step] <= y) {
+                id += step;
+                y -= vlist->row_y_tree[id];
+            }
+        }
+    }
+
+    return LV_MIN(id, vlist->row_cnt - 1);
+}
+
+static void measure_row(lv_obj_t * obj, uint32_t row_id)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_h == NULL || vlist->row_h[row_id] != 0) return;
+
+    lv_coord_t h = vlist->height_cb(obj, row_id);
+    if(h < 1) h = 1;
+    vlist->row_h[row_id] = h;
+
+    int32_t d = h - vlist->row_h_def;
+    if(d == 0) return;
+    uint32_t i;
+    for(i = row_id + 1; i <= vlist->row_cnt; i += i & (~i + 1)) vlist->row_y_tree[i] += d;
+}
+
+static void draw_scrollbar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    lv_coord_t view_h = lv_obj_get_content_height(obj);
+    int32_t total = get_total_h(obj);
+    if(total <= view_h) return;
+
+    lv_coord_t thickness = lv_obj_get_style_width(obj, LV_PART_SCROLLBAR);
+    if(thickness <= 0) return;
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_SCROLLBAR, &rect_dsc);
+    if(rect_dsc.bg_opa <= LV_OPA_MIN && rect_dsc.border_opa <= LV_OPA_MIN) return;
+
+    lv_coord_t top = lv_obj_get_style_pad_top(obj, LV_PART_SCROLLBAR);
+    lv_coord_t bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_SCROLLBAR);
+    lv_coord_t right = lv_obj_get_style_pad_right(obj, LV_PART_SCROLLBAR);
+    lv_coord_t track = lv_obj_get_height(obj) - top - bottom;
+    lv_coord_t bar_h = (lv_coord_t)LV_MAX((int64_t)track * view_h / total, LV_DPX(10));
+    if(bar_h > track) bar_h = track;
+
+    int32_t vtop = LV_CLAMP(0, vlist->base_y + lv_obj_get_scroll_y(obj), total - view_h);
+    lv_coord_t pos = (lv_coord_t)((int64_t)(track - bar_h) * vtop / (total - view_h));
+
+    lv_area_t area;
+    area.x2 = obj->coords.x2 - right;
+    area.x1 = area.x2 - thickness + 1;
+    area.y1 = obj->coords.y1 + top + pos;
+    area.y2 = area.y1 + bar_h - 1;
+    lv_draw_rect(draw_ctx, &rect_dsc, &area);
+}
+
+#endif
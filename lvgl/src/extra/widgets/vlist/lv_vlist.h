@@ -0,0 +1,173 @@
+/**
+ * @file lv_vlist.h
+ *
+ */
+
+#ifndef LV_VLIST_H
+#define LV_VLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_VLIST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_VLIST_ROW_NONE 0xFFFFFFFF
+LV_EXPORT_CONST_INT(LV_VLIST_ROW_NONE);
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Create an empty row object. It will be reused for many rows.
+ * @param vlist     the virtual list, the parent of the new row
+ * @return          the new row object (a child of `vlist`)
+ */
+typedef lv_obj_t * (*lv_vlist_create_row_cb_t)(lv_obj_t * vlist);
+
+/**
+ * Fill a (recycled) row object with the data of a row
+ * @param vlist     the virtual list
+ * @param row       a row object created by `lv_vlist_create_row_cb_t`
+ * @param row_id    index of the row in the data source
+ */
+typedef void (*lv_vlist_bind_row_cb_t)(lv_obj_t * vlist, lv_obj_t * row, uint32_t row_id);
+
+/**
+ * Tell the height of a row. Called once per row, the result is cached
+ * until `lv_vlist_refresh_row()` or `lv_vlist_set_row_count()`.
+ * @param vlist     the virtual list
+ * @param row_id    index of the row in the data source
+ * @return          height of the row in pixels
+ */
+typedef lv_coord_t (*lv_vlist_row_height_cb_t)(lv_obj_t * vlist, uint32_t row_id);
+
+/*Data of virtual list*/
+typedef struct {
+    lv_obj_t obj;
+    lv_vlist_create_row_cb_t create_cb;
+    lv_vlist_bind_row_cb_t bind_cb;
+    lv_vlist_row_height_cb_t height_cb;
+    lv_obj_t ** pool;           /**< Row objects. Only the visible ones are bound to a row*/
+    uint32_t * pool_ids;        /**< Row id bound to the pooled objects or `LV_VLIST_ROW_NONE`*/
+    lv_coord_t * row_h;         /**< Cached row heights, 0: not measured yet (only with `height_cb`)*/
+    int32_t * row_y_tree;       /**< Fenwick tree of the row heights (only with `height_cb`)*/
+    uint32_t row_cnt;
+    uint32_t first_row;         /**< First bound row*/
+    uint32_t last_row;          /**< Last bound row*/
+    int32_t base_y;             /**< Virtual y coordinate of the top of the scrollable window*/
+    lv_coord_t win_h;           /**< Height of the scrollable window reported as self size*/
+    uint16_t pool_cnt;
+    lv_coord_t row_h_def;       /**< Height of the rows or estimation for not measured rows*/
+    uint8_t updating : 1;       /**< Guard against recursive updates on scroll events*/
+} lv_vlist_t;
+
+extern const lv_obj_class_t lv_vlist_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a virtual list object
+ * @param parent    pointer to an object, it will be the parent of the new virtual list
+ * @return          pointer to the created virtual list
+ */
+lv_obj_t * lv_vlist_create(lv_obj_t * parent);
+
+/**
+ * Set the data source of the list. Only the visible rows will exist as objects.
+ * @param obj       pointer to a virtual list object
+ * @param row_cnt   number of rows
+ * @param create_cb creates an empty row object
+ * @param bind_cb   fills a row object with the data of a row
+ */
+void lv_vlist_set_data_source(lv_obj_t * obj, uint32_t row_cnt, lv_vlist_create_row_cb_t create_cb,
+                              lv_vlist_bind_row_cb_t bind_cb);
+
+/**
+ * Change the number of rows. The visible rows are bound again.
+ * @param obj       pointer to a virtual list object
+ * @param row_cnt   new number of rows
+ */
+void lv_vlist_set_row_count(lv_obj_t * obj, uint32_t row_cnt);
+
+/**
+ * Set the height of the rows. With `height_cb` it's used as an estimation for rows not seen yet.
+ * @param obj       pointer to a virtual list object
+ * @param h         height of a row in pixels
+ */
+void lv_vlist_set_row_height(lv_obj_t * obj, lv_coord_t h);
+
+/**
+ * Use rows with different heights. The heights are queried lazily and cached.
+ * @param obj       pointer to a virtual list object
+ * @param height_cb the height getter or NULL to use `lv_vlist_set_row_height()` for all rows
+ */
+void lv_vlist_set_row_height_cb(lv_obj_t * obj, lv_vlist_row_height_cb_t height_cb);
+
+/**
+ * Notify the list that the data of a row has changed.
+ * The row is bound again if visible and its cached height is dropped.
+ * @param obj       pointer to a virtual list object
+ * @param row_id    index of the changed row
+ */
+void lv_vlist_refresh_row(lv_obj_t * obj, uint32_t row_id);
+
+/**
+ * Bind all the visible rows again
+ * @param obj       pointer to a virtual list object
+ */
+void lv_vlist_refresh(lv_obj_t * obj);
+
+/**
+ * Scroll to make a row the top one
+ * @param obj       pointer to a virtual list object
+ * @param row_id    index of the row
+ * @param anim_en   LV_ANIM_ON: scroll with animation (only inside the current scroll window)
+ */
+void lv_vlist_scroll_to_row(lv_obj_t * obj, uint32_t row_id, lv_anim_enable_t anim_en);
+
+/**
+ * Get the row object of a row if it's visible
+ * @param obj       pointer to a virtual list object
+ * @param row_id    index of the row
+ * @return          the row object or NULL if the row is not visible
+ */
+lv_obj_t * lv_vlist_get_row_obj(lv_obj_t * obj, uint32_t row_id);
+
+/**
+ * Get the row index a row object is currently bound to. Useful in the event handlers of the rows.
+ * @param obj       pointer to a virtual list object
+ * @param row       a row object of the list
+ * @return          the row index or `LV_VLIST_ROW_NONE`
+ */
+uint32_t lv_vlist_get_row_id(lv_obj_t * obj, lv_obj_t * row);
+
+/**
+ * Get the number of rows
+ * @param obj       pointer to a virtual list object
+ * @return          number of rows
+ */
+uint32_t lv_vlist_get_row_count(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_VLIST*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VLIST_H*/
@@ -17,6 +17,7 @@
 #include "../core/lv_obj.h"
 #include "../core/lv_refr.h"
 #include "../core/lv_theme.h"
+#include "../extra/others/latency/lv_latency.h"
 #include "../draw/sdl/lv_draw_sdl.h"
 #include "../draw/sw/lv_draw_sw.h"
 #include "../draw/sdl/lv_draw_sdl.h"
@@ -277,6 +278,7 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
     lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
     lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
     disp->inv_p = 0;
+    disp->scroll_pending = 0;
     if(disp->act_scr != NULL) lv_obj_invalidate(disp->act_scr);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -518,6 +520,7 @@ lv_coord_t lv_disp_get_dpi(const lv_disp_t * disp)
  */
 void LV_ATTRIBUTE_FLUSH_READY lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
+    LV_LATENCY_FLUSH_READY(disp_drv);
     disp_drv->draw_buf->flushing = 0;
     disp_drv->draw_buf->flushing_last = 0;
 }
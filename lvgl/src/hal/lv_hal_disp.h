@@ -137,6 +137,11 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: called when start rendering */
     void (*render_start_cb)(struct _lv_disp_drv_t * disp_drv);
 
+    /** OPTIONAL: Move already flushed pixels on the display (e.g. in the frame buffer).
+     * `area` is the destination and the pixels come from `area` moved by (-dx, -dy). They can overlap.
+     * Used to scroll without redrawing the whole scrolled object. Return `false` if the pixels weren't moved.*/
+    bool (*copy_area_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -177,6 +182,7 @@ typedef struct _lv_disp_t {
     uint8_t draw_prev_over_act : 1; /**< 1: Draw previous screen over active screen*/
     uint8_t del_prev : 1;           /**< 1: Automatically delete the previous screen when the screen load anim. is ready*/
     uint8_t rendering_in_progress : 1; /**< 1: The current screen rendering is in progress*/
+    uint8_t scroll_pending : 1;     /**< 1: `scroll_area` has to be moved with `copy_area_cb` before the next refresh*/
 
     lv_opa_t bg_opa;                /**<Opacity of the background color or wallpaper*/
     lv_color_t bg_color;            /**< Default display color when screens are transparent*/
@@ -188,11 +194,17 @@ typedef struct _lv_disp_t {
     uint16_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Area whose flushed pixels are moved by (scroll_dx, scroll_dy) before the next refresh*/
+    lv_area_t scroll_area;
+    lv_coord_t scroll_dx;
+    lv_coord_t scroll_dy;
+
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
+    uint32_t last_refr_time;            /**< Duration of the last refresh in ms*/
 } lv_disp_t;
 
 /**********************
@@ -82,6 +82,8 @@ typedef struct {
 
     lv_indev_state_t state; /**< LV_INDEV_STATE_REL or LV_INDEV_STATE_PR*/
     bool continue_reading;  /**< If set to true, the read callback is invoked again*/
+    uint64_t timestamp_us;  /**< When the input happened in microseconds, on the same monotonic clock every time
+                                 (`CLOCK_MONOTONIC` on Linux). 0: unknown, it's considered to happen when it's read*/
 } lv_indev_data_t;
 
 /** Initialized by the user and registered by 'lv_indev_add()'*/
@@ -126,6 +128,16 @@ typedef struct _lv_indev_drv_t {
     uint16_t long_press_repeat_time;
 } lv_indev_drv_t;
 
+#if LV_INDEV_SCROLL_PREDICT
+/** A time stamped point of a pointer to estimate its velocity*/
+typedef struct {
+    lv_point_t point;
+    uint32_t time_us;   /**< The lower bits of `timestamp_us` or the tick*/
+} _lv_indev_sample_t;
+
+#define _LV_INDEV_SAMPLE_CNT    8
+#endif
+
 /** Run time data of input devices
  * Internally used by the library, you should not need to touch it.
  */
@@ -155,6 +167,16 @@ typedef struct _lv_indev_proc_t {
             lv_area_t scroll_area;
 
             lv_point_t gesture_sum; /*Count the gesture pixels to check LV_INDEV_DEF_GESTURE_LIMIT*/
+#if LV_INDEV_SCROLL_PREDICT
+            _lv_indev_sample_t samples[_LV_INDEV_SAMPLE_CNT]; /*The last samples of the press, the oldest first*/
+            uint32_t sample_tick;           /*When the last sample was read*/
+            lv_point_t velocity;            /*Least-squares fit of the samples [px/s]*/
+            lv_point_t predict_ofs;         /*Extrapolation of the finger added to the scrolling*/
+            struct _lv_obj_t * throw_obj;   /*The object scrolled by a momentum animation*/
+            uint8_t sample_cnt;
+            uint8_t sample_stamped : 1;     /*The samples have the time stamps of the driver*/
+            uint8_t sample_end : 1;         /*The press of the samples is released*/
+#endif
             /*Flags*/
             lv_dir_t scroll_dir : 4;
             lv_dir_t gesture_dir : 4;
@@ -229,6 +229,17 @@
     #endif
 #endif
 
+/*1: Estimate the velocity of the scrolling by a least-squares fit of the time stamped input samples,
+ *scroll to where the finger will be when the frame is shown, and advance the momentum, snap and other
+ *animations when a frame is rendered instead of on their own timer*/
+#ifndef LV_INDEV_SCROLL_PREDICT
+    #ifdef CONFIG_LV_INDEV_SCROLL_PREDICT
+        #define LV_INDEV_SCROLL_PREDICT CONFIG_LV_INDEV_SCROLL_PREDICT
+    #else
+        #define LV_INDEV_SCROLL_PREDICT 0
+    #endif
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #ifndef LV_TICK_CUSTOM
@@ -302,6 +313,27 @@
         #endif
     #endif
 
+    /*Byte budget of the shadow cache. The blurred corners are keyed by their size, radius and the spread area,
+     *so objects with the same shadow share them. The least recently used corners are freed first.*/
+    #ifndef LV_SHADOW_CACHE_MEM_SIZE
+        #ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+            #define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+        #else
+            #define LV_SHADOW_CACHE_MEM_SIZE (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+        #endif
+    #endif
+
+    /*Byte budget of the anti-aliased coverage of rounded corners per radius.
+     *Rounded rectangles with a single color and no other masks are drawn from them.
+     *A radius costs about 12 bytes per pixel of radius. 0: calculate them on every draw*/
+    #ifndef LV_CORNER_CACHE_MEM_SIZE
+        #ifdef CONFIG_LV_CORNER_CACHE_MEM_SIZE
+            #define LV_CORNER_CACHE_MEM_SIZE CONFIG_LV_CORNER_CACHE_MEM_SIZE
+        #else
+            #define LV_CORNER_CACHE_MEM_SIZE 0
+        #endif
+    #endif
+
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
     * radius * 4 bytes are used per circle (the most often used radiuses are saved)
@@ -343,6 +375,17 @@
     #endif
 #endif
 
+/*Memory budget [bytes] of the retained renderings of the objects with `lv_obj_set_layer_cache()`.
+ *The pages of the tileviews are cached if it's not 0.
+ *0: to disable layer caching*/
+#ifndef LV_LAYER_CACHE_SIZE
+    #ifdef CONFIG_LV_LAYER_CACHE_SIZE
+        #define LV_LAYER_CACHE_SIZE CONFIG_LV_LAYER_CACHE_SIZE
+    #else
+        #define LV_LAYER_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -403,7 +446,9 @@
 #endif
 
 /*Maximum buffer size to allocate for rotation.
- *Only used if software rotation is enabled in the display driver.*/
+ *Only used if software rotation is enabled in the display driver.
+ *If the whole draw buffer fits, it's rotated and flushed at once (required for `full_refresh`),
+ *else it's rotated and flushed in chunks.*/
 #ifndef LV_DISP_ROT_MAX_BUF
     #ifdef CONFIG_LV_DISP_ROT_MAX_BUF
         #define LV_DISP_ROT_MAX_BUF CONFIG_LV_DISP_ROT_MAX_BUF
@@ -539,6 +584,22 @@
             #define LV_GPU_SDL_LRU_SIZE (1024 * 1024 * 8)
         #endif
     #endif
+    /*Width and height of the textures glyphs are packed into, 0 to use a texture per glyph*/
+    #ifndef LV_GPU_SDL_ATLAS_SIZE
+        #ifdef CONFIG_LV_GPU_SDL_ATLAS_SIZE
+            #define LV_GPU_SDL_ATLAS_SIZE CONFIG_LV_GPU_SDL_ATLAS_SIZE
+        #else
+            #define LV_GPU_SDL_ATLAS_SIZE 512
+        #endif
+    #endif
+    /*Maximal number of atlas textures of a pixel format. If they are full the least recently used one is cleared.*/
+    #ifndef LV_GPU_SDL_ATLAS_MAX_CNT
+        #ifdef CONFIG_LV_GPU_SDL_ATLAS_MAX_CNT
+            #define LV_GPU_SDL_ATLAS_MAX_CNT CONFIG_LV_GPU_SDL_ATLAS_MAX_CNT
+        #else
+            #define LV_GPU_SDL_ATLAS_MAX_CNT 4
+        #endif
+    #endif
     /*Custom blend mode for mask drawing, disable if you need to link with older SDL2 lib*/
     #ifndef LV_GPU_SDL_CUSTOM_BLEND_MODE
         #ifdef CONFIG_LV_GPU_SDL_CUSTOM_BLEND_MODE
@@ -1733,6 +1794,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_STREAMCHART
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_STREAMCHART
+            #define LV_USE_STREAMCHART CONFIG_LV_USE_STREAMCHART
+        #else
+            #define LV_USE_STREAMCHART 0
+        #endif
+    #else
+        #define LV_USE_STREAMCHART 1
+    #endif
+#endif
+
 #ifndef LV_USE_COLORWHEEL
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_COLORWHEEL
@@ -1814,6 +1887,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_VLIST
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_VLIST
+            #define LV_USE_VLIST CONFIG_LV_USE_VLIST
+        #else
+            #define LV_USE_VLIST 0
+        #endif
+    #else
+        #define LV_USE_VLIST      1
+    #endif
+#endif
+
 #ifndef LV_USE_MENU
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_MENU
@@ -2355,6 +2440,15 @@
     #endif
 #endif
 
+/*Memory mapped pack of images and fonts in the native format. Requires a POSIX system to map files.*/
+#ifndef LV_USE_ASSETPACK
+    #ifdef CONFIG_LV_USE_ASSETPACK
+        #define LV_USE_ASSETPACK CONFIG_LV_USE_ASSETPACK
+    #else
+        #define LV_USE_ASSETPACK 0
+    #endif
+#endif
+
 /*-----------
  * Others
  *----------*/
@@ -2469,6 +2563,73 @@
     #endif // LV_IME_PINYIN_USE_K9_MODE
 #endif
 
+/*1: Enable the startup profiler. Measures named phases, the object creation per class,
+ *the style setting, the rendering and the allocations*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of phases to store. The later phases are counted for the last one.*/
+    #ifndef LV_PROFILER_MAX_PHASES
+        #ifdef CONFIG_LV_PROFILER_MAX_PHASES
+            #define LV_PROFILER_MAX_PHASES CONFIG_LV_PROFILER_MAX_PHASES
+        #else
+            #define LV_PROFILER_MAX_PHASES 16
+        #endif
+    #endif
+
+    /*Number of object classes to store. The rest is counted together.*/
+    #ifndef LV_PROFILER_MAX_CLASSES
+        #ifdef CONFIG_LV_PROFILER_MAX_CLASSES
+            #define LV_PROFILER_MAX_CLASSES CONFIG_LV_PROFILER_MAX_CLASSES
+        #else
+            #define LV_PROFILER_MAX_CLASSES 32
+        #endif
+    #endif
+#endif
+
+/*1: Enable the touch-to-photon latency measurement. Follows every input until the frame with its
+ *first visible response is flushed and collects the latencies per screen*/
+#ifndef LV_USE_LATENCY
+    #ifdef CONFIG_LV_USE_LATENCY
+        #define LV_USE_LATENCY CONFIG_LV_USE_LATENCY
+    #else
+        #define LV_USE_LATENCY 0
+    #endif
+#endif
+#if LV_USE_LATENCY
+    /*Number of screens to store. The rest is counted together.*/
+    #ifndef LV_LATENCY_MAX_SCREENS
+        #ifdef CONFIG_LV_LATENCY_MAX_SCREENS
+            #define LV_LATENCY_MAX_SCREENS CONFIG_LV_LATENCY_MAX_SCREENS
+        #else
+            #define LV_LATENCY_MAX_SCREENS 8
+        #endif
+    #endif
+
+    /*Number of the last samples per screen to calculate the percentiles from*/
+    #ifndef LV_LATENCY_MAX_SAMPLES
+        #ifdef CONFIG_LV_LATENCY_MAX_SAMPLES
+            #define LV_LATENCY_MAX_SAMPLES CONFIG_LV_LATENCY_MAX_SAMPLES
+        #else
+            #define LV_LATENCY_MAX_SAMPLES 512
+        #endif
+    #endif
+#endif
+
+/*1: Enable the bindings of widgets to the application's model. The changes are written once per frame.*/
+#ifndef LV_USE_BINDING
+    #ifdef CONFIG_LV_USE_BINDING
+        #define LV_USE_BINDING CONFIG_LV_USE_BINDING
+    #else
+        #define LV_USE_BINDING 0
+    #endif
+#endif
+
 /*==================
 * EXAMPLES
 *==================*/
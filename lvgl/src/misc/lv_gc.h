@@ -21,6 +21,7 @@ extern "C" {
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "../draw/sw/lv_draw_sw_cache.h"
 #include "../core/lv_obj_pos.h"
 
 /*********************
@@ -49,6 +50,7 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
+    LV_DISPATCH(f, lv_ll_t, _lv_layer_cache_ll)                                                        \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
@@ -59,7 +61,9 @@ extern "C" {
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
-    LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
+    LV_DISPATCH(f, _lv_draw_sw_cache_t, _lv_grad_cache)                                                \
+    LV_DISPATCH_COND(f, _lv_draw_sw_cache_t, _lv_shadow_cache, LV_DRAW_COMPLEX, 1)                     \
+    LV_DISPATCH_COND(f, _lv_draw_sw_cache_t, _lv_corner_cache, LV_DRAW_COMPLEX, 1)                     \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "../extra/others/profiler/lv_profiler.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -158,6 +159,7 @@ void * lv_mem_alloc(size_t size)
         max_used = LV_MAX(cur_used, max_used);
 #endif
         MEM_TRACE("allocated at %p", alloc);
+        LV_PROFILER_ALLOC(size);
     }
     return alloc;
 }
@@ -172,6 +174,8 @@ void lv_mem_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+    LV_PROFILER_FREE();
+
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
@@ -213,6 +217,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     }
 
     MEM_TRACE("allocated at %p", new_p);
+    LV_PROFILER_ALLOC(new_size);
     return new_p;
 }
 
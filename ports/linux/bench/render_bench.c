@@ -0,0 +1,457 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2023 NXP
+ */
+
+/**
+ * Benchmark of the rendering of the generated UI.
+ * Builds the UI against an in-memory display and plays scripted scenarios: swipes of the tileviews
+ * with a virtual touch pad, the container switches of events_init.c, the slide of screen_win_1
+ * and label updates. The time is simulated so every run renders the same frames.
+ * The tour of the scenarios is made `pass count` times, the first pass warms up the lazily built
+ * parts and the caches and isn't measured.
+ * Prints a JSON object per line: a header, then the distribution of the frame and render times,
+ * the drawn pixels, the allocations and a checksum of the last frame for every scenario.
+ * With `--frames` every frame is printed too.
+ * Usage: render_bench [pass count] [--frames]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for clock_gettime() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+#include "gui_guider.h"
+#include "events_init.h"
+
+#if LV_USE_PROFILER == 0
+    #error "render_bench requires LV_USE_PROFILER 1 in lv_conf.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES       800     /*Resolution of the generated UI*/
+#define BENCH_VER_RES       480
+#define BENCH_PX_CNT        (BENCH_HOR_RES * BENCH_VER_RES)
+#define BENCH_FRAME_MS      LV_DISP_DEF_REFR_PERIOD /*Simulated time between two frames*/
+#define BENCH_MAX_FRAMES    300     /*Give up waiting for the screen to settle after this many frames*/
+#define DRAG_STEPS          12      /*Frames of a swipe while the finger is down*/
+#define STORM_UPDATES       4       /*Updates of every label in a frame of the label storm*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t frame_us;      /*Whole `lv_timer_handler()`: animations, input, layout and rendering*/
+    uint32_t render_us;     /*Refreshing the display only*/
+    uint32_t px;            /*Rendered pixels*/
+    uint32_t alloc_cnt;
+    uint32_t alloc_size;
+} frame_stat_t;
+
+typedef struct {
+    const char * name;
+    void (*frame_cb)(uint32_t frame);   /*Called before every frame with the index of the frame*/
+    uint32_t min_frame_cnt;             /*Play at least this many frames, then until the screen settles*/
+} scenario_t;
+
+typedef struct {
+    frame_stat_t * frames;
+    uint32_t frame_cnt;
+    uint32_t checksum;
+} scenario_res_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
+static void touch_read_cb(lv_indev_drv_t * drv, lv_indev_data_t * data);
+static void drag(uint32_t frame, lv_coord_t x_start, lv_coord_t y_start, lv_coord_t dx, lv_coord_t dy);
+static void click(lv_obj_t * obj);
+static void swipe_to_home_control(uint32_t frame);
+static void swipe_to_home(uint32_t frame);
+static void swipe_to_settings(uint32_t frame);
+static void swipe_to_hub(uint32_t frame);
+static void switch_home_panels(uint32_t frame);
+static void win_1_slide_in(uint32_t frame);
+static void win_1_slide_out(uint32_t frame);
+static void switch_settings_panels(uint32_t frame);
+static void update_sensor_labels(uint32_t frame);
+static void label_storm(uint32_t frame);
+static void collect_labels(lv_obj_t * obj);
+static void play(const scenario_t * sc, scenario_res_t * res, bool measure);
+static void print_dist(const char * name, const frame_stat_t * frames, uint32_t frame_cnt, size_t ofs);
+static int compare_u32(const void * a, const void * b);
+static uint64_t time_us(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_PX_CNT];
+static lv_color_t draw_buf1[BENCH_PX_CNT];
+static lv_disp_t * disp;
+static uint32_t tick_ms;
+static uint32_t frame_px;
+
+static lv_point_t touch_point;
+static bool touch_pressed;
+
+static lv_obj_t ** labels;
+static char ** label_texts;
+static uint32_t label_cnt;
+
+/*A tour of the UI, every scenario starts where the previous one ended*/
+static const scenario_t scenarios[] = {
+    {"swipe to home control", swipe_to_home_control, DRAG_STEPS + 1},
+    {"switch home panels", switch_home_panels, 40},
+    {"win_1 slide in", win_1_slide_in, 1},
+    {"win_1 slide out", win_1_slide_out, 1},
+    {"swipe to home", swipe_to_home, DRAG_STEPS + 1},
+    {"swipe to settings", swipe_to_settings, DRAG_STEPS + 1},
+    {"switch settings panels", switch_settings_panels, 40},
+    {"swipe to hub", swipe_to_hub, DRAG_STEPS + 1},
+    {"sensor labels", update_sensor_labels, 60},
+    {"label storm", label_storm, 61},
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_ui guider_ui;
+
+/*The time is simulated to render the same frames in every run*/
+uint32_t custom_tick_get(void)
+{
+    return tick_ms;
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t pass_cnt = 6;
+    bool print_frames = false;
+    int a;
+    for(a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "--frames") == 0) print_frames = true;
+        else pass_cnt = (uint32_t)atoi(argv[a]) + 1;
+    }
+    if(pass_cnt < 2) pass_cnt = 2;
+
+    /*A single phase, the scenarios take the differences frame by frame*/
+    lv_profiler_phase("render_bench");
+    lv_init();
+
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, draw_buf1, NULL, BENCH_PX_CNT);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.hor_res = BENCH_HOR_RES;
+    disp_drv.ver_res = BENCH_VER_RES;
+    disp = lv_disp_drv_register(&disp_drv);
+
+    static lv_indev_drv_t indev_drv;
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = touch_read_cb;
+    lv_indev_drv_register(&indev_drv);
+
+    setup_ui(&guider_ui);
+    events_init(&guider_ui);
+
+    /*Hide the performance monitor as its text changes from frame to frame*/
+    lv_refr_now(disp);
+    lv_obj_t * sys_layer = lv_disp_get_layer_sys(disp);
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(sys_layer); i++) {
+        lv_obj_add_flag(lv_obj_get_child(sys_layer, i), LV_OBJ_FLAG_HIDDEN);
+    }
+
+    uint32_t sc_cnt = sizeof(scenarios) / sizeof(scenarios[0]);
+    scenario_res_t * results = calloc(sc_cnt, sizeof(scenario_res_t));
+    uint32_t p;
+    for(p = 0; p < pass_cnt; p++) {
+        for(i = 0; i < sc_cnt; i++) {
+            play(&scenarios[i], &results[i], p > 0);
+        }
+    }
+
+    printf("{\"bench\":\"render_bench\",\"hor_res\":%d,\"ver_res\":%d,\"color_depth\":%d,\"frame_ms\":%d,\"passes\":%u}\n",
+           BENCH_HOR_RES, BENCH_VER_RES, LV_COLOR_DEPTH, BENCH_FRAME_MS, (unsigned)(pass_cnt - 1));
+
+    for(i = 0; i < sc_cnt; i++) {
+        const scenario_res_t * res = &results[i];
+        uint64_t px_sum = 0;
+        uint64_t alloc_sum = 0;
+        uint64_t alloc_size_sum = 0;
+        uint32_t f;
+        for(f = 0; f < res->frame_cnt; f++) {
+            if(print_frames) {
+                const frame_stat_t * fs = &res->frames[f];
+                printf("{\"scenario\":\"%s\",\"frame\":%u,\"frame_us\":%u,\"render_us\":%u,\"px\":%u,"
+                       "\"allocs\":%u,\"alloc_bytes\":%u}\n", scenarios[i].name, (unsigned)f, (unsigned)fs->frame_us,
+                       (unsigned)fs->render_us, (unsigned)fs->px, (unsigned)fs->alloc_cnt, (unsigned)fs->alloc_size);
+            }
+            px_sum += res->frames[f].px;
+            alloc_sum += res->frames[f].alloc_cnt;
+            alloc_size_sum += res->frames[f].alloc_size;
+        }
+
+        printf("{\"scenario\":\"%s\",\"frames\":%u,", scenarios[i].name, (unsigned)res->frame_cnt);
+        print_dist("frame_us", res->frames, res->frame_cnt, offsetof(frame_stat_t, frame_us));
+        print_dist("render_us", res->frames, res->frame_cnt, offsetof(frame_stat_t, render_us));
+        print_dist("px", res->frames, res->frame_cnt, offsetof(frame_stat_t, px));
+        print_dist("allocs", res->frames, res->frame_cnt, offsetof(frame_stat_t, alloc_cnt));
+        printf("\"px_total\":%llu,\"allocs_total\":%llu,\"alloc_bytes_total\":%llu,\"checksum\":\"%08x\"}\n",
+               (unsigned long long)px_sum, (unsigned long long)alloc_sum, (unsigned long long)alloc_size_sum,
+               (unsigned)res->checksum);
+        free(res->frames);
+    }
+
+    free(results);
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
+{
+    frame_px += px;
+}
+
+static void touch_read_cb(lv_indev_drv_t * drv, lv_indev_data_t * data)
+{
+    data->point = touch_point;
+    data->state = touch_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+/**
+ * Move the finger of the virtual touch pad in a straight line, then lift it
+ * @param frame     index of the frame in the swipe
+ * @param dx        movement in a frame
+ */
+static void drag(uint32_t frame, lv_coord_t x_start, lv_coord_t y_start, lv_coord_t dx, lv_coord_t dy)
+{
+    if(frame < DRAG_STEPS) {
+        touch_point.x = x_start + dx * (lv_coord_t)frame;
+        touch_point.y = y_start + dy * (lv_coord_t)frame;
+        touch_pressed = true;
+    }
+    else {
+        touch_pressed = false;
+    }
+}
+
+static void click(lv_obj_t * obj)
+{
+    lv_event_send(obj, LV_EVENT_CLICKED, NULL);
+}
+
+static void swipe_to_home_control(uint32_t frame)
+{
+    drag(frame, 700, 240, -50, 0);
+}
+
+static void swipe_to_home(uint32_t frame)
+{
+    drag(frame, 100, 240, 50, 0);
+}
+
+static void swipe_to_settings(uint32_t frame)
+{
+    drag(frame, 400, 440, 0, -35);
+}
+
+static void swipe_to_hub(uint32_t frame)
+{
+    drag(frame, 400, 40, 0, 35);
+}
+
+static void switch_home_panels(uint32_t frame)
+{
+    if(frame == 0) click(guider_ui.screen_imgbtn_5);
+    else if(frame == 10) click(guider_ui.screen_imgbtn_6);
+    else if(frame == 20) click(guider_ui.screen_imgbtn_7);
+    else if(frame == 30) click(guider_ui.screen_imgbtn_5);
+}
+
+static void win_1_slide_in(uint32_t frame)
+{
+    if(frame == 0) click(guider_ui.screen_imgbtn_14);
+}
+
+static void win_1_slide_out(uint32_t frame)
+{
+    if(frame == 0) click(guider_ui.screen_win_1_item0);
+}
+
+static void switch_settings_panels(uint32_t frame)
+{
+    if(frame == 0) click(guider_ui.screen_imgbtn_1);
+    else if(frame == 10) click(guider_ui.screen_imgbtn_2);
+    else if(frame == 20) click(guider_ui.screen_imgbtn_3);
+    else if(frame == 30) click(guider_ui.screen_imgbtn_4);
+}
+
+/*The way the sensor thread updates the labels*/
+static void update_sensor_labels(uint32_t frame)
+{
+    lv_label_set_text_fmt(guider_ui.screen_label_49, "%d.%d°C", 20 + (int)(frame % 10), (int)(frame % 7));
+    lv_label_set_text_fmt(guider_ui.screen_label_50, "%d%%", 40 + (int)(frame % 20));
+}
+
+/*Update every label of the screen a few times in every frame, then restore the texts*/
+static void label_storm(uint32_t frame)
+{
+    uint32_t i;
+    if(frame == 0) {
+        label_cnt = 0;
+        collect_labels(guider_ui.screen);
+        label_texts = malloc(label_cnt * sizeof(char *));
+        for(i = 0; i < label_cnt; i++) label_texts[i] = strdup(lv_label_get_text(labels[i]));
+    }
+
+    if(frame < 60) {
+        uint32_t u;
+        for(u = 0; u < STORM_UPDATES; u++) {
+            for(i = 0; i < label_cnt; i++) {
+                lv_label_set_text_fmt(labels[i], "%u", (unsigned)(frame * STORM_UPDATES + u + i));
+            }
+        }
+    }
+    else if(frame == 60) {
+        for(i = 0; i < label_cnt; i++) {
+            lv_label_set_text(labels[i], label_texts[i]);
+            free(label_texts[i]);
+        }
+        free(label_texts);
+        free(labels);
+        labels = NULL;
+    }
+}
+
+static void collect_labels(lv_obj_t * obj)
+{
+    if(lv_obj_check_type(obj, &lv_label_class)) {
+        labels = realloc(labels, (label_cnt + 1) * sizeof(lv_obj_t *));
+        labels[label_cnt] = obj;
+        label_cnt++;
+    }
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        collect_labels(lv_obj_get_child(obj, i));
+    }
+}
+
+/**
+ * Play a scenario frame by frame
+ * @param measure   true: append the frames to `res`
+ */
+static void play(const scenario_t * sc, scenario_res_t * res, bool measure)
+{
+    uint32_t f;
+    for(f = 0; f < BENCH_MAX_FRAMES; f++) {
+        /*Settled: nothing is animated and nothing waits to be redrawn*/
+        if(f >= sc->min_frame_cnt && lv_anim_count_running() == 0 && disp->inv_p == 0) break;
+
+        sc->frame_cb(f);
+
+        const lv_profiler_phase_t * phase = lv_profiler_get_phase(lv_profiler_get_phase_cnt() - 1);
+        uint64_t render_start = phase->cat_time_us[LV_PROFILER_CAT_RENDER];
+        uint32_t alloc_start = phase->alloc_cnt;
+        uint64_t alloc_size_start = phase->alloc_size;
+        frame_px = 0;
+
+        tick_ms += BENCH_FRAME_MS;
+        uint64_t t_start = time_us();
+        lv_timer_handler();
+        uint32_t t = (uint32_t)(time_us() - t_start);
+
+        if(!measure) continue;
+
+        res->frames = realloc(res->frames, (res->frame_cnt + 1) * sizeof(frame_stat_t));
+        frame_stat_t * fs = &res->frames[res->frame_cnt];
+        fs->frame_us = t;
+        fs->render_us = (uint32_t)(phase->cat_time_us[LV_PROFILER_CAT_RENDER] - render_start);
+        fs->px = frame_px;
+        fs->alloc_cnt = phase->alloc_cnt - alloc_start;
+        fs->alloc_size = (uint32_t)(phase->alloc_size - alloc_size_start);
+        res->frame_cnt++;
+    }
+
+    if(f == BENCH_MAX_FRAMES) fprintf(stderr, "%s: the screen didn't settle\n", sc->name);
+
+    if(measure) {
+        res->checksum = 0;
+        uint32_t i;
+        for(i = 0; i < BENCH_PX_CNT; i++) res->checksum = res->checksum * 31 + fb[i].full;
+    }
+}
+
+/**
+ * Print the distribution of a field of the frames as a JSON member
+ * @param ofs   offset of a uint32_t in `frame_stat_t`
+ */
+static void print_dist(const char * name, const frame_stat_t * frames, uint32_t frame_cnt, size_t ofs)
+{
+    if(frame_cnt == 0) {
+        printf("\"%s\":null,", name);
+        return;
+    }
+
+    uint32_t * v = malloc(frame_cnt * sizeof(uint32_t));
+    uint64_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        memcpy(&v[i], (const uint8_t *)&frames[i] + ofs, sizeof(uint32_t));
+        sum += v[i];
+    }
+    qsort(v, frame_cnt, sizeof(uint32_t), compare_u32);
+
+    /*Nearest rank percentiles*/
+    printf("\"%s\":{\"min\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,\"mean\":%u},", name,
+           (unsigned)v[0], (unsigned)v[(frame_cnt - 1) * 50 / 100], (unsigned)v[(frame_cnt - 1) * 90 / 100],
+           (unsigned)v[(frame_cnt - 1) * 99 / 100], (unsigned)v[frame_cnt - 1], (unsigned)(sum / frame_cnt));
+    free(v);
+}
+
+static int compare_u32(const void * a, const void * b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static uint64_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,264 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2023 NXP
+ */
+
+/**
+ * Benchmark of software display rotation.
+ * Renders the same portrait UI on a portrait panel (no rotation) and on a landscape panel
+ * rotated by 90, 180 and 270 degrees with partial refresh, full refresh and direct mode, and prints the median frame time.
+ * In direct mode only a card is redrawn in each frame, the rest has to stay in the draw buffer unrotated.
+ * The rotated frames are compared to the unrotated one so the benchmark also checks the rotation.
+ * Usage: rotate_bench [frame count]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for clock_gettime() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   480     /*Resolution of the portrait UI*/
+#define BENCH_VER_RES   800
+#define BENCH_PX_CNT    (BENCH_HOR_RES * BENCH_VER_RES)
+#define BENCH_PARTIAL   (BENCH_PX_CNT / 10)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    lv_disp_rot_t rotated;
+    bool full_refresh;
+    bool direct_mode;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void create_ui(lv_obj_t * scr);
+static double run_case(const bench_case_t * bc, uint32_t frame_cnt, lv_color_t * fb);
+static int compare_u32(const void * a, const void * b);
+static uint32_t compare_rotated(const lv_color_t * fb, const lv_color_t * ref, lv_disp_rot_t rotated);
+static uint64_t time_us(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb_ref[2][BENCH_PX_CNT];  /*Unrotated frame with partial (and direct mode) and full refresh*/
+static lv_color_t fb_rot[BENCH_PX_CNT];     /*Frame of the rotated panel*/
+static lv_color_t draw_buf1[BENCH_PX_CNT];
+static lv_color_t draw_buf2[BENCH_PX_CNT];
+
+static const bench_case_t cases[] = {
+    {"no rotation, partial", LV_DISP_ROT_NONE, false, false},
+    {"no rotation, full refresh", LV_DISP_ROT_NONE, true, false},
+    {"90 deg, partial", LV_DISP_ROT_90, false, false},
+    {"90 deg, full refresh", LV_DISP_ROT_90, true, false},
+    {"90 deg, direct mode", LV_DISP_ROT_90, false, true},
+    {"180 deg, partial", LV_DISP_ROT_180, false, false},
+    {"180 deg, full refresh", LV_DISP_ROT_180, true, false},
+    {"180 deg, direct mode", LV_DISP_ROT_180, false, true},
+    {"270 deg, partial", LV_DISP_ROT_270, false, false},
+    {"270 deg, full refresh", LV_DISP_ROT_270, true, false},
+    {"270 deg, direct mode", LV_DISP_ROT_270, false, true},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t custom_tick_get(void)
+{
+    static uint64_t start_ms = 0;
+    uint64_t now_ms = time_us() / 1000;
+    if(start_ms == 0) start_ms = now_ms;
+    return (uint32_t)(now_ms - start_ms);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t frame_cnt = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    if(frame_cnt == 0) frame_cnt = 1;
+
+    lv_init();
+
+    printf("%-28s %12s %10s\n", "case", "frame [us]", "diff [px]");
+
+    uint32_t bad = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const bench_case_t * bc = &cases[i];
+        lv_color_t * ref = fb_ref[bc->full_refresh ? 1 : 0];
+        lv_color_t * fb = bc->rotated == LV_DISP_ROT_NONE ? ref : fb_rot;
+        double t = run_case(bc, frame_cnt, fb);
+        if(bc->rotated == LV_DISP_ROT_NONE) {
+            printf("%-28s %12.1f %10s\n", bc->name, t, "-");
+        }
+        else {
+            uint32_t diff = compare_rotated(fb, ref, bc->rotated);
+            printf("%-28s %12.1f %10u\n", bc->name, t, (unsigned)diff);
+            if(diff) bad++;
+        }
+    }
+
+    return bad ? 1 : 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_color_t * fb = drv->user_data;
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+static void create_ui(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+
+    lv_obj_t * header = lv_obj_create(scr);
+    lv_obj_set_size(header, LV_PCT(100), 60);
+    lv_obj_set_style_bg_grad_color(header, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_dir(header, LV_GRAD_DIR_HOR, 0);
+    lv_obj_t * title = lv_label_create(header);
+    lv_label_set_text(title, "Living room");
+    lv_obj_center(title);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * card = lv_obj_create(scr);
+        lv_obj_set_size(card, 210, 150);
+        lv_obj_set_pos(card, 20 + (i % 2) * 230, 80 + (i / 2) * 170);
+        lv_obj_set_style_shadow_width(card, 16, 0);
+
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text_fmt(label, "Light %d", (int)i + 1);
+        lv_obj_t * sw = lv_switch_create(card);
+        lv_obj_align(sw, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        lv_obj_t * slider = lv_slider_create(card);
+        lv_obj_set_width(slider, 150);
+        lv_obj_align(slider, LV_ALIGN_LEFT_MID, 0, 0);
+        lv_slider_set_value(slider, (int32_t)(i * 12), LV_ANIM_OFF);
+    }
+}
+
+/**
+ * Set up the display for a case and render `frame_cnt` frames, full screen ones or in direct mode one card each
+ * @return the median time of a frame in microseconds
+ */
+static double run_case(const bench_case_t * bc, uint32_t frame_cnt, lv_color_t * fb)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    static lv_disp_t * disp;
+
+    if(bc->full_refresh) lv_disp_draw_buf_init(&draw_buf, draw_buf1, draw_buf2, BENCH_PX_CNT);
+    else if(bc->direct_mode) lv_disp_draw_buf_init(&draw_buf, draw_buf1, NULL, BENCH_PX_CNT);
+    else lv_disp_draw_buf_init(&draw_buf, draw_buf1, NULL, BENCH_PARTIAL);
+
+    /*The panel is landscape if the UI is rotated by 90 or 270 degrees*/
+    bool landscape = bc->rotated == LV_DISP_ROT_90 || bc->rotated == LV_DISP_ROT_270;
+    if(disp == NULL) {
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.flush_cb = flush_cb;
+        disp_drv.draw_buf = &draw_buf;
+        disp_drv.sw_rotate = 1;
+    }
+    disp_drv.hor_res = landscape ? BENCH_VER_RES : BENCH_HOR_RES;
+    disp_drv.ver_res = landscape ? BENCH_HOR_RES : BENCH_VER_RES;
+    disp_drv.rotated = bc->rotated;
+    disp_drv.full_refresh = bc->full_refresh;
+    disp_drv.direct_mode = bc->direct_mode;
+    disp_drv.user_data = fb;
+
+    /*Use the same display for all cases as the performance monitor can't be moved to a new display*/
+    if(disp == NULL) {
+        disp = lv_disp_drv_register(&disp_drv);
+        create_ui(lv_disp_get_scr_act(disp));
+        lv_refr_now(disp);
+
+        /*Hide the performance monitor as its text changes from frame to frame*/
+        lv_obj_t * sys_layer = lv_disp_get_layer_sys(disp);
+        uint32_t i;
+        for(i = 0; i < lv_obj_get_child_cnt(sys_layer); i++) {
+            lv_obj_add_flag(lv_obj_get_child(sys_layer, i), LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    else {
+        lv_disp_drv_update(disp, &disp_drv);
+    }
+    lv_refr_now(disp);
+
+    /*The median is less sensitive to the other processes than the average*/
+    uint32_t * frame_times = malloc(frame_cnt * sizeof(uint32_t));
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        uint64_t t_start = time_us();
+        /*The first child is the header, the cards follow*/
+        if(bc->direct_mode) lv_obj_invalidate(lv_obj_get_child(scr, 1 + i % 8));
+        else lv_obj_invalidate(scr);
+        lv_refr_now(disp);
+        frame_times[i] = (uint32_t)(time_us() - t_start);
+    }
+
+    qsort(frame_times, frame_cnt, sizeof(uint32_t), compare_u32);
+    double t = frame_times[frame_cnt / 2];
+    free(frame_times);
+    return t;
+}
+
+static int compare_u32(const void * a, const void * b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+/**
+ * Compare the frame of the rotated panel with the unrotated frame rendered with the same refresh mode
+ * @return number of different pixels
+ */
+static uint32_t compare_rotated(const lv_color_t * fb, const lv_color_t * ref, lv_disp_rot_t rotated)
+{
+    uint32_t diff = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < BENCH_VER_RES; y++) {
+        for(x = 0; x < BENCH_HOR_RES; x++) {
+            lv_color_t ref_c = ref[y * BENCH_HOR_RES + x];
+            lv_color_t c;
+            if(rotated == LV_DISP_ROT_90) c = fb[(BENCH_HOR_RES - 1 - x) * BENCH_VER_RES + y];
+            else if(rotated == LV_DISP_ROT_180) c = fb[(BENCH_VER_RES - 1 - y) * BENCH_HOR_RES + (BENCH_HOR_RES - 1 - x)];
+            else c = fb[x * BENCH_VER_RES + (BENCH_VER_RES - 1 - y)];
+            if(c.full != ref_c.full) diff++;
+        }
+    }
+
+    return diff;
+}
+
+static uint64_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,276 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2023 NXP
+ */
+
+/**
+ * Benchmark of the startup.
+ * Builds the generated UI against a dummy display and renders the first frame with the profiler running.
+ * Every run is made in a new process so all of them start from a cold library.
+ * Prints the median time of the phases and the object classes, and the counts of the first run.
+ * Fails if the first frame isn't the same in every run.
+ * Usage: startup_bench [run count]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for clock_gettime() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "lvgl.h"
+#include "gui_guider.h"
+#include "events_init.h"
+
+#if LV_USE_PROFILER == 0
+    #error "startup_bench requires LV_USE_PROFILER 1 in lv_conf.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES   800     /*Resolution of the generated UI*/
+#define BENCH_VER_RES   480
+#define BENCH_PX_CNT    (BENCH_HOR_RES * BENCH_VER_RES)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*The result of a run sent by the child process. The names and the classes are pointers into
+ *the same program so they are valid in the parent too.*/
+typedef struct {
+    uint32_t phase_cnt;
+    lv_profiler_phase_t phases[LV_PROFILER_MAX_PHASES];
+    uint32_t class_cnt;
+    lv_profiler_class_t classes[LV_PROFILER_MAX_CLASSES];
+    int64_t first_flush_us;
+    uint32_t checksum;
+} run_result_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void run_startup(run_result_t * res);
+static bool run_child(run_result_t * res);
+static uint64_t median(const run_result_t * runs, uint32_t run_cnt, size_t ofs);
+static int compare_u64(const void * a, const void * b);
+static uint64_t time_us(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_PX_CNT];
+static lv_color_t draw_buf1[BENCH_PX_CNT];
+
+/**********************
+ *      MACROS
+ **********************/
+/*Median of a uint64_t field of the results*/
+#define MEDIAN(field) median(runs, run_cnt, offsetof(run_result_t, field))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_ui guider_ui;
+
+uint32_t custom_tick_get(void)
+{
+    static uint64_t start_ms = 0;
+    uint64_t now_ms = time_us() / 1000;
+    if(start_ms == 0) start_ms = now_ms;
+    return (uint32_t)(now_ms - start_ms);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t run_cnt = argc > 1 ? (uint32_t)atoi(argv[1]) : 20;
+    if(run_cnt == 0) run_cnt = 1;
+
+    run_result_t * runs = calloc(run_cnt, sizeof(run_result_t));
+    uint32_t i;
+    for(i = 0; i < run_cnt; i++) {
+        if(!run_child(&runs[i])) {
+            fprintf(stderr, "run %u failed\n", (unsigned)i);
+            return 1;
+        }
+    }
+
+    /*The counts don't depend on the timing so they are printed from the first run*/
+    const run_result_t * first = &runs[0];
+    printf("%u runs, median times, counts of the first run\n", (unsigned)run_cnt);
+    printf("%-16s %10s %10s %10s %10s %7s %7s %7s %10s\n", "phase", "time[us]", "create[us]", "style[us]",
+           "render[us]", "objs", "styles", "allocs", "bytes");
+    for(i = 0; i < first->phase_cnt; i++) {
+        const lv_profiler_phase_t * p = &first->phases[i];
+        printf("%-16s %10u %10u %10u %10u %7u %7u %7u %10u\n", p->name,
+               (unsigned)MEDIAN(phases[i].time_us),
+               (unsigned)MEDIAN(phases[i].cat_time_us[LV_PROFILER_CAT_OBJ_CREATE]),
+               (unsigned)MEDIAN(phases[i].cat_time_us[LV_PROFILER_CAT_STYLE]),
+               (unsigned)MEDIAN(phases[i].cat_time_us[LV_PROFILER_CAT_RENDER]),
+               (unsigned)p->obj_cnt, (unsigned)p->style_cnt, (unsigned)p->alloc_cnt, (unsigned)p->alloc_size);
+    }
+
+    printf("\n%-24s %7s %10s\n", "class", "count", "time[us]");
+    for(i = 0; i < first->class_cnt; i++) {
+        const lv_profiler_class_t * c = &first->classes[i];
+        printf("%-24s %7u %10u\n", lv_profiler_get_class_name(c->class_p), (unsigned)c->cnt,
+               (unsigned)MEDIAN(classes[i].time_us));
+    }
+
+    if(first->first_flush_us >= 0) printf("\ntime to first flush: %u us\n", (unsigned)MEDIAN(first_flush_us));
+    else printf("\nnothing was flushed\n");
+
+    /*The UI is the same in every run so the frames have to be the same too*/
+    uint32_t bad = 0;
+    for(i = 1; i < run_cnt; i++) {
+        if(runs[i].checksum != first->checksum) bad++;
+    }
+    printf("first frame checksum: %08x, %u different\n", (unsigned)first->checksum, (unsigned)bad);
+
+    free(runs);
+    return bad ? 1 : 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Start the library and the UI like the application does, and render the first frame
+ * @param res   store the profile here
+ */
+static void run_startup(run_result_t * res)
+{
+    lv_profiler_phase("lv_init");
+    lv_init();
+
+    lv_profiler_phase("display");
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, draw_buf1, NULL, BENCH_PX_CNT);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.hor_res = BENCH_HOR_RES;
+    disp_drv.ver_res = BENCH_VER_RES;
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+
+    lv_profiler_phase("setup_ui");
+    setup_ui(&guider_ui);
+
+    lv_profiler_phase("events_init");
+    events_init(&guider_ui);
+
+    /*Render right away instead of waiting for the refresh timer to make the runs comparable*/
+    lv_profiler_phase("first frame");
+    lv_refr_now(disp);
+    lv_profiler_stop();
+
+    res->phase_cnt = lv_profiler_get_phase_cnt();
+    uint32_t i;
+    for(i = 0; i < res->phase_cnt; i++) res->phases[i] = *lv_profiler_get_phase(i);
+    res->class_cnt = lv_profiler_get_class_cnt();
+    for(i = 0; i < res->class_cnt; i++) res->classes[i] = *lv_profiler_get_class(i);
+    res->first_flush_us = lv_profiler_get_first_flush_time();
+
+    /*The performance monitor in the corner is the same in the first frame of every run*/
+    res->checksum = 0;
+    for(i = 0; i < BENCH_PX_CNT; i++) res->checksum = res->checksum * 31 + fb[i].full;
+}
+
+/**
+ * Make a run in a child process
+ * @param res   the result of the run is copied here
+ * @return      true: the child finished and sent the result
+ */
+static bool run_child(run_result_t * res)
+{
+    int fds[2];
+    if(pipe(fds) != 0) return false;
+
+    pid_t pid = fork();
+    if(pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if(pid == 0) {
+        close(fds[0]);
+        run_result_t * child_res = calloc(1, sizeof(run_result_t));
+        run_startup(child_res);
+        const uint8_t * p = (const uint8_t *)child_res;
+        size_t left = sizeof(run_result_t);
+        while(left > 0) {
+            ssize_t n = write(fds[1], p, left);
+            if(n <= 0) _exit(1);
+            p += n;
+            left -= n;
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    uint8_t * p = (uint8_t *)res;
+    size_t left = sizeof(run_result_t);
+    while(left > 0) {
+        ssize_t n = read(fds[0], p, left);
+        if(n <= 0) break;
+        p += n;
+        left -= n;
+    }
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    return left == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * Get the median of a field of the runs
+ * @param ofs   offset of a uint64_t in `run_result_t`
+ */
+static uint64_t median(const run_result_t * runs, uint32_t run_cnt, size_t ofs)
+{
+    uint64_t * v = malloc(run_cnt * sizeof(uint64_t));
+    uint32_t i;
+    for(i = 0; i < run_cnt; i++) memcpy(&v[i], (const uint8_t *)&runs[i] + ofs, sizeof(uint64_t));
+
+    /*The median is less sensitive to the other processes than the average*/
+    qsort(v, run_cnt, sizeof(uint64_t), compare_u64);
+    uint64_t m = v[run_cnt / 2];
+    free(v);
+    return m;
+}
+
+static int compare_u64(const void * a, const void * b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+static uint64_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -13,6 +13,7 @@
 #include <unistd.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
@@ -252,6 +253,50 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
     lv_disp_flush_ready(drv);
 }
 
+/**
+ * Move pixels on the frame buffer. Set it as `copy_area_cb` to scroll without redrawing.
+ * @param drv pointer to driver where this function belongs
+ * @param area the destination area, the pixels are copied from `area` moved by (-dx, -dy)
+ * @param dx horizontal movement
+ * @param dy vertical movement
+ * @return true: the pixels were moved; false: not supported with this frame buffer
+ */
+bool fbdev_copy_area(lv_disp_drv_t * drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    LV_UNUSED(drv);
+
+    if(fbp == NULL || vinfo.bits_per_pixel < 8) return false;
+
+    /*Truncate the destination so that the source is on the screen too*/
+    int32_t act_x1 = LV_MAX3(area->x1, 0, dx);
+    int32_t act_y1 = LV_MAX3(area->y1, 0, dy);
+    int32_t act_x2 = LV_MIN3(area->x2, (int32_t)vinfo.xres - 1, (int32_t)vinfo.xres - 1 + dx);
+    int32_t act_y2 = LV_MIN3(area->y2, (int32_t)vinfo.yres - 1, (int32_t)vinfo.yres - 1 + dy);
+    if(act_x1 > act_x2 || act_y1 > act_y2) return true;
+
+    /*24 bit is handled as 32 bit by `fbdev_flush` too*/
+    long int px_size = vinfo.bits_per_pixel == 24 ? 4 : vinfo.bits_per_pixel / 8;
+    long int row_size = (act_x2 - act_x1 + 1) * px_size;
+    long int src_ofs = dy * finfo.line_length + dx * px_size;
+    int32_t y;
+
+    /*Go against the movement so that the source rows are read before they're overwritten*/
+    if(dy > 0) {
+        for(y = act_y2; y >= act_y1; y--) {
+            char * dest = fbp + (y + vinfo.yoffset) * finfo.line_length + (act_x1 + vinfo.xoffset) * px_size;
+            memmove(dest, dest - src_ofs, row_size);
+        }
+    }
+    else {
+        for(y = act_y1; y <= act_y2; y++) {
+            char * dest = fbp + (y + vinfo.yoffset) * finfo.line_length + (act_x1 + vinfo.xoffset) * px_size;
+            memmove(dest, dest - src_ofs, row_size);
+        }
+    }
+
+    return true;
+}
+
 void fbdev_get_sizes(uint32_t *width, uint32_t *height, uint32_t *dpi) {
     if (width)
         *width = vinfo.xres;
@@ -18,6 +18,16 @@
 #include <linux/input.h>
 #endif
 
+#if EVDEV_THREAD
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#endif
+
 #if USE_XKB
 #include "xkb.h"
 #endif /* USE_XKB */
@@ -25,15 +35,66 @@
 /*********************
  *      DEFINES
  *********************/
+#if EVDEV_THREAD
+#define EVDEV_READ_CNT      64      /*Events read with one `read()`*/
+#define EVDEV_POLL_MS       100     /*Check this often if the thread has to stop*/
+#define EVDEV_RETRY_MS      5       /*Retry this often to queue a frame when the queue is full*/
+
+/*Older headers have the time stamp as a `struct timeval` only*/
+#ifndef input_event_sec
+#define input_event_sec     time.tv_sec
+#define input_event_usec    time.tv_usec
+#endif
+
+#if (EVDEV_QUEUE_SIZE & (EVDEV_QUEUE_SIZE - 1)) != 0
+#error "EVDEV_QUEUE_SIZE has to be a power of 2"
+#endif
+#endif /*EVDEV_THREAD*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if EVDEV_THREAD
+/*A multi-touch slot seen by the reader thread*/
+typedef struct {
+    int32_t id;             /*Tracking ID, -1 if the slot is free*/
+    int32_t x;
+    int32_t y;
+    uint32_t down_seq;      /*Orders the contacts by the time they touched down*/
+} evdev_slot_t;
+
+/*State of the device collected by the reader thread from the events of a frame*/
+typedef struct {
+    evdev_slot_t slots[EVDEV_MAX_SLOTS];
+    int32_t slot;           /*Slot the ABS_MT_... events refer to*/
+    uint32_t down_seq;
+    int32_t root_x;
+    int32_t root_y;
+    bool button;
+    uint16_t key;
+    bool key_pressed;
+    bool has_key;           /*A key was pressed or released in the current frame*/
+    bool dropping;          /*The kernel dropped events, ignore the rest of the frame*/
+    bool pending;           /*`pending_frame` didn't fit into the queue yet*/
+    evdev_frame_t pending_frame;
+} evdev_reader_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 int map(int x, int in_min, int in_max, int out_min, int out_max);
+static uint32_t evdev_map_key(uint16_t code, bool pressed);
+static void evdev_set_point(lv_indev_drv_t * drv, int32_t x, int32_t y, lv_point_t * point);
+#if EVDEV_THREAD
+static void evdev_thread_start(void);
+static void evdev_thread_stop(void);
+static void * evdev_thread(void * arg);
+static void evdev_process(evdev_reader_t * rd, const struct input_event * in);
+static void evdev_end_frame(evdev_reader_t * rd, const struct input_event * in);
+static bool evdev_push_frame(const evdev_frame_t * frame);
+static bool evdev_pop_frame(evdev_frame_t * frame);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -45,6 +106,21 @@ int evdev_button;
 
 int evdev_key_val;
 
+#if EVDEV_THREAD
+static pthread_t evdev_tid;
+static bool evdev_thread_running;
+static atomic_bool evdev_stop;
+
+/*Single producer (the reader thread), single consumer (`evdev_read()`) queue of frames*/
+static evdev_frame_t evdev_queue[EVDEV_QUEUE_SIZE];
+static atomic_uint evdev_queue_head;
+static atomic_uint evdev_queue_tail;
+static atomic_uint evdev_dropped_cnt;
+
+static evdev_reader_t evdev_reader;
+static evdev_frame_t evdev_last_frame;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -73,7 +149,11 @@ void evdev_init(void)
  *         false: the device file doesn't exist current system
  */
 bool evdev_set_file(char* dev_name)
-{ 
+{
+#if EVDEV_THREAD
+     evdev_thread_stop();
+#endif
+
      if(evdev_fd != -1) {
         close(evdev_fd);
      }
@@ -99,8 +179,76 @@ bool evdev_set_file(char* dev_name)
      evdev_key_val = 0;
      evdev_button = LV_INDEV_STATE_REL;
 
+#if EVDEV_THREAD
+     evdev_thread_start();
+#endif
+
      return true;
 }
+
+#if EVDEV_THREAD
+/**
+ * Get the input frame used by the last `evdev_read()`
+ * @return the frame with the calibrated position of every contact
+ */
+const evdev_frame_t * evdev_get_frame(void)
+{
+    return &evdev_last_frame;
+}
+
+/**
+ * Get the number of frames which were replaced by a newer one because the queue was full
+ * @return number of dropped frames since the device was opened
+ */
+uint32_t evdev_get_dropped_cnt(void)
+{
+    return atomic_load(&evdev_dropped_cnt);
+}
+
+/**
+ * Get the next queued frame of the evdev.
+ * Sets `continue_reading` while there are more frames so no stroke is lost if a frame took long.
+ * @param data store the evdev data here
+ */
+void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
+{
+    evdev_frame_t frame;
+    bool new_frame = evdev_pop_frame(&frame);
+    if(new_frame) {
+        evdev_set_point(drv, frame.x, frame.y, &frame.point);
+        uint8_t i;
+        for(i = 0; i < frame.touch_cnt; i++) {
+            evdev_set_point(drv, frame.touches[i].point.x, frame.touches[i].point.y, &frame.touches[i].point);
+        }
+        evdev_last_frame = frame;
+        /*The kernel stamps the events with CLOCK_MONOTONIC*/
+        data->timestamp_us = frame.time_us;
+        data->continue_reading = atomic_load_explicit(&evdev_queue_head, memory_order_relaxed) !=
+                                 atomic_load_explicit(&evdev_queue_tail, memory_order_acquire);
+    }
+
+    if(drv->type == LV_INDEV_TYPE_KEYPAD) {
+        if(new_frame && frame.has_key) {
+            uint32_t key = evdev_map_key(frame.key, frame.key_pressed);
+            /* Only record button state when actual output is produced to prevent widgets from refreshing */
+            if(key != 0) {
+                evdev_key_val = key;
+                evdev_button = frame.key_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+            }
+        }
+        data->key = evdev_key_val;
+        data->state = evdev_button;
+        return;
+    }
+    if(drv->type != LV_INDEV_TYPE_POINTER)
+        return ;
+
+    data->point = evdev_last_frame.point;
+    data->state = evdev_last_frame.state;
+}
+
+#else /*EVDEV_THREAD*/
+
 /**
  * Get the current position and state of the evdev
  * @param data store the evdev data here
@@ -161,42 +309,7 @@ void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
                 else if(in.value == 1)
                     evdev_button = LV_INDEV_STATE_PR;
             } else if(drv->type == LV_INDEV_TYPE_KEYPAD) {
-#if USE_XKB
-                data->key = xkb_process_key(in.code, in.value != 0);
-#else
-                switch(in.code) {
-                    case KEY_BACKSPACE:
-                        data->key = LV_KEY_BACKSPACE;
-                        break;
-                    case KEY_ENTER:
-                        data->key = LV_KEY_ENTER;
-                        break;
-                    case KEY_PREVIOUS:
-                        data->key = LV_KEY_PREV;
-                        break;
-                    case KEY_NEXT:
-                        data->key = LV_KEY_NEXT;
-                        break;
-                    case KEY_UP:
-                        data->key = LV_KEY_UP;
-                        break;
-                    case KEY_LEFT:
-                        data->key = LV_KEY_LEFT;
-                        break;
-                    case KEY_RIGHT:
-                        data->key = LV_KEY_RIGHT;
-                        break;
-                    case KEY_DOWN:
-                        data->key = LV_KEY_DOWN;
-                        break;
-                    case KEY_TAB:
-                        data->key = LV_KEY_NEXT;
-                        break;
-                    default:
-                        data->key = 0;
-                        break;
-                }
-#endif /* USE_XKB */
+                data->key = evdev_map_key(in.code, in.value != 0);
                 if (data->key != 0) {
                     /* Only record button state when actual output is produced to prevent widgets from refreshing */
                     data->state = (in.value) ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
@@ -218,27 +331,13 @@ void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
         return ;
     /*Store the collected data*/
 
-#if EVDEV_CALIBRATE
-    data->point.x = map(evdev_root_x, EVDEV_HOR_MIN, EVDEV_HOR_MAX, 0, drv->disp->driver->hor_res);
-    data->point.y = map(evdev_root_y, EVDEV_VER_MIN, EVDEV_VER_MAX, 0, drv->disp->driver->ver_res);
-#else
-    data->point.x = evdev_root_x;
-    data->point.y = evdev_root_y;
-#endif
+    evdev_set_point(drv, evdev_root_x, evdev_root_y, &data->point);
 
     data->state = evdev_button;
 
-    if(data->point.x < 0)
-      data->point.x = 0;
-    if(data->point.y < 0)
-      data->point.y = 0;
-    if(data->point.x >= drv->disp->driver->hor_res)
-      data->point.x = drv->disp->driver->hor_res - 1;
-    if(data->point.y >= drv->disp->driver->ver_res)
-      data->point.y = drv->disp->driver->ver_res - 1;
-
     return ;
 }
+#endif /*EVDEV_THREAD*/
 
 /**********************
  *   STATIC FUNCTIONS
@@ -248,4 +347,297 @@ int map(int x, int in_min, int in_max, int out_min, int out_max)
   return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
 
+/**
+ * Convert a key code of the kernel to an LVGL key
+ * @return the LVGL key or 0 if the key has no meaning for LVGL
+ */
+static uint32_t evdev_map_key(uint16_t code, bool pressed)
+{
+#if USE_XKB
+    return xkb_process_key(code, pressed);
+#else
+    (void)pressed;
+    switch(code) {
+        case KEY_BACKSPACE:
+            return LV_KEY_BACKSPACE;
+        case KEY_ENTER:
+            return LV_KEY_ENTER;
+        case KEY_PREVIOUS:
+            return LV_KEY_PREV;
+        case KEY_NEXT:
+            return LV_KEY_NEXT;
+        case KEY_UP:
+            return LV_KEY_UP;
+        case KEY_LEFT:
+            return LV_KEY_LEFT;
+        case KEY_RIGHT:
+            return LV_KEY_RIGHT;
+        case KEY_DOWN:
+            return LV_KEY_DOWN;
+        case KEY_TAB:
+            return LV_KEY_NEXT;
+        default:
+            return 0;
+    }
+#endif /* USE_XKB */
+}
+
+/**
+ * Calibrate a raw coordinate and limit it to the display
+ */
+static void evdev_set_point(lv_indev_drv_t * drv, int32_t x, int32_t y, lv_point_t * point)
+{
+#if EVDEV_CALIBRATE
+    point->x = map(x, EVDEV_HOR_MIN, EVDEV_HOR_MAX, 0, drv->disp->driver->hor_res);
+    point->y = map(y, EVDEV_VER_MIN, EVDEV_VER_MAX, 0, drv->disp->driver->ver_res);
+#else
+    point->x = x;
+    point->y = y;
+#endif
+
+    if(point->x < 0)
+      point->x = 0;
+    if(point->y < 0)
+      point->y = 0;
+    if(point->x >= drv->disp->driver->hor_res)
+      point->x = drv->disp->driver->hor_res - 1;
+    if(point->y >= drv->disp->driver->ver_res)
+      point->y = drv->disp->driver->ver_res - 1;
+}
+
+#if EVDEV_THREAD
+static void evdev_thread_start(void)
+{
+#ifdef EVIOCSCLOCKID
+    /*Use the clock of `clock_gettime(CLOCK_MONOTONIC)` for the time stamps to compare them with the rendering*/
+    int clk = CLOCK_MONOTONIC;
+    ioctl(evdev_fd, EVIOCSCLOCKID, &clk);
+#endif
+
+    memset(&evdev_reader, 0, sizeof(evdev_reader));
+    uint32_t i;
+    for(i = 0; i < EVDEV_MAX_SLOTS; i++) evdev_reader.slots[i].id = -1;
+    memset(&evdev_last_frame, 0, sizeof(evdev_last_frame));
+    evdev_last_frame.state = LV_INDEV_STATE_REL;
+    atomic_store(&evdev_queue_head, 0);
+    atomic_store(&evdev_queue_tail, 0);
+    atomic_store(&evdev_dropped_cnt, 0);
+    atomic_store(&evdev_stop, false);
+
+    int err = pthread_create(&evdev_tid, NULL, evdev_thread, NULL);
+    if(err != 0) {
+        fprintf(stderr, "unable to start the evdev thread: %s\n", strerror(err));
+        return;
+    }
+    evdev_thread_running = true;
+}
+
+static void evdev_thread_stop(void)
+{
+    if(!evdev_thread_running) return;
+
+    atomic_store(&evdev_stop, true);
+    pthread_join(evdev_tid, NULL);
+    evdev_thread_running = false;
+}
+
+/**
+ * Read the events in bulk as they arrive and queue a frame at every SYN_REPORT
+ */
+static void * evdev_thread(void * arg)
+{
+    (void)arg;
+    struct input_event in[EVDEV_READ_CNT];
+    struct pollfd pfd = {.fd = evdev_fd, .events = POLLIN};
+
+    while(!atomic_load(&evdev_stop)) {
+        if(evdev_reader.pending && evdev_push_frame(&evdev_reader.pending_frame)) {
+            evdev_reader.pending = false;
+        }
+
+        int res = poll(&pfd, 1, evdev_reader.pending ? EVDEV_RETRY_MS : EVDEV_POLL_MS);
+        if(res < 0 && errno != EINTR) {
+            perror("evdev poll");
+            break;
+        }
+        if(res <= 0) continue;
+        if(pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            fprintf(stderr, "evdev: the device is gone\n");
+            break;
+        }
+
+        ssize_t len = read(evdev_fd, in, sizeof(in));
+        if(len < 0) {
+            if(errno == EAGAIN || errno == EINTR) continue;
+            perror("evdev read");
+            break;
+        }
+
+        size_t i;
+        for(i = 0; i < (size_t)len / sizeof(struct input_event); i++) {
+            evdev_process(&evdev_reader, &in[i]);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Update the state of the device with an event
+ */
+static void evdev_process(evdev_reader_t * rd, const struct input_event * in)
+{
+    if(in->type == EV_SYN) {
+        if(in->code == SYN_DROPPED) {
+            rd->dropping = true;
+        }
+        else if(in->code == SYN_REPORT) {
+            if(!rd->dropping) evdev_end_frame(rd, in);
+            rd->dropping = false;
+        }
+        return;
+    }
+
+    if(rd->dropping) return;
+
+    evdev_slot_t * slot = rd->slot >= 0 && rd->slot < EVDEV_MAX_SLOTS ? &rd->slots[rd->slot] : NULL;
+
+    if(in->type == EV_REL) {
+        if(in->code == REL_X)
+#if EVDEV_SWAP_AXES
+            rd->root_y += in->value;
+#else
+            rd->root_x += in->value;
+#endif
+        else if(in->code == REL_Y)
+#if EVDEV_SWAP_AXES
+            rd->root_x += in->value;
+#else
+            rd->root_y += in->value;
+#endif
+    }
+    else if(in->type == EV_ABS) {
+        if(in->code == ABS_X)
+#if EVDEV_SWAP_AXES
+            rd->root_y = in->value;
+#else
+            rd->root_x = in->value;
+#endif
+        else if(in->code == ABS_Y)
+#if EVDEV_SWAP_AXES
+            rd->root_x = in->value;
+#else
+            rd->root_y = in->value;
+#endif
+        else if(in->code == ABS_MT_SLOT)
+            rd->slot = in->value;
+        else if(in->code == ABS_MT_POSITION_X && slot)
+#if EVDEV_SWAP_AXES
+            slot->y = in->value;
+#else
+            slot->x = in->value;
+#endif
+        else if(in->code == ABS_MT_POSITION_Y && slot)
+#if EVDEV_SWAP_AXES
+            slot->x = in->value;
+#else
+            slot->y = in->value;
+#endif
+        else if(in->code == ABS_MT_TRACKING_ID && slot) {
+            if(in->value >= 0 && slot->id < 0) slot->down_seq = ++rd->down_seq;
+            slot->id = in->value;
+        }
+    }
+    else if(in->type == EV_KEY) {
+        if(in->code == BTN_MOUSE || in->code == BTN_TOUCH) {
+            if(in->value == 0) rd->button = false;
+            else if(in->value == 1) rd->button = true;
+        }
+        else {
+            /*One key per frame, the earlier key gets a frame of its own*/
+            if(rd->has_key) evdev_end_frame(rd, in);
+            rd->key = in->code;
+            rd->key_pressed = in->value != 0;
+            rd->has_key = true;
+        }
+    }
+}
+
+/**
+ * Queue the state of the device as a frame.
+ * If the queue is full the frame is kept and queued later. A newer frame replaces it
+ * as it has the newer state, so only the movements and the keys in between are lost.
+ * @param in    the event which closes the frame, its time stamp is used
+ */
+static void evdev_end_frame(evdev_reader_t * rd, const struct input_event * in)
+{
+    evdev_frame_t * frame = &rd->pending_frame;
+    if(rd->pending) atomic_fetch_add(&evdev_dropped_cnt, 1);
+
+    frame->time_us = (uint64_t)in->input_event_sec * 1000000 + in->input_event_usec;
+
+    /*List the contacts in the order they touched down, the first one drives the pointer*/
+    frame->touch_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < EVDEV_MAX_SLOTS; i++) {
+        if(rd->slots[i].id < 0) continue;
+        uint32_t j = frame->touch_cnt;
+        while(j > 0 && rd->slots[frame->touches[j - 1].slot].down_seq > rd->slots[i].down_seq) {
+            frame->touches[j] = frame->touches[j - 1];
+            j--;
+        }
+        frame->touches[j].id = rd->slots[i].id;
+        frame->touches[j].slot = (uint8_t)i;
+        frame->touches[j].point.x = rd->slots[i].x;
+        frame->touches[j].point.y = rd->slots[i].y;
+        frame->touch_cnt++;
+    }
+
+    /*The pointer stays where the last contact was lifted*/
+    if(frame->touch_cnt > 0) {
+        rd->root_x = frame->touches[0].point.x;
+        rd->root_y = frame->touches[0].point.y;
+    }
+    frame->x = rd->root_x;
+    frame->y = rd->root_y;
+    frame->state = rd->button || frame->touch_cnt > 0 ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    frame->key = rd->key;
+    frame->key_pressed = rd->key_pressed;
+    frame->has_key = rd->has_key;
+    rd->has_key = false;
+
+    rd->pending = !evdev_push_frame(frame);
+}
+
+/**
+ * Add a frame to the queue. Called by the reader thread only.
+ * @return false: the queue is full
+ */
+static bool evdev_push_frame(const evdev_frame_t * frame)
+{
+    unsigned tail = atomic_load_explicit(&evdev_queue_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&evdev_queue_head, memory_order_acquire);
+    if(tail - head >= EVDEV_QUEUE_SIZE) return false;
+
+    evdev_queue[tail & (EVDEV_QUEUE_SIZE - 1)] = *frame;
+    atomic_store_explicit(&evdev_queue_tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Take the oldest frame from the queue. Called by `evdev_read()` only.
+ * @return false: the queue is empty
+ */
+static bool evdev_pop_frame(evdev_frame_t * frame)
+{
+    unsigned head = atomic_load_explicit(&evdev_queue_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&evdev_queue_tail, memory_order_acquire);
+    if(head == tail) return false;
+
+    *frame = evdev_queue[head & (EVDEV_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&evdev_queue_head, head + 1, memory_order_release);
+    return true;
+}
+#endif /*EVDEV_THREAD*/
+
 #endif
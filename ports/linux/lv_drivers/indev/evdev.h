@@ -36,6 +36,28 @@ extern "C" {
 /**********************
  *      TYPEDEFS
  **********************/
+#if EVDEV_THREAD
+/*A contact of a multi-touch screen*/
+typedef struct {
+    int32_t id;             /*Tracking ID given by the kernel*/
+    uint8_t slot;
+    lv_point_t point;
+} evdev_touch_t;
+
+/*The state of the device at a SYN_REPORT of the kernel*/
+typedef struct {
+    uint64_t time_us;       /*Time stamp of the kernel, CLOCK_MONOTONIC if the kernel supports it*/
+    int32_t x;              /*Raw position of the pointer*/
+    int32_t y;
+    lv_point_t point;       /*Calibrated position of the pointer*/
+    lv_indev_state_t state;
+    uint8_t touch_cnt;
+    evdev_touch_t touches[EVDEV_MAX_SLOTS];  /*In the order they touched down, the first one drives the pointer*/
+    uint16_t key;           /*Key code of the kernel if `has_key`*/
+    bool key_pressed;
+    bool has_key;
+} evdev_frame_t;
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -58,6 +80,19 @@ bool evdev_set_file(char* dev_name);
  */
 void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
 
+#if EVDEV_THREAD
+/**
+ * Get the input frame used by the last `evdev_read()`, e.g. to detect gestures
+ * @return the frame with the calibrated position of every contact
+ */
+const evdev_frame_t * evdev_get_frame(void);
+/**
+ * Get the number of frames which were replaced by a newer one because the queue was full
+ * @return number of dropped frames since the device was opened
+ */
+uint32_t evdev_get_dropped_cnt(void);
+#endif
+
 
 /**********************
  *      MACROS
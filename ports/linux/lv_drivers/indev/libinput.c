@@ -45,6 +45,7 @@ static void reset_scanned_devices(void);
 
 static void read_pointer(libinput_drv_state_t *state, struct libinput_event *event);
 static void read_keypad(libinput_drv_state_t *state, struct libinput_event *event);
+static void stamp_change(libinput_drv_state_t *state, uint64_t time_us);
 
 static int open_restricted(const char *path, int flags, void *user_data);
 static void close_restricted(int fd, void *user_data);
@@ -246,6 +247,8 @@ report_most_recent_state:
   data->point.y = state->most_recent_touch_point.y;
   data->state = state->button;
   data->key = state->key_val;
+  data->timestamp_us = state->time_us;
+  state->time_us = 0;
 }
 
 
@@ -392,15 +395,18 @@ static void read_pointer(libinput_drv_state_t *state, struct libinput_event *eve
       if (x < 0 || x > drv->hor_res || y < 0 || y > drv->ver_res) {
         break; /* ignore touches that are out of bounds */
       }
+      stamp_change(state, libinput_event_touch_get_time_usec(touch_event));
       state->most_recent_touch_point.x = x;
       state->most_recent_touch_point.y = y;
       state->button = LV_INDEV_STATE_PR;
       break;
     case LIBINPUT_EVENT_TOUCH_UP:
+      stamp_change(state, libinput_event_touch_get_time_usec(libinput_event_get_touch_event(event)));
       state->button = LV_INDEV_STATE_REL;
       break;
     case LIBINPUT_EVENT_POINTER_MOTION:
       pointer_event = libinput_event_get_pointer_event(event);
+      stamp_change(state, libinput_event_pointer_get_time_usec(pointer_event));
       state->most_recent_touch_point.x += libinput_event_pointer_get_dx(pointer_event);
       state->most_recent_touch_point.y += libinput_event_pointer_get_dy(pointer_event);
       state->most_recent_touch_point.x = LV_CLAMP(0, state->most_recent_touch_point.x, drv->hor_res - 1);
@@ -408,6 +414,7 @@ static void read_pointer(libinput_drv_state_t *state, struct libinput_event *eve
       break;
     case LIBINPUT_EVENT_POINTER_BUTTON:
       pointer_event = libinput_event_get_pointer_event(event);
+      stamp_change(state, libinput_event_pointer_get_time_usec(pointer_event));
       enum libinput_button_state button_state = libinput_event_pointer_get_button_state(pointer_event); 
       state->button = button_state == LIBINPUT_BUTTON_STATE_RELEASED ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
       break;
@@ -468,6 +475,7 @@ static void read_keypad(libinput_drv_state_t *state, struct libinput_event *even
       if (state->key_val != 0) {
         /* Only record button state when actual output is produced to prevent widgets from refreshing */
         state->button = (key_state == LIBINPUT_KEY_STATE_RELEASED) ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
+        stamp_change(state, libinput_event_keyboard_get_time_usec(keyboard_event));
       }
       break;
     default:
@@ -475,6 +483,17 @@ static void read_keypad(libinput_drv_state_t *state, struct libinput_event *even
   }
 }
 
+/**
+ * Remember the time of the first change since the last read. libinput uses CLOCK_MONOTONIC.
+ * @param state driver state to use
+ * @param time_us time stamp of the event in microseconds
+ */
+static void stamp_change(libinput_drv_state_t *state, uint64_t time_us) {
+  if (state->time_us == 0) {
+    state->time_us = time_us;
+  }
+}
+
 static int open_restricted(const char *path, int flags, void *user_data)
 {
   LV_UNUSED(user_data);
@@ -56,6 +56,7 @@ typedef struct {
   int button;
   int key_val;
   lv_point_t most_recent_touch_point;
+  uint64_t time_us; /* time of the oldest change not reported yet, 0 if there is none */
 
   struct libinput *libinput_context;
   struct libinput_device *libinput_device;
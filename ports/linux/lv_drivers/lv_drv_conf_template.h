@@ -190,6 +190,10 @@
 #  ifndef LV_WAYLAND_XDG_SHELL
 #    define LV_WAYLAND_XDG_SHELL 0
 #  endif
+/* Number of buffers of a window, the next frame is drawn into one the compositor released */
+#  ifndef LV_WAYLAND_BUFFER_COUNT
+#    define LV_WAYLAND_BUFFER_COUNT 3
+#  endif
 #endif
 
 /*----------------
@@ -450,6 +454,12 @@
 #  define EVDEV_NAME   "/dev/input/event0"        /*You can use the "evtest" Linux tool to get the list of devices and test them*/
 #  define EVDEV_SWAP_AXES         0               /*Swap the x and y axes of the touchscreen*/
 
+#  define EVDEV_THREAD            1               /*Read the events in a thread and queue a frame with the kernel time stamp at every SYN_REPORT*/
+#  if EVDEV_THREAD
+#    define EVDEV_QUEUE_SIZE     64               /*Queued frames, power of 2*/
+#    define EVDEV_MAX_SLOTS      10               /*Tracked contacts of a multi-touch screen*/
+#  endif  /*EVDEV_THREAD*/
+
 #  define EVDEV_CALIBRATE         0               /*Scale and offset the touchscreen coordinates by using maximum and minimum values for each axis*/
 
 #  if EVDEV_CALIBRATE
@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -54,6 +55,10 @@
 #define LV_WAYLAND_CYCLE_PERIOD LV_MIN(LV_DISP_DEF_REFR_PERIOD,1)
 #endif
 
+#ifndef LV_WAYLAND_BUFFER_COUNT
+#define LV_WAYLAND_BUFFER_COUNT 3
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -122,6 +127,10 @@ struct buffer_hdl
     int size;
     struct wl_buffer *wl_buffer;
     bool busy;
+
+    /* Areas presented from other buffers since this buffer was drawn (window body only) */
+    lv_area_t stale_areas[LV_INV_BUF_SIZE];
+    uint16_t stale_cnt;
 };
 
 struct buffer_allocator
@@ -144,6 +153,7 @@ struct graphic_object
     int width;
     int height;
 
+    /* Content of decorations, the body uses the buffer pool of its window */
     struct buffer_hdl buffer;
 
     struct input input;
@@ -227,6 +237,16 @@ struct window
 
     struct graphic_object * body;
 
+    /* The body is drawn into a buffer released by the compositor and only the damaged areas are updated */
+    struct buffer_hdl buffers[LV_WAYLAND_BUFFER_COUNT];
+    struct buffer_hdl *back_buffer;
+    struct buffer_hdl *front_buffer;
+    lv_area_t damage[LV_INV_BUF_SIZE];
+    uint16_t damage_cnt;
+
+    /* Requested with the last commit, the next frame is drawn when the compositor is ready for it */
+    struct wl_callback *frame_callback;
+
 #if LV_WAYLAND_CLIENT_SIDE_DECORATIONS
     struct graphic_object * decoration[NUM_DECORATIONS];
 #endif
@@ -251,6 +271,8 @@ struct window
 
 static struct application application;
 
+static void present_front_buffer(struct window *window, const lv_area_t *damage, uint16_t damage_cnt);
+
 static inline bool _is_digit(char ch)
 {
     return (ch >= '0') && (ch <= '9');
@@ -1086,14 +1108,13 @@ static const struct wl_shell_surface_listener shell_surface_listener = {
 static void xdg_surface_handle_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial)
 {
     struct window *window = (struct window *)data;
-    struct buffer_hdl *buffer = &window->body->buffer;
 
     xdg_surface_ack_configure(xdg_surface, serial);
 
-    if ((!window->body->surface_configured) && (buffer->busy)) {
+    if ((!window->body->surface_configured) && (window->front_buffer != NULL)) {
        // Flush occured before surface was configured, so add buffer here
-       wl_surface_attach(window->body->surface, buffer->wl_buffer, 0, 0);
-       wl_surface_commit(window->body->surface);
+       lv_area_t full = { 0, 0, window->width - 1, window->height - 1 };
+       present_front_buffer(window, &full, 1);
        window->flush_pending = true;
     }
 
@@ -1181,7 +1202,8 @@ static void handle_global(void *data, struct wl_registry *registry,
 
     if (strcmp(interface, wl_compositor_interface.name) == 0)
     {
-        app->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 1);
+        // Version 4 is needed for damage in buffer coordinates
+        app->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, LV_MIN(version, 4));
     }
     else if (strcmp(interface, wl_subcompositor_interface.name) == 0)
     {
@@ -1233,6 +1255,218 @@ static const struct wl_buffer_listener wl_buffer_listener = {
     .release = handle_wl_buffer_release,
 };
 
+static void handle_wl_frame_done(void *data, struct wl_callback *callback, uint32_t time)
+{
+    struct window *window = (struct window *)data;
+    lv_timer_t *refr_timer;
+
+    wl_callback_destroy(callback);
+    window->frame_callback = NULL;
+
+    // The compositor is ready for the next frame, draw it if anything changed
+    refr_timer = (window->lv_disp != NULL) ? _lv_disp_get_refr_timer(window->lv_disp) : NULL;
+    if (refr_timer)
+    {
+        lv_timer_resume(refr_timer);
+        lv_timer_ready(refr_timer);
+    }
+}
+
+static const struct wl_callback_listener wl_frame_listener = {
+    .done = handle_wl_frame_done,
+};
+
+static void add_area(lv_area_t *areas, uint16_t *cnt, const lv_area_t *area, const lv_area_t *full)
+{
+    uint16_t i;
+
+    for (i = 0; i < *cnt; i++)
+    {
+        if (_lv_area_is_in(area, &areas[i], 0))
+        {
+            return;
+        }
+    }
+
+    if (*cnt < LV_INV_BUF_SIZE)
+    {
+        areas[*cnt] = *area;
+        (*cnt)++;
+    }
+    else
+    {
+        // No more room, use the whole buffer
+        areas[0] = *full;
+        *cnt = 1;
+    }
+}
+
+static bool area_is_redrawn(lv_disp_t *disp, const lv_area_t *area)
+{
+    uint16_t i;
+
+    if ((disp == NULL) || (disp->driver->rotated != LV_DISP_ROT_NONE))
+    {
+        return false;
+    }
+
+    for (i = 0; i < disp->inv_p; i++)
+    {
+        if (!disp->inv_area_joined[i] && _lv_area_is_in(area, &disp->inv_areas[i], 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Get the buffer to draw the next frame of the window body into.
+ * A buffer is chosen which isn't used by the compositor, preferably the last presented one.
+ * Otherwise the areas presented since the buffer was drawn are copied from the last presented buffer.
+ * @param window the window
+ * @param skip_redrawn true to not copy the areas which are about to be redrawn anyway
+ * @return the back buffer, or NULL on error
+ */
+static struct buffer_hdl * get_back_buffer(struct window *window, bool skip_redrawn)
+{
+    struct buffer_hdl *buffer = window->back_buffer;
+    struct buffer_hdl *front = window->front_buffer;
+    int i;
+
+    if (buffer != NULL)
+    {
+        return buffer;
+    }
+
+    while (buffer == NULL)
+    {
+        if ((front != NULL) && !front->busy)
+        {
+            buffer = front;
+            break;
+        }
+
+        for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
+        {
+            if ((window->buffers[i].wl_buffer != NULL) && !window->buffers[i].busy)
+            {
+                buffer = &window->buffers[i];
+                break;
+            }
+        }
+
+        // All buffers are used by the compositor, wait for a release instead of tearing a presented one
+        if ((buffer == NULL) && (wl_display_dispatch(window->application->display) < 0))
+        {
+            LV_LOG_ERROR("failed to wait for a free wayland buffer");
+            return NULL;
+        }
+    }
+
+    if ((front != NULL) && (front != buffer))
+    {
+        const size_t stride = window->width * BYTES_PER_PIXEL;
+        uint16_t a;
+
+        for (a = 0; a < buffer->stale_cnt; a++)
+        {
+            const lv_area_t *area = &buffer->stale_areas[a];
+            const size_t row_size = lv_area_get_width(area) * BYTES_PER_PIXEL;
+            size_t offset = (area->y1 * stride) + (area->x1 * BYTES_PER_PIXEL);
+            int32_t y;
+
+            if (skip_redrawn && area_is_redrawn(window->lv_disp, area))
+            {
+                continue;
+            }
+
+            for (y = area->y1; y <= area->y2; y++)
+            {
+                memcpy((uint8_t *)buffer->base + offset, (uint8_t *)front->base + offset, row_size);
+                offset += stride;
+            }
+        }
+    }
+
+    buffer->stale_cnt = 0;
+    window->back_buffer = buffer;
+
+    return buffer;
+}
+
+static void present_front_buffer(struct window *window, const lv_area_t *damage, uint16_t damage_cnt)
+{
+    struct wl_surface *surface = window->body->surface;
+    struct buffer_hdl *buffer = window->front_buffer;
+    uint16_t i;
+
+    for (i = 0; i < damage_cnt; i++)
+    {
+        if (wl_surface_get_version(surface) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION)
+        {
+            wl_surface_damage_buffer(surface, damage[i].x1, damage[i].y1,
+                                     lv_area_get_width(&damage[i]), lv_area_get_height(&damage[i]));
+        }
+        else
+        {
+            // Same as the buffer coordinates as neither scale nor transform is set
+            wl_surface_damage(surface, damage[i].x1, damage[i].y1,
+                              lv_area_get_width(&damage[i]), lv_area_get_height(&damage[i]));
+        }
+    }
+
+    if (window->frame_callback == NULL)
+    {
+        window->frame_callback = wl_surface_frame(surface);
+        wl_callback_add_listener(window->frame_callback, &wl_frame_listener, window);
+    }
+
+    wl_surface_attach(surface, buffer->wl_buffer, 0, 0);
+    wl_surface_commit(surface);
+    buffer->busy = true;
+}
+
+static void commit_back_buffer(struct window *window)
+{
+    struct buffer_hdl *buffer = window->back_buffer;
+    const lv_area_t full = { 0, 0, window->width - 1, window->height - 1 };
+    uint16_t a;
+    int i;
+
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    // The other buffers miss the damaged areas now
+    for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
+    {
+        struct buffer_hdl *other = &window->buffers[i];
+        if ((other == buffer) || (other->wl_buffer == NULL))
+        {
+            continue;
+        }
+
+        for (a = 0; a < window->damage_cnt; a++)
+        {
+            add_area(other->stale_areas, &other->stale_cnt, &window->damage[a], &full);
+        }
+    }
+
+    window->front_buffer = buffer;
+    window->back_buffer = NULL;
+
+    if (window->body->surface_configured)
+    {
+        present_front_buffer(window, window->damage, window->damage_cnt);
+    }
+
+    window->damage_cnt = 0;
+    window->flush_pending = true;
+}
+
 static bool initialize_allocator(struct buffer_allocator *allocator, const char *dir)
 {
     static const char template[] = "/lvgl-wayland-XXXXXX";
@@ -1673,23 +1907,38 @@ static void detach_decoration(struct window *window,
 
 static bool resize_window(struct window *window, int width, int height)
 {
-    struct buffer_hdl *buffer = &window->body->buffer;
+    int i;
 
     LV_LOG_TRACE("resize window %dx%d", width, height);
 
     // De-initialize previous buffers
-    if (buffer->busy)
+    for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
     {
-        LV_LOG_WARN("Deinitializing busy window buffer...");
-        wl_surface_attach(window->body->surface, NULL, 0, 0);
-        wl_surface_commit(window->body->surface);
-        buffer->busy = false;
+        struct buffer_hdl *buffer = &window->buffers[i];
+        if (buffer->busy)
+        {
+            LV_LOG_WARN("Deinitializing busy window buffer...");
+            wl_surface_attach(window->body->surface, NULL, 0, 0);
+            wl_surface_commit(window->body->surface);
+            buffer->busy = false;
+        }
+
+        if (!deinitialize_buffer(window, buffer))
+        {
+            LV_LOG_ERROR("failed to deinitialize window buffer");
+            return false;
+        }
     }
 
-    if (!deinitialize_buffer(window, buffer))
+    window->back_buffer = NULL;
+    window->front_buffer = NULL;
+    window->damage_cnt = 0;
+
+    // A detached surface may never get its frame callback, don't wait for it
+    if (window->frame_callback)
     {
-        LV_LOG_ERROR("failed to deinitialize window buffer");
-        return false;
+        wl_callback_destroy(window->frame_callback);
+        window->frame_callback = NULL;
     }
 
 #if LV_WAYLAND_CLIENT_SIDE_DECORATIONS
@@ -1704,11 +1953,15 @@ static bool resize_window(struct window *window, int width, int height)
     }
 #endif
 
-    // Initialize backing buffer
-    if (!initialize_buffer(window, buffer, width, height))
+    // Initialize backing buffers, all of them are cleared so they are in sync
+    for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
     {
-        LV_LOG_ERROR("failed to initialize window buffer");
-        return false;
+        if (!initialize_buffer(window, &window->buffers[i], width, height))
+        {
+            LV_LOG_ERROR("failed to initialize window buffer");
+            return false;
+        }
+        window->buffers[i].stale_cnt = 0;
     }
 
     window->width = width;
@@ -1926,7 +2179,19 @@ static void destroy_window(struct window *window)
     }
 #endif
 
-    deinitialize_buffer(window, &window->body->buffer);
+    if (window->frame_callback)
+    {
+        wl_callback_destroy(window->frame_callback);
+        window->frame_callback = NULL;
+    }
+
+    int i;
+    for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
+    {
+        deinitialize_buffer(window, &window->buffers[i]);
+    }
+    window->back_buffer = NULL;
+    window->front_buffer = NULL;
     destroy_graphic_obj(window->body);
 
     deinitialize_allocator(&window->allocator);
@@ -1935,7 +2200,7 @@ static void destroy_window(struct window *window)
 static void _lv_wayland_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
     struct window *window = disp_drv->user_data;
-    struct buffer_hdl *buffer = &window->body->buffer;
+    struct buffer_hdl *buffer;
 
     const lv_coord_t hres = (disp_drv->rotated == 0) ? (disp_drv->hor_res) : (disp_drv->ver_res);
     const lv_coord_t vres = (disp_drv->rotated == 0) ? (disp_drv->ver_res) : (disp_drv->hor_res);
@@ -1964,56 +2229,96 @@ static void _lv_wayland_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv
         lv_disp_flush_ready(disp_drv);
         return;
     }
-//    else if (buffer->busy)
-//    {
-//        LV_LOG_WARN("skip flush since wayland backing buffer is busy");
-//        lv_disp_flush_ready(disp_drv);
-//        return;
-//    }
 
-    int32_t x;
+    // Draw into a buffer which is not used by the compositor to avoid tearing
+    buffer = get_back_buffer(window, true);
+    if (!buffer)
+    {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    const lv_area_t full = { 0, 0, disp_drv->hor_res - 1, disp_drv->ver_res - 1 };
+    lv_area_t damage;
     int32_t y;
 
-    for (y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++)
+    if (!_lv_area_intersect(&damage, area, &full))
+    {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    for (y = damage.y1; y <= damage.y2; y++)
     {
-        for (x = area->x1; x <= area->x2 && x < disp_drv->hor_res; x++)
+        const lv_color_t *src = color_p + ((y - area->y1) * lv_area_get_width(area)) + (damage.x1 - area->x1);
+        uint8_t * const buf = (uint8_t *)buffer->base + (((y * disp_drv->hor_res) + damage.x1) * BYTES_PER_PIXEL);
+#if (LV_COLOR_DEPTH == 1)
+        int32_t x;
+        for (x = 0; x < lv_area_get_width(&damage); x++)
         {
-            int offset = (y * disp_drv->hor_res) + x;
-#if (LV_COLOR_DEPTH == 32)
-            uint32_t * const buf = (uint32_t *)buffer->base + offset;
-            *buf = color_p->full;
-#elif (LV_COLOR_DEPTH == 16)
-            uint16_t * const buf = (uint16_t *)buffer->base + offset;
-            *buf = color_p->full;
-#elif (LV_COLOR_DEPTH == 8)
-            uint8_t * const buf = (uint8_t *)buffer->base + offset;
-            *buf = color_p->full;
-#elif (LV_COLOR_DEPTH == 1)
-            uint8_t * const buf = (uint8_t *)buffer->base + offset;
-            *buf = ((0x07 * color_p->ch.red)   << 5) |
-                   ((0x07 * color_p->ch.green) << 2) |
-                   ((0x03 * color_p->ch.blue)  << 0);
-#endif
-            color_p++;
+            buf[x] = ((0x07 * src[x].ch.red)   << 5) |
+                     ((0x07 * src[x].ch.green) << 2) |
+                     ((0x03 * src[x].ch.blue)  << 0);
         }
+#else
+        memcpy(buf, src, lv_area_get_width(&damage) * BYTES_PER_PIXEL);
+#endif
     }
 
-    wl_surface_damage(window->body->surface, area->x1, area->y1,
-                      (area->x2 - area->x1 + 1), (area->y2 - area->y1 + 1));
+    add_area(window->damage, &window->damage_cnt, &damage, &full);
 
     if (lv_disp_flush_is_last(disp_drv))
     {
-        if (window->body->surface_configured) {
-           wl_surface_attach(window->body->surface, buffer->wl_buffer, 0, 0);
-           wl_surface_commit(window->body->surface);
-        }
-        buffer->busy = true;
-        window->flush_pending = true;
+        commit_back_buffer(window);
     }
 
     lv_disp_flush_ready(disp_drv);
 }
 
+static bool _lv_wayland_copy_area(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_coord_t dx, lv_coord_t dy)
+{
+    struct window *window = disp_drv->user_data;
+
+    if (!window || window->closed || window->shall_close || window->resize_pending)
+    {
+        return false;
+    }
+
+    // Every refresh presents its back buffer, so a new one is taken here and all of its stale areas
+    // are copied from the last presented buffer before moving the pixels
+    struct buffer_hdl *buffer = get_back_buffer(window, false);
+    if (!buffer)
+    {
+        return false;
+    }
+
+    const lv_area_t full = { 0, 0, disp_drv->hor_res - 1, disp_drv->ver_res - 1 };
+    const size_t stride = disp_drv->hor_res * BYTES_PER_PIXEL;
+    const size_t row_size = lv_area_get_width(area) * BYTES_PER_PIXEL;
+    uint8_t *base = (uint8_t *)buffer->base + (area->x1 * BYTES_PER_PIXEL);
+    int32_t y;
+
+    /* Go against the movement so that the source rows are read before they're overwritten */
+    if (dy > 0)
+    {
+        for (y = area->y2; y >= area->y1; y--)
+        {
+            memmove(base + y * stride, base + (y - dy) * stride - dx * BYTES_PER_PIXEL, row_size);
+        }
+    }
+    else
+    {
+        for (y = area->y1; y <= area->y2; y++)
+        {
+            memmove(base + y * stride, base + (y - dy) * stride - dx * BYTES_PER_PIXEL, row_size);
+        }
+    }
+
+    add_area(window->damage, &window->damage_cnt, area, &full);
+
+    return true;
+}
+
 static void _lv_wayland_handle_input(void)
 {
     while (wl_display_prepare_read(application.display) != 0)
@@ -2076,7 +2381,16 @@ static void _lv_wayland_handle_output(void)
         }
         else if (window->resize_pending)
         {
-            bool do_resize = !window->body->buffer.busy;
+            bool do_resize = true;
+            int i;
+            for (i = 0; i < LV_WAYLAND_BUFFER_COUNT; i++)
+            {
+                if (window->buffers[i].busy)
+                {
+                    do_resize = false;
+                    break;
+                }
+            }
 #if LV_WAYLAND_CLIENT_SIDE_DECORATIONS
             if (!window->application->opt_disable_decorations && !window->fullscreen)
             {
@@ -2131,6 +2445,28 @@ static void _lv_wayland_cycle(lv_timer_t * tmr)
     _lv_wayland_handle_output();
 }
 
+static void _lv_wayland_refr_timer(lv_timer_t * tmr)
+{
+    lv_disp_t *disp = tmr->user_data;
+    struct window *window = (disp != NULL) ? disp->driver->user_data : NULL;
+
+    // The compositor didn't show the last frame yet, wait for its frame callback
+    if (window && window->frame_callback)
+    {
+        lv_timer_pause(tmr);
+        return;
+    }
+
+    _lv_disp_refr_timer(tmr);
+
+    // Present the frame even if its last flush was skipped or its pixels were only moved,
+    // so that the next frame and _lv_wayland_copy_area() start from the last presented buffer
+    if (window && window->back_buffer && !window->closed && !window->shall_close && !window->resize_pending)
+    {
+        commit_back_buffer(window);
+    }
+}
+
 static void _lv_wayland_pointer_read(lv_indev_drv_t *drv, lv_indev_data_t *data)
 {
     struct window *window = drv->disp->driver->user_data;
@@ -2357,11 +2693,18 @@ lv_disp_t * lv_wayland_create_window(lv_coord_t hor_res, lv_coord_t ver_res, cha
     window->lv_disp_drv.hor_res = hor_res;
     window->lv_disp_drv.ver_res = ver_res;
     window->lv_disp_drv.flush_cb = _lv_wayland_flush;
+    window->lv_disp_drv.copy_area_cb = _lv_wayland_copy_area;
     window->lv_disp_drv.user_data = window;
 
     /* Register display */
     window->lv_disp = lv_disp_drv_register(&window->lv_disp_drv);
 
+    /* Pace the refresh with the frame callbacks of the compositor */
+    if (window->lv_disp && _lv_disp_get_refr_timer(window->lv_disp))
+    {
+        lv_timer_set_cb(_lv_disp_get_refr_timer(window->lv_disp), _lv_wayland_refr_timer);
+    }
+
     /* Register input */
     lv_indev_drv_init(&window->lv_indev_drv_pointer);
     window->lv_indev_drv_pointer.type = LV_INDEV_TYPE_POINTER;
@@ -9,6 +9,7 @@
 #define _DEFAULT_SOURCE /* needed for usleep() */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <limits.h>
@@ -19,10 +20,20 @@
 #include "gui_guider.h"
 #include "events_init.h"
 #include "custom.h"
+#include "assets.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*Split the startup into phases, the report is printed to stderr on exit*/
+#if LV_USE_PROFILER
+    #define PROFILER_PHASE(name) lv_profiler_phase(name)
+#else
+    #define PROFILER_PHASE(name)
+#endif
+#ifndef ASSET_PACK_PATH
+    #define ASSET_PACK_PATH "assets.lvap"   /*Can be overridden by the GUI_ASSET_PACK environment variable*/
+#endif
 struct pollfd pfd;
 uint32_t time_till_next;
 int sleep_time;
@@ -37,6 +48,9 @@ int sleep_time;
 static bool close_cb(lv_disp_t * disp);
 static void hal_init(void);
 static void * tick_thread(void * data);
+#if LV_USE_PROFILER || LV_USE_LATENCY
+static void report_print(const char * buf);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -59,23 +73,54 @@ int main(int argc, char ** argv)
     (void) argv;    /*Unused*/
 
     /*Initialize LittlevGL*/
+    PROFILER_PHASE("lv_init");
     lv_init();
 
     /*Initialize the HAL (display, input devices, tick) for LittlevGL*/
+    PROFILER_PHASE("hal_init");
     hal_init();
 
     /*Create a GUI-Guider app */
+    PROFILER_PHASE("setup_ui");
     setup_ui(&guider_ui);
+    PROFILER_PHASE("custom_init");
     events_init(&guider_ui);
     custom_init(&guider_ui);
 
+    /*Use the images and fonts of the asset pack if there is one*/
+    PROFILER_PHASE("assets");
+    const char * asset_pack = getenv("GUI_ASSET_PACK");
+    if(assets_init(asset_pack ? asset_pack : ASSET_PACK_PATH)) {
+        assets_apply(guider_ui.screen);
+        ui_part_built_cb = assets_apply;    /*Also for the parts built later*/
+    }
+
+    /*Measure the touch-to-photon latency if the GUI_LATENCY environment variable is set.
+     *With GUI_LATENCY=synthetic a virtual finger taps and swipes too. The report is printed to stderr on exit.*/
+#if LV_USE_LATENCY
+    const char * latency = getenv("GUI_LATENCY");
+    if(latency) {
+        lv_latency_set_screen_name(guider_ui.screen, "screen");
+        if(strcmp(latency, "synthetic") == 0) lv_latency_synthetic_create(NULL, 1000);
+        lv_latency_start();
+    }
+#endif
+
     pfd.fd = lv_wayland_get_fd();
     pfd.events = POLLIN;
 
+    /*The first call renders the whole screen*/
+    PROFILER_PHASE("first frame");
+    bool first = true;
+
     while(1) {
         /* Periodically call the lv_task handler.
          * It could be done in a timer interrupt or an OS task too.*/
         time_till_next = lv_wayland_timer_handler();
+        if(first) {
+            PROFILER_PHASE("run");
+            first = false;
+        }
 #if LV_USE_VIDEO
         video_play(&guider_ui);
 #endif
@@ -94,6 +139,14 @@ int main(int argc, char ** argv)
         while ((poll(&pfd, 1, sleep_time) < 0) && (errno == EINTR));
     }
 
+#if LV_USE_PROFILER
+    lv_profiler_stop();
+    lv_profiler_report(report_print);
+#endif
+#if LV_USE_LATENCY
+    if(getenv("GUI_LATENCY")) lv_latency_report(report_print);
+#endif
+
     return 0;
 }
 
@@ -104,6 +157,13 @@ static bool close_cb(lv_disp_t * disp)
 {
 }
 
+#if LV_USE_PROFILER || LV_USE_LATENCY
+static void report_print(const char * buf)
+{
+    fputs(buf, stderr);
+}
+#endif
+
 /**
  * Initialize the Hardware Abstraction Layer (HAL) for the Littlev graphics library
  */
@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2023 NXP
+ */
+
+/**
+ * Test of the SHT30 driver and the I2C bus on a mock adapter.
+ * The simulated sensor measures 4 times/s like the real one, so the test takes about 15 s.
+ * CRC errors, NACKs (from the sensor and ENXIO from a missing device) and bus errors are injected,
+ * then the counters, the backoff of the recovery and the samples after the recovery are checked.
+ * Usage: sensor_test
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for clock_gettime() and usleep() */
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "sht30.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_PERIOD     250     /*Sample period [ms], the shortest one*/
+#define TEST_TEMP       23.5f
+#define TEST_HUMIDITY   45.0f
+
+#define CHECK(cond)     check(cond, #cond, __LINE__)
+#define COUNTER(name)   offsetof(sht30_counters_t, name)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void test_sampling(void);
+static void test_crc_error(void);
+static void test_nack(void);
+static void test_missing_device(void);
+static void test_bus_error(void);
+static void test_backoff(void);
+static void test_recovery(void);
+static bool wait_for(size_t counter, uint32_t value, uint32_t timeout_ms, uint64_t * time);
+static sht30_counters_t get_counters(void);
+static void check(bool ok, const char * expr, int line);
+static uint64_t time_ms(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static i2c_mock_t mock;
+static sht30_fake_t fake = {.temp = TEST_TEMP, .humidity = TEST_HUMIDITY};
+static uint32_t fail_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    i2c_adapter_t adapter;
+    i2c_adapter_init_mock(&adapter, &mock);
+    sht30_fake_attach(&mock, &fake, SHT30_ADDR);
+
+    i2c_bus_t * bus = i2c_bus_create(&adapter);
+    if(bus == NULL || sht30_add(bus, SHT30_ADDR, TEST_PERIOD) != 0 || i2c_bus_start(bus) != 0) {
+        printf("can't start the bus\n");
+        return 1;
+    }
+
+    test_sampling();
+    test_crc_error();
+    test_nack();
+    test_missing_device();
+    test_bus_error();
+    test_backoff();
+    test_recovery();
+
+    i2c_bus_stats_t stats;
+    i2c_bus_get_stats(bus, &stats);
+    i2c_bus_del(bus);
+
+    sht30_counters_t c = get_counters();
+    printf("samples %u, crc errors %u, no data %u, bus errors %u, setups %u, transfers %u\n",
+           (unsigned)c.sample_cnt, (unsigned)c.crc_err_cnt, (unsigned)c.no_data_cnt, (unsigned)c.bus_err_cnt,
+           (unsigned)c.setup_cnt, (unsigned)stats.transfer_cnt);
+    printf("%s\n", fail_cnt ? "FAIL" : "ok");
+    return fail_cnt ? 1 : 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void test_sampling(void)
+{
+    printf("sampling\n");
+    CHECK(wait_for(COUNTER(sample_cnt), 2, 2000, NULL));
+
+    sht30_sample_t sample;
+    CHECK(sht30_get_last(&sample));
+    CHECK(fabsf(sample.temp - TEST_TEMP) < 0.1f);
+    CHECK(fabsf(sample.humidity - TEST_HUMIDITY) < 0.1f);
+
+    sht30_counters_t c = get_counters();
+    CHECK(c.setup_cnt == 1);
+    CHECK(c.crc_err_cnt == 0);
+    CHECK(c.bus_err_cnt == 0);
+}
+
+/*A wrong CRC drops the measurement only*/
+static void test_crc_error(void)
+{
+    printf("crc error\n");
+    sht30_counters_t c = get_counters();
+    fake.corrupt_cnt = 2;
+    CHECK(wait_for(COUNTER(crc_err_cnt), c.crc_err_cnt + 2, 2000, NULL));
+    CHECK(wait_for(COUNTER(sample_cnt), c.sample_cnt + 1, 1000, NULL));
+
+    sht30_counters_t c2 = get_counters();
+    CHECK(c2.crc_err_cnt == c.crc_err_cnt + 2);
+    CHECK(c2.setup_cnt == c.setup_cnt);
+    CHECK(c2.bus_err_cnt == c.bus_err_cnt);
+}
+
+/*A NACKed fetch means there is no new measurement, it's fetched again soon*/
+static void test_nack(void)
+{
+    printf("nack\n");
+    sht30_counters_t c = get_counters();
+    fake.nack_cnt = 3;
+    CHECK(wait_for(COUNTER(no_data_cnt), c.no_data_cnt + 3, 2000, NULL));
+    CHECK(wait_for(COUNTER(sample_cnt), c.sample_cnt + 1, 1000, NULL));
+
+    sht30_counters_t c2 = get_counters();
+    CHECK(c2.setup_cnt == c.setup_cnt);
+    CHECK(c2.bus_err_cnt == c.bus_err_cnt);
+}
+
+/*The mock adapter fails with ENXIO if there is no device at the address, it's a NACK too*/
+static void test_missing_device(void)
+{
+    printf("missing device\n");
+    sht30_counters_t c = get_counters();
+    mock.dev_cnt = 0;
+    CHECK(wait_for(COUNTER(no_data_cnt), c.no_data_cnt + 4, 1000, NULL));
+    mock.dev_cnt = 1;
+    CHECK(wait_for(COUNTER(sample_cnt), c.sample_cnt + 1, 1000, NULL));
+
+    sht30_counters_t c2 = get_counters();
+    CHECK(c2.setup_cnt == c.setup_cnt);
+    CHECK(c2.bus_err_cnt == c.bus_err_cnt);
+}
+
+/*A failed fetch is tried again in the next period, the sensor is set up again only if it keeps failing*/
+static void test_bus_error(void)
+{
+    printf("bus error\n");
+    sht30_counters_t c = get_counters();
+    fake.fail_cnt = 1;
+    CHECK(wait_for(COUNTER(bus_err_cnt), c.bus_err_cnt + 1, 1000, NULL));
+    CHECK(wait_for(COUNTER(sample_cnt), c.sample_cnt + 1, 1000, NULL));
+    CHECK(get_counters().setup_cnt == c.setup_cnt);
+
+    fake.fail_cnt = 3;
+    CHECK(wait_for(COUNTER(setup_cnt), c.setup_cnt + 1, 2000, NULL));
+    CHECK(wait_for(COUNTER(sample_cnt), get_counters().sample_cnt + 1, 1000, NULL));
+    CHECK(get_counters().bus_err_cnt == c.bus_err_cnt + 4);
+}
+
+/*The sensor is set up successfully but never has data: the backoff has to grow anyway*/
+static void test_backoff(void)
+{
+    printf("backoff\n");
+    sht30_counters_t c = get_counters();
+    uint64_t t[4];
+    uint32_t i;
+
+    fake.nack_cnt = UINT32_MAX;
+    for(i = 0; i < 4; i++) {
+        CHECK(wait_for(COUNTER(setup_cnt), c.setup_cnt + 1 + i, 4000, &t[i]));
+    }
+
+    /*Each setup is after a failed fetch period plus the backoff: 100, 200, 400, 800 ms*/
+    uint32_t gap0 = t[1] - t[0];
+    uint32_t gap2 = t[3] - t[2];
+    printf("  setups after %u, %u, %u ms\n", (unsigned)gap0, (unsigned)(t[2] - t[1]), (unsigned)gap2);
+    CHECK(gap2 >= gap0 + 400);
+}
+
+/*After a valid measurement the backoff starts from the shortest one again*/
+static void test_recovery(void)
+{
+    printf("recovery\n");
+    fake.nack_cnt = 0;
+    CHECK(wait_for(COUNTER(sample_cnt), get_counters().sample_cnt + 1, 3000, NULL));
+
+    sht30_counters_t c = get_counters();
+    uint64_t failed;
+    uint64_t setup;
+    fake.fail_cnt = 3;
+    CHECK(wait_for(COUNTER(bus_err_cnt), c.bus_err_cnt + 3, 2000, &failed));
+    CHECK(wait_for(COUNTER(setup_cnt), c.setup_cnt + 1, 1000, &setup));
+    printf("  set up %u ms after the last error\n", (unsigned)(setup - failed));
+    CHECK(setup - failed < 300);
+
+    CHECK(wait_for(COUNTER(sample_cnt), get_counters().sample_cnt + 1, 1000, NULL));
+}
+
+/*Wait until a counter reaches `value` and save the time when it did*/
+static bool wait_for(size_t counter, uint32_t value, uint32_t timeout_ms, uint64_t * time)
+{
+    uint64_t start = time_ms();
+    while(time_ms() - start < timeout_ms) {
+        sht30_counters_t c = get_counters();
+        if(*(uint32_t *)((uint8_t *)&c + counter) >= value) {
+            if(time) *time = time_ms();
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+static sht30_counters_t get_counters(void)
+{
+    sht30_counters_t c;
+    sht30_get_counters(&c);
+    return c;
+}
+
+static void check(bool ok, const char * expr, int line)
+{
+    if(ok) return;
+    printf("  line %d: %s failed\n", line, expr);
+    fail_cnt++;
+}
+
+static uint64_t time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2023 NXP
+ */
+
+/**
+ * Write the images and fonts compiled into the application into an asset pack.
+ * Usage: mkassetpack <output file>
+ * The application maps the pack at startup (see custom/assets.h), so the assets can be
+ * replaced by rebuilding only this tool with the new image and font sources.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include "lvgl.h"
+#include "assets.h"
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*Time is not used by the tool but lv_conf.h expects the application to provide it*/
+uint32_t custom_tick_get(void)
+{
+    return 0;
+}
+
+int main(int argc, char ** argv)
+{
+    if(argc != 2) {
+        fprintf(stderr, "Usage: %s <output file>\n", argv[0]);
+        return 1;
+    }
+
+    lv_init();
+
+    if(!assets_write_pack(argv[1])) {
+        fprintf(stderr, "Couldn't write %s\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}